@@ -105,6 +105,17 @@ class IndexExistsError : public RedBaseError {
         : RedBaseError("Index already exists: " + tab_name + '.' + col_name) {}
 };
 
+class DuplicateKeyError : public RedBaseError {
+   public:
+    DuplicateKeyError(const std::string &tab_name, const std::string &col_name)
+        : RedBaseError("Duplicate key in unique index: " + tab_name + '.' + col_name) {}
+};
+
+class UnknownMethodError : public RedBaseError {
+   public:
+    UnknownMethodError(const std::string &method) : RedBaseError("Unknown storage method: " + method) {}
+};
+
 // QL errors
 class InvalidValueCountError : public RedBaseError {
    public:
@@ -1,9 +1,14 @@
 #include "execution_manager.h"
 
+#include <cmath>
+#include <tuple>
+
 #include "executor_delete.h"
+#include "executor_index_only_scan.h"
 #include "executor_index_scan.h"
 #include "executor_insert.h"
 #include "executor_nestedloop_join.h"
+#include "executor_parallel_seq_scan.h"
 #include "executor_projection.h"
 #include "executor_seq_scan.h"
 #include "executor_update.h"
@@ -68,6 +73,11 @@ std::vector<Condition> QlManager::check_where_clause(const std::vector<std::stri
             TabMeta &rhs_tab = sm_manager_->db_.get_table(cond.rhs_col.tab_name);
             auto rhs_col = rhs_tab.get_col(cond.rhs_col.col_name);
             rhs_type = rhs_col->type;
+            // 溢出字段的值不在记录中，只支持与常量比较
+            if (lhs_col->is_overflow() || rhs_col->is_overflow()) {
+                throw InternalError("Cannot compare out-of-line column " + cond.lhs_col.col_name + " with column " +
+                                    cond.rhs_col.col_name);
+            }
         }
         if (lhs_type != rhs_type) {
             throw IncompatibleTypeError(coltype2str(lhs_type), coltype2str(rhs_type));
@@ -76,21 +86,230 @@ std::vector<Condition> QlManager::check_where_clause(const std::vector<std::stri
     return res_conds;
 }
 
-int QlManager::get_indexNo(std::string tab_name, std::vector<Condition> curr_conds) {
-    int index_no = -1;
+/**
+ * @brief 索引能够用于conds的列数：从第一列开始匹配等值条件得到最长的等值前缀，前缀之后的一列还可以匹配一个范围条件
+ * 哈希索引只有每一列上都有等值条件时才能使用
+ *
+ * @param eq_len 输出等值前缀的长度
+ * @return 匹配的列数，0表示该索引不能缩小扫描范围
+ */
+int QlManager::match_index(const std::string &tab_name, const IndexMeta &index, const std::vector<Condition> &conds,
+                           int *eq_len) {
+    auto has_cond = [&](const ColMeta &col, bool eq) {
+        return std::any_of(conds.begin(), conds.end(), [&](const Condition &cond) {
+            return cond.is_rhs_val && cond.lhs_col.tab_name == tab_name && cond.lhs_col.col_name == col.name &&
+                   (eq ? cond.op == OP_EQ : cond.op != OP_NE);
+        });
+    };
+    *eq_len = 0;
+    while (*eq_len < index.col_num && has_cond(index.cols[*eq_len], true)) {
+        (*eq_len)++;
+    }
+    if (!ix_index_ordered(index.type) && *eq_len < index.col_num) {
+        return 0;
+    }
+    if (*eq_len < index.col_num && has_cond(index.cols[*eq_len], false)) {
+        return *eq_len + 1;
+    }
+    return *eq_len;
+}
+
+/**
+ * @brief 为表选择扫描使用的索引
+ * 表上执行过ANALYZE时按estimate_scan()估计的代价选择，全表扫描的代价更低时不使用索引；
+ * 否则选择匹配列数最多的索引，相同时选择等值前缀更长的，与B+树索引匹配的列数相同时优先使用常驻内存的ART索引，
+ * 其次是哈希索引
+ *
+ * @param tab_name 表名
+ * @param curr_conds 表上的条件
+ * @return std::vector<std::string> 选中的索引包含的列名，没有可用的索引时为空
+ */
+std::vector<std::string> QlManager::get_index_cols(std::string tab_name, std::vector<Condition> curr_conds) {
     TabMeta &tab = sm_manager_->db_.get_table(tab_name);
-    for (auto &cond : curr_conds) {
-        if (cond.is_rhs_val && cond.op != OP_NE) {
-            // If rhs is value and op is not "!=", find if lhs has index
-            auto lhs_col = tab.get_col(cond.lhs_col.col_name);
-            if (lhs_col->index) {
-                // This column has index, use it
-                index_no = lhs_col - tab.cols.begin();
+    const IndexMeta *best = nullptr;
+    if (tab.stats.analyzed) {
+        best = estimate_scan(tab_name, curr_conds).index;
+        return best == nullptr ? std::vector<std::string>{} : best->col_names();
+    }
+    std::tuple<int, int, int> best_score = {0, 0, 0};  // (匹配的列数, 等值前缀长度, 索引类型的优先级)
+    for (auto &index : tab.indexes) {
+        int eq_len;
+        int matched = match_index(tab_name, index, curr_conds, &eq_len);
+        if (matched == 0) {
+            continue;
+        }
+        int type_rank = index.type == IX_INDEX_ART ? 2 : index.type == IX_INDEX_HASH ? 1 : 0;
+        std::tuple<int, int, int> score = {matched, eq_len, type_rank};
+        if (score > best_score) {
+            best = &index;
+            best_score = score;
+        }
+    }
+    return best == nullptr ? std::vector<std::string>{} : best->col_names();
+}
+
+/**
+ * @brief 由统计信息估计表上col_idx列满足conds中与常量比较的条件的记录所占的比例
+ *
+ * @param eq_only 只考虑等值条件（索引的等值前缀）
+ */
+double QlManager::estimate_selectivity(const TabMeta &tab, int col_idx, const std::vector<Condition> &conds,
+                                       bool eq_only) {
+    auto &col = tab.cols[col_idx];
+    auto &col_stats = tab.stats.cols[col_idx];
+    double sel = 1, lower = 0, upper = 1;
+    for (auto &cond : conds) {
+        if (!cond.is_rhs_val || cond.lhs_col.tab_name != tab.name || cond.lhs_col.col_name != col.name ||
+            (eq_only && cond.op != OP_EQ)) {
+            continue;
+        }
+        if (col_stats.bounds.empty()) {
+            // 没有统计信息的列（溢出字段）使用固定的选择率
+            sel *= cond.op == OP_EQ ? DEFAULT_EQ_SEL : cond.op == OP_NE ? 1 : DEFAULT_RANGE_SEL;
+            continue;
+        }
+        uint64_t value = sm_stats_value(cond.rhs_val.raw->data, col.type, col.len);
+        double below = col_stats.fraction_below(value), equal = col_stats.fraction_equal(value);
+        switch (cond.op) {
+            case OP_EQ:
+                sel = std::min(sel, equal);
                 break;
-            }
+            case OP_NE:
+                sel *= 1 - equal;
+                break;
+            case OP_LT:
+                upper = std::min(upper, below);
+                break;
+            case OP_LE:
+                upper = std::min(upper, below + equal);
+                break;
+            case OP_GT:
+                lower = std::max(lower, below + equal);
+                break;
+            case OP_GE:
+                lower = std::max(lower, below);
+                break;
+        }
+    }
+    return sel * std::max(0.0, upper - lower);
+}
+
+/**
+ * @brief 基于ANALYZE的统计信息估计表的扫描方式：比较全表扫描和每个可用索引的代价，返回代价最低的
+ * 全表扫描顺序读取所有page；索引扫描从根结点查找到叶子，顺序读取范围内的叶子，再按rid随机读取记录
+ * 索引范围内的entry数由等值前缀各列的选择率与下一列上范围条件的选择率相乘得到（假设各列独立）
+ *
+ * @param tab_name 已经执行过ANALYZE的表
+ * @param conds 表上的条件，可以包含连接条件（不影响估计）
+ */
+QlManager::ScanEstimate QlManager::estimate_scan(const std::string &tab_name, const std::vector<Condition> &conds) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    double num_rows = std::max<double>(tab.stats.num_rows, 1);
+    double num_pages = std::max(tab.stats.num_pages - 1, 1);  // 第0页是file header
+    double rows = num_rows;
+    for (int i = 0; i < (int)tab.cols.size(); i++) {
+        rows *= estimate_selectivity(tab, i, conds, false);
+    }
+    ScanEstimate best = {.index = nullptr,
+                         .cost = num_pages * SEQ_PAGE_COST + num_rows * CPU_TUPLE_COST,
+                         .rows = std::max(rows, 1.0)};
+    for (auto &index : tab.indexes) {
+        int eq_len;
+        int matched = match_index(tab_name, index, conds, &eq_len);
+        if (matched == 0) {
+            continue;
+        }
+        double sel = 1;
+        for (int i = 0; i < matched; i++) {
+            int col_idx = index.col_idxs[i];
+            sel *= estimate_selectivity(tab, col_idx, conds, i < eq_len);
+        }
+        double entries = std::max(num_rows * sel, 1.0);
+        double index_pages;
+        if (index.type == IX_INDEX_ART) {
+            index_pages = 0;  // 常驻内存，查找不读取page
+        } else if (index.type == IX_INDEX_HASH) {
+            index_pages = 1;
+        } else if (index.stats.height > 0) {
+            index_pages = index.stats.height + std::ceil(index.stats.num_leaves * sel);
+        } else {
+            // 索引建立在ANALYZE之后，按叶子的大小估计
+            double leaves = num_rows * (index.col_tot_len + index.include_len + sizeof(Rid)) / PAGE_SIZE;
+            index_pages = std::ceil(std::log(std::max(leaves, 2.0)) / std::log(PAGE_SIZE / 16.0)) + 1 +
+                          std::ceil(leaves * sel);
+        }
+        double cost = index_pages * RANDOM_PAGE_COST + std::min(entries, num_pages) * RANDOM_PAGE_COST +
+                      entries * (CPU_INDEX_COST + CPU_TUPLE_COST);
+        if (cost < best.cost) {
+            best.index = &index;
+            best.cost = cost;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief 多表连接时按估计的代价调整表的顺序，所有表都执行过ANALYZE时才调整
+ * 连接是右深的嵌套循环，第i张表对前面每个组合都扫描一次：cost(i) = scan(i) + rows(i) * cost(i+1)
+ * 表的数量不超过MAX_REORDER_TABLES时枚举所有顺序，选择代价最低的
+ *
+ * @param tab_names 表名，原地调整顺序
+ * @param conds 查询的全部条件
+ */
+void QlManager::order_tables(std::vector<std::string> *tab_names, const std::vector<Condition> &conds) {
+    int n = static_cast<int>(tab_names->size());
+    if (n < 2 || n > MAX_REORDER_TABLES) {
+        return;
+    }
+    std::vector<ScanEstimate> scans;
+    for (auto &tab_name : *tab_names) {
+        if (!sm_manager_->db_.get_table(tab_name).stats.analyzed) {
+            return;
+        }
+        scans.push_back(estimate_scan(tab_name, conds));
+    }
+    std::vector<int> order(n), best_order;
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    double best_cost = 0;
+    do {
+        double cost = scans[order[n - 1]].cost;
+        for (int i = n - 2; i >= 0; i--) {
+            cost = scans[order[i]].cost + scans[order[i]].rows * cost;
+        }
+        if (best_order.empty() || cost < best_cost) {
+            best_order = order;
+            best_cost = cost;
         }
+    } while (std::next_permutation(order.begin(), order.end()));
+    std::vector<std::string> ordered;
+    for (int i : best_order) {
+        ordered.push_back((*tab_names)[i]);
     }
-    return index_no;
+    *tab_names = std::move(ordered);
+}
+
+/**
+ * @brief 判断表上查询用到的列是否都在索引的key或INCLUDE列中，是则可以只读索引完成扫描
+ *
+ * @param tab_name 表名
+ * @param index_col_names 索引包含的列名
+ * @param sel_cols 投影的列（已经补全表名）
+ * @param conds 查询的全部条件，包括其他表上以及连接时用到本表列的条件
+ */
+bool QlManager::index_covers(const std::string &tab_name, const std::vector<std::string> &index_col_names,
+                             const std::vector<TabCol> &sel_cols, const std::vector<Condition> &conds) {
+    auto &index = *sm_manager_->db_.get_table(tab_name).get_index_meta(index_col_names);
+    // 只读索引的扫描需要按顺序遍历叶子，哈希索引不支持
+    if (index.type != IX_INDEX_BTREE) {
+        return false;
+    }
+    auto covered = [&](const TabCol &col) { return col.tab_name != tab_name || index.covers(col.col_name); };
+    return std::all_of(sel_cols.begin(), sel_cols.end(), covered) &&
+           std::all_of(conds.begin(), conds.end(), [&](const Condition &cond) {
+               return covered(cond.lhs_col) && (cond.is_rhs_val || covered(cond.rhs_col));
+           });
 }
 
 void QlManager::insert_into(const std::string &tab_name, std::vector<Value> values, Context *context) {
@@ -114,18 +333,18 @@ void QlManager::delete_from(const std::string &tab_name, std::vector<Condition>
     // make scan executor
     std::unique_ptr<AbstractExecutor> scanExecutor;
     // lab3 task3 Todo
-    // 根据get_indexNo判断conds上有无索引
+    // 根据get_index_cols判断conds上有无索引
     // 创建合适的scan executor(有索引优先用索引)
     // lab3 task3 Todo end
     RmFileHandle *rfh = sm_manager_->fhs_.at(tab_name).get();
     context->lock_mgr_->LockIXOnTable(context->txn_, rfh->GetFd());
     LockDataId lock_data_id = LockDataId{rfh->GetFd(), LockDataType::TABLE};
     context->txn_->GetLockSet()->insert(lock_data_id);
-    int index_no = get_indexNo(tab_name, conds);
-    if (index_no == -1) {
+    auto index_col_names = get_index_cols(tab_name, conds);
+    if (index_col_names.empty()) {
         scanExecutor = std::make_unique<SeqScanExecutor>(sm_manager_, tab_name, conds, context);
     } else {
-        scanExecutor = std::make_unique<IndexScanExecutor>(sm_manager_, tab_name, conds, index_no, context);
+        scanExecutor = std::make_unique<IndexScanExecutor>(sm_manager_, tab_name, conds, index_col_names, context);
     }
 
     for (scanExecutor->beginTuple(); !scanExecutor->is_end(); scanExecutor->nextTuple()) {
@@ -168,11 +387,11 @@ void QlManager::update_set(const std::string &tab_name, std::vector<SetClause> s
     LockDataId lock_data_id = LockDataId{rfh->GetFd(), LockDataType::TABLE};
     context->txn_->GetLockSet()->insert(lock_data_id);
     std::unique_ptr<AbstractExecutor> scanExecutor;
-    int index_no = get_indexNo(tab_name, conds);
-    if (index_no == -1) {
+    auto index_col_names = get_index_cols(tab_name, conds);
+    if (index_col_names.empty()) {
         scanExecutor = std::make_unique<SeqScanExecutor>(sm_manager_, tab_name, conds, context);
     } else {
-        scanExecutor = std::make_unique<IndexScanExecutor>(sm_manager_, tab_name, conds, index_no, context);
+        scanExecutor = std::make_unique<IndexScanExecutor>(sm_manager_, tab_name, conds, index_col_names, context);
     }
     for (scanExecutor->beginTuple(); !scanExecutor->is_end(); scanExecutor->nextTuple()) {
         rids.push_back(scanExecutor->rid());
@@ -230,28 +449,51 @@ void QlManager::select_from(std::vector<TabCol> sel_cols, const std::vector<std:
     }
     // Parse where clause
     conds = check_where_clause(tab_names, conds);
+    // 判断能否只读索引时需要看到所有条件，pop_conds会逐表取走条件
+    const auto all_conds = conds;
+    // 有统计信息时按估计的代价决定连接的顺序，输出的列仍按sel_cols的顺序
+    std::vector<std::string> tabs = tab_names;
+    order_tables(&tabs, conds);
     // Scan table , 生成表算子列表tab_nodes
-    std::vector<std::unique_ptr<AbstractExecutor>> table_scan_executors(tab_names.size());
-    for (size_t i = 0; i < tab_names.size(); i++) {
-        auto curr_conds = pop_conds(conds, {tab_names.begin(), tab_names.begin() + i + 1});
-        int index_no = get_indexNo(tab_names[i], curr_conds);
+    std::vector<std::unique_ptr<AbstractExecutor>> table_scan_executors(tabs.size());
+    for (size_t i = 0; i < tabs.size(); i++) {
+        auto curr_conds = pop_conds(conds, {tabs.begin(), tabs.begin() + i + 1});
+        auto index_col_names = get_index_cols(tabs[i], curr_conds);
         // lab3 task2 Todo
-        // 根据get_indexNo判断conds上有无索引
+        // 根据get_index_cols判断conds上有无索引
         // 创建合适的scan executor(有索引优先用索引)存入table_scan_executors
         // lab3 task2 Todo end
-        for (std::string tab_name : tab_names) {
+        for (std::string tab_name : tabs) {
             RmFileHandle *rfh = sm_manager_->fhs_.at(tab_name).get();
             context->lock_mgr_->LockISOnTable(context->txn_, rfh->GetFd());
             LockDataId lock_data_id = LockDataId{rfh->GetFd(), LockDataType::TABLE};
             context->txn_->GetLockSet()->insert(lock_data_id);
         }
-        if (index_no != -1) {
-            // printf("index_no: %d\n", index_no);
+        if (!index_col_names.empty() && index_covers(tabs[i], index_col_names, sel_cols, all_conds)) {
+            table_scan_executors[i] = std::make_unique<IndexOnlyScanExecutor>(sm_manager_, tabs[i], curr_conds,
+                                                                              index_col_names, context);
+        } else if (!index_col_names.empty()) {
             table_scan_executors[i] =
-                std::make_unique<IndexScanExecutor>(sm_manager_, tab_names[i], curr_conds, index_no, context);
+                std::make_unique<IndexScanExecutor>(sm_manager_, tabs[i], curr_conds, index_col_names, context);
         } else {
             // printf("no index\n");
-            table_scan_executors[i] = std::make_unique<SeqScanExecutor>(sm_manager_, tab_names[i], curr_conds, context);
+            std::unique_ptr<SeqScanExecutor> seq_scan;
+            int num_pages = sm_manager_->fhs_.at(tabs[i])->get_file_hdr().num_pages;
+            int num_workers = (int)std::thread::hardware_concurrency();
+            if (tabs.size() == 1 && num_workers > 1 && num_pages > ParallelSeqScanExecutor::MORSEL_PAGES &&
+                context->lock_mgr_ != nullptr) {
+                // 单表的大表扫描使用并行扫描；连接的内表需要按外表元组反复扫描，仍然使用串行扫描
+                // worker需要通过锁管理器识别其他事务未提交的修改，没有锁管理器时同样使用串行扫描
+                seq_scan = std::make_unique<ParallelSeqScanExecutor>(sm_manager_, tabs[i], curr_conds, context,
+                                                                     num_workers);
+            } else {
+                seq_scan = std::make_unique<SeqScanExecutor>(sm_manager_, tabs[i], curr_conds, context);
+            }
+            if (tabs.size() == 1) {
+                // 单表查询时扫描算子只需要输出被投影的列
+                seq_scan->set_output_cols(sel_cols);
+            }
+            table_scan_executors[i] = std::move(seq_scan);
         }
     }
     assert(conds.empty());
@@ -263,12 +505,12 @@ void QlManager::select_from(std::vector<TabCol> sel_cols, const std::vector<std:
     // 逆序遍历tab_nodes为左节点, 现query_plan为右节点,生成joinNode作为新query_plan 根节点
     // 生成query_plan tree完毕后, 根节点转换成投影算子
     // lab3 task2 Todo End
-    for (int i = tab_names.size() - 2; i >= 0; i--) {
+    for (int i = tabs.size() - 2; i >= 0; i--) {
         std::unique_ptr<AbstractExecutor> left = std::move(table_scan_executors[i]);
         std::unique_ptr<AbstractExecutor> right = std::move(executorTreeRoot);
         executorTreeRoot = std::make_unique<NestedLoopJoinExecutor>(std::move(left), std::move(right));
     }
-    executorTreeRoot = std::make_unique<ProjectionExecutor>(std::move(executorTreeRoot), sel_cols);
+    executorTreeRoot = std::make_unique<ProjectionExecutor>(std::move(executorTreeRoot), sel_cols, sm_manager_);
 
     // Column titles
     std::vector<std::string> captions;
@@ -83,6 +83,24 @@ class QlManager {
    private:
     SmManager *sm_manager_;
 
+    // 代价估计的参数：顺序/随机读取一个page、处理一条记录/一个索引entry的代价
+    static constexpr double SEQ_PAGE_COST = 1.0;
+    static constexpr double RANDOM_PAGE_COST = 4.0;
+    static constexpr double CPU_TUPLE_COST = 0.01;
+    static constexpr double CPU_INDEX_COST = 0.005;
+    // 没有统计信息的列上等值和范围条件的选择率
+    static constexpr double DEFAULT_EQ_SEL = 0.005;
+    static constexpr double DEFAULT_RANGE_SEL = 1.0 / 3;
+    // 枚举连接顺序的最大表数
+    static constexpr int MAX_REORDER_TABLES = 6;
+
+    // 一张表的扫描方式及其估计
+    struct ScanEstimate {
+        const IndexMeta *index;  // 使用的索引，nullptr表示全表扫描
+        double cost;             // 扫描的代价
+        double rows;             // 满足表上条件的记录数
+    };
+
    public:
     QlManager(SmManager *sm_manager) : sm_manager_(sm_manager) {}
 
@@ -101,5 +119,12 @@ class QlManager {
     std::vector<ColMeta> get_all_cols(const std::vector<std::string> &tab_names);
     std::vector<Condition> check_where_clause(const std::vector<std::string> &tab_names,
                                               const std::vector<Condition> &conds);
-    int get_indexNo(std::string tab_name, std::vector<Condition> curr_conds);
+    int match_index(const std::string &tab_name, const IndexMeta &index, const std::vector<Condition> &conds,
+                    int *eq_len);
+    std::vector<std::string> get_index_cols(std::string tab_name, std::vector<Condition> curr_conds);
+    double estimate_selectivity(const TabMeta &tab, int col_idx, const std::vector<Condition> &conds, bool eq_only);
+    ScanEstimate estimate_scan(const std::string &tab_name, const std::vector<Condition> &conds);
+    void order_tables(std::vector<std::string> *tab_names, const std::vector<Condition> &conds);
+    bool index_covers(const std::string &tab_name, const std::vector<std::string> &index_col_names,
+                      const std::vector<TabCol> &sel_cols, const std::vector<Condition> &conds);
 };
@@ -44,9 +44,64 @@ class AbstractExecutor {
         return pos;
     }
 
+    /**
+     * @brief 判断记录是否满足条件，条件的左边是记录中的列，右边是常量或同一记录中的列
+     * 溢出字段只有在条件中用到时才从表的溢出文件中读取页链
+     */
+    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec,
+                   SmManager *sm_manager) {
+        auto lhs_col = get_col(rec_cols, cond.lhs_col);
+        char *lhs = rec->data + lhs_col->offset;
+        std::unique_ptr<char[]> lhs_buf;
+        if (lhs_col->is_overflow()) {
+            lhs_buf = std::make_unique<char[]>(lhs_col->len);
+            sm_manager->ofhs_.at(lhs_col->tab_name)
+                ->get_value(*reinterpret_cast<RmOverflowPtr *>(lhs), lhs_buf.get(), lhs_col->len);
+            lhs = lhs_buf.get();
+        }
+        char *rhs;
+        ColType rhs_type;
+        if (cond.is_rhs_val) {
+            rhs_type = cond.rhs_val.type;
+            rhs = cond.rhs_val.raw->data;
+        } else {
+            // rhs is a column
+            auto rhs_col = get_col(rec_cols, cond.rhs_col);
+            rhs_type = rhs_col->type;
+            rhs = rec->data + rhs_col->offset;
+        }
+        assert(rhs_type == lhs_col->type);  // TODO convert to common type
+        int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
+        if (cond.op == OP_EQ) {
+            return cmp == 0;
+        } else if (cond.op == OP_NE) {
+            return cmp != 0;
+        } else if (cond.op == OP_LT) {
+            return cmp < 0;
+        } else if (cond.op == OP_GT) {
+            return cmp > 0;
+        } else if (cond.op == OP_LE) {
+            return cmp <= 0;
+        } else if (cond.op == OP_GE) {
+            return cmp >= 0;
+        } else {
+            throw InternalError("Unexpected op type");
+        }
+    }
+
+    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec,
+                    SmManager *sm_manager) {
+        return std::all_of(conds.begin(), conds.end(),
+                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec, sm_manager); });
+    }
+
     std::map<TabCol, Value> rec2dict(const std::vector<ColMeta> &cols, const RmRecord *rec) {
         std::map<TabCol, Value> rec_dict;
         for (auto &col : cols) {
+            // 溢出字段不参与连接条件（见QlManager::check_where_clause），不需要读取页链
+            if (col.is_overflow()) {
+                continue;
+            }
             TabCol key = {.tab_name = col.tab_name, .col_name = col.name};
             Value val;
             char *val_buf = rec->data + col.offset;
@@ -27,39 +27,51 @@ class DeleteExecutor : public AbstractExecutor {
     }
     std::unique_ptr<RmRecord> Next() override {
         // Get all index files
-        std::vector<IxIndexHandle *> ihs(tab_.cols.size(), nullptr);
-        for (size_t col_i = 0; col_i < tab_.cols.size(); col_i++) {
-            if (tab_.cols[col_i].index) {
-                // lab3 task3 Todo
-                // 获取需要的索引句柄,填充vector ihs
-                // lab3 task3 Todo end
-                ihs[col_i] = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, col_i)).get();
-            }
-            else ihs[col_i]=nullptr;
-        }
-        // Delete each rid from record file and index file
-        for (auto &rid : rids_) {
-            auto rec = fh_->get_record(rid, context_);
+        // 索引的删除先收集到每个索引的缓冲中，所有记录删除完之后按key排序一次性应用
+        std::vector<IxChangeBuffer> ihs;
+        for (auto &index : tab_.indexes) {
             // lab3 task3 Todo
-            // Delete from index file
-            // Delete from record file
+            // 获取需要的索引句柄,填充vector ihs
             // lab3 task3 Todo end
+            auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.col_idxs);
+            ihs.emplace_back(sm_manager_->ihs_.at(index_name).get(), index.col_tot_len, index.include_len);
+        }
+        // Delete each rid from record file and index file
+        try {
+            for (auto &rid : rids_) {
+                auto rec = fh_->get_record(rid, context_);
+                // lab3 task3 Todo
+                // Delete from index file
+                // Delete from record file
+                // lab3 task3 Todo end
             
-            // Delete from index file
-            for (long unsigned int i = 0; i < tab_.cols.size(); i++) {
-                if (tab_.cols[i].index) {
-                    auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, i)).get();;//index file handle
-                    ifh->delete_entry(rec->data + tab_.cols[i].offset,context_->txn_);
+                // Delete from index file
+                char key[IX_MAX_COL_LEN];
+                for (size_t i = 0; i < tab_.indexes.size(); i++) {
+                    tab_.indexes[i].get_key(rec->data, key);
+                    ihs[i].add_delete(key, rid);
                 }
-            }
-            // Delete from record file
-            fh_->delete_record(rid, context_);
+                // Delete from record file
+                fh_->delete_record(rid, context_);
 
-            // record a delete operation into the transaction
-            WriteRecord* wr= new WriteRecord(WType::DELETE_TUPLE, tab_name_,rid, *rec);
-            context_->txn_->AppendWriteRecord(wr);  
+                // record a delete operation into the transaction
+                WriteRecord* wr= new WriteRecord(WType::DELETE_TUPLE, tab_name_,rid, *rec);
+                context_->txn_->AppendWriteRecord(wr);  
+            }
+        } catch (...) {
+            // 已经删除的记录在回滚时按逐行维护的索引撤销，先把它们的索引修改应用完
+            flush_index_changes(ihs);
+            throw;
         }
+        flush_index_changes(ihs);
         return nullptr;
     }
     Rid &rid() override { return _abstract_rid; }
+
+   private:
+    void flush_index_changes(std::vector<IxChangeBuffer> &ihs) {
+        for (auto &buffer : ihs) {
+            buffer.flush(context_->txn_);
+        }
+    }
 };
\ No newline at end of file
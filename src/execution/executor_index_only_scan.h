@@ -0,0 +1,140 @@
+#pragma once
+
+#include "execution_defs.h"
+#include "execution_manager.h"
+#include "executor_abstract.h"
+#include "executor_index_scan.h"
+#include "index/ix.h"
+#include "system/sm.h"
+
+/**
+ * @brief 只读索引的扫描：查询用到的列都在索引的key或INCLUDE列中时，直接由叶子中的entry拼出记录，不再读取表中的记录
+ * 输出的记录与表的记录格式相同，不被索引覆盖的列填0（规划时保证这些列不会被投影或比较）
+ */
+class IndexOnlyScanExecutor : public AbstractExecutor {
+   private:
+    std::string tab_name_;
+    std::vector<Condition> conds_;
+    RmFileHandle *fh_;
+    std::vector<ColMeta> cols_;
+    size_t len_;
+    std::vector<Condition> fed_conds_;
+
+    IndexMeta index_meta_;
+    IxIndexHandle *ih_;
+
+    Rid rid_;
+    std::unique_ptr<IxScan> scan_;
+    std::unique_ptr<RmRecord> rec_;  // 当前entry拼出的记录
+
+    SmManager *sm_manager_;
+
+   public:
+    IndexOnlyScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                          const std::vector<std::string> &index_col_names, Context *context) {
+        rid_ = {-1, -1};
+        scan_ = nullptr;
+        sm_manager_ = sm_manager;
+        tab_name_ = std::move(tab_name);
+        conds_ = std::move(conds);
+        TabMeta &tab = sm_manager_->db_.get_table(tab_name_);
+        fh_ = sm_manager_->fhs_.at(tab_name_).get();
+        cols_ = tab.cols;
+        index_meta_ = *tab.get_index_meta(index_col_names);
+        assert(index_meta_.type == IX_INDEX_BTREE);
+        ih_ = static_cast<IxIndexHandle *>(
+            sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_meta_.col_idxs))
+                .get());
+        len_ = cols_.back().offset + cols_.back().stored_len();
+        context_ = context;
+        std::map<CompOp, CompOp> swap_op = {
+            {OP_EQ, OP_EQ}, {OP_NE, OP_NE}, {OP_LT, OP_GT}, {OP_GT, OP_LT}, {OP_LE, OP_GE}, {OP_GE, OP_LE},
+        };
+        for (auto &cond : conds_) {
+            if (cond.lhs_col.tab_name != tab_name_) {
+                assert(!cond.is_rhs_val && cond.rhs_col.tab_name == tab_name_);
+                std::swap(cond.lhs_col, cond.rhs_col);
+                cond.op = swap_op.at(cond.op);
+            }
+        }
+        fed_conds_ = conds_;
+    }
+
+    std::string getType() { return "indexOnlyScan"; }
+
+    void beginTuple() {
+        auto range = IndexScanExecutor::scan_range(ih_, index_meta_, fed_conds_);
+        scan_ = std::make_unique<IxScan>(ih_, range.first, range.second, sm_manager_->get_bpm(), true);
+        rec_ = std::make_unique<RmRecord>(len_);
+        memset(rec_->data, 0, len_);
+        while (!scan_->is_end() && !read_entry()) {
+            scan_->next();
+        }
+    }
+
+    void nextTuple() {
+        assert(!is_end());
+        for (scan_->next(); !scan_->is_end() && !read_entry(); scan_->next()) {
+        }
+    }
+
+    bool is_end() const override { return scan_->is_end(); }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        if (is_end()) {
+            return nullptr;
+        }
+        return std::make_unique<RmRecord>(*rec_);
+    }
+
+    void feed(const std::map<TabCol, Value> &feed_dict) override {
+        fed_conds_ = conds_;
+        for (auto &cond : fed_conds_) {
+            if (cond.is_rhs_val) {
+                continue;
+            }
+            auto it = feed_dict.find(cond.rhs_col);
+            if (it != feed_dict.end()) {
+                cond.rhs_val = it->second;
+                cond.is_rhs_val = true;
+            }
+        }
+    }
+
+    Rid &rid() override { return rid_; }
+
+   private:
+    /**
+     * @brief 由当前entry拼出记录并判断条件
+     * 不读取表中的记录，但仍然在rid上加共享锁，与IndexScanExecutor经由get_record加的锁一致
+     * entry是在加锁之前从叶子中复制的，可能是其他事务未提交的修改，加锁之后需要确认它仍然在树中
+     *
+     * @return 记录满足所有条件时返回true
+     */
+    bool read_entry() {
+        char key[IX_MAX_COL_LEN * IX_MAX_COL_NUM];
+        std::vector<char> include(index_meta_.include_len);
+        rid_ = scan_->entry(key, include.data());
+        context_->lock_mgr_->LockSharedOnRecord(context_->txn_, rid_, fh_->GetFd());
+        context_->txn_->GetLockSet()->insert(LockDataId{fh_->GetFd(), rid_, LockDataType::RECORD});
+        if (!ih_->has_entry(key, rid_, include.data())) {
+            return false;  // entry已被删除，或者key、INCLUDE列已被修改
+        }
+
+        int offset = 0;
+        for (auto &col : index_meta_.cols) {
+            ix_denormalize_key(key + offset, col.type, col.len, rec_->data + col.offset);
+            offset += col.len;
+        }
+        offset = 0;
+        for (auto &col : index_meta_.include_cols) {
+            memcpy(rec_->data + col.offset, include.data() + offset, col.len);
+            offset += col.len;
+        }
+        return eval_conds(cols_, fed_conds_, rec_.get(), sm_manager_);
+    }
+};
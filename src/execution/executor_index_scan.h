@@ -15,7 +15,8 @@ class IndexScanExecutor : public AbstractExecutor {
     size_t len_;
     std::vector<Condition> fed_conds_;
 
-    int index_no_;
+    IndexMeta index_meta_;  // 扫描使用的（多列）索引
+    int lookahead_pages_;   // 回表时同时预读的记录页个数
 
     Rid rid_;
     std::unique_ptr<RecScan> scan_;
@@ -23,13 +24,13 @@ class IndexScanExecutor : public AbstractExecutor {
     SmManager *sm_manager_;
 
    public:
-    IndexScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds, int index_no,
-                      Context *context) {
+    IndexScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                      const std::vector<std::string> &index_col_names, Context *context,
+                      int lookahead_pages = RM_LOOKAHEAD_PAGES)
+        : lookahead_pages_(lookahead_pages) {
         // lab3 task2 todo
         // 参考seqscan作法,实现indexscan构造方法
         // lab3 task2 todo
-        //!这里是简单的copy了一下，加上了特有的index_no_
-        index_no_ = index_no;
         rid_ = {-1, -1};
         scan_ = nullptr;
         sm_manager_ = sm_manager;
@@ -38,7 +39,8 @@ class IndexScanExecutor : public AbstractExecutor {
         TabMeta &tab = sm_manager_->db_.get_table(tab_name_);
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
         cols_ = tab.cols;
-        len_ = cols_.back().offset + cols_.back().len;
+        index_meta_ = *tab.get_index_meta(index_col_names);
+        len_ = cols_.back().offset + cols_.back().stored_len();
         context_ = context;
         std::map<CompOp, CompOp> swap_op = {
             {OP_EQ, OP_EQ}, {OP_NE, OP_NE}, {OP_LT, OP_GT}, {OP_GT, OP_LT}, {OP_LE, OP_GE}, {OP_GE, OP_LE},
@@ -61,56 +63,37 @@ class IndexScanExecutor : public AbstractExecutor {
         check_runtime_conds();
 
         // index is available, scan index
-        auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_no_)).get();
-        Iid lower = ih->leaf_begin();
-        Iid upper = ih->leaf_end();
-        auto &index_col = cols_[index_no_];
-        for (auto &cond : fed_conds_) {
-            if (cond.is_rhs_val && cond.op != OP_NE && cond.lhs_col.col_name == index_col.name) {
-                char *rhs_key = cond.rhs_val.raw->data;
-                if (cond.op == OP_EQ) {
-                    lower = ih->lower_bound(rhs_key);
-                    upper = ih->upper_bound(rhs_key);
-                } else if (cond.op == OP_LT) {
-                    upper = ih->lower_bound(rhs_key);
-                } else if (cond.op == OP_LE) {
-                    upper = ih->upper_bound(rhs_key);
-                } else if (cond.op == OP_GT) {
-                    lower = ih->upper_bound(rhs_key);
-                } else if (cond.op == OP_GE) {
-                    lower = ih->lower_bound(rhs_key);
-                } else {
-                    throw InternalError("Unexpected op type");
-                }
-
-                // lab3 task2 todo
-                /**
-                 * else if(cond.op == ?){
-                 *
-                 * }else if(){
-                 * ...
-                 * }else if(){
-                 * ...
-                 * }
-                 * ...
-                 * else{
-                 *  throw InternalError("Unexpected op type");
-                 * }
-                 *
-                 *
-                 */
-                // 利用cond 进行索引扫描
-                // lab3 task2 todo end
-                break;
+        auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_meta_.col_idxs))
+                      .get();
+        // lab3 task2 todo
+        // 利用cond 进行索引扫描
+        // lab3 task2 todo end
+        if (!ix_index_ordered(index_meta_.type)) {
+            // 规划时保证哈希/ART索引的每一列上都有等值条件
+            std::vector<char> key(index_meta_.col_tot_len);
+            int offset = 0;
+            for (auto &col : index_meta_.cols) {
+                auto eq = std::find_if(fed_conds_.begin(), fed_conds_.end(), [&](const Condition &cond) {
+                    return cond.is_rhs_val && cond.op == OP_EQ && cond.lhs_col.col_name == col.name;
+                });
+                assert(eq != fed_conds_.end());
+                memcpy(key.data() + offset, eq->rhs_val.raw->data, col.len);
+                offset += col.len;
             }
+            scan_ = std::make_unique<IxPointScan>(ih, key.data());
+        } else {
+            auto bih = static_cast<IxIndexHandle *>(ih);
+            auto range = scan_range(bih, index_meta_, fed_conds_);
+            scan_ = std::make_unique<IxScan>(bih, range.first, range.second, sm_manager_->get_bpm());
         }
-        scan_ = std::make_unique<IxScan>(ih, lower, upper, sm_manager_->get_bpm());
+        // 按索引的顺序回表，经过预读队列使后面的记录页在读取当前记录时并行读入
+        scan_ = std::make_unique<RmLookaheadScan>(std::move(scan_), fh_, lookahead_pages_);
         // Get the first record
         while (!scan_->is_end()) {
             rid_ = scan_->rid();
             try {
                 auto rec = fh_->get_record(rid_, context_);
-                if (eval_conds(cols_, fed_conds_, rec.get())) {
+                if (eval_conds(cols_, fed_conds_, rec.get(), sm_manager_)) {
                     break;
                 }
             } catch (RecordNotFoundError &e) {
@@ -133,7 +116,7 @@ class IndexScanExecutor : public AbstractExecutor {
             }
             rid_ = scan_->rid();
             auto rec = fh_->get_record(rid_, context_);
-            if (eval_conds(cols_, fed_conds_, rec.get())) {
+            if (eval_conds(cols_, fed_conds_, rec.get(), sm_manager_)) {
                 break;
             }
         }
@@ -182,41 +165,59 @@ class IndexScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
-        auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
-        ColType rhs_type;
-        if (cond.is_rhs_val) {
-            rhs_type = cond.rhs_val.type;
-            rhs = cond.rhs_val.raw->data;
-        } else {
-            // rhs is a column
-            auto rhs_col = get_col(rec_cols, cond.rhs_col);
-            rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+    /**
+     * @brief 根据条件计算在索引上扫描的区间[lower, upper)，条件的lhs都已经是本表的列
+     */
+    static std::pair<Iid, Iid> scan_range(IxIndexHandle *ih, const IndexMeta &index_meta,
+                                          const std::vector<Condition> &conds) {
+        // 扫描区间由索引最长的等值前缀和其后一列上的范围条件确定，端点是编码后的key：
+        // 未限定的列在下界补0x00、上界补0xFF，开区间的端点反过来补齐，再用lower_bound/upper_bound定位；
+        // 非唯一索引的key之后拼接的rid按同样的方式补齐
+        int key_len = ih->key_len();
+        std::vector<char> lower_key(key_len, 0), upper_key(key_len, (char)0xff);
+        bool lower_open = false, upper_open = false, full_key = true;
+        int offset = 0;
+        for (auto &col : index_meta.cols) {
+            auto eq = std::find_if(conds.begin(), conds.end(), [&](const Condition &cond) {
+                return cond.is_rhs_val && cond.op == OP_EQ && cond.lhs_col.col_name == col.name;
+            });
+            if (eq != conds.end()) {
+                ix_normalize_key(eq->rhs_val.raw->data, col.type, col.len, lower_key.data() + offset);
+                memcpy(upper_key.data() + offset, lower_key.data() + offset, col.len);
+                offset += col.len;
+                continue;
+            }
+            // 等值前缀之后的一列：取最紧的上下界
+            char bound[IX_MAX_COL_LEN];
+            for (auto &cond : conds) {
+                if (!cond.is_rhs_val || cond.op == OP_NE || cond.lhs_col.col_name != col.name) {
+                    continue;
+                }
+                bool is_lower = cond.op == OP_GT || cond.op == OP_GE;
+                bool open = cond.op == OP_GT || cond.op == OP_LT;
+                char *key = (is_lower ? lower_key : upper_key).data() + offset;
+                ix_normalize_key(cond.rhs_val.raw->data, col.type, col.len, bound);
+                int cmp = memcmp(bound, key, col.len);
+                if ((is_lower ? cmp > 0 : cmp < 0) || (cmp == 0 && open)) {
+                    memcpy(key, bound, col.len);
+                    (is_lower ? lower_open : upper_open) = open;
+                }
+            }
+            offset += col.len;
+            full_key = false;
+            break;
         }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
-        int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
-        if (cond.op == OP_EQ) {
-            return cmp == 0;
-        } else if (cond.op == OP_NE) {
-            return cmp != 0;
-        } else if (cond.op == OP_LT) {
-            return cmp < 0;
-        } else if (cond.op == OP_GT) {
-            return cmp > 0;
-        } else if (cond.op == OP_LE) {
-            return cmp <= 0;
-        } else if (cond.op == OP_GE) {
-            return cmp >= 0;
-        } else {
-            throw InternalError("Unexpected op type");
+        // 每一列上都有等值条件（如连接的内表按外表的值查找）时，Bloom filter排除的key不需要访问任何page
+        if (full_key && !ih->MayContain(lower_key.data())) {
+            Iid none = {.page_no = IX_NO_PAGE, .slot_no = 0};
+            return {none, none};
         }
-    }
-
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
-        return std::all_of(conds.begin(), conds.end(),
-                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
+        memset(lower_key.data() + offset, lower_open ? 0xff : 0, key_len - offset);
+        memset(upper_key.data() + offset, upper_open ? 0 : 0xff, key_len - offset);
+        Iid lower =
+            lower_open ? ih->upper_bound_normalized(lower_key.data()) : ih->lower_bound_normalized(lower_key.data());
+        Iid upper =
+            upper_open ? ih->lower_bound_normalized(upper_key.data()) : ih->upper_bound_normalized(upper_key.data());
+        return {lower, upper};
     }
 };
\ No newline at end of file
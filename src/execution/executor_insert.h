@@ -46,22 +46,52 @@ class InsertExecutor : public AbstractExecutor {
                 throw IncompatibleTypeError(coltype2str(col.type), coltype2str(val.type));
             }
             val.init_raw(col.len);
-            memcpy(rec.data + col.offset, val.raw->data, col.len);
+            if (col.is_overflow()) {
+                // 大字段写入溢出页链，记录中只存放指针
+                auto ptr = sm_manager_->ofhs_.at(tab_name_)->insert_value(val.raw->data, val.str_val.size());
+                memcpy(rec.data + col.offset, &ptr, sizeof(ptr));
+            } else {
+                memcpy(rec.data + col.offset, val.raw->data, col.len);
+            }
         }
         // Insert into record file
         rid_ = fh_->insert_record(rec.data, context_);
-        // Transaction insert
-        WriteRecord* wr= new WriteRecord(WType::INSERT_TUPLE, tab_name_, rid_);
-        context_->txn_->AppendWriteRecord(wr);  
         // Insert into index
-        for (size_t i = 0; i < tab_.cols.size(); i++) {
-            auto &col = tab_.cols[i];
-            if (col.index) {
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, i)).get();
-                ih->insert_entry(rec.data + col.offset, rid_,context_->txn_);
+        char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
+        for (size_t i = 0; i < tab_.indexes.size(); i++) {
+            auto &index = tab_.indexes[i];
+            index.get_key(rec.data, key);
+            index.get_include(rec.data, include);
+            if (!get_index(index)->insert_entry(key, rid_, context_->txn_, include)) {
+                // 哈希索引的key唯一，key已经存在时撤销这条记录，语句失败
+                undo_insert(rec, i);
+                throw DuplicateKeyError(tab_name_, SmManager::index_cols_str(index.col_names()));
             }
         }
+        // Transaction insert
+        WriteRecord* wr= new WriteRecord(WType::INSERT_TUPLE, tab_name_, rid_);
+        context_->txn_->AppendWriteRecord(wr);  
         return std::make_unique<RmRecord>(rec);
     }
     Rid &rid() override { return rid_; }
+
+   private:
+    IxIndex *get_index(const IndexMeta &index) {
+        auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.col_idxs);
+        return sm_manager_->ihs_.at(index_name).get();
+    }
+
+    /**
+     * @brief 删除已经插入的记录、它在前num_indexes个索引中的entry以及溢出字段的页链
+     * 此时还没有写入事务的write set，回滚时不会再处理这条记录
+     */
+    void undo_insert(const RmRecord &rec, size_t num_indexes) {
+        char key[IX_MAX_COL_LEN];
+        for (size_t i = 0; i < num_indexes; i++) {
+            tab_.indexes[i].get_key(rec.data, key);
+            get_index(tab_.indexes[i])->delete_entry(key, rid_, context_->txn_);
+        }
+        fh_->delete_record(rid_, context_);
+        sm_manager_->release_overflow(tab_name_, rec);
+    }
 };
\ No newline at end of file
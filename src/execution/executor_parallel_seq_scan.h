@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "executor_seq_scan.h"
+
+/**
+ * @brief 并行顺序扫描算子
+ * 把表的page范围切分为若干morsel（每个MORSEL_PAGES个page），worker线程每次领取一个morsel，
+ * 在其中运行自己的RmScan并在本地判断谓词，把满足条件的rid成批放入结果队列；
+ * 算子按到达顺序消费这些批次，因此输出顺序与串行扫描不同（上层不能依赖扫描顺序）
+ * worker不获取记录锁，筛选结果只是候选：执行线程在输出前对记录加锁，重新读取并判断谓词，
+ * 跳过在筛选之后被其他事务修改或删除、已经不再满足条件的记录
+ * 被其他事务加锁的记录可能是未提交的修改，worker不判断谓词直接作为候选，由执行线程像串行扫描一样等待加锁后再判断
+ */
+class ParallelSeqScanExecutor : public SeqScanExecutor {
+   public:
+    static constexpr int MORSEL_PAGES = 64;  // 每个morsel包含的page数
+
+   private:
+    int num_workers_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<int> next_morsel_{0};  // 下一个待领取的morsel
+    int num_morsels_ = 0;
+
+    std::mutex latch_;                      // 保护以下成员
+    std::condition_variable cv_;            // 队列非空/未满或worker结束时通知
+    std::deque<std::vector<Rid>> batches_;  // 已完成的morsel中满足条件的rid
+    int running_workers_ = 0;
+    bool stop_ = false;                     // 提前结束扫描（如算子被销毁或重新beginTuple）
+    std::exception_ptr error_;              // worker中抛出的异常，由执行线程重新抛出
+
+    std::vector<Rid> batch_;  // 当前正在输出的批次
+    size_t batch_pos_ = 0;
+    bool end_ = true;
+
+   public:
+    ParallelSeqScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                            Context *context, int num_workers)
+        : SeqScanExecutor(sm_manager, std::move(tab_name), std::move(conds), context), num_workers_(num_workers) {}
+
+    ~ParallelSeqScanExecutor() override { stop_workers(); }
+
+    std::string getType() override { return "ParallelSeqScan"; }
+
+    void beginTuple() override {
+        stop_workers();
+        check_runtime_conds();
+
+        int num_pages = fh_->get_file_hdr().num_pages - RM_FIRST_RECORD_PAGE;
+        num_morsels_ = (num_pages + MORSEL_PAGES - 1) / MORSEL_PAGES;
+        next_morsel_ = 0;
+        batches_.clear();
+        batch_.clear();
+        batch_pos_ = 0;
+        stop_ = false;
+        error_ = nullptr;
+        end_ = false;
+
+        auto preds = get_scan_preds();
+        int num_workers = std::max(1, std::min(num_workers_, num_morsels_));
+        running_workers_ = num_workers;
+        for (int i = 0; i < num_workers; i++) {
+            workers_.emplace_back([this, preds] { worker(preds); });
+        }
+        advance();
+    }
+
+    void nextTuple() override {
+        check_runtime_conds();
+        assert(!is_end());
+        batch_pos_++;
+        advance();
+    }
+
+    bool is_end() const override { return end_; }
+
+   private:
+    /**
+     * @brief 领取morsel并扫描，直到所有morsel都被领取或扫描被停止
+     */
+    void worker(const std::vector<RmScanPred> &preds) {
+        try {
+            int morsel;
+            while ((morsel = next_morsel_.fetch_add(1)) < num_morsels_) {
+                int first_page_no = RM_FIRST_RECORD_PAGE + morsel * MORSEL_PAGES;
+                std::vector<Rid> rids;
+                for (RmScan scan(fh_, preds, first_page_no, first_page_no + MORSEL_PAGES); !scan.is_end();
+                     scan.next()) {
+                    bool locked_by_others;
+                    auto rec = fh_->read_record(scan.rid(), cond_col_idxs_, context_, &locked_by_others);
+                    if (locked_by_others || eval_conds(cols_, fed_conds_, rec.get(), sm_manager_)) {
+                        rids.push_back(scan.rid());
+                    }
+                }
+                std::unique_lock lock{latch_};
+                // 限制队列长度，避免上层消费较慢时缓存整张表的rid
+                cv_.wait(lock, [&] { return stop_ || (int)batches_.size() < 2 * num_workers_; });
+                if (stop_) {
+                    break;
+                }
+                if (!rids.empty()) {
+                    batches_.push_back(std::move(rids));
+                    cv_.notify_all();
+                }
+            }
+        } catch (...) {
+            std::scoped_lock lock{latch_};
+            if (error_ == nullptr) {
+                error_ = std::current_exception();
+            }
+            stop_ = true;
+        }
+        std::scoped_lock lock{latch_};
+        running_workers_--;
+        cv_.notify_all();
+    }
+
+    /**
+     * @brief 从batch_pos_开始找到下一个输出的rid，当前批次用完时从队列中取下一批
+     * 候选记录加锁后重新判断谓词，不满足的跳过
+     */
+    void advance() {
+        while (true) {
+            while (batch_pos_ >= batch_.size()) {
+                std::unique_lock lock{latch_};
+                cv_.wait(lock, [&] { return !batches_.empty() || running_workers_ == 0; });
+                if (error_ != nullptr) {
+                    auto error = error_;
+                    lock.unlock();
+                    stop_workers();
+                    std::rethrow_exception(error);
+                }
+                if (batches_.empty()) {
+                    end_ = true;
+                    return;
+                }
+                batch_ = std::move(batches_.front());
+                batches_.pop_front();
+                batch_pos_ = 0;
+                cv_.notify_all();
+            }
+            rid_ = batch_[batch_pos_];
+            if (recheck()) {
+                return;
+            }
+            batch_pos_++;
+        }
+    }
+
+    /**
+     * @brief 对rid_加S锁后重新读取谓词列并判断fed_conds_
+     * 锁在事务结束前不会释放，因此之后Next()读到的记录与这里判断的一致
+     *
+     * @return false表示记录已被删除或不再满足谓词
+     */
+    bool recheck() {
+        auto rec = fh_->get_record(rid_, cond_col_idxs_, context_);
+        return fh_->is_record(rid_) && eval_conds(cols_, fed_conds_, rec.get(), sm_manager_);
+    }
+
+    void stop_workers() {
+        {
+            std::scoped_lock lock{latch_};
+            stop_ = true;
+            cv_.notify_all();
+        }
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    }
+};
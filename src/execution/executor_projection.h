@@ -11,10 +11,13 @@ class ProjectionExecutor : public AbstractExecutor {
     std::vector<ColMeta> cols_;
     size_t len_;
     std::vector<size_t> sel_idxs_;
+    SmManager *sm_manager_;
 
    public:
-    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols) {
+    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols,
+                       SmManager *sm_manager) {
         prev_ = std::move(prev);
+        sm_manager_ = sm_manager;
 
         size_t curr_offset = 0;
         auto &prev_cols = prev_->cols();
@@ -60,7 +63,14 @@ class ProjectionExecutor : public AbstractExecutor {
             // lab3 task2 Todo
             // 利用memcpy生成proj_rec
             // lab3 task2 Todo End
-            memcpy(proj_rec->data + proj_col.offset, prev_rec->data + prev_col.offset, proj_col.len);
+            if (prev_col.is_overflow()) {
+                // 溢出字段在投影时才读取页链，投影结果中存放完整的字段值
+                auto ptr = reinterpret_cast<RmOverflowPtr *>(prev_rec->data + prev_col.offset);
+                sm_manager_->ofhs_.at(prev_col.tab_name)->get_value(*ptr, proj_rec->data + proj_col.offset,
+                                                                    proj_col.len);
+            } else {
+                memcpy(proj_rec->data + proj_col.offset, prev_rec->data + prev_col.offset, proj_col.len);
+            }
         }
         return proj_rec;
     }
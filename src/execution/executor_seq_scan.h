@@ -7,13 +7,15 @@
 #include "system/sm.h"
 
 class SeqScanExecutor : public AbstractExecutor {
-   private:
+   protected:
     std::string tab_name_;
     std::vector<Condition> conds_;  // 初始扫描条件(来自SQL)
     RmFileHandle *fh_;              // TableHeap
     std::vector<ColMeta> cols_;
     size_t len_;
     std::vector<Condition> fed_conds_;  // 实际扫描条件(可能由于连接运算动态改变)
+    std::vector<int> cond_col_idxs_;    // 谓词中用到的列，PAX布局下判断谓词时只读取这些列
+    std::vector<int> out_col_idxs_;     // Next()需要输出的列，为空表示输出所有列
 
     Rid rid_;                        // 当前扫描到的记录的rid
     std::unique_ptr<RecScan> scan_;  // table_iterator
@@ -28,7 +30,7 @@ class SeqScanExecutor : public AbstractExecutor {
         TabMeta &tab = sm_manager_->db_.get_table(tab_name_);
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
         cols_ = tab.cols;
-        len_ = cols_.back().offset + cols_.back().len;
+        len_ = cols_.back().offset + cols_.back().stored_len();
         context_ = context;
         std::map<CompOp, CompOp> swap_op = {
             {OP_EQ, OP_EQ}, {OP_NE, OP_NE}, {OP_LT, OP_GT}, {OP_GT, OP_LT}, {OP_LE, OP_GE}, {OP_GE, OP_LE},
@@ -42,10 +44,27 @@ class SeqScanExecutor : public AbstractExecutor {
                 std::swap(cond.lhs_col, cond.rhs_col);
                 cond.op = swap_op.at(cond.op);
             }
+            add_col_idx(cond_col_idxs_, cond.lhs_col);
+            if (!cond.is_rhs_val && cond.rhs_col.tab_name == tab_name_) {
+                add_col_idx(cond_col_idxs_, cond.rhs_col);
+            }
         }
         fed_conds_ = conds_;
     }
 
+    /**
+     * @brief 设置上层算子实际需要的列，Next()只输出这些列（其余列填0）
+     * 对于PAX布局的表，扫描时只需要访问谓词列和输出列的minipage
+     */
+    void set_output_cols(const std::vector<TabCol> &out_cols) {
+        out_col_idxs_.clear();
+        for (auto &col : out_cols) {
+            if (col.tab_name == tab_name_) {
+                add_col_idx(out_col_idxs_, col);
+            }
+        }
+    }
+
     std::string getType() override { return "SeqScan"; }
 
     /**
@@ -55,18 +74,18 @@ class SeqScanExecutor : public AbstractExecutor {
     void beginTuple() override {
         check_runtime_conds();
 
-        scan_ = std::make_unique<RmScan>(fh_);
+        scan_ = std::make_unique<RmScan>(fh_, get_scan_preds());
 
         // 得到第一个满足fed_conds_条件的record,并把其rid赋给算子成员rid_
         while (!scan_->is_end()) {
             rid_ = scan_->rid();
             try {
-                auto rec = fh_->get_record(rid_, context_);  // TableHeap->GetTuple() 当前扫描到的记录
+                auto rec = fh_->get_record(rid_, cond_col_idxs_, context_);  // 当前扫描到的记录(只包含谓词列)
                 // lab3 task2 todo
                 // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
                 // 满足则中止循环
                 // lab3 task2 todo end
-                if (eval_conds(cols_, fed_conds_, rec.get())) {
+                if (eval_conds(cols_, fed_conds_, rec.get(), sm_manager_)) {
                     break;
                 }
             } catch (RecordNotFoundError &e) {
@@ -86,8 +105,8 @@ class SeqScanExecutor : public AbstractExecutor {
             // 满足则中止循环
             // lab3 task2 todo End
             rid_ = scan_->rid();
-            auto rec = fh_->get_record(rid_, context_);
-            if (eval_conds(cols_, fed_conds_, rec.get())) {
+            auto rec = fh_->get_record(rid_, cond_col_idxs_, context_);
+            if (eval_conds(cols_, fed_conds_, rec.get(), sm_manager_)) {
                 break;
             }
         }
@@ -106,6 +125,9 @@ class SeqScanExecutor : public AbstractExecutor {
         if (is_end()) {
             return nullptr;
         }
+        if (!out_col_idxs_.empty()) {
+            return fh_->get_record(rid_, out_col_idxs_, context_);
+        }
         auto rec = fh_->get_record(rid_, context_);
         return rec;
     }
@@ -128,50 +150,43 @@ class SeqScanExecutor : public AbstractExecutor {
 
     Rid &rid() override { return rid_; }
 
-    void check_runtime_conds() {
+    /**
+     * @brief 将与常量比较的条件转换为RmScan的谓词，用于根据zone map跳过page
+     */
+    std::vector<RmScanPred> get_scan_preds() {
+        static const std::map<CompOp, RmCompOp> scan_op = {
+            {OP_EQ, RM_OP_EQ}, {OP_LT, RM_OP_LT}, {OP_LE, RM_OP_LE}, {OP_GT, RM_OP_GT}, {OP_GE, RM_OP_GE},
+        };
+        std::vector<RmScanPred> preds;
         for (auto &cond : fed_conds_) {
-            assert(cond.lhs_col.tab_name == tab_name_);
-            if (!cond.is_rhs_val) {
-                assert(cond.rhs_col.tab_name == tab_name_);
+            auto op = scan_op.find(cond.op);
+            if (!cond.is_rhs_val || op == scan_op.end()) {
+                continue;
             }
+            auto lhs_col = get_col(cols_, cond.lhs_col);
+            if (lhs_col->is_overflow()) {
+                continue;
+            }
+            preds.push_back({.col_idx = (int)(lhs_col - cols_.begin()),
+                             .op = op->second,
+                             .value = std::string(cond.rhs_val.raw->data, lhs_col->len)});
         }
+        return preds;
     }
 
-    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
-        auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
-        ColType rhs_type;
-        if (cond.is_rhs_val) {
-            rhs_type = cond.rhs_val.type;
-            rhs = cond.rhs_val.raw->data;
-        } else {
-            // rhs is a column
-            auto rhs_col = get_col(rec_cols, cond.rhs_col);
-            rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
-        }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
-        int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
-        if (cond.op == OP_EQ) {
-            return cmp == 0;
-        } else if (cond.op == OP_NE) {
-            return cmp != 0;
-        } else if (cond.op == OP_LT) {
-            return cmp < 0;
-        } else if (cond.op == OP_GT) {
-            return cmp > 0;
-        } else if (cond.op == OP_LE) {
-            return cmp <= 0;
-        } else if (cond.op == OP_GE) {
-            return cmp >= 0;
-        } else {
-            throw InternalError("Unexpected op type");
+    void add_col_idx(std::vector<int> &col_idxs, const TabCol &target) {
+        int col_idx = get_col(cols_, target) - cols_.begin();
+        if (std::find(col_idxs.begin(), col_idxs.end(), col_idx) == col_idxs.end()) {
+            col_idxs.push_back(col_idx);
         }
     }
 
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
-        return std::all_of(conds.begin(), conds.end(),
-                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
+    void check_runtime_conds() {
+        for (auto &cond : fed_conds_) {
+            assert(cond.lhs_col.tab_name == tab_name_);
+            if (!cond.is_rhs_val) {
+                assert(cond.rhs_col.tab_name == tab_name_);
+            }
+        }
     }
 };
\ No newline at end of file
@@ -1,4 +1,7 @@
 #pragma once
+
+#include <set>
+
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
@@ -28,75 +31,192 @@ class UpdateExecutor : public AbstractExecutor {
         context_ = context;
     }
     std::unique_ptr<RmRecord> Next() override {
-        // Get all necessary index files
-        std::vector<IxIndexHandle *> ihs(tab_.cols.size(), nullptr);
-        for (auto &set_clause : set_clauses_) {
-            auto lhs_col = tab_.get_col(set_clause.lhs.col_name);
-            if (lhs_col->index) {
-                size_t lhs_col_idx = lhs_col - tab_.cols.begin();
+        // Get all necessary index files：只有key列或INCLUDE列被更新的索引需要维护
+        // 索引的修改先收集到每个索引的缓冲中，所有记录更新完之后按key排序一次性应用
+        std::vector<std::pair<const IndexMeta *, IxChangeBuffer>> ihs;
+        for (auto &index : tab_.indexes) {
+            bool updated = std::any_of(set_clauses_.begin(), set_clauses_.end(), [&](const SetClause &set_clause) {
+                return index.covers(set_clause.lhs.col_name);
+            });
+            if (updated) {
                 // lab3 task3 Todo
                 // 获取需要的索引句柄,填充vector ihs
                 // lab3 task3 Todo end
-                ihs[lhs_col_idx] = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, lhs_col_idx)).get();;
+                auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.col_idxs);
+                ihs.emplace_back(&index, IxChangeBuffer(sm_manager_->ihs_.at(index_name).get(), index.col_tot_len,
+                                                        index.include_len));
             }
         }
+        check_unique_keys(ihs);
+        char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
         // Update each rid from record file and index file
-        for (auto &rid : rids_) {
-            auto rec = fh_->get_record(rid, context_);
-            // lab3 task3 Todo
-            // Remove old entry from index
-            // lab3 task3 Todo end
-            // Remove old entry from index
-            //before update
-            WriteRecord* wr= new WriteRecord(WType::UPDATE_TUPLE, tab_name_, rid,*rec);
-            context_->txn_->AppendWriteRecord(wr);  
+        try {
+            for (auto &rid : rids_) {
+                auto rec = fh_->get_record(rid, context_);
+                // lab3 task3 Todo
+                // Remove old entry from index
+                // lab3 task3 Todo end
+                // Remove old entry from index
+                //before update
+                WriteRecord* wr= new WriteRecord(WType::UPDATE_TUPLE, tab_name_, rid,*rec);
+                context_->txn_->AppendWriteRecord(wr);  
             
-            for (long unsigned int i = 0; i < tab_.cols.size(); i++) {
-                if (tab_.cols[i].index) {
-                    auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, i)).get();//index file handle
-                    ifh->delete_entry(rec->data + tab_.cols[i].offset,context_->txn_);
+                for (auto &[index, buffer] : ihs) {
+                    index->get_key(rec->data, key);
+                    buffer.add_delete(key, rid);
                 }
-            }
             
-            // record a update operation into the transaction
-            // RmRecord update_record{rec->size};
-            // memcpy(update_record.data, rec->data, rec->size);
+                // record a update operation into the transaction
+                // RmRecord update_record{rec->size};
+                // memcpy(update_record.data, rec->data, rec->size);
 
-            // lab3 task3 Todo
-            // Update record in record file
-            // lab3 task3 Todo end
-            // Update record in record file
-            for (auto &set_clause : set_clauses_) {
-                auto lhs_col = tab_.get_col(set_clause.lhs.col_name);
-                // size_t lhs_col_idx = lhs_col - tab_.cols.begin();
                 // lab3 task3 Todo
                 // Update record in record file
                 // lab3 task3 Todo end
                 // Update record in record file
-                // printf("In update,update: %s\n", set_clause.rhs.raw->data);
-                // printf("ori:%s\n", rec->data + lhs_col->offset);
-                // printf("offset:%d\n", lhs_col->offset);
-                // printf("len:%d\n", lhs_col->len);
-                memcpy(rec->data + lhs_col->offset, set_clause.rhs.raw->data, lhs_col->len);
-                // printf("after:%d\n", *(rec->data));
-                // printf("after:%s\n", rec->data + lhs_col->offset);
-            }
-            fh_->update_record(rid, rec->data, context_);
+                for (auto &set_clause : set_clauses_) {
+                    auto lhs_col = tab_.get_col(set_clause.lhs.col_name);
+                    // size_t lhs_col_idx = lhs_col - tab_.cols.begin();
+                    // lab3 task3 Todo
+                    // Update record in record file
+                    // lab3 task3 Todo end
+                    // Update record in record file
+                    // printf("In update,update: %s\n", set_clause.rhs.raw->data);
+                    // printf("ori:%s\n", rec->data + lhs_col->offset);
+                    // printf("offset:%d\n", lhs_col->offset);
+                    // printf("len:%d\n", lhs_col->len);
+                    if (lhs_col->is_overflow()) {
+                        // 新值写入新的页链，旧页链在事务提交时才释放
+                        auto ptr = sm_manager_->ofhs_.at(tab_name_)->insert_value(set_clause.rhs.raw->data,
+                                                                                 set_clause.rhs.str_val.size());
+                        memcpy(rec->data + lhs_col->offset, &ptr, sizeof(ptr));
+                    } else {
+                        memcpy(rec->data + lhs_col->offset, set_clause.rhs.raw->data, lhs_col->len);
+                    }
+                    // printf("after:%d\n", *(rec->data));
+                    // printf("after:%s\n", rec->data + lhs_col->offset);
+                }
+                fh_->update_record(rid, rec->data, context_);
             
-            // lab3 task3 Todo
-            // Insert new entry into index
-            // lab3 task3 Todo end
-            // Insert new entry into index
-            for (long unsigned int i = 0; i < tab_.cols.size(); i++) {
-                if (tab_.cols[i].index) {
-                    auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, i)).get();//index file handle
-                    ifh->insert_entry(rec->data + tab_.cols[i].offset,rid,context_->txn_);
+                // lab3 task3 Todo
+                // Insert new entry into index
+                // lab3 task3 Todo end
+                // Insert new entry into index
+                for (auto &[index, buffer] : ihs) {
+                    index->get_key(rec->data, key);
+                    index->get_include(rec->data, include);
+                    buffer.add_insert(key, rid, include);
                 }
-            }
 
-            // return rec;
+                // return rec;
+            }
+        } catch (...) {
+            // 已经更新的记录在回滚时按逐行维护的索引撤销，先把它们的索引修改应用完
+            flush_index_changes(ihs);
+            throw;
+        }
+        const IndexMeta *failed = flush_index_changes(ihs);
+        if (failed != nullptr) {
+            // 检查之后其他事务插入了相同的key，哈希索引跳过了插入：撤销本条语句的全部更新，语句失败
+            undo_updates(ihs);
+            throw DuplicateKeyError(tab_name_, SmManager::index_cols_str(failed->col_names()));
         }
         return nullptr;
     }
     Rid &rid() override { return _abstract_rid; }
+
+   private:
+    IxIndex *get_index(const IndexMeta &index) {
+        auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.col_idxs);
+        return sm_manager_->ihs_.at(index_name).get();
+    }
+
+    /**
+     * @brief 哈希索引的key唯一：在修改任何记录之前检查更新后的key既不与其他记录的key相同，被更新的记录之间也互不相同
+     * 否则语句结束时应用索引修改会跳过重复的key，被更新的记录在索引中丢失
+     * 检查时不持有索引上的锁，其他事务仍可能在检查之后插入相同的key，由flush_index_changes()发现
+     */
+    void check_unique_keys(const std::vector<std::pair<const IndexMeta *, IxChangeBuffer>> &ihs) {
+        std::vector<const IndexMeta *> hash_indexes;
+        for (auto &[index, buffer] : ihs) {
+            if (index->type == IX_INDEX_HASH) {
+                hash_indexes.push_back(index);
+            }
+        }
+        if (hash_indexes.empty()) {
+            return;
+        }
+        std::set<std::pair<int, int>> updated;
+        for (auto &rid : rids_) {
+            updated.emplace(rid.page_no, rid.slot_no);
+        }
+        std::vector<std::set<std::string>> new_keys(hash_indexes.size());
+        char key[IX_MAX_COL_LEN];
+        for (auto &rid : rids_) {
+            auto rec = fh_->get_record(rid, context_);
+            for (auto &set_clause : set_clauses_) {
+                auto lhs_col = tab_.get_col(set_clause.lhs.col_name);
+                if (!lhs_col->is_overflow()) {  // 溢出字段不能作为索引的key
+                    memcpy(rec->data + lhs_col->offset, set_clause.rhs.raw->data, lhs_col->len);
+                }
+            }
+            for (size_t i = 0; i < hash_indexes.size(); i++) {
+                auto index = hash_indexes[i];
+                index->get_key(rec->data, key);
+                std::vector<Rid> owners;
+                get_index(*index)->GetValue(key, &owners, context_->txn_);
+                bool taken = std::any_of(owners.begin(), owners.end(),
+                                         [&](const Rid &owner) { return updated.count({owner.page_no, owner.slot_no}) == 0; });
+                if (taken || !new_keys[i].emplace(key, index->col_tot_len).second) {
+                    throw DuplicateKeyError(tab_name_, SmManager::index_cols_str(index->col_names()));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 应用所有索引缓冲中的修改
+     * 哈希索引中被删除的旧entry都存在、插入的key在检查时都不重复，应用的个数少于修改的个数说明有插入因key已存在被跳过
+     *
+     * @return 有插入被跳过的哈希索引，没有时为nullptr
+     */
+    const IndexMeta *flush_index_changes(std::vector<std::pair<const IndexMeta *, IxChangeBuffer>> &ihs) {
+        const IndexMeta *failed = nullptr;
+        for (auto &[index, buffer] : ihs) {
+            int num_changes = (int)buffer.size();
+            if (buffer.flush(context_->txn_) < num_changes && index->type == IX_INDEX_HASH && failed == nullptr) {
+                failed = index;
+            }
+        }
+        return failed;
+    }
+
+    /**
+     * @brief 撤销本条语句的全部更新：写回旧记录，把索引中的新entry换回旧entry，并从write set中移除对应的写记录
+     * 与事务回滚中UPDATE_TUPLE的处理相同；索引修改同样先全部删除再全部插入，key互换的记录也能恢复
+     */
+    void undo_updates(std::vector<std::pair<const IndexMeta *, IxChangeBuffer>> &ihs) {
+        auto write_set = context_->txn_->GetWriteSet();
+        std::vector<WriteRecord *> wrs(write_set->end() - rids_.size(), write_set->end());
+        write_set->erase(write_set->end() - rids_.size(), write_set->end());
+        char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
+        for (auto wr : wrs) {
+            auto new_rec = fh_->get_record(wr->GetRid(), context_);
+            for (auto &[index, buffer] : ihs) {
+                index->get_key(new_rec->data, key);
+                buffer.add_delete(key, wr->GetRid());
+                index->get_key(wr->GetRecord().data, key);
+                index->get_include(wr->GetRecord().data, include);
+                buffer.add_insert(key, wr->GetRid(), include);
+            }
+            fh_->update_record(wr->GetRid(), wr->GetRecord().data, context_);
+            if (sm_manager_->ofhs_.count(tab_name_)) {
+                sm_manager_->release_overflow(tab_name_, *new_rec, &wr->GetRecord());
+            }
+        }
+        flush_index_changes(ihs);
+        for (auto wr : wrs) {
+            delete wr;
+        }
+    }
 };
\ No newline at end of file
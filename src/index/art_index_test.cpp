@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <thread>  // NOLINT
+
+#include "gtest/gtest.h"
+
+#define private public
+#include "ix.h"
+#undef private  // for use private variables in "ix.h"
+
+/**
+ * @brief ART索引只在内存中，不需要数据库目录和缓冲池；以std::map<key, rids>作为对照
+ */
+class ArtIndexTest : public ::testing::Test {
+   public:
+    using Postings = std::map<std::string, std::vector<Rid>>;
+
+    static bool rid_less(const Rid &a, const Rid &b) {
+        return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+    }
+
+    // 检查mock中的每个key都能查到且rid的顺序一致，并检查key和entry的个数
+    void CheckAll(IxArtIndexHandle *ih, const Postings &mock) {
+        size_t num_entries = 0;
+        std::vector<Rid> result;
+        for (auto &[key, rids] : mock) {
+            result.clear();
+            ASSERT_TRUE(ih->GetValue(key.data(), &result, nullptr));
+            std::vector<Rid> expected = rids;
+            std::sort(expected.begin(), expected.end(), rid_less);
+            ASSERT_EQ(result, expected);
+            num_entries += rids.size();
+        }
+        EXPECT_EQ(ih->num_keys(), mock.size());
+        EXPECT_EQ(ih->num_entries(), num_entries);
+    }
+};
+
+/**
+ * @brief INT key：随机插入、查找、删除，结点在4/16/48/256之间变大和变小
+ */
+TEST_F(ArtIndexTest, IntKeyTest) {
+    IxArtIndexHandle ih({TYPE_INT}, {sizeof(int)});
+    const int scale = 100000;
+    std::vector<int> keys(scale);
+    for (int i = 0; i < scale; i++) {
+        keys[i] = i * 37 - scale;  // 含负数，跨越符号位
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+    Postings mock;
+    auto key_str = [](int key) { return std::string((const char *)&key, sizeof(key)); };
+    for (int key : keys) {
+        ASSERT_TRUE(ih.insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, nullptr));
+        mock[key_str(key)].push_back(Rid{.page_no = key, .slot_no = 0});
+    }
+    // 重复的(key,rid)不插入；同一个key的不同rid都保存下来
+    EXPECT_FALSE(ih.insert_entry((const char *)&keys[0], Rid{.page_no = keys[0], .slot_no = 0}, nullptr));
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(ih.insert_entry((const char *)&keys[1], Rid{.page_no = -i, .slot_no = i}, nullptr));
+        mock[key_str(keys[1])].push_back(Rid{.page_no = -i, .slot_no = i});
+    }
+    CheckAll(&ih, mock);
+    std::vector<Rid> result;
+    int missing = 1;
+    EXPECT_FALSE(ih.GetValue((const char *)&missing, &result, nullptr));
+
+    // 删除大部分key，只留下每隔97个的key
+    for (int i = 0; i < scale; i++) {
+        if (i % 97 == 0 || i == 1) {
+            continue;
+        }
+        ASSERT_TRUE(ih.delete_entry((const char *)&keys[i], Rid{.page_no = keys[i], .slot_no = 0}, nullptr));
+        mock.erase(key_str(keys[i]));
+    }
+    EXPECT_FALSE(ih.delete_entry((const char *)&keys[2], Rid{.page_no = keys[2], .slot_no = 0}, nullptr));
+    // rid不同时不删除
+    EXPECT_FALSE(ih.delete_entry((const char *)&keys[0], Rid{.page_no = 5, .slot_no = 5}, nullptr));
+    ASSERT_TRUE(ih.delete_entry((const char *)&keys[1], Rid{.page_no = -3, .slot_no = 3}, nullptr));
+    auto &rids = mock[key_str(keys[1])];
+    rids.erase(std::find(rids.begin(), rids.end(), Rid{.page_no = -3, .slot_no = 3}));
+    CheckAll(&ih, mock);
+
+    // 删除所有entry之后树为空，可以重新插入
+    for (auto &[key, key_rids] : mock) {
+        for (auto &rid : key_rids) {
+            ASSERT_TRUE(ih.delete_entry(key.data(), rid, nullptr));
+        }
+    }
+    EXPECT_EQ(ih.root_, 0u);
+    ASSERT_TRUE(ih.insert_entry((const char *)&keys[0], Rid{.page_no = 1, .slot_no = 1}, nullptr));
+    result.clear();
+    ASSERT_TRUE(ih.GetValue((const char *)&keys[0], &result, nullptr));
+    EXPECT_EQ(result, std::vector<Rid>{(Rid{.page_no = 1, .slot_no = 1})});
+}
+
+/**
+ * @brief 多列key（CHAR(40), INT）：字符串有很长的公共前缀，超过结点保存的前缀长度，
+ * 插入时路径在省略的字节处分开，删除时结点与唯一的孩子合并路径
+ */
+TEST_F(ArtIndexTest, LongPrefixTest) {
+    const int str_len = 40;
+    IxArtIndexHandle ih({TYPE_STRING, TYPE_INT}, {str_len, sizeof(int)});
+    auto make_key = [&](int group, int id, int b) {
+        std::string key(str_len + sizeof(int), '\0');
+        // 同一组的字符串有30个字节的公共前缀，第group%5个字节之后的前缀也不同
+        std::string prefix(30, 'p');
+        prefix[group % 5 * 6] = 'a' + group;
+        snprintf(&key[0], str_len, "%s-%04d", prefix.c_str(), id);
+        memcpy(&key[str_len], &b, sizeof(int));
+        return key;
+    };
+    Postings mock;
+    std::mt19937 rng(1);
+    std::vector<std::string> keys;
+    for (int group = 0; group < 10; group++) {
+        for (int id = 0; id < 300; id++) {
+            for (int b = 0; b < 3; b++) {
+                keys.push_back(make_key(group, id, b * 1000 - 1));
+            }
+        }
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    for (size_t i = 0; i < keys.size(); i++) {
+        Rid rid = {.page_no = (int)i, .slot_no = (int)(i % 7)};
+        ASSERT_TRUE(ih.insert_entry(keys[i].data(), rid, nullptr));
+        mock[keys[i]].push_back(rid);
+    }
+    CheckAll(&ih, mock);
+    // 与已有key只在省略的前缀字节中不同的key查不到
+    std::vector<Rid> result;
+    std::string other = make_key(0, 1, -1);
+    other[20] = 'x';
+    EXPECT_FALSE(ih.GetValue(other.data(), &result, nullptr));
+
+    // 随机删除，每删除一批检查一次
+    std::vector<std::pair<std::string, Rid>> entries;
+    for (auto &[key, rids] : mock) {
+        for (auto &rid : rids) {
+            entries.emplace_back(key, rid);
+        }
+    }
+    std::shuffle(entries.begin(), entries.end(), rng);
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto &[key, rid] = entries[i];
+        ASSERT_TRUE(ih.delete_entry(key.data(), rid, nullptr));
+        auto &rids = mock[key];
+        rids.erase(std::find(rids.begin(), rids.end(), rid));
+        if (rids.empty()) {
+            mock.erase(key);
+        }
+        if (i % 2000 == 0) {
+            CheckAll(&ih, mock);
+        }
+    }
+    EXPECT_EQ(ih.num_keys(), 0u);
+}
+
+/**
+ * @brief 多个线程并发查找，同时一个线程插入和删除其他的key
+ */
+TEST_F(ArtIndexTest, ConcurrentTest) {
+    IxArtIndexHandle ih({TYPE_INT}, {sizeof(int)});
+    const int scale = 20000;
+    for (int key = 0; key < scale; key += 2) {
+        ASSERT_TRUE(ih.insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, nullptr));
+    }
+    auto reader = [&]() {
+        std::vector<Rid> result;
+        for (int round = 0; round < 10; round++) {
+            for (int key = 0; key < scale; key += 2) {
+                result.clear();
+                EXPECT_TRUE(ih.GetValue((const char *)&key, &result, nullptr));
+                EXPECT_EQ(result.size(), 1u);
+            }
+        }
+    };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back(reader);
+    }
+    for (int round = 0; round < 5; round++) {
+        for (int key = 1; key < scale; key += 2) {
+            EXPECT_TRUE(ih.insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, nullptr));
+        }
+        for (int key = 1; key < scale; key += 2) {
+            EXPECT_TRUE(ih.delete_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, nullptr));
+        }
+    }
+    for (auto &thread : readers) {
+        thread.join();
+    }
+    EXPECT_EQ(ih.num_keys(), (size_t)scale / 2);
+}
@@ -22,6 +22,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
@@ -268,7 +269,38 @@ void DeleteHelper(IxIndexHandle *tree, const std::vector<int64_t> &keys,
     const char *index_key;
     for (auto key : keys) {
         index_key = (const char *)&key;
-        tree->delete_entry(index_key, transaction);
+        Rid rid = {.page_no = static_cast<int32_t>(key >> 32), .slot_no = static_cast<int32_t>(key & 0xFFFFFFFF)};
+        tree->delete_entry(index_key, rid, transaction);
+    }
+
+    delete transaction;
+}
+
+// helper function for the scaling benchmark: thread i owns keys i+1, i+1+n, i+1+2n, ...
+// inserts them, looks them up and then deletes the even ones
+void MixedWorkloadHelper(IxIndexHandle *tree, int64_t scale, uint64_t num_threads, uint64_t thread_itr) {
+    Transaction *transaction = new Transaction(0);
+
+    std::vector<int64_t> keys;
+    for (int64_t key = thread_itr + 1; key <= scale; key += num_threads) {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine(thread_itr));
+
+    for (auto key : keys) {
+        Rid rid = {.page_no = static_cast<int32_t>(key >> 32), .slot_no = static_cast<int32_t>(key & 0xFFFFFFFF)};
+        EXPECT_TRUE(tree->insert_entry((const char *)&key, rid, transaction));
+    }
+    std::vector<Rid> rids;
+    for (auto key : keys) {
+        rids.clear();
+        EXPECT_TRUE(tree->GetValue((const char *)&key, &rids, transaction));
+    }
+    for (auto key : keys) {
+        if (key % 2 == 0) {
+            Rid rid = {.page_no = static_cast<int32_t>(key >> 32), .slot_no = static_cast<int32_t>(key & 0xFFFFFFFF)};
+            EXPECT_TRUE(tree->delete_entry((const char *)&key, rid, transaction));
+        }
     }
 
     delete transaction;
@@ -361,3 +393,101 @@ TEST_F(BPlusTreeConcurrentTest, MixScaleTest) {
     }
     EXPECT_EQ(size, keys.size() - delete_keys.size());
 }
+
+/**
+ * @brief 乐观读（不加锁、检查版本号）与分裂/合并并发：写线程反复插入和删除奇数key，
+ * 读线程查找一直存在的偶数key，必须每次都找到正确的rid
+ */
+TEST_F(BPlusTreeConcurrentTest, OptimisticReadTest) {
+    const int scale = 5000;
+    const int writer_num = 4;
+    const int reader_num = 4;
+    const int order = 4;  // 很小的阶使写操作频繁地分裂、合并结点以及替换根结点
+    ih_->file_hdr_.btree_order = order;
+    Transaction txn(0);
+    for (int key = 0; key < scale * 2; key += 2) {
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = 0, .slot_no = key}, &txn));
+    }
+
+    std::atomic<int> writers_running{writer_num};
+    auto writer = [&](int tid) {
+        Transaction transaction(0);
+        for (int round = 0; round < 3; round++) {
+            for (int key = tid * 2 + 1; key < scale * 2; key += writer_num * 2) {
+                EXPECT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = 1, .slot_no = key}, &transaction));
+            }
+            for (int key = tid * 2 + 1; key < scale * 2; key += writer_num * 2) {
+                EXPECT_TRUE(ih_->delete_entry((const char *)&key, Rid{.page_no = 1, .slot_no = key}, &transaction));
+            }
+        }
+        writers_running--;
+    };
+    auto reader = [&](int tid) {
+        std::default_random_engine rng(tid);
+        std::vector<Rid> rids;
+        while (writers_running > 0) {
+            int key = rng() % scale * 2;
+            rids.clear();
+            ASSERT_TRUE(ih_->GetValue((const char *)&key, &rids, nullptr));
+            ASSERT_EQ(rids.size(), 1);
+            EXPECT_EQ(rids[0], (Rid{.page_no = 0, .slot_no = key}));
+            int missing = -1 - key;
+            EXPECT_FALSE(ih_->GetValue((const char *)&missing, &rids, nullptr));
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < writer_num; i++) {
+        threads.emplace_back(writer, i);
+    }
+    for (int i = 0; i < reader_num; i++) {
+        threads.emplace_back(reader, i);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    int current_key = 0;
+    IxScan scan(ih_.get(), ih_->leaf_begin(), ih_->leaf_end(), buffer_pool_manager_.get());
+    while (!scan.is_end()) {
+        ASSERT_EQ(scan.rid().slot_no, current_key);
+        current_key += 2;
+        scan.next();
+    }
+    EXPECT_EQ(current_key, scale * 2);
+}
+
+/**
+ * @brief 以不同的线程数运行相同的插入/查找/删除负载，并检查最终结果
+ * 每个线程操作互不相交的key；吞吐量随线程数的变化由ix_bench测量
+ */
+TEST_F(BPlusTreeConcurrentTest, MixedWorkloadScalingTest) {
+    const int64_t scale = 20000;
+    const int order = 255;
+    const std::vector<uint64_t> thread_nums = {1, 2, 4, 8, 16};
+
+    for (size_t i = 0; i < thread_nums.size(); i++) {
+        uint64_t thread_num = thread_nums[i];
+        int bench_index_no = index_no + 1 + i;
+        if (ix_manager_->exists(TEST_FILE_NAME, bench_index_no)) {
+            ix_manager_->destroy_index(TEST_FILE_NAME, bench_index_no);
+        }
+        ix_manager_->create_index(TEST_FILE_NAME, bench_index_no, TYPE_INT, sizeof(int));
+        auto ih = ix_manager_->open_index(TEST_FILE_NAME, bench_index_no);
+        ih->file_hdr_.btree_order = order;
+
+        LaunchParallelTest(thread_num, MixedWorkloadHelper, ih.get(), scale, thread_num);
+
+        // 剩下的key是1~scale中的所有奇数
+        int64_t current_key = 1;
+        IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get());
+        while (!scan.is_end()) {
+            ASSERT_EQ(scan.rid().slot_no, current_key);
+            current_key += 2;
+            scan.next();
+        }
+        EXPECT_EQ(current_key, scale + 1);
+
+        ix_manager_->close_index(ih.get());
+        ix_manager_->destroy_index(TEST_FILE_NAME, bench_index_no);
+    }
+}
@@ -362,7 +362,8 @@ TEST_F(BPlusTreeTests, InsertAndDeleteTest1) {
     }
     for (auto key : delete_keys) {
         index_key = (const char *)&key;
-        bool delete_ret = ih_->delete_entry(index_key, txn_.get());  // 调用Delete
+        Rid rid = {.page_no = static_cast<int32_t>(key >> 32), .slot_no = static_cast<int32_t>(key & 0xFFFFFFFF)};
+        bool delete_ret = ih_->delete_entry(index_key, rid, txn_.get());  // 调用Delete
         ASSERT_EQ(delete_ret, true);
 
         Draw(buffer_pool_manager_.get(), "InsertAndDeleteTest1_delete" + std::to_string(key) + ".dot");
@@ -430,7 +431,8 @@ TEST_F(BPlusTreeTests, InsertAndDeleteTest2) {
     std::vector<int64_t> delete_keys = {1, 2, 3, 4, 7, 5};
     for (auto key : delete_keys) {
         index_key = (const char *)&key;
-        bool delete_ret = ih_->delete_entry(index_key, txn_.get());  // 调用Delete
+        Rid rid = {.page_no = static_cast<int32_t>(key >> 32), .slot_no = static_cast<int32_t>(key & 0xFFFFFFFF)};
+        bool delete_ret = ih_->delete_entry(index_key, rid, txn_.get());  // 调用Delete
         ASSERT_EQ(delete_ret, true);
 
         Draw(buffer_pool_manager_.get(), "InsertAndDeleteTest2_delete" + std::to_string(key) + ".dot");
@@ -482,7 +484,7 @@ TEST_F(BPlusTreeTests, LargeScaleTest) {
             }
             int key = it->first;
             // printf("delete rand key=%d\n", key);
-            bool delete_ret = ih_->delete_entry((const char *)&key, txn_.get());
+            bool delete_ret = ih_->delete_entry((const char *)&key, it->second, txn_.get());
             ASSERT_EQ(delete_ret, true);
             mock.erase(it);
             del_cnt++;
@@ -494,3 +496,139 @@ TEST_F(BPlusTreeTests, LargeScaleTest) {
     std::cout << "Insert keys count: " << add_cnt << '\n' << "Delete keys count: " << del_cnt << '\n';
     check_all(ih_.get(), mock);
 }
+
+/**
+ * @brief 反复插入后删除大部分key，被删除结点的page进入空闲页链表并被之后的插入复用，文件不会持续增长
+ */
+TEST_F(BPlusTreeTests, FreePageReuseTest) {
+    const int order = 16;
+    const int scale = 2000;
+    const int rounds = 10;
+    ih_->file_hdr_.btree_order = order;
+    // 统计树中和空闲页链表中的page数
+    auto count_pages = [&](int *live, int *free) {
+        *live = 0;
+        std::vector<page_id_t> stack{ih_->file_hdr_.root_page};
+        while (!stack.empty()) {
+            IxNodeHandle *node = ih_->FetchNode(stack.back());
+            stack.pop_back();
+            (*live)++;
+            if (!node->IsLeafPage()) {
+                for (int i = 0; i < node->GetSize(); i++) {
+                    stack.push_back(node->ValueAt(i));
+                }
+            }
+            buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
+            delete node;
+        }
+        *free = 0;
+        for (page_id_t page_no = ih_->file_hdr_.first_free_page_no; page_no != IX_NO_PAGE; (*free)++) {
+            IxNodeHandle *node = ih_->FetchNode(page_no);
+            page_no = node->page_hdr->next_free_page_no;
+            buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
+            delete node;
+        }
+    };
+    std::multimap<int, Rid> mock;
+    int peak_pages = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < scale; i++) {
+            int key = round * scale + i;
+            Rid rid = {.page_no = key, .slot_no = round};
+            ASSERT_TRUE(ih_->insert_entry((const char *)&key, rid, txn_.get()));
+            mock.insert({key, rid});
+        }
+        if (round == 0) {
+            peak_pages = ih_->file_hdr_.num_pages;
+        }
+        // 只保留每轮的最后一个key
+        for (auto it = mock.begin(); it != mock.end();) {
+            if (it->first % scale != scale - 1) {
+                ASSERT_TRUE(ih_->delete_entry((const char *)&it->first, it->second, txn_.get()));
+                it = mock.erase(it);
+            } else {
+                it++;
+            }
+        }
+        int live, free;
+        count_pages(&live, &free);
+        EXPECT_EQ(live + free + IX_INIT_NUM_PAGES - 1, ih_->file_hdr_.num_pages);
+        EXPECT_GT(free, 0);
+        if (round == rounds / 2) {
+            // 重新打开之后空闲页链表仍然有效，新的page_no从num_pages开始分配
+            ix_manager_->close_index(ih_.get());
+            ih_ = ix_manager_->open_index(TEST_FILE_NAME, index_no);
+            ih_->file_hdr_.btree_order = order;
+            EXPECT_EQ(disk_manager_->get_fd2pageno(ih_->fd_), ih_->file_hdr_.num_pages);
+        }
+    }
+    check_all(ih_.get(), mock);
+    // 之后每一轮需要的page不比第一轮多（多出的几个结点存放每轮保留下来的key）
+    EXPECT_LE(ih_->file_hdr_.num_pages, peak_pages + rounds);
+}
+
+/**
+ * @brief 通过IxChangeBuffer批量应用一条"UPDATE"的索引修改：大部分key改为新值，两行交换key，
+ * 以及插入已经存在、删除不存在的entry，结果与逐条修改相同
+ */
+TEST_F(BPlusTreeTests, ApplyChangesTest) {
+    const int order = 16;
+    const int scale = 5000;
+    ih_->file_hdr_.btree_order = order;
+    std::vector<int> keys(scale);
+    for (int i = 0; i < scale; i++) {
+        keys[i] = i * 2;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+    std::multimap<int, Rid> mock;
+    for (int key : keys) {
+        Rid rid = {.page_no = key, .slot_no = 0};
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, rid, txn_.get()));
+        mock.insert({key, rid});
+    }
+
+    // 按记录的顺序（即乱序的key）收集修改：key为4的倍数的行改为key+1，其他行删除
+    IxChangeBuffer buffer(ih_.get(), sizeof(int), 0);
+    int expected = 0;
+    for (int key : keys) {
+        if (key == 0 || key == 2) {
+            continue;
+        }
+        Rid rid = {.page_no = key, .slot_no = 0};
+        buffer.add_delete((const char *)&key, rid);
+        mock.erase(key);
+        expected++;
+        if (key % 4 == 0) {
+            int new_key = key + 1;
+            buffer.add_insert((const char *)&new_key, rid, nullptr);
+            mock.insert({new_key, rid});
+            expected++;
+        }
+    }
+    // 唯一索引中两行交换key：逐行修改时第一行插入新key会失败，批量应用时同一个key先删除再插入
+    int key0 = 0, key2 = 2;
+    Rid rid0 = {.page_no = 0, .slot_no = 0}, rid2 = {.page_no = 2, .slot_no = 0};
+    buffer.add_delete((const char *)&key0, rid0);
+    buffer.add_insert((const char *)&key2, rid0, nullptr);
+    buffer.add_delete((const char *)&key2, rid2);
+    buffer.add_insert((const char *)&key0, rid2, nullptr);
+    mock.erase(key0);
+    mock.erase(key2);
+    mock.insert({key0, rid2});
+    mock.insert({key2, rid0});
+    expected += 4;
+    // 不会修改索引的entry：删除不存在的key、rid不同的key，插入已经存在的key
+    int missing = 3, exist = 5;
+    buffer.add_delete((const char *)&missing, Rid{.page_no = 3, .slot_no = 0});
+    buffer.add_delete((const char *)&key2, Rid{.page_no = 7, .slot_no = 7});
+    buffer.add_insert((const char *)&exist, Rid{.page_no = 1, .slot_no = 1}, nullptr);
+
+    EXPECT_EQ(buffer.flush(txn_.get()), expected);
+    EXPECT_EQ(buffer.size(), 0u);
+    check_all(ih_.get(), mock);
+    // 叶子的写锁都已经释放，之后的修改不会阻塞
+    EXPECT_EQ(buffer.flush(txn_.get()), 0);
+    ASSERT_TRUE(ih_->insert_entry((const char *)&missing, Rid{.page_no = 3, .slot_no = 0}, txn_.get()));
+    mock.insert({missing, Rid{.page_no = 3, .slot_no = 0}});
+    check_all(ih_.get(), mock);
+}
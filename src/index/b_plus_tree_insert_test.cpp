@@ -312,3 +312,833 @@ TEST_F(BPlusTreeTests, LargeScaleTest) {
     }
     EXPECT_EQ(current_key, keys.size() + 1);
 }
+
+/**
+ * @brief 批量查找与逐个GetValue的结果相同：有序的key（成段连续、跨越多个叶子、重复、不存在），以及无序的key
+ */
+TEST_F(BPlusTreeTests, BatchLookupTest) {
+    const int scale = 20000;
+    const int order = 8;  // 较小的阶使树有多层，相邻key的路径在不同层分叉
+    ih_->file_hdr_.btree_order = order;
+    std::vector<int> keys;
+    for (int i = 0; i < scale; i++) {
+        keys.push_back(i * 2);  // 只插入偶数，奇数key不存在
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine{});
+    for (int key : keys) {
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+    }
+
+    auto check_batch = [&](std::vector<int> probe) {
+        std::vector<const char *> batch;
+        for (int &key : probe) {
+            batch.push_back((const char *)&key);
+        }
+        std::vector<std::pair<int, Rid>> result;
+        int found = ih_->BatchLookup(batch, &result, txn_.get());
+        ASSERT_EQ(found, (int)result.size());
+        std::vector<int> expected;
+        for (int i = 0; i < (int)probe.size(); i++) {
+            std::vector<Rid> rids;
+            if (ih_->GetValue(batch[i], &rids, txn_.get())) {
+                expected.push_back(i);
+            }
+        }
+        ASSERT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < result.size(); i++) {
+            int key = probe[result[i].first];
+            EXPECT_EQ(result[i].second, (Rid{.page_no = key, .slot_no = 0}));
+            if (i > 0) {
+                EXPECT_LE(probe[result[i - 1].first], key);  // 结果按key的升序
+            }
+        }
+        std::vector<int> actual;
+        for (auto &entry : result) {
+            actual.push_back(entry.first);
+        }
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(actual, expected);
+    };
+
+    // 成段连续的key，段与段之间跨越多个叶子
+    std::vector<int> probe;
+    for (int start = -5; start < scale * 2 + 10; start += 997) {
+        for (int key = start; key < start + 40; key++) {
+            probe.push_back(key);
+        }
+    }
+    check_batch(probe);
+    // 所有key，以及重复的key
+    probe.clear();
+    for (int key = -1; key <= scale * 2; key++) {
+        probe.push_back(key);
+        if (key % 100 == 0) {
+            probe.push_back(key);
+        }
+    }
+    check_batch(probe);
+    // 无序的key
+    std::shuffle(probe.begin(), probe.end(), std::default_random_engine{});
+    probe.resize(3000);
+    check_batch(probe);
+    check_batch({});
+    check_batch({scale * 2 + 1});
+}
+
+/**
+ * @brief 非唯一索引的批量查找与逐个GetValue的结果相同：每个key的rid个数不同，有的key的entry跨越多个叶子
+ */
+TEST_F(BPlusTreeTests, BatchLookupNonUniqueTest) {
+    const std::vector<int> col_idxs = {6};
+    const int num_keys = 2000;
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)}, 0, true, false);
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    ASSERT_FALSE(ih->file_hdr_.unique);
+    ih->file_hdr_.btree_order = 8;
+
+    std::vector<std::pair<int, Rid>> entries;
+    for (int key = 0; key < num_keys; key += 2) {  // 只插入偶数，奇数key不存在
+        int num_rids = key % 7 == 0 ? 40 : key % 5 + 1;
+        for (int i = 0; i < num_rids; i++) {
+            entries.emplace_back(key, Rid{.page_no = i - 3, .slot_no = key});
+        }
+    }
+    std::shuffle(entries.begin(), entries.end(), std::default_random_engine{});
+    for (auto &[key, rid] : entries) {
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, rid, txn_.get()));
+    }
+
+    auto check_batch = [&](std::vector<int> probe) {
+        std::vector<const char *> batch;
+        for (int &key : probe) {
+            batch.push_back((const char *)&key);
+        }
+        std::vector<std::pair<int, Rid>> result;
+        int found = ih->BatchLookup(batch, &result, txn_.get());
+        // 每个key的rid连续出现，key按升序排列
+        std::vector<std::pair<int, std::vector<Rid>>> actual;
+        for (size_t i = 0; i < result.size(); i++) {
+            if (i > 0) {
+                EXPECT_LE(probe[result[i - 1].first], probe[result[i].first]);
+            }
+            if (actual.empty() || actual.back().first != result[i].first) {
+                actual.emplace_back(result[i].first, std::vector<Rid>{});
+            }
+            actual.back().second.push_back(result[i].second);
+        }
+        EXPECT_EQ(found, (int)actual.size());
+        std::sort(actual.begin(), actual.end(),
+                  [](const auto &a, const auto &b) { return a.first < b.first; });
+        std::vector<std::pair<int, std::vector<Rid>>> expected;
+        for (int i = 0; i < (int)probe.size(); i++) {
+            std::vector<Rid> rids;
+            if (ih->GetValue(batch[i], &rids, txn_.get())) {
+                expected.emplace_back(i, rids);
+            }
+        }
+        EXPECT_EQ(actual, expected);
+    };
+
+    std::vector<int> probe;
+    for (int key = -1; key <= num_keys; key++) {
+        probe.push_back(key);
+        if (key % 70 == 0) {
+            probe.push_back(key);
+        }
+    }
+    check_batch(probe);
+    std::shuffle(probe.begin(), probe.end(), std::default_random_engine{});
+    probe.resize(500);
+    check_batch(probe);
+    check_batch({num_keys + 1});
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief 检查以page_no为根的子树：父结点指针、父结点中的key等于孩子的第一个key、非根结点不少于最小容量
+ *
+ * @return 子树中叶子结点的键值对数量
+ */
+static int CheckSubtree(IxIndexHandle *ih, page_id_t page_no, page_id_t parent_no) {
+    IxNodeHandle *node = ih->FetchNode(page_no);
+    EXPECT_EQ(node->GetParentPageNo(), parent_no);
+    EXPECT_LE(node->GetSize(), ih->file_hdr_.btree_order);
+    if (parent_no != IX_NO_PAGE) {
+        EXPECT_GE(node->GetSize(), node->GetMinSize());
+    }
+    int num_entries = node->GetSize();
+    if (!node->IsLeafPage()) {
+        num_entries = 0;
+        for (int i = 0; i < node->GetSize(); i++) {
+            IxNodeHandle *child = ih->FetchNode(node->ValueAt(i));
+            EXPECT_EQ(node->KeyAt(i), child->KeyAt(0));
+            ih->ReleaseNode(child, false);
+            num_entries += CheckSubtree(ih, node->ValueAt(i), page_no);
+        }
+    }
+    ih->ReleaseNode(node, false);
+    return num_entries;
+}
+
+/**
+ * @brief 用较小的内存限制强制排序器溢出到磁盘，批量构建后检查树的结构，并继续插入和删除
+ */
+TEST_F(BPlusTreeTests, BulkLoadTest) {
+    const int scale = 20000;
+    const int order = 64;
+
+    assert(order > 2 && order <= ih_->file_hdr_.btree_order);
+    ih_->file_hdr_.btree_order = order;
+
+    std::vector<int> keys;
+    for (int key = 1; key <= scale; key++) {
+        keys.push_back(key);
+    }
+    auto rng = std::default_random_engine{};
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    // 每个key添加两次，只保留rid较小的一项
+    IxSorter sorter(disk_manager_.get(), sizeof(int), 0, TEST_FILE_NAME, 4 * PAGE_SIZE);
+    char key_buf[sizeof(int)];
+    for (int key : keys) {
+        ih_->normalize_key((const char *)&key, key_buf);
+        sorter.add(key_buf, Rid{.page_no = 1, .slot_no = key});
+        sorter.add(key_buf, Rid{.page_no = 0, .slot_no = key});
+    }
+    sorter.finish();
+    EXPECT_GT(sorter.runs_.size(), 1);
+    EXPECT_EQ(sorter.size(), scale);
+    ih_->bulk_load(&sorter, 0.7);
+
+    EXPECT_EQ(CheckSubtree(ih_.get(), ih_->file_hdr_.root_page, IX_NO_PAGE), scale);
+    // 所有page顺序分配，没有空洞
+    EXPECT_EQ(ih_->file_hdr_.num_pages, disk_manager_->get_fd2pageno(ih_->fd_));
+
+    std::vector<Rid> rids;
+    for (int key : keys) {
+        rids.clear();
+        ih_->GetValue((const char *)&key, &rids, txn_.get());
+        ASSERT_EQ(rids.size(), 1);
+        EXPECT_EQ(rids[0].page_no, 0);
+        EXPECT_EQ(rids[0].slot_no, key);
+    }
+
+    // 批量构建的树上继续插入和删除
+    for (int key = scale + 1; key <= 2 * scale; key++) {
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = 0, .slot_no = key}, txn_.get()));
+    }
+    for (int key = 1; key <= 2 * scale; key += 2) {
+        ASSERT_TRUE(ih_->delete_entry((const char *)&key, Rid{.page_no = 0, .slot_no = key}, txn_.get()));
+    }
+    EXPECT_EQ(CheckSubtree(ih_.get(), ih_->file_hdr_.root_page, IX_NO_PAGE), scale);
+
+    int expected_key = 2;
+    for (IxScan scan(ih_.get(), ih_->leaf_begin(), ih_->leaf_end(), buffer_pool_manager_.get()); !scan.is_end();
+         scan.next()) {
+        EXPECT_EQ(scan.rid().slot_no, expected_key);
+        expected_key += 2;
+    }
+    EXPECT_EQ(expected_key, 2 * scale + 2);
+}
+
+/**
+ * @brief 编码后的key按memcmp比较的结果与ix_compare比较原始值的结果一致，并且可以还原
+ */
+TEST_F(BPlusTreeTests, KeyNormalizeTest) {
+    std::default_random_engine rng;
+    auto sign = [](int x) { return (x > 0) - (x < 0); };
+    auto check = [&](auto a, auto b, ColType type) {
+        char na[sizeof(a)], nb[sizeof(b)];
+        ix_normalize_key((const char *)&a, type, sizeof(a), na);
+        ix_normalize_key((const char *)&b, type, sizeof(b), nb);
+        ASSERT_EQ(sign(memcmp(na, nb, sizeof(a))), ix_compare((const char *)&a, (const char *)&b, type, sizeof(a)))
+            << a << " " << b;
+        decltype(a) decoded;
+        ix_denormalize_key(na, type, sizeof(a), (char *)&decoded);
+        ASSERT_EQ(decoded, a);
+    };
+    std::vector<int> ints = {0, 1, -1, INT32_MIN, INT32_MAX, INT32_MIN + 1, INT32_MAX - 1, 255, 256, -256};
+    std::vector<float> floats = {0.0f, -0.0f, 1.0f, -1.0f, 1e-30f, -1e-30f, 1e30f, -1e30f, 0.5f, -0.5f};
+    for (int i = 0; i < 1000; i++) {
+        ints.push_back(static_cast<int>(rng()));
+        floats.push_back(std::uniform_real_distribution<float>(-1e6, 1e6)(rng));
+    }
+    for (int a : ints) {
+        for (int b : ints) {
+            check(a, b, TYPE_INT);
+        }
+    }
+    for (float a : floats) {
+        for (float b : floats) {
+            check(a, b, TYPE_FLOAT);
+        }
+    }
+}
+
+/**
+ * @brief 结点内查找函数（标量和AVX2版本）在编码后的key上的结果与std::lower_bound/std::upper_bound一致
+ */
+TEST_F(BPlusTreeTests, NodeSearchTest) {
+    std::default_random_engine rng;
+    auto check = [&](auto value_type, ColType type, bool use_simd) {
+        using T = decltype(value_type);
+        IxKeySearch search = IxKeySearch::get(sizeof(T), use_simd);
+        for (int n = 0; n <= 300; n++) {
+            std::vector<T> keys(n);
+            for (auto &key : keys) {
+                key = static_cast<T>(rng() % (2 * n + 1)) - n;  // 包含重复的key和负数
+            }
+            std::sort(keys.begin(), keys.end());
+            std::vector<char> node_keys(n * sizeof(T));
+            for (int i = 0; i < n; i++) {
+                ix_normalize_key((const char *)&keys[i], type, sizeof(T), node_keys.data() + i * sizeof(T));
+            }
+            for (int t = -n - 1; t <= n + 1; t++) {
+                T target = static_cast<T>(t);
+                char norm_target[sizeof(T)];
+                ix_normalize_key((const char *)&target, type, sizeof(T), norm_target);
+                EXPECT_EQ(search.lower_bound(node_keys.data(), n, norm_target, sizeof(T)),
+                          std::lower_bound(keys.begin(), keys.end(), target) - keys.begin());
+                EXPECT_EQ(search.upper_bound(node_keys.data(), n, norm_target, sizeof(T)),
+                          std::upper_bound(keys.begin(), keys.end(), target) - keys.begin());
+            }
+        }
+    };
+    check(int(), TYPE_INT, false);
+    check(int(), TYPE_INT, true);
+    check(float(), TYPE_FLOAT, false);
+    check(float(), TYPE_FLOAT, true);
+
+    const int col_len = 3;
+    std::vector<std::string> strs;
+    for (int i = 0; i < 200; i++) {
+        strs.push_back(std::string(1, 'a' + rng() % 26) + std::string(1, 'a' + rng() % 26) + '\0');
+    }
+    std::sort(strs.begin(), strs.end());
+    std::string keys;
+    for (auto &s : strs) {
+        keys += s;
+    }
+    IxKeySearch search = IxKeySearch::get(col_len);
+    for (char c = 'a'; c <= 'z'; c++) {
+        std::string target = std::string(2, c) + '\0';
+        EXPECT_EQ(search.lower_bound(keys.data(), strs.size(), target.data(), col_len),
+                  std::lower_bound(strs.begin(), strs.end(), target) - strs.begin());
+        EXPECT_EQ(search.upper_bound(keys.data(), strs.size(), target.data(), col_len),
+                  std::upper_bound(strs.begin(), strs.end(), target) - strs.begin());
+    }
+}
+
+/**
+ * @brief 多列索引：key为(INT,FLOAT)拼接，按列的字典序排列；只限定第一列时用补齐的编码后key定位前缀区间
+ */
+TEST_F(BPlusTreeTests, CompositeKeyTest) {
+    const std::vector<int> col_idxs = {1, 2};
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT, TYPE_FLOAT}, {sizeof(int), sizeof(float)});
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    ih->file_hdr_.btree_order = 4;
+
+    struct Key {
+        int a;
+        float b;
+    };
+    const int num_a = 20, num_b = 20;
+    std::vector<Key> keys;
+    for (int a = -num_a / 2; a < num_a / 2; a++) {
+        for (int b = 0; b < num_b; b++) {
+            keys.push_back({a, (float)(b - num_b / 2) / 4});
+        }
+    }
+    auto rng = std::default_random_engine{};
+    std::shuffle(keys.begin(), keys.end(), rng);
+    for (auto &key : keys) {
+        char raw[sizeof(Key)];
+        memcpy(raw, &key.a, sizeof(int));
+        memcpy(raw + sizeof(int), &key.b, sizeof(float));
+        ASSERT_TRUE(ih->insert_entry(raw, Rid{.page_no = key.a, .slot_no = (int)(key.b * 4)}, txn_.get()));
+    }
+    // 叶子中按(a,b)的字典序排列
+    int count = 0;
+    Rid prev{INT32_MIN, INT32_MIN};
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end();
+         scan.next(), count++) {
+        Rid rid = scan.rid();
+        EXPECT_TRUE(rid.page_no > prev.page_no || (rid.page_no == prev.page_no && rid.slot_no > prev.slot_no));
+        prev = rid;
+    }
+    EXPECT_EQ(count, num_a * num_b);
+    // a = 3的所有key：下界补0x00，上界补0xFF
+    int a = 3;
+    char lower[sizeof(Key)], upper[sizeof(Key)];
+    ix_normalize_key((const char *)&a, TYPE_INT, sizeof(int), lower);
+    memcpy(upper, lower, sizeof(int));
+    memset(lower + sizeof(int), 0, sizeof(float));
+    memset(upper + sizeof(int), 0xff, sizeof(float));
+    count = 0;
+    for (IxScan scan(ih.get(), ih->lower_bound_normalized(lower), ih->upper_bound_normalized(upper),
+                     buffer_pool_manager_.get());
+         !scan.is_end(); scan.next(), count++) {
+        EXPECT_EQ(scan.rid().page_no, a);
+        EXPECT_EQ(scan.rid().slot_no, count - num_b / 2);
+    }
+    EXPECT_EQ(count, num_b);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief INCLUDE列随rid存放在叶子中：分裂、合并/重分配以及批量构建之后，每个key读出的INCLUDE列都应该与插入时一致
+ */
+TEST_F(BPlusTreeTests, IncludeTest) {
+    const std::vector<int> col_idxs = {3};
+    const int include_len = 12;
+    auto make_include = [&](int key, char *include) {
+        int value = key * 7;
+        memcpy(include, &value, sizeof(int));
+        snprintf(include + sizeof(int), include_len - sizeof(int), "v%06d", key);
+    };
+    auto check_scan = [&](IxIndexHandle *ih, const std::vector<int> &expected) {
+        size_t pos = 0;
+        for (IxScan scan(ih, ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get(), true);
+             !scan.is_end(); scan.next(), pos++) {
+            ASSERT_LT(pos, expected.size());
+            char key[sizeof(int)], include[include_len], want[include_len];
+            Rid rid = scan.entry(key, include);
+            EXPECT_EQ(rid.page_no, expected[pos]);
+            make_include(expected[pos], want);
+            EXPECT_EQ(memcmp(include, want, include_len), 0);
+        }
+        EXPECT_EQ(pos, expected.size());
+    };
+
+    // 逐条插入，再删除一半的key
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)}, include_len);
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    ih->file_hdr_.btree_order = 4;
+    const int num_keys = 500;
+    std::vector<int> keys(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine{});
+    char include[include_len];
+    for (int key : keys) {
+        make_include(key, include);
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get(), include));
+    }
+    std::vector<int> expected;
+    for (int key : keys) {
+        if (key % 2 == 0) {
+            ASSERT_TRUE(ih->delete_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+        }
+    }
+    for (int key = 1; key < num_keys; key += 2) {
+        expected.push_back(key);
+    }
+    check_scan(ih.get(), expected);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+
+    // 批量构建
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)}, include_len);
+    ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    {
+        IxSorter sorter(disk_manager_.get(), sizeof(int), include_len, TEST_FILE_NAME, 4 * PAGE_SIZE);
+        char key_buf[sizeof(int)];
+        for (int key : keys) {
+            make_include(key, include);
+            sorter.add(ih->normalize_key((const char *)&key, key_buf), Rid{.page_no = key, .slot_no = 0}, include);
+        }
+        sorter.finish();
+        ih->bulk_load(&sorter);
+    }
+    std::sort(keys.begin(), keys.end());
+    check_scan(ih.get(), keys);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief 检查变长key结点的子树：key严格递增且都在父结点的分隔key确定的区间[lo,hi)内、父结点指针、结点的字节数
+ *
+ * @param hi 区间的上界，为空表示没有上界
+ * @param check_underflow 是否检查非根结点不需要合并（批量构建的最后一个结点可能不满）
+ * @return 子树中叶子结点的键值对数量
+ */
+static int CheckVarSubtree(IxIndexHandle *ih, page_id_t page_no, page_id_t parent_no, const std::string &lo,
+                           const std::string &hi, bool check_underflow) {
+    int col_len = ih->file_hdr_.col_len;
+    IxNodeHandle *node = ih->FetchNode(page_no);
+    EXPECT_EQ(node->GetParentPageNo(), parent_no);
+    EXPECT_LE(node->used_bytes(), PAGE_SIZE);
+    if (parent_no != IX_NO_PAGE && check_underflow) {
+        EXPECT_FALSE(node->IsUnderflow());
+    }
+    std::vector<std::string> keys(node->GetSize(), std::string(col_len, 0));
+    for (int i = 0; i < node->GetSize(); i++) {
+        node->read_key(i, keys[i].data());
+    }
+    // 内部结点的第一个key不用于查找
+    for (int i = node->IsLeafPage() ? 0 : 1; i < node->GetSize(); i++) {
+        EXPECT_GE(keys[i], lo);
+        if (!hi.empty()) {
+            EXPECT_LT(keys[i], hi);
+        }
+        if (i > 0 && (node->IsLeafPage() || i > 1)) {
+            EXPECT_LT(keys[i - 1], keys[i]);
+        }
+    }
+    int num_entries = node->GetSize();
+    if (!node->IsLeafPage()) {
+        num_entries = 0;
+        for (int i = 0; i < node->GetSize(); i++) {
+            num_entries += CheckVarSubtree(ih, node->ValueAt(i), page_no, i == 0 ? lo : keys[i],
+                                           i + 1 < node->GetSize() ? keys[i + 1] : hi, check_underflow);
+        }
+    }
+    ih->ReleaseNode(node, false);
+    return num_entries;
+}
+
+/**
+ * @brief 较长的字符串key使用变长key结点：随机插入、删除和批量构建之后检查树的结构、点查询和扫描结果，
+ * 并且内部结点中的分隔key经过后缀截断，应明显短于完整的key
+ */
+TEST_F(BPlusTreeTests, CompressedKeyTest) {
+    const std::vector<int> col_idxs = {4};
+    const int col_len = 64;
+    const int include_len = sizeof(int);
+    const int num_keys = 20000;
+    // 共同的长前缀 + 长度不等的后缀，key末尾补0
+    std::vector<std::string> keys;
+    std::mt19937 rng(0);
+    for (int i = 0; i < num_keys; i++) {
+        char buf[col_len + 1] = {};
+        int len = snprintf(buf, sizeof(buf), "warehouse-07/district-%02d/customer-%06d/", i % 10, i);
+        for (int pad = rng() % 16; pad > 0 && len < col_len; pad--) {
+            buf[len++] = 'a' + rng() % 26;
+        }
+        keys.emplace_back(buf, col_len);
+    }
+    auto check_lookup = [&](IxIndexHandle *ih, int i, bool exists) {
+        std::vector<Rid> rids;
+        EXPECT_EQ(ih->GetValue(keys[i].data(), &rids, txn_.get()), exists);
+        if (exists) {
+            ASSERT_EQ(rids.size(), 1);
+            EXPECT_EQ(rids[0].slot_no, i);
+        }
+    };
+    auto check_scan = [&](IxIndexHandle *ih, int step) {
+        std::vector<int> expected;
+        for (int i = 0; i < num_keys; i += step) {
+            expected.push_back(i);
+        }
+        std::sort(expected.begin(), expected.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+        size_t pos = 0;
+        for (IxScan scan(ih, ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get(), true);
+             !scan.is_end(); scan.next(), pos++) {
+            ASSERT_LT(pos, expected.size());
+            char key[col_len];
+            int include;
+            Rid rid = scan.entry(key, (char *)&include);
+            EXPECT_EQ(rid.slot_no, expected[pos]);
+            EXPECT_EQ(include, expected[pos] * 3);
+            EXPECT_EQ(memcmp(key, keys[expected[pos]].data(), col_len), 0);
+        }
+        EXPECT_EQ(pos, expected.size());
+    };
+
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_STRING}, {col_len}, include_len);
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    ASSERT_TRUE(ih->file_hdr_.key_compress);
+    std::vector<int> order(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::default_random_engine{});
+    for (int i : order) {
+        int include = i * 3;
+        ASSERT_TRUE(ih->insert_entry(keys[i].data(), Rid{.page_no = 0, .slot_no = i}, txn_.get(), (char *)&include));
+    }
+    EXPECT_FALSE(ih->insert_entry(keys[0].data(), Rid{.page_no = 0, .slot_no = 0}, txn_.get()));
+    EXPECT_EQ(CheckVarSubtree(ih.get(), ih->file_hdr_.root_page, IX_NO_PAGE, "", "", true), num_keys);
+    {
+        // 根结点中的分隔key只需区分相邻的叶子，比最短的完整key还短
+        int min_len = col_len;
+        for (auto &key : keys) {
+            min_len = std::min(min_len, ix_key_sig_len(key.data(), col_len));
+        }
+        IxNodeHandle *root = ih->FetchNode(ih->file_hdr_.root_page);
+        ASSERT_FALSE(root->IsLeafPage());
+        for (int i = 1; i < root->GetSize(); i++) {
+            char key[col_len];
+            root->read_key(i, key);
+            EXPECT_LT(ix_key_sig_len(key, col_len), min_len);
+        }
+        ih->ReleaseNode(root, false);
+    }
+    for (int i = 0; i < num_keys; i += 97) {
+        check_lookup(ih.get(), i, true);
+    }
+    {
+        // 变长key结点上的批量查找
+        std::vector<const char *> batch;
+        for (int i = 0; i < num_keys; i += 3) {
+            batch.push_back(keys[i].data());
+        }
+        std::vector<std::pair<int, Rid>> result;
+        EXPECT_EQ(ih->BatchLookup(batch, &result, txn_.get()), (int)batch.size());
+        for (auto &entry : result) {
+            EXPECT_EQ(entry.second.slot_no, entry.first * 3);
+        }
+    }
+    // 删除奇数key，触发合并和重分配
+    for (int i : order) {
+        if (i % 2 == 1) {
+            ASSERT_TRUE(ih->delete_entry(keys[i].data(), Rid{.page_no = 0, .slot_no = i}, txn_.get()));
+        }
+    }
+    EXPECT_EQ(CheckVarSubtree(ih.get(), ih->file_hdr_.root_page, IX_NO_PAGE, "", "", true), num_keys / 2);
+    for (int i = 0; i < 200; i++) {
+        check_lookup(ih.get(), i, i % 2 == 0);
+    }
+    check_scan(ih.get(), 2);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+
+    // 批量构建
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_STRING}, {col_len}, include_len);
+    ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    {
+        IxSorter sorter(disk_manager_.get(), col_len, include_len, TEST_FILE_NAME, 16 * PAGE_SIZE);
+        for (int i : order) {
+            int include = i * 3;
+            sorter.add(keys[i].data(), Rid{.page_no = 0, .slot_no = i}, (char *)&include);
+        }
+        sorter.finish();
+        ih->bulk_load(&sorter);
+    }
+    EXPECT_EQ(CheckVarSubtree(ih.get(), ih->file_hdr_.root_page, IX_NO_PAGE, "", "", false), num_keys);
+    EXPECT_EQ(ih->file_hdr_.num_pages, disk_manager_->get_fd2pageno(ih->fd_));
+    for (int i = 0; i < num_keys; i += 101) {
+        check_lookup(ih.get(), i, true);
+    }
+    check_scan(ih.get(), 1);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief 非唯一索引：一个key对应多个rid，GetValue按rid的顺序返回，删除时由rid确定entry；
+ * 相同key的entry跨越多个叶子，lower_bound/upper_bound定位的区间包含key的所有entry
+ */
+TEST_F(BPlusTreeTests, NonUniqueTest) {
+    const std::vector<int> col_idxs = {5};
+    const int num_keys = 20;
+    const int rids_per_key = 300;
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)}, 0, true, false);
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    ASSERT_FALSE(ih->file_hdr_.unique);
+    ASSERT_EQ(ih->key_len(), (int)(sizeof(int) + sizeof(Rid)));
+    ih->file_hdr_.btree_order = 16;  // 每个key的entry分布在多个叶子上
+
+    std::vector<std::pair<int, Rid>> entries;
+    for (int key = 0; key < num_keys; key++) {
+        for (int i = 0; i < rids_per_key; i++) {
+            // page_no有负数，检查rid的编码保持顺序
+            entries.emplace_back(key - num_keys / 2, Rid{.page_no = i / 10 - 5, .slot_no = (i * 7) % 10});
+        }
+    }
+    std::shuffle(entries.begin(), entries.end(), std::default_random_engine{});
+    for (auto &[key, rid] : entries) {
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, rid, txn_.get()));
+    }
+    // (key,rid)重复时插入失败
+    EXPECT_FALSE(ih->insert_entry((const char *)&entries[0].first, entries[0].second, txn_.get()));
+    EXPECT_EQ(CheckSubtree(ih.get(), ih->file_hdr_.root_page, IX_NO_PAGE), num_keys * rids_per_key);
+
+    auto expected_rids = [&](int key, bool deleted_odd) {
+        std::vector<Rid> rids;
+        for (auto &[k, rid] : entries) {
+            if (k == key && !(deleted_odd && rid.slot_no % 2 == 1)) {
+                rids.push_back(rid);
+            }
+        }
+        std::sort(rids.begin(), rids.end(), [](const Rid &a, const Rid &b) {
+            return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+        });
+        return rids;
+    };
+    auto check_key = [&](int key, bool deleted_odd) {
+        auto expected = expected_rids(key, deleted_odd);
+        std::vector<Rid> rids;
+        EXPECT_EQ(ih->GetValue((const char *)&key, &rids, txn_.get()), !expected.empty());
+        EXPECT_EQ(rids, expected);
+        // 区间扫描得到相同的rid
+        rids.clear();
+        for (IxScan scan(ih.get(), ih->lower_bound((const char *)&key), ih->upper_bound((const char *)&key),
+                         buffer_pool_manager_.get());
+             !scan.is_end(); scan.next()) {
+            rids.push_back(scan.rid());
+        }
+        EXPECT_EQ(rids, expected);
+    };
+    for (int key = -num_keys / 2 - 1; key <= num_keys / 2; key++) {
+        check_key(key, false);
+    }
+
+    // 删除slot_no为奇数的entry，rid不存在时删除失败
+    int key = entries[0].first;
+    EXPECT_FALSE(ih->delete_entry((const char *)&key, Rid{.page_no = 100, .slot_no = 1}, txn_.get()));
+    for (auto &[k, rid] : entries) {
+        if (rid.slot_no % 2 == 1) {
+            ASSERT_TRUE(ih->delete_entry((const char *)&k, rid, txn_.get()));
+        }
+    }
+    EXPECT_EQ(CheckSubtree(ih.get(), ih->file_hdr_.root_page, IX_NO_PAGE), num_keys * rids_per_key / 2);
+    for (int key = -num_keys / 2 - 1; key <= num_keys / 2; key++) {
+        check_key(key, true);
+    }
+    // 批量查找返回每个key的所有rid
+    std::vector<int> probe = {-1, 0, 1};
+    std::vector<const char *> batch;
+    for (int &k : probe) {
+        batch.push_back((const char *)&k);
+    }
+    std::vector<std::pair<int, Rid>> result;
+    EXPECT_EQ(ih->BatchLookup(batch, &result, txn_.get()), 3);
+    EXPECT_EQ(result.size(), 3u * rids_per_key / 2);
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief Bloom filter：重建后存在的key都能查到、不存在的key大多被排除；插入的新key加入filter；
+ * 删除的key成为假阳性但查不到；关闭时写入索引文件，重新打开后仍然有效，打开期间磁盘上的filter作废
+ */
+TEST_F(BPlusTreeTests, BloomFilterTest) {
+    const int scale = 20000;
+    const std::vector<int> col_idxs = {6};
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+    }
+    ix_manager_->create_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)}, 0, true, false);
+    auto ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+    for (int key = 0; key < scale * 2; key += 2) {
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 1}, txn_.get()));
+    }
+    EXPECT_FALSE(ih->HasBloomFilter());
+    ih->BuildBloomFilter(scale);
+    ASSERT_TRUE(ih->HasBloomFilter());
+
+    // 统计奇数key（都不存在）中没有被filter排除的比例
+    auto check_keys = [&](int end) {
+        int false_positives = 0;
+        char key_buf[IX_MAX_COL_LEN];
+        for (int key = 0; key < end; key++) {
+            std::vector<Rid> rids;
+            bool found = ih->GetValue((const char *)&key, &rids, txn_.get());
+            EXPECT_EQ(found, key % 2 == 0);
+            if (key % 2 == 0) {
+                EXPECT_EQ(rids.size(), 2u);
+            } else {
+                false_positives += ih->MayContain(ih->normalize_key((const char *)&key, key_buf));
+            }
+        }
+        return false_positives;
+    };
+    EXPECT_LT(check_keys(scale * 2), scale * 3 / 100);
+
+    // 之后插入的key加入filter
+    for (int key = scale * 2; key < scale * 3; key += 2) {
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+        ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 1}, txn_.get()));
+    }
+    check_keys(scale * 3);
+    // 删除的key仍在filter中，但查不到
+    int deleted = 10;
+    ASSERT_TRUE(ih->delete_entry((const char *)&deleted, Rid{.page_no = deleted, .slot_no = 0}, txn_.get()));
+    ASSERT_TRUE(ih->delete_entry((const char *)&deleted, Rid{.page_no = deleted, .slot_no = 1}, txn_.get()));
+    char key_buf[IX_MAX_COL_LEN];
+    EXPECT_TRUE(ih->MayContain(ih->normalize_key((const char *)&deleted, key_buf)));
+    std::vector<Rid> rids;
+    EXPECT_FALSE(ih->GetValue((const char *)&deleted, &rids, txn_.get()));
+    ASSERT_TRUE(ih->insert_entry((const char *)&deleted, Rid{.page_no = deleted, .slot_no = 0}, txn_.get()));
+    ASSERT_TRUE(ih->insert_entry((const char *)&deleted, Rid{.page_no = deleted, .slot_no = 1}, txn_.get()));
+
+    // 关闭后重新打开，filter从索引文件中读入；打开期间磁盘上的file header中没有filter
+    for (int round = 0; round < 2; round++) {
+        ix_manager_->close_index(ih.get());
+        ih = ix_manager_->open_index(TEST_FILE_NAME, col_idxs);
+        ASSERT_TRUE(ih->HasBloomFilter());
+        IxFileHdr disk_hdr;
+        disk_manager_->read_page(ih->fd_, IX_FILE_HDR_PAGE, (char *)&disk_hdr, sizeof(disk_hdr));
+        EXPECT_EQ(disk_hdr.bloom_num_blocks, 0);
+        // filter按scale个key确定大小，插入更多的key之后假阳性率上升
+        EXPECT_LT(check_keys(scale * 3), scale * 3 / 2 / 10);
+        // 树的新page覆盖上次写入filter的page
+        for (int key = scale * 3 + round * 1000; key < scale * 3 + round * 1000 + 1000; key += 2) {
+            ASSERT_TRUE(ih->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+            ASSERT_TRUE(ih->delete_entry((const char *)&key, Rid{.page_no = key, .slot_no = 0}, txn_.get()));
+        }
+    }
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+}
+
+/**
+ * @brief IxScan按叶子成批取出entry：区间的两端落在叶子中间、叶子边界以及区间为空时结果与逐个查找一致
+ */
+TEST_F(BPlusTreeTests, ScanBatchTest) {
+    const int scale = 5000;
+    ih_->file_hdr_.btree_order = 16;
+    std::vector<int> keys(scale);
+    for (int i = 0; i < scale; i++) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine{});
+    // rid的page_no与key的顺序无关
+    auto rid_of = [](int key) { return Rid{.page_no = key * 7919 % 1000, .slot_no = key}; };
+    for (int key : keys) {
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, rid_of(key), txn_.get()));
+    }
+    auto check_range = [&](int lower, int upper) {
+        Iid lo = ih_->lower_bound((const char *)&lower), hi = ih_->upper_bound((const char *)&upper);
+        std::vector<Rid> expected;
+        for (int key = std::max(lower, 0); key <= std::min(upper, scale - 1); key++) {
+            expected.push_back(rid_of(key));
+        }
+        std::vector<Rid> rids;
+        for (IxScan scan(ih_.get(), lo, hi, buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+            rids.push_back(scan.rid());
+        }
+        EXPECT_EQ(rids, expected);
+    };
+    check_range(-10, scale + 10);
+    check_range(0, 0);
+    check_range(100, 2000);
+    check_range(scale - 3, scale + 3);
+    check_range(10, 5);  // 空区间
+    std::default_random_engine rng(1);
+    for (int i = 0; i < 50; i++) {
+        int lower = std::uniform_int_distribution<int>(0, scale)(rng);
+        check_range(lower, lower + std::uniform_int_distribution<int>(0, 200)(rng));
+    }
+}
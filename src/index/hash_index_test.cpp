@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <thread>  // NOLINT
+
+#include "gtest/gtest.h"
+
+#define private public
+#include "ix.h"
+#undef private  // for use private variables in "ix.h"
+
+#include "storage/buffer_pool_manager.h"
+
+const std::string TEST_DB_NAME = "HashIndexTest_db";  // 以数据库名作为根目录
+const std::string TEST_FILE_NAME = "table1";          // 测试文件名的前缀
+const std::vector<int> col_idxs = {0};                // 创建的索引文件名为"table1.0.idx"
+
+/** 对于每个测试点，先创建和进入目录TEST_DB_NAME
+ * 然后在此目录下创建和打开INT列上的哈希索引"table1.0.idx"，记录IxHashIndexHandle */
+class HashIndexTest : public ::testing::Test {
+   public:
+    std::unique_ptr<DiskManager> disk_manager_;
+    std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+    std::unique_ptr<IxManager> ix_manager_;
+    std::unique_ptr<IxHashIndexHandle> ih_;
+
+   public:
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        disk_manager_ = std::make_unique<DiskManager>();
+        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(256, disk_manager_.get());
+        ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
+        if (!disk_manager_->is_dir(TEST_DB_NAME)) {
+            disk_manager_->create_dir(TEST_DB_NAME);
+        }
+        if (chdir(TEST_DB_NAME.c_str()) < 0) {
+            throw UnixError();
+        }
+        if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, col_idxs))) {
+            ix_manager_->destroy_index(TEST_FILE_NAME, col_idxs);
+        }
+        ix_manager_->create_hash_index(TEST_FILE_NAME, col_idxs, {TYPE_INT}, {sizeof(int)});
+        ih_ = ix_manager_->open_hash_index(TEST_FILE_NAME, col_idxs);
+    }
+
+    void TearDown() override {
+        ix_manager_->close_index(ih_.get());
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+    }
+
+    // 关闭后重新打开索引，检查目录和bucket都已经写回文件
+    void Reopen() {
+        ix_manager_->close_index(ih_.get());
+        ih_ = ix_manager_->open_hash_index(TEST_FILE_NAME, col_idxs);
+    }
+
+    // 检查目录与各个bucket的local_depth一致，并且每个entry都在其hash值对应的bucket中
+    void CheckStructure(int expected_entries) {
+        IxHashIndexHandle *ih = ih_.get();
+        int global_depth = ih->file_hdr_.global_depth;
+        ASSERT_EQ(ih->dir_.size(), 1u << global_depth);
+        int num_entries = 0;
+        std::set<page_id_t> visited;
+        for (int i = 0; i < (int)ih->dir_.size(); i++) {
+            Page *bucket = ih->FetchPage(ih->dir_[i]);
+            auto hdr = ih->bucket_hdr(bucket);
+            int local_depth = hdr->local_depth;
+            EXPECT_LE(local_depth, global_depth);
+            // 低local_depth位相同的目录项都指向该bucket
+            for (int j = i & ((1 << local_depth) - 1); j < (int)ih->dir_.size(); j += 1 << local_depth) {
+                EXPECT_EQ(ih->dir_[j], ih->dir_[i]);
+            }
+            if (visited.insert(ih->dir_[i]).second) {
+                num_entries += hdr->num_entries;
+                for (int k = 0; k < hdr->num_entries; k++) {
+                    uint64_t hash = ix_hash_key(ih->bucket_entry(bucket, k), ih->file_hdr_.col_len);
+                    EXPECT_EQ(hash & ((1u << local_depth) - 1), (uint64_t)(i & ((1 << local_depth) - 1)));
+                    EXPECT_EQ(ih->bucket_tags(bucket)[k], IxHashIndexHandle::hash_tag(hash));
+                }
+            }
+            ih->ReleasePage(bucket, false);
+        }
+        EXPECT_EQ(num_entries, expected_entries);
+    }
+};
+
+/**
+ * @brief 随机顺序插入、查找、删除，并在关闭重新打开之后检查
+ */
+TEST_F(HashIndexTest, InsertLookupDeleteTest) {
+    const int scale = 50000;
+    std::vector<int> keys(scale);
+    for (int i = 0; i < scale; i++) {
+        keys[i] = i * 7 - scale;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+    // 减小bucket的容量，使目录多次加倍并用到多个目录页
+    ih_->file_hdr_.bucket_capacity = 8;
+    for (int key : keys) {
+        ASSERT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = 1}, nullptr));
+    }
+    // 重复的key插入失败
+    EXPECT_FALSE(ih_->insert_entry((const char *)&keys[0], Rid{.page_no = 0, .slot_no = 0}, nullptr));
+    EXPECT_GT(ih_->file_hdr_.num_dir_pages, 1);
+    CheckStructure(scale);
+
+    std::vector<Rid> result;
+    for (int key : keys) {
+        result.clear();
+        ASSERT_TRUE(ih_->GetValue((const char *)&key, &result, nullptr));
+        ASSERT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0], (Rid{.page_no = key, .slot_no = 1}));
+    }
+    int missing = 3;
+    EXPECT_FALSE(ih_->GetValue((const char *)&missing, &result, nullptr));
+
+    // 删除一半的key
+    for (int i = 0; i < scale; i += 2) {
+        ASSERT_TRUE(ih_->delete_entry((const char *)&keys[i], Rid{.page_no = keys[i], .slot_no = 1}, nullptr));
+    }
+    EXPECT_FALSE(ih_->delete_entry((const char *)&keys[0], Rid{.page_no = keys[0], .slot_no = 1}, nullptr));
+    // rid不同时不删除
+    EXPECT_FALSE(ih_->delete_entry((const char *)&keys[1], Rid{.page_no = keys[1], .slot_no = 2}, nullptr));
+
+    Reopen();
+    CheckStructure(scale / 2);
+    for (int i = 0; i < scale; i++) {
+        result.clear();
+        EXPECT_EQ(ih_->GetValue((const char *)&keys[i], &result, nullptr), i % 2 == 1);
+    }
+    // 删除后的key可以重新插入
+    ASSERT_TRUE(ih_->insert_entry((const char *)&keys[0], Rid{.page_no = 5, .slot_no = 5}, nullptr));
+    result.clear();
+    ASSERT_TRUE(ih_->GetValue((const char *)&keys[0], &result, nullptr));
+    EXPECT_EQ(result[0], (Rid{.page_no = 5, .slot_no = 5}));
+}
+
+/**
+ * @brief 多列key（INT, CHAR(20)），以及FLOAT的-0.0与0.0视为同一个key
+ */
+TEST_F(HashIndexTest, CompositeKeyTest) {
+    const std::vector<int> composite_idxs = {1, 2};
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, composite_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, composite_idxs);
+    }
+    ix_manager_->create_hash_index(TEST_FILE_NAME, composite_idxs, {TYPE_INT, TYPE_STRING}, {sizeof(int), 20});
+    auto ih = ix_manager_->open_hash_index(TEST_FILE_NAME, composite_idxs);
+    auto make_key = [](int a, int b) {
+        std::string key(sizeof(int) + 20, '\0');
+        memcpy(&key[0], &a, sizeof(int));
+        snprintf(&key[sizeof(int)], 20, "name-%d", b);
+        return key;
+    };
+    for (int a = 0; a < 100; a++) {
+        for (int b = 0; b < 100; b++) {
+            ASSERT_TRUE(ih->insert_entry(make_key(a, b).data(), Rid{.page_no = a, .slot_no = b}, nullptr));
+        }
+    }
+    std::vector<Rid> result;
+    for (int a = 0; a < 100; a++) {
+        for (int b = 0; b < 100; b++) {
+            result.clear();
+            ASSERT_TRUE(ih->GetValue(make_key(a, b).data(), &result, nullptr));
+            EXPECT_EQ(result[0], (Rid{.page_no = a, .slot_no = b}));
+        }
+    }
+    EXPECT_FALSE(ih->GetValue(make_key(100, 0).data(), &result, nullptr));
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, composite_idxs);
+
+    const std::vector<int> float_idxs = {3};
+    if (disk_manager_->is_file(ix_manager_->get_index_name(TEST_FILE_NAME, float_idxs))) {
+        ix_manager_->destroy_index(TEST_FILE_NAME, float_idxs);
+    }
+    ix_manager_->create_hash_index(TEST_FILE_NAME, float_idxs, {TYPE_FLOAT}, {sizeof(float)});
+    ih = ix_manager_->open_hash_index(TEST_FILE_NAME, float_idxs);
+    float zero = 0.0f, neg_zero = -0.0f;
+    ASSERT_TRUE(ih->insert_entry((const char *)&zero, Rid{.page_no = 1, .slot_no = 1}, nullptr));
+    EXPECT_FALSE(ih->insert_entry((const char *)&neg_zero, Rid{.page_no = 2, .slot_no = 2}, nullptr));
+    result.clear();
+    EXPECT_TRUE(ih->GetValue((const char *)&neg_zero, &result, nullptr));
+    ix_manager_->close_index(ih.get());
+    ix_manager_->destroy_index(TEST_FILE_NAME, float_idxs);
+}
+
+/**
+ * @brief 多个线程并发插入各自的key并查找其他线程的key，同时进行bucket分裂和目录加倍，最后并发删除一半
+ */
+TEST_F(HashIndexTest, ConcurrentTest) {
+    const int thread_num = 8;
+    const int keys_per_thread = 10000;
+    auto insert_worker = [&](int tid) {
+        std::vector<int> keys;
+        for (int i = 0; i < keys_per_thread; i++) {
+            keys.push_back(i * thread_num + tid);
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(tid));
+        std::vector<Rid> result;
+        for (int key : keys) {
+            EXPECT_TRUE(ih_->insert_entry((const char *)&key, Rid{.page_no = key, .slot_no = tid}, nullptr));
+            // 刚插入的key一定能查到
+            result.clear();
+            EXPECT_TRUE(ih_->GetValue((const char *)&key, &result, nullptr));
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < thread_num; tid++) {
+        threads.emplace_back(insert_worker, tid);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    CheckStructure(thread_num * keys_per_thread);
+
+    auto delete_worker = [&](int tid) {
+        for (int i = 0; i < keys_per_thread; i += 2) {
+            int key = i * thread_num + tid;
+            EXPECT_TRUE(ih_->delete_entry((const char *)&key, Rid{.page_no = key, .slot_no = tid}, nullptr));
+        }
+    };
+    threads.clear();
+    for (int tid = 0; tid < thread_num; tid++) {
+        threads.emplace_back(delete_worker, tid);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::vector<Rid> result;
+    for (int key = 0; key < thread_num * keys_per_thread; key++) {
+        result.clear();
+        bool found = ih_->GetValue((const char *)&key, &result, nullptr);
+        ASSERT_EQ(found, (key / thread_num) % 2 == 1);
+        if (found) {
+            EXPECT_EQ(result[0], (Rid{.page_no = key, .slot_no = key % thread_num}));
+        }
+    }
+}
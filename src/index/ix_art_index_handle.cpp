@@ -0,0 +1,615 @@
+#include "ix_art_index_handle.h"
+
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <new>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// 叶子中的rid按(page_no, slot_no)排序，与非唯一B+树中相同key的entry顺序一致
+bool rid_less(const Rid &a, const Rid &b) {
+    return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+}
+
+}  // namespace
+
+IxArtIndexHandle::IxArtIndexHandle(const std::vector<ColType> &col_types, const std::vector<int> &col_lens) {
+    assert(!col_types.empty() && col_types.size() == col_lens.size());
+    if (col_types.size() > IX_MAX_COL_NUM) {
+        throw InternalError("Too many columns in index");
+    }
+    col_num_ = static_cast<int>(col_types.size());
+    key_len_ = 0;
+    for (int i = 0; i < col_num_; i++) {
+        col_types_[i] = col_types[i];
+        col_lens_[i] = col_lens[i];
+        key_len_ += col_lens[i];
+    }
+    if (key_len_ > IX_MAX_COL_LEN) {
+        throw InvalidColLengthError(key_len_);
+    }
+}
+
+IxArtIndexHandle::~IxArtIndexHandle() { destroy(root_); }
+
+/**
+ * @brief 查找key对应的所有rid
+ *
+ * @param key 原始key
+ * @param result 找到时按rid的顺序追加key对应的所有rid
+ * @return 是否找到
+ */
+bool IxArtIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    const ArtLeaf *leaf = find_leaf(reinterpret_cast<const uint8_t *>(key));
+    if (leaf == nullptr) {
+        return false;
+    }
+    result->insert(result->end(), leaf->rids.begin(), leaf->rids.end());
+    return true;
+}
+
+/**
+ * @brief 插入(key,rid)，(key,rid)已经存在时不插入
+ *
+ * @param include ART索引没有INCLUDE列，忽略
+ * @return 是否插入成功
+ */
+bool IxArtIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                                    const char *include) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    bool inserted = insert(&root_, reinterpret_cast<const uint8_t *>(key), 0, value);
+    num_entries_ += inserted;
+    return inserted;
+}
+
+/**
+ * @brief 删除(key,rid)；key相同但rid不同的entry不删除
+ *
+ * @return 是否删除成功
+ */
+bool IxArtIndexHandle::delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    bool removed = remove(&root_, reinterpret_cast<const uint8_t *>(key), 0, value);
+    num_entries_ -= removed;
+    return removed;
+}
+
+/**
+ * @brief 从根结点向下查找编码后的key所在的叶子
+ * 内部结点只比较保存下来的前缀字节，被省略的字节在叶子中比较整个key时检查
+ */
+const IxArtIndexHandle::ArtLeaf *IxArtIndexHandle::find_leaf(const uint8_t *key) const {
+    ArtRef ref = root_;
+    int depth = 0;
+    while (ref != 0) {
+        if (is_leaf(ref)) {
+            const ArtLeaf *leaf = as_leaf(ref);
+            return memcmp(leaf_key(leaf), key, key_len_) == 0 ? leaf : nullptr;
+        }
+        const ArtNode *node = as_node(ref);
+        if (node->prefix_len > 0) {
+            int len = std::min<int>(node->prefix_len, IX_ART_MAX_PREFIX);
+            if (memcmp(node->prefix, key + depth, len) != 0) {
+                return nullptr;
+            }
+            depth += node->prefix_len;
+        }
+        ArtRef *child = find_child(node, key[depth]);
+        if (child == nullptr) {
+            return nullptr;
+        }
+        ref = *child;
+        depth++;
+    }
+    return nullptr;
+}
+
+IxArtIndexHandle::ArtLeaf *IxArtIndexHandle::make_leaf(const uint8_t *key, const Rid &rid) const {
+    void *mem = ::operator new(sizeof(ArtLeaf) + key_len_);
+    ArtLeaf *leaf = new (mem) ArtLeaf();
+    memcpy(reinterpret_cast<char *>(mem) + sizeof(ArtLeaf), key, key_len_);
+    leaf->rids.push_back(rid);
+    return leaf;
+}
+
+void IxArtIndexHandle::free_leaf(ArtLeaf *leaf) {
+    leaf->~ArtLeaf();
+    ::operator delete(leaf);
+}
+
+/**
+ * @brief 把(key,rid)插入以*ref为根、已经匹配了key的前depth个字节的子树
+ * 结点分裂（路径上出现不同的字节）或者长大时直接修改*ref
+ *
+ * @return (key,rid)之前是否不存在
+ */
+bool IxArtIndexHandle::insert(ArtRef *ref, const uint8_t *key, int depth, const Rid &rid) {
+    if (*ref == 0) {
+        *ref = leaf_ref(make_leaf(key, rid));
+        num_keys_++;
+        return true;
+    }
+    if (is_leaf(*ref)) {
+        ArtLeaf *leaf = as_leaf(*ref);
+        const uint8_t *old_key = leaf_key(leaf);
+        if (memcmp(old_key + depth, key + depth, key_len_ - depth) == 0) {
+            auto pos = std::lower_bound(leaf->rids.begin(), leaf->rids.end(), rid, rid_less);
+            if (pos != leaf->rids.end() && *pos == rid) {
+                return false;
+            }
+            leaf->rids.insert(pos, rid);
+            return true;
+        }
+        // 两个key从depth开始的公共部分成为新结点的路径，定长的key不会是另一个key的前缀
+        int lcp = 0;
+        while (old_key[depth + lcp] == key[depth + lcp]) {
+            lcp++;
+        }
+        auto node = new ArtNode4();
+        node->type = ART_NODE4;
+        node->prefix_len = lcp;
+        memcpy(node->prefix, key + depth, std::min(lcp, IX_ART_MAX_PREFIX));
+        ArtRef old_ref = *ref;
+        *ref = node_ref(node);
+        add_child(ref, node, old_key[depth + lcp], old_ref);
+        add_child(ref, node, key[depth + lcp], leaf_ref(make_leaf(key, rid)));
+        num_keys_++;
+        return true;
+    }
+    ArtNode *node = as_node(*ref);
+    if (node->prefix_len > 0) {
+        int diff = prefix_mismatch(node, key, depth);
+        if (diff < (int)node->prefix_len) {
+            // 在路径的第diff个字节处分开：新结点保存相同的部分，原结点保留不同之后的部分
+            auto parent = new ArtNode4();
+            parent->type = ART_NODE4;
+            parent->prefix_len = diff;
+            memcpy(parent->prefix, node->prefix, std::min(diff, IX_ART_MAX_PREFIX));
+            uint8_t node_byte;
+            if (node->prefix_len <= IX_ART_MAX_PREFIX) {
+                node_byte = node->prefix[diff];
+                node->prefix_len -= diff + 1;
+                memmove(node->prefix, node->prefix + diff + 1, node->prefix_len);
+            } else {
+                // 省略的路径字节从子树中任意一个key（最小的key）中取出
+                const uint8_t *min_key = leaf_key(minimum(*ref));
+                node_byte = min_key[depth + diff];
+                node->prefix_len -= diff + 1;
+                memcpy(node->prefix, min_key + depth + diff + 1,
+                       std::min<int>(node->prefix_len, IX_ART_MAX_PREFIX));
+            }
+            ArtRef old_ref = *ref;
+            *ref = node_ref(parent);
+            add_child(ref, parent, node_byte, old_ref);
+            add_child(ref, parent, key[depth + diff], leaf_ref(make_leaf(key, rid)));
+            num_keys_++;
+            return true;
+        }
+        depth += node->prefix_len;
+    }
+    ArtRef *child = find_child(node, key[depth]);
+    if (child != nullptr) {
+        return insert(child, key, depth + 1, rid);
+    }
+    add_child(ref, node, key[depth], leaf_ref(make_leaf(key, rid)));
+    num_keys_++;
+    return true;
+}
+
+/**
+ * @brief 从以*ref为根的子树中删除(key,rid)，叶子变空时从父结点中删除，父结点孩子过少时缩小或与唯一的孩子合并
+ *
+ * @return 是否删除成功
+ */
+bool IxArtIndexHandle::remove(ArtRef *ref, const uint8_t *key, int depth, const Rid &rid) {
+    auto erase_rid = [&](ArtLeaf *leaf) {
+        if (memcmp(leaf_key(leaf), key, key_len_) != 0) {
+            return false;
+        }
+        auto pos = std::lower_bound(leaf->rids.begin(), leaf->rids.end(), rid, rid_less);
+        if (pos == leaf->rids.end() || *pos != rid) {
+            return false;
+        }
+        leaf->rids.erase(pos);
+        return true;
+    };
+    if (*ref == 0) {
+        return false;
+    }
+    if (is_leaf(*ref)) {
+        // 只有整棵树只有一个叶子时才会走到这里
+        ArtLeaf *leaf = as_leaf(*ref);
+        if (!erase_rid(leaf)) {
+            return false;
+        }
+        if (leaf->rids.empty()) {
+            free_leaf(leaf);
+            *ref = 0;
+            num_keys_--;
+        }
+        return true;
+    }
+    ArtNode *node = as_node(*ref);
+    if (node->prefix_len > 0) {
+        int len = std::min<int>(node->prefix_len, IX_ART_MAX_PREFIX);
+        if (memcmp(node->prefix, key + depth, len) != 0) {
+            return false;
+        }
+        depth += node->prefix_len;
+    }
+    ArtRef *child = find_child(node, key[depth]);
+    if (child == nullptr) {
+        return false;
+    }
+    if (!is_leaf(*child)) {
+        return remove(child, key, depth + 1, rid);
+    }
+    ArtLeaf *leaf = as_leaf(*child);
+    if (!erase_rid(leaf)) {
+        return false;
+    }
+    if (leaf->rids.empty()) {
+        free_leaf(leaf);
+        remove_child(ref, node, key[depth], child);
+        num_keys_--;
+    }
+    return true;
+}
+
+/**
+ * @brief 查找结点中byte对应的孩子
+ * @return 孩子指针在结点中的位置，没有该孩子时返回nullptr
+ */
+IxArtIndexHandle::ArtRef *IxArtIndexHandle::find_child(const ArtNode *node, uint8_t byte) {
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = const_cast<ArtNode4 *>(static_cast<const ArtNode4 *>(node));
+            for (int i = 0; i < n->num_children; i++) {
+                if (n->keys[i] == byte) {
+                    return &n->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case ART_NODE16: {
+            auto n = const_cast<ArtNode16 *>(static_cast<const ArtNode16 *>(node));
+#if defined(__SSE2__)
+            // 一次比较16个字节
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys)));
+            int mask = _mm_movemask_epi8(cmp) & ((1 << n->num_children) - 1);
+            return mask != 0 ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (int i = 0; i < n->num_children; i++) {
+                if (n->keys[i] == byte) {
+                    return &n->children[i];
+                }
+            }
+            return nullptr;
+#endif
+        }
+        case ART_NODE48: {
+            auto n = const_cast<ArtNode48 *>(static_cast<const ArtNode48 *>(node));
+            int idx = n->child_index[byte];
+            return idx != 0 ? &n->children[idx - 1] : nullptr;
+        }
+        case ART_NODE256: {
+            auto n = const_cast<ArtNode256 *>(static_cast<const ArtNode256 *>(node));
+            return n->children[byte] != 0 ? &n->children[byte] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void IxArtIndexHandle::copy_header(ArtNode *dst, const ArtNode *src) {
+    dst->num_children = src->num_children;
+    dst->prefix_len = src->prefix_len;
+    memcpy(dst->prefix, src->prefix, IX_ART_MAX_PREFIX);
+}
+
+/**
+ * @brief 在结点中加入byte对应的孩子，结点已满时换成更大的结点，*ref指向换后的结点
+ *
+ * @param ref 父结点中指向node的位置
+ */
+void IxArtIndexHandle::add_child(ArtRef *ref, ArtNode *node, uint8_t byte, ArtRef child) {
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(node);
+            if (n->num_children < 4) {
+                int pos = 0;
+                while (pos < n->num_children && n->keys[pos] < byte) {
+                    pos++;
+                }
+                memmove(n->keys + pos + 1, n->keys + pos, n->num_children - pos);
+                memmove(n->children + pos + 1, n->children + pos, (n->num_children - pos) * sizeof(ArtRef));
+                n->keys[pos] = byte;
+                n->children[pos] = child;
+                n->num_children++;
+                return;
+            }
+            auto bigger = new ArtNode16();
+            bigger->type = ART_NODE16;
+            copy_header(bigger, n);
+            memcpy(bigger->keys, n->keys, 4);
+            memcpy(bigger->children, n->children, 4 * sizeof(ArtRef));
+            *ref = node_ref(bigger);
+            delete n;
+            add_child(ref, bigger, byte, child);
+            return;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(node);
+            if (n->num_children < 16) {
+                int pos = 0;
+                while (pos < n->num_children && n->keys[pos] < byte) {
+                    pos++;
+                }
+                memmove(n->keys + pos + 1, n->keys + pos, n->num_children - pos);
+                memmove(n->children + pos + 1, n->children + pos, (n->num_children - pos) * sizeof(ArtRef));
+                n->keys[pos] = byte;
+                n->children[pos] = child;
+                n->num_children++;
+                return;
+            }
+            auto bigger = new ArtNode48();
+            bigger->type = ART_NODE48;
+            copy_header(bigger, n);
+            for (int i = 0; i < 16; i++) {
+                bigger->children[i] = n->children[i];
+                bigger->child_index[n->keys[i]] = i + 1;
+            }
+            *ref = node_ref(bigger);
+            delete n;
+            add_child(ref, bigger, byte, child);
+            return;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(node);
+            if (n->num_children < 48) {
+                // 删除孩子后children中的空位不连续，使用第一个空位
+                int pos = 0;
+                while (n->children[pos] != 0) {
+                    pos++;
+                }
+                n->children[pos] = child;
+                n->child_index[byte] = pos + 1;
+                n->num_children++;
+                return;
+            }
+            auto bigger = new ArtNode256();
+            bigger->type = ART_NODE256;
+            copy_header(bigger, n);
+            for (int b = 0; b < 256; b++) {
+                if (n->child_index[b] != 0) {
+                    bigger->children[b] = n->children[n->child_index[b] - 1];
+                }
+            }
+            *ref = node_ref(bigger);
+            delete n;
+            add_child(ref, bigger, byte, child);
+            return;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(node);
+            n->children[byte] = child;
+            n->num_children++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 删除结点中byte对应的孩子，孩子过少时换成更小的结点；Node4只剩一个孩子时用该孩子代替结点，
+ * 结点的路径和孩子对应的字节拼接到孩子的路径之前
+ *
+ * @param ref 父结点中指向node的位置
+ * @param child 孩子指针在node中的位置
+ */
+void IxArtIndexHandle::remove_child(ArtRef *ref, ArtNode *node, uint8_t byte, ArtRef *child) {
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(node);
+            int pos = static_cast<int>(child - n->children);
+            memmove(n->keys + pos, n->keys + pos + 1, n->num_children - pos - 1);
+            memmove(n->children + pos, n->children + pos + 1, (n->num_children - pos - 1) * sizeof(ArtRef));
+            n->num_children--;
+            if (n->num_children == 1) {
+                ArtRef only = n->children[0];
+                if (!is_leaf(only)) {
+                    ArtNode *c = as_node(only);
+                    int len = n->prefix_len;
+                    if (len < IX_ART_MAX_PREFIX) {
+                        n->prefix[len++] = n->keys[0];
+                    }
+                    if (len < IX_ART_MAX_PREFIX) {
+                        int sub_len = std::min<int>(c->prefix_len, IX_ART_MAX_PREFIX - len);
+                        memcpy(n->prefix + len, c->prefix, sub_len);
+                        len += sub_len;
+                    }
+                    memcpy(c->prefix, n->prefix, std::min(len, IX_ART_MAX_PREFIX));
+                    c->prefix_len += n->prefix_len + 1;
+                }
+                *ref = only;
+                delete n;
+            }
+            return;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(node);
+            int pos = static_cast<int>(child - n->children);
+            memmove(n->keys + pos, n->keys + pos + 1, n->num_children - pos - 1);
+            memmove(n->children + pos, n->children + pos + 1, (n->num_children - pos - 1) * sizeof(ArtRef));
+            n->num_children--;
+            if (n->num_children == 3) {
+                auto smaller = new ArtNode4();
+                smaller->type = ART_NODE4;
+                copy_header(smaller, n);
+                memcpy(smaller->keys, n->keys, 3);
+                memcpy(smaller->children, n->children, 3 * sizeof(ArtRef));
+                *ref = node_ref(smaller);
+                delete n;
+            }
+            return;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(node);
+            n->children[n->child_index[byte] - 1] = 0;
+            n->child_index[byte] = 0;
+            n->num_children--;
+            if (n->num_children == 12) {
+                auto smaller = new ArtNode16();
+                smaller->type = ART_NODE16;
+                copy_header(smaller, n);
+                int pos = 0;
+                for (int b = 0; b < 256; b++) {
+                    if (n->child_index[b] != 0) {
+                        smaller->keys[pos] = b;
+                        smaller->children[pos] = n->children[n->child_index[b] - 1];
+                        pos++;
+                    }
+                }
+                *ref = node_ref(smaller);
+                delete n;
+            }
+            return;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(node);
+            n->children[byte] = 0;
+            n->num_children--;
+            // 比Node48的容量少一些时才缩小，避免在边界上反复变换
+            if (n->num_children == 37) {
+                auto smaller = new ArtNode48();
+                smaller->type = ART_NODE48;
+                copy_header(smaller, n);
+                int pos = 0;
+                for (int b = 0; b < 256; b++) {
+                    if (n->children[b] != 0) {
+                        smaller->children[pos] = n->children[b];
+                        smaller->child_index[b] = pos + 1;
+                        pos++;
+                    }
+                }
+                *ref = node_ref(smaller);
+                delete n;
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 子树中最小的key所在的叶子，用于取出结点省略的路径字节
+ */
+const IxArtIndexHandle::ArtLeaf *IxArtIndexHandle::minimum(ArtRef ref) {
+    while (!is_leaf(ref)) {
+        const ArtNode *node = as_node(ref);
+        switch (node->type) {
+            case ART_NODE4:
+                ref = static_cast<const ArtNode4 *>(node)->children[0];
+                break;
+            case ART_NODE16:
+                ref = static_cast<const ArtNode16 *>(node)->children[0];
+                break;
+            case ART_NODE48: {
+                auto n = static_cast<const ArtNode48 *>(node);
+                int b = 0;
+                while (n->child_index[b] == 0) {
+                    b++;
+                }
+                ref = n->children[n->child_index[b] - 1];
+                break;
+            }
+            case ART_NODE256: {
+                auto n = static_cast<const ArtNode256 *>(node);
+                int b = 0;
+                while (n->children[b] == 0) {
+                    b++;
+                }
+                ref = n->children[b];
+                break;
+            }
+        }
+    }
+    return as_leaf(ref);
+}
+
+/**
+ * @brief key从depth开始与结点的路径第一个不同的位置，路径与key相同时返回路径的长度
+ */
+int IxArtIndexHandle::prefix_mismatch(const ArtNode *node, const uint8_t *key, int depth) const {
+    int len = std::min<int>(node->prefix_len, IX_ART_MAX_PREFIX);
+    int i = 0;
+    for (; i < len; i++) {
+        if (node->prefix[i] != key[depth + i]) {
+            return i;
+        }
+    }
+    if ((int)node->prefix_len > IX_ART_MAX_PREFIX) {
+        const uint8_t *min_key = leaf_key(minimum(node_ref(const_cast<ArtNode *>(node))));
+        for (; i < (int)node->prefix_len; i++) {
+            if (min_key[depth + i] != key[depth + i]) {
+                return i;
+            }
+        }
+    }
+    return i;
+}
+
+void IxArtIndexHandle::destroy(ArtRef ref) {
+    if (ref == 0) {
+        return;
+    }
+    if (is_leaf(ref)) {
+        free_leaf(as_leaf(ref));
+        return;
+    }
+    ArtNode *node = as_node(ref);
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                destroy(n->children[i]);
+            }
+            delete n;
+            break;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                destroy(n->children[i]);
+            }
+            delete n;
+            break;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(node);
+            for (int i = 0; i < 48; i++) {
+                destroy(n->children[i]);
+            }
+            delete n;
+            break;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(node);
+            for (int b = 0; b < 256; b++) {
+                destroy(n->children[b]);
+            }
+            delete n;
+            break;
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <vector>
+
+#include "ix_defs.h"
+#include "ix_index.h"
+#include "ix_key.h"
+
+/**
+ * @brief 常驻内存的自适应基数树（ART）索引，只支持整个key上的等值查询，用于较小的、查询频繁的表
+ * 树中的key是ix_normalize_key编码后的定长key，每层按一个字节分支：内部结点按孩子个数在4/16/48/256四种大小之间
+ * 自适应地变化，只有一个孩子的路径压缩为结点的前缀；同一个key的所有rid按rid的顺序存放在一个叶子中
+ * 索引不写入文件，打开数据库时由SmManager从表中的记录重新构建，之后由DML和事务回滚通过IxIndex接口维护
+ * 并发控制：整棵树一个读写锁，点查询之间互不阻塞
+ */
+class IxArtIndexHandle : public IxIndex {
+   private:
+    // 孩子指针的最低位为1时指向叶子，否则指向内部结点
+    using ArtRef = uintptr_t;
+
+    enum ArtNodeType : uint8_t { ART_NODE4, ART_NODE16, ART_NODE48, ART_NODE256 };
+
+    // 叶子之后紧接着存放编码后的key，见leaf_key()
+    struct ArtLeaf {
+        std::vector<Rid> rids;  // 按rid升序
+    };
+
+    struct ArtNode {
+        ArtNodeType type;
+        uint16_t num_children;
+        uint32_t prefix_len;                // 压缩的路径长度，可能大于IX_ART_MAX_PREFIX
+        uint8_t prefix[IX_ART_MAX_PREFIX];  // 只保存路径的前IX_ART_MAX_PREFIX个字节，其余的字节到叶子中比较
+    };
+
+    struct ArtNode4 : ArtNode {
+        uint8_t keys[4];  // 有序
+        ArtRef children[4];
+    };
+
+    struct ArtNode16 : ArtNode {
+        uint8_t keys[16];  // 有序
+        ArtRef children[16];
+    };
+
+    struct ArtNode48 : ArtNode {
+        uint8_t child_index[256];  // 字节 -> children的下标+1，0表示没有孩子
+        ArtRef children[48];
+    };
+
+    struct ArtNode256 : ArtNode {
+        ArtRef children[256];
+    };
+
+    int col_num_;
+    ColType col_types_[IX_MAX_COL_NUM];
+    int col_lens_[IX_MAX_COL_NUM];
+    int key_len_;  // 编码后的key的长度
+    ArtRef root_ = 0;
+    size_t num_keys_ = 0;
+    size_t num_entries_ = 0;
+    mutable std::shared_mutex latch_;
+
+   public:
+    IxArtIndexHandle(const std::vector<ColType> &col_types, const std::vector<int> &col_lens);
+
+    ~IxArtIndexHandle() override;
+
+    bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) override;
+
+    bool insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                      const char *include = nullptr) override;
+
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction) override;
+
+    size_t num_keys() const { return num_keys_; }
+
+    size_t num_entries() const { return num_entries_; }
+
+    // 与B+树、哈希索引使用相同的编码
+    const char *normalize_key(const char *key, char *buf) const {
+        int offset = 0;
+        for (int i = 0; i < col_num_; i++) {
+            ix_normalize_key(key + offset, col_types_[i], col_lens_[i], buf + offset);
+            offset += col_lens_[i];
+        }
+        return buf;
+    }
+
+   private:
+    static bool is_leaf(ArtRef ref) { return ref & 1; }
+
+    static ArtLeaf *as_leaf(ArtRef ref) { return reinterpret_cast<ArtLeaf *>(ref & ~(ArtRef)1); }
+
+    static ArtNode *as_node(ArtRef ref) { return reinterpret_cast<ArtNode *>(ref); }
+
+    static ArtRef leaf_ref(ArtLeaf *leaf) { return reinterpret_cast<ArtRef>(leaf) | 1; }
+
+    static ArtRef node_ref(ArtNode *node) { return reinterpret_cast<ArtRef>(node); }
+
+    static const uint8_t *leaf_key(const ArtLeaf *leaf) { return reinterpret_cast<const uint8_t *>(leaf + 1); }
+
+    const ArtLeaf *find_leaf(const uint8_t *key) const;
+
+    ArtLeaf *make_leaf(const uint8_t *key, const Rid &rid) const;
+
+    static void free_leaf(ArtLeaf *leaf);
+
+    bool insert(ArtRef *ref, const uint8_t *key, int depth, const Rid &rid);
+
+    bool remove(ArtRef *ref, const uint8_t *key, int depth, const Rid &rid);
+
+    // for inner nodes
+    static ArtRef *find_child(const ArtNode *node, uint8_t byte);
+
+    static void copy_header(ArtNode *dst, const ArtNode *src);
+
+    static void add_child(ArtRef *ref, ArtNode *node, uint8_t byte, ArtRef child);
+
+    static void remove_child(ArtRef *ref, ArtNode *node, uint8_t byte, ArtRef *child);
+
+    static const ArtLeaf *minimum(ArtRef ref);
+
+    int prefix_mismatch(const ArtNode *node, const uint8_t *key, int depth) const;
+
+    static void destroy(ArtRef ref);
+};
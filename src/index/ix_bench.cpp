@@ -0,0 +1,346 @@
+/**
+ * @brief IxIndexHandle的吞吐量基准测试（google benchmark），输出JSON用于比较不同版本之间的性能回退
+ * 操作：insert、点查询lookup、范围扫描scan（从一个key开始读IX_BENCH_SCAN_LEN个entry）、delete
+ * key类型：INT、FLOAT、CHAR(n)；key的分布：sequential、uniform、zipfian（theta=0.99，热点打散在整个key空间中）
+ * 线程数：1, 2, 4, ...直到--max_threads；缓冲池：warm（预先载入的page都在缓冲池中）或cold（刷盘后清空缓冲池，
+ * 并让操作系统丢弃文件的page cache）
+ * 每次运行先用IxSorter+bulk_load批量构建含--keys个key的非唯一索引（与CREATE INDEX相同），已有的key为0,2,4,...；
+ * insert插入奇数key（sequential时插入在最大key之后），lookup/scan/delete的目标为已有的key
+ * 每个线程执行--ops/线程数次操作，迭代次数固定，不同版本的结果可以直接比较
+ *
+ * 用法：ix_bench [--keys=N] [--ops=N] [--char_len=n] [--max_threads=N] [--pool_pages=N] [google benchmark的参数]
+ * 默认以JSON格式输出到标准输出，可以用--benchmark_out=<file>另外写入文件，用--benchmark_filter=<regex>选择测试
+ */
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>  // NOLINT
+
+#define private public
+#include "ix.h"
+#undef private
+
+static const std::string BENCH_DB_NAME = "IxBench_db";
+static const std::string BENCH_FILE_NAME = "bench";
+static constexpr int IX_BENCH_SCAN_LEN = 100;
+static constexpr double IX_BENCH_ZIPF_THETA = 0.99;
+
+enum BenchOp { BENCH_INSERT, BENCH_LOOKUP, BENCH_SCAN, BENCH_DELETE };
+enum BenchDist { BENCH_SEQUENTIAL, BENCH_UNIFORM, BENCH_ZIPFIAN };
+
+static const char *op_names[] = {"insert", "lookup", "scan", "delete"};
+static const char *dist_names[] = {"sequential", "uniform", "zipfian"};
+
+// 命令行参数
+static int num_keys = 1000000;
+static int num_ops = 200000;
+static int char_len = 32;
+static int max_threads = (int)std::max(1u, std::thread::hardware_concurrency());
+static int pool_pages = 65536;
+
+struct BenchConfig {
+    BenchOp op;
+    ColType type;
+    BenchDist dist;
+    bool cold;
+};
+
+static int col_len_of(ColType type) { return type == TYPE_STRING ? char_len : 4; }
+
+static const char *type_name(ColType type) { return type == TYPE_INT ? "INT" : type == TYPE_FLOAT ? "FLOAT" : "CHAR"; }
+
+// 第v个key：INT和FLOAT直接取v（v < 2^24，float可以精确表示），CHAR为补0的十进制数，字典序与v的大小一致
+static void make_key(ColType type, int64_t v, char *key) {
+    if (type == TYPE_INT) {
+        int value = (int)v;
+        memcpy(key, &value, sizeof(value));
+    } else if (type == TYPE_FLOAT) {
+        float value = (float)v;
+        memcpy(key, &value, sizeof(value));
+    } else {
+        memset(key, 0, char_len);
+        snprintf(key, char_len, "user%012lld", (long long)v);
+    }
+}
+
+/**
+ * @brief 在[0, n)中生成zipfian分布的下标（Gray et al., "Quickly generating billion-record synthetic databases"）
+ * 排名为r的元素映射到hash(r) % n，热点分散在整个key空间，而不是集中在最小的key上
+ */
+class ZipfianGenerator {
+    int64_t n_;
+    double alpha_, zetan_, eta_, half_pow_theta_;
+
+    static double zeta(int64_t n) {
+        double sum = 0;
+        for (int64_t i = 1; i <= n; i++) {
+            sum += 1.0 / std::pow((double)i, IX_BENCH_ZIPF_THETA);
+        }
+        return sum;
+    }
+
+    static uint64_t fnv_hash(uint64_t value) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ (value & 0xff)) * 0x100000001b3ULL;
+            value >>= 8;
+        }
+        return hash;
+    }
+
+   public:
+    explicit ZipfianGenerator(int64_t n) : n_(n) {
+        alpha_ = 1.0 / (1.0 - IX_BENCH_ZIPF_THETA);
+        zetan_ = zeta(n);
+        eta_ = (1.0 - std::pow(2.0 / n, 1.0 - IX_BENCH_ZIPF_THETA)) / (1.0 - zeta(2) / zetan_);
+        half_pow_theta_ = std::pow(0.5, IX_BENCH_ZIPF_THETA);
+    }
+
+    int64_t next(std::mt19937_64 &rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * zetan_;
+        int64_t rank;
+        if (uz < 1.0) {
+            rank = 0;
+        } else if (uz < 1.0 + half_pow_theta_) {
+            rank = 1;
+        } else {
+            rank = std::min<int64_t>(n_ - 1, (int64_t)(n_ * std::pow(eta_ * u - eta_ + 1.0, alpha_)));
+        }
+        return (int64_t)(fnv_hash(rank) % (uint64_t)n_);
+    }
+};
+
+/**
+ * @brief 每个线程按指定的分布生成[0, n)中的下标；sequential时各个线程从n的不同位置开始依次递增
+ */
+class IndexGenerator {
+    BenchDist dist_;
+    int64_t n_;
+    int64_t next_seq_;
+    std::mt19937_64 rng_;
+    const ZipfianGenerator *zipf_;
+
+   public:
+    IndexGenerator(BenchDist dist, int64_t n, int thread_idx, int num_threads, const ZipfianGenerator *zipf)
+        : dist_(dist), n_(n), next_seq_(n * thread_idx / num_threads), rng_(thread_idx + 1), zipf_(zipf) {}
+
+    int64_t next() {
+        switch (dist_) {
+            case BENCH_SEQUENTIAL:
+                return next_seq_++ % n_;
+            case BENCH_UNIFORM:
+                return std::uniform_int_distribution<int64_t>(0, n_ - 1)(rng_);
+            default:
+                return zipf_->next(rng_);
+        }
+    }
+};
+
+/**
+ * @brief 一次运行使用的缓冲池和索引，由第0个线程在计时开始之前创建、计时结束之后销毁
+ */
+struct BenchEnv {
+    DiskManager disk_manager;
+    BufferPoolManager bpm;
+    IxManager ix_manager;
+    std::unique_ptr<IxIndexHandle> ih;
+    std::unique_ptr<ZipfianGenerator> zipf;
+
+    explicit BenchEnv(const BenchConfig &config)
+        : bpm(pool_pages, &disk_manager), ix_manager(&disk_manager, &bpm) {
+        int col_len = col_len_of(config.type);
+        if (disk_manager.is_file(ix_manager.get_index_name(BENCH_FILE_NAME, {0}))) {
+            ix_manager.destroy_index(BENCH_FILE_NAME, 0);
+        }
+        // 与SmManager建的B+树索引相同：非唯一索引，key后面拼接rid
+        ix_manager.create_index(BENCH_FILE_NAME, {0}, {config.type}, {col_len}, 0, true, false);
+        ih = ix_manager.open_index(BENCH_FILE_NAME, 0);
+        {
+            IxSorter sorter(&disk_manager, ih->key_len(), 0, BENCH_FILE_NAME);
+            char key[IX_MAX_COL_LEN], norm_key[IX_MAX_COL_LEN];
+            for (int i = 0; i < num_keys; i++) {
+                Rid rid = {.page_no = i, .slot_no = 0};
+                make_key(config.type, 2 * (int64_t)i, key);
+                sorter.add(ih->normalize_key(key, norm_key, &rid), rid);
+            }
+            sorter.finish();
+            ih->bulk_load(&sorter);
+        }
+        if (config.dist == BENCH_ZIPFIAN) {
+            zipf = std::make_unique<ZipfianGenerator>(num_keys);
+        }
+        if (config.cold) {
+            // file header所在的页一直被pin住，不能丢弃
+            bpm.FlushAllPages(ih->fd_);
+            bpm.DiscardPages(ih->fd_, IX_FILE_HDR_PAGE + 1);
+            fdatasync(ih->fd_);
+            posix_fadvise(ih->fd_, 0, 0, POSIX_FADV_DONTNEED);
+        }
+    }
+
+    ~BenchEnv() {
+        ix_manager.close_index(ih.get());
+        ix_manager.destroy_index(BENCH_FILE_NAME, 0);
+    }
+};
+
+static BenchEnv *env = nullptr;
+
+static void run_bench(benchmark::State &state, BenchConfig config) {
+    if (state.thread_index() == 0) {
+        env = new BenchEnv(config);
+    }
+    // 第0个线程创建env之后，所有线程在第一次迭代之前同步，之后才能使用env
+    char key[IX_MAX_COL_LEN];
+    std::vector<Rid> result;
+    Transaction txn(state.thread_index());
+    std::unique_ptr<IndexGenerator> gen;
+    int64_t num_found = 0, num_entries = 0;
+    int64_t seq = 0;
+    for (auto _ : state) {
+        if (gen == nullptr) {
+            gen = std::make_unique<IndexGenerator>(config.dist, num_keys, state.thread_index(), state.threads(),
+                                                   env->zipf.get());
+        }
+        IxIndexHandle *ih = env->ih.get();
+        switch (config.op) {
+            case BENCH_INSERT: {
+                // 新key都是奇数；sequential时插入在所有已有key之后，各个线程的key交错递增
+                int64_t v = config.dist == BENCH_SEQUENTIAL
+                                ? 2 * (int64_t)num_keys + seq * state.threads() + state.thread_index()
+                                : 2 * gen->next() + 1;
+                make_key(config.type, v, key);
+                Rid rid = {.page_no = num_keys + (int)seq, .slot_no = state.thread_index() + 1};
+                num_found += ih->insert_entry(key, rid, &txn);
+                seq++;
+                break;
+            }
+            case BENCH_LOOKUP: {
+                make_key(config.type, 2 * gen->next(), key);
+                result.clear();
+                num_found += ih->GetValue(key, &result, &txn);
+                break;
+            }
+            case BENCH_SCAN: {
+                make_key(config.type, 2 * gen->next(), key);
+                int n = 0;
+                for (IxScan scan(ih, ih->lower_bound(key), ih->leaf_end(), &env->bpm); !scan.is_end() &&
+                                                                                        n < IX_BENCH_SCAN_LEN;
+                     scan.next()) {
+                    benchmark::DoNotOptimize(scan.rid());
+                    n++;
+                }
+                num_entries += n;
+                num_found += n > 0;
+                break;
+            }
+            case BENCH_DELETE: {
+                // zipfian时热点key被删除之后再次删除会找不到，hit_rate反映这一点
+                int64_t i = gen->next();
+                make_key(config.type, 2 * i, key);
+                num_found += ih->delete_entry(key, Rid{.page_no = (int)i, .slot_no = 0}, &txn);
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_rate"] = benchmark::Counter((double)num_found / state.iterations(),
+                                                    benchmark::Counter::kAvgThreads);
+    if (config.op == BENCH_SCAN) {
+        state.counters["entries_per_second"] = benchmark::Counter((double)num_entries, benchmark::Counter::kIsRate);
+    }
+    if (state.thread_index() == 0) {
+        // 所有线程在最后一次迭代之后同步，此时没有线程再使用env
+        state.counters["pages"] = (double)env->ih->file_hdr_.num_pages;
+        delete env;
+        env = nullptr;
+    }
+}
+
+static bool parse_flag(const char *arg, const char *name, int *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    *value = atoi(arg + len + 1);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    // 默认输出JSON；取出本测试自己的参数，其余的交给google benchmark
+    std::vector<char *> args = {argv[0]};
+    bool has_format = false;
+    for (int i = 1; i < argc; i++) {
+        if (parse_flag(argv[i], "--keys", &num_keys) || parse_flag(argv[i], "--ops", &num_ops) ||
+            parse_flag(argv[i], "--char_len", &char_len) || parse_flag(argv[i], "--max_threads", &max_threads) ||
+            parse_flag(argv[i], "--pool_pages", &pool_pages)) {
+            continue;
+        }
+        has_format |= strncmp(argv[i], "--benchmark_format", strlen("--benchmark_format")) == 0;
+        args.push_back(argv[i]);
+    }
+    char json_format[] = "--benchmark_format=json";
+    if (!has_format) {
+        args.push_back(json_format);
+    }
+    int bench_argc = (int)args.size();
+    benchmark::Initialize(&bench_argc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(bench_argc, args.data())) {
+        return 1;
+    }
+    // FLOAT key需要精确表示所有的key，最大的key为sequential insert的2 * keys + ops
+    if (num_keys <= 0 || num_ops <= 0 || char_len < 17 || char_len > IX_MAX_COL_LEN - (int)sizeof(Rid) ||
+        max_threads <= 0 || 2 * (int64_t)num_keys + num_ops >= (1 << 24)) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+    benchmark::AddCustomContext("keys", std::to_string(num_keys));
+    benchmark::AddCustomContext("ops", std::to_string(num_ops));
+    benchmark::AddCustomContext("char_len", std::to_string(char_len));
+    benchmark::AddCustomContext("pool_pages", std::to_string(pool_pages));
+
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+    for (BenchOp op : {BENCH_INSERT, BENCH_LOOKUP, BENCH_SCAN, BENCH_DELETE}) {
+        for (ColType type : {TYPE_INT, TYPE_FLOAT, TYPE_STRING}) {
+            for (BenchDist dist : {BENCH_SEQUENTIAL, BENCH_UNIFORM, BENCH_ZIPFIAN}) {
+                for (bool cold : {false, true}) {
+                    std::string name = std::string(op_names[op]) + "/" + type_name(type) + "/" + dist_names[dist] +
+                                       (cold ? "/cold" : "/warm");
+                    for (int threads : thread_counts) {
+                        benchmark::RegisterBenchmark(name.c_str(), run_bench, BenchConfig{op, type, dist, cold})
+                            ->Threads(threads)
+                            ->Iterations(std::max(1, num_ops / threads))
+                            ->UseRealTime()
+                            ->Unit(benchmark::kMicrosecond);
+                    }
+                }
+            }
+        }
+    }
+
+    DiskManager disk_manager;
+    if (disk_manager.is_dir(BENCH_DB_NAME)) {
+        disk_manager.destroy_dir(BENCH_DB_NAME);
+    }
+    disk_manager.create_dir(BENCH_DB_NAME);
+    if (chdir(BENCH_DB_NAME.c_str()) < 0) {
+        throw UnixError();
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    if (chdir("..") < 0) {
+        throw UnixError();
+    }
+    disk_manager.destroy_dir(BENCH_DB_NAME);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "ix_defs.h"
+
+/**
+ * @brief 分块的Bloom filter（split block Bloom filter），用于在访问B+树之前排除不存在的key
+ * 位数组分成IX_BLOOM_BLOCK_SIZE字节的块，每个key由hash的高32位选中一个块，在块内的8个32位字中各置一位，
+ * 因此一次查询只访问一个cache line；只能插入不能删除，删除的key成为假阳性，由REINDEX/ANALYZE重建
+ * 插入与查询可以并发：置位使用原子的fetch_or，插入者先置位再修改树，能在树中找到的key在filter中一定存在
+ */
+class IxBloomFilter {
+   public:
+    static constexpr int WORDS_PER_BLOCK = IX_BLOOM_BLOCK_SIZE / sizeof(uint32_t);
+
+   private:
+    int num_blocks_;
+    std::unique_ptr<std::atomic<uint32_t>[]> words_;
+
+    // 块内第i个字中置位的位置由hash的低32位乘以不同的奇数常量得到
+    static constexpr uint32_t SALT[WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                       0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    std::atomic<uint32_t> *block(uint64_t hash) const {
+        uint64_t idx = ((hash >> 32) * (uint64_t)num_blocks_) >> 32;
+        return &words_[idx * WORDS_PER_BLOCK];
+    }
+
+    static uint32_t mask(uint64_t hash, int i) { return 1U << (((uint32_t)hash * SALT[i]) >> 27); }
+
+   public:
+    explicit IxBloomFilter(int num_blocks)
+        : num_blocks_(num_blocks), words_(new std::atomic<uint32_t>[(size_t)num_blocks * WORDS_PER_BLOCK]) {
+        for (size_t i = 0; i < (size_t)num_blocks * WORDS_PER_BLOCK; i++) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 按预计的key个数确定块数，每个key约IX_BLOOM_BITS_PER_KEY位
+    static int blocks_for(int64_t num_keys) {
+        int64_t bits = std::max<int64_t>(num_keys, 1) * IX_BLOOM_BITS_PER_KEY;
+        int64_t blocks = (bits + IX_BLOOM_BLOCK_SIZE * 8 - 1) / (IX_BLOOM_BLOCK_SIZE * 8);
+        return (int)std::min<int64_t>(blocks, IX_BLOOM_MAX_BLOCKS);
+    }
+
+    void add(uint64_t hash) {
+        std::atomic<uint32_t> *words = block(hash);
+        for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+            words[i].fetch_or(mask(hash, i), std::memory_order_relaxed);
+        }
+    }
+
+    bool may_contain(uint64_t hash) const {
+        const std::atomic<uint32_t> *words = block(hash);
+        for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+            if ((words[i].load(std::memory_order_relaxed) & mask(hash, i)) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int num_blocks() const { return num_blocks_; }
+
+    // 位数组的字节数，持久化时按page依次存放
+    size_t size() const { return (size_t)num_blocks_ * IX_BLOOM_BLOCK_SIZE; }
+
+    // 读出/写入位数组中从offset开始的len个字节
+    void read(size_t offset, char *buf, size_t len) const {
+        for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+            uint32_t word = words_[(offset + i) / sizeof(uint32_t)].load(std::memory_order_relaxed);
+            memcpy(buf + i, &word, sizeof(word));
+        }
+    }
+
+    void write(size_t offset, const char *buf, size_t len) {
+        for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+            uint32_t word;
+            memcpy(&word, buf + i, sizeof(word));
+            words_[(offset + i) / sizeof(uint32_t)].store(word, std::memory_order_relaxed);
+        }
+    }
+};
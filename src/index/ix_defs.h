@@ -1,19 +1,40 @@
 #pragma once
 
+#include <cstdint>
+
 #include "defs.h"
 #include "storage/buffer_pool_manager.h"
 
+constexpr int IX_MAX_COL_NUM = 8;  // 多列索引最多包含的列数
+
+// 索引的类型（在CREATE INDEX ... USING时指定，保存在IndexMeta中）
+enum IxIndexType {
+    IX_INDEX_BTREE = 0,  // B+树，支持等值和范围查询
+    IX_INDEX_HASH = 1,   // 可扩展哈希，只支持整个key上的等值查询
+    IX_INDEX_ART = 2     // 常驻内存的自适应基数树，只支持整个key上的等值查询，不写入文件
+};
+
+// 只有B+树索引有序，支持范围扫描、INCLUDE列和索引覆盖扫描；其他索引只用于整个key上的等值查询
+inline bool ix_index_ordered(IxIndexType type) { return type == IX_INDEX_BTREE; }
+
 struct IxFileHdr {
-    page_id_t first_free_page_no;
-    int num_pages;        // disk pages
+    page_id_t first_free_page_no;  // 空闲页链表的表头，B+树中被删除的结点通过IxPageHdr::next_free_page_no链接
+    int num_pages;        // disk pages，包括空闲页链表中的page
     page_id_t root_page;  // root page no
-    ColType col_type;
-    int col_len;      // ColMeta->len
+    int col_num;                        // 索引包含的列数，key由各列的值按顺序拼接而成
+    ColType col_types[IX_MAX_COL_NUM];  // 每一列的类型
+    int col_lens[IX_MAX_COL_NUM];       // 每一列的长度
+    int col_len;      // 结点中key的总长度，即各列ColMeta->len之和，非唯一索引还要加上sizeof(Rid)
+    int include_len;  // 叶子的每个entry在rid之外存放的INCLUDE列的总长度，不参与比较
+    bool unique;      // key是否唯一；非唯一索引在key之后拼接编码后的rid，(key,rid)唯一，相同key的entry按rid排序
+    bool key_compress;  // 是否使用变长key结点（IxVarPageHdr），含字符串列的较长key才使用
     int btree_order;  // children per page 每个结点最多可插入的键值对数量
     int keys_size;  // keys_size = (btree_order + 1) * col_len
     // first_leaf初始化之后没有进行修改，只不过是在测试文件中遍历叶子结点的时候用了
     page_id_t first_leaf;  // 在上层IxManager的open函数进行初始化，初始化为root page_no
     page_id_t last_leaf;
+    page_id_t bloom_page;  // Bloom filter位数组存放的第一个page，关闭时写在树的所有page之后
+    int bloom_num_blocks;  // Bloom filter的块数，0表示没有Bloom filter
 };
 
 struct IxPageHdr {
@@ -25,6 +46,36 @@ struct IxPageHdr {
     page_id_t next_leaf;  // next leaf node's page_no, effective only when is_leaf is true
 };
 
+/**
+ * @brief 变长key结点的页头，紧跟在IxPageHdr之后
+ * 之后是定长的slot数组（IxVarSlot，叶子结点中后面还跟着INCLUDE列），key的字节从页尾向前存放：
+ * 叶子结点中所有key共同的前缀只在页尾存放一次（head-prefix compression），每个key只存放前缀之后的部分；
+ * key末尾的0都不存放，内部结点中的分隔key经过后缀截断（suffix truncation），通常只有几个字节
+ */
+struct IxVarPageHdr {
+    uint16_t prefix_len;  // 公共前缀的长度，内部结点为0
+    uint16_t prefix_sig;  // 公共前缀去掉末尾的0之后的长度，页尾的prefix_sig个字节即公共前缀
+    uint16_t heap_begin;  // key的字节从页尾向前存放到heap_begin
+    uint16_t garbage;     // [heap_begin, PAGE_SIZE)中已经删除的key占用的字节数，空间不够时整理
+};
+
+struct IxVarSlot {
+    Rid rid;
+    uint16_t key_off;  // key去掉公共前缀后剩余部分在页中的偏移
+    uint16_t key_len;  // 剩余部分去掉末尾的0之后的长度
+};
+
+/**
+ * @brief B+树的形状，由ANALYZE统计后保存在IndexMeta中，供优化器估计索引扫描的代价
+ */
+struct IxTreeStats {
+    int height;           // 根结点到叶子的层数，只有根叶子时为1；0表示没有统计过
+    int num_leaves;       // 叶子结点数
+    int64_t num_entries;  // entry数
+    int64_t num_keys;     // 不同key的个数（非唯一索引不计拼接的rid）
+    double fill_factor;   // 叶子的平均填充率
+};
+
 // 这个其实和Rid结构类似
 struct Iid {
     int page_no;
@@ -41,3 +92,60 @@ constexpr int IX_LEAF_HEADER_PAGE = 1;
 constexpr int IX_INIT_ROOT_PAGE = 2;
 constexpr int IX_INIT_NUM_PAGES = 3;
 constexpr int IX_MAX_COL_LEN = 512;
+// key中含有字符串列且长度不小于该值时使用变长key结点
+constexpr int IX_KEY_COMPRESS_MIN_LEN = 16;
+// 变长key结点的字节数低于该值（且key数量低于GetMinSize()）时需要合并或重分配
+constexpr int IX_VAR_MIN_USED = PAGE_SIZE / 4;
+// 乐观读（不加锁、检查版本号）连续失败该次数后改为加读锁查找，避免写密集时读操作饿死
+constexpr int IX_OLC_MAX_RESTARTS = 8;
+
+// 哈希索引每个目录页存放的目录项数
+constexpr int IX_HASH_DIR_SLOTS = PAGE_SIZE / sizeof(page_id_t);
+// 目录最多有2^IX_HASH_MAX_DEPTH项
+constexpr int IX_HASH_MAX_DEPTH = 18;
+constexpr int IX_HASH_MAX_DIR_PAGES = (1 << IX_HASH_MAX_DEPTH) / IX_HASH_DIR_SLOTS;
+constexpr int IX_HASH_INIT_DIR_PAGE = 1;
+constexpr int IX_HASH_INIT_BUCKET_PAGE = 2;
+constexpr int IX_HASH_INIT_NUM_PAGES = 3;
+
+/**
+ * @brief 可扩展哈希索引的file header，存放在第0页
+ * 目录有2^global_depth项，每项是一个bucket的page_no，依次存放在dir_pages中的各个目录页上
+ */
+struct IxHashFileHdr {
+    int num_pages;                      // 文件中的page数
+    int col_num;                        // 索引包含的列数
+    ColType col_types[IX_MAX_COL_NUM];  // 每一列的类型
+    int col_lens[IX_MAX_COL_NUM];       // 每一列的长度
+    int col_len;                        // key的总长度
+    int bucket_capacity;                // 每个bucket最多存放的entry数
+    int global_depth;                   // 目录使用hash值的低global_depth位
+    int num_dir_pages;                  // 目录页的个数
+    page_id_t dir_pages[IX_HASH_MAX_DIR_PAGES];  // 目录页的page_no
+};
+static_assert(sizeof(IxHashFileHdr) <= PAGE_SIZE);
+
+/**
+ * @brief 哈希索引bucket页的页头
+ * 之后是bucket_capacity个1字节的tag（hash值的最高字节，查找时先比较tag），再之后是entry数组，
+ * 每个entry为编码后的key和rid；entry之间没有顺序，删除时用最后一个entry填补空位
+ */
+struct IxHashBucketHdr {
+    int local_depth;  // 该bucket中所有key的hash值的低local_depth位相同
+    int num_entries;
+};
+
+// Bloom filter每个块的字节数（两个块为一个cache line），每个key只在一个块中置位
+constexpr int IX_BLOOM_BLOCK_SIZE = 32;
+// 每个key平均占用的位数，假阳性率约为1%
+constexpr int IX_BLOOM_BITS_PER_KEY = 10;
+// Bloom filter最多的块数（32MB）
+constexpr int IX_BLOOM_MAX_BLOCKS = 1 << 20;
+
+// ART索引的内部结点保存的压缩路径的最大字节数，更长的路径只保存前缀，其余的字节到叶子中比较
+constexpr int IX_ART_MAX_PREFIX = 8;
+
+// 批量建索引时排序器可以使用的内存，超出后排好序的数据写入临时文件
+constexpr size_t IX_SORT_MEMORY = 16 << 20;
+// 批量建索引时每个结点的填充率，留出的空位供之后的插入使用，减少分裂
+constexpr double IX_BULK_LOAD_FILL_FACTOR = 0.9;
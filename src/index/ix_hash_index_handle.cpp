@@ -0,0 +1,292 @@
+#include "ix_hash_index_handle.h"
+
+#include <algorithm>
+#include <thread>
+
+IxHashIndexHandle::IxHashIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
+    : disk_manager_(disk_manager),
+      buffer_pool_manager_(buffer_pool_manager),
+      fd_(fd),
+      hdr_page_(buffer_pool_manager->FetchPage(PageId{.fd = fd, .page_no = IX_FILE_HDR_PAGE})),
+      file_hdr_(*reinterpret_cast<IxHashFileHdr *>(hdr_page_->GetData())) {
+    entry_len_ = file_hdr_.col_len + (int)sizeof(Rid);
+    disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+    // 把目录读入内存
+    dir_.resize(1 << file_hdr_.global_depth);
+    for (int begin = 0; begin < (int)dir_.size(); begin += IX_HASH_DIR_SLOTS) {
+        Page *page = FetchPage(file_hdr_.dir_pages[begin / IX_HASH_DIR_SLOTS]);
+        int num = std::min<int>(IX_HASH_DIR_SLOTS, (int)dir_.size() - begin);
+        memcpy(dir_.data() + begin, page->GetData(), num * sizeof(page_id_t));
+        ReleasePage(page, false);
+    }
+}
+
+/**
+ * @brief 查找key对应的rid
+ *
+ * @param key 原始key
+ * @param result 找到时把rid存入result
+ * @return 是否找到
+ */
+bool IxHashIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    uint64_t hash = ix_hash_key(key, file_hdr_.col_len);
+    Page *bucket = latch_bucket(hash, false);
+    int pos = find_entry(bucket, key, hash);
+    if (pos >= 0) {
+        Rid rid;
+        memcpy(&rid, bucket_entry(bucket, pos) + file_hdr_.col_len, sizeof(Rid));
+        result->push_back(rid);
+    }
+    bucket->RUnlatch();
+    ReleasePage(bucket, false);
+    return pos >= 0;
+}
+
+/**
+ * @brief 插入(key,rid)，key已经存在时不插入
+ * 先只对bucket加写锁插入，bucket已满时再持有目录的写锁分裂bucket
+ *
+ * @param include 哈希索引没有INCLUDE列，忽略
+ * @return 是否插入成功
+ */
+bool IxHashIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                                     const char *include) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    uint64_t hash = ix_hash_key(key, file_hdr_.col_len);
+    Page *bucket = latch_bucket(hash, true);
+    bool exists = find_entry(bucket, key, hash) >= 0;
+    bool fits = bucket_hdr(bucket)->num_entries < file_hdr_.bucket_capacity;
+    if (!exists && fits) {
+        append_entry(bucket, key, value, hash);
+    }
+    bucket->WUnlatch();
+    ReleasePage(bucket, !exists && fits);
+    if (exists || fits) {
+        return !exists;
+    }
+    return insert_split(key, value, hash);
+}
+
+/**
+ * @brief 删除(key,rid)，bucket变空时不合并
+ *
+ * @param value key对应的rid不是value时不删除
+ * @return 是否删除成功
+ */
+bool IxHashIndexHandle::delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    uint64_t hash = ix_hash_key(key, file_hdr_.col_len);
+    Page *bucket = latch_bucket(hash, true);
+    int pos = find_entry(bucket, key, hash);
+    if (pos >= 0 && memcmp(bucket_entry(bucket, pos) + file_hdr_.col_len, &value, sizeof(Rid)) != 0) {
+        pos = -1;
+    }
+    if (pos >= 0) {
+        remove_entry(bucket, pos);
+    }
+    bucket->WUnlatch();
+    ReleasePage(bucket, pos >= 0);
+    return pos >= 0;
+}
+
+/**
+ * @brief 持有目录的读锁找到hash对应的bucket并加锁，然后释放目录的读锁
+ * 分裂bucket的线程持有目录的写锁并对bucket加写锁，因此加锁之后bucket中的内容与目录一致
+ *
+ * @return 加了读锁或写锁的bucket页，需要在外面解锁并unpin
+ */
+Page *IxHashIndexHandle::latch_bucket(uint64_t hash, bool exclusive) {
+    dir_latch_.RLock();
+    Page *bucket = FetchPage(dir_[dir_index(hash)]);
+    if (exclusive) {
+        bucket->WLatch();
+    } else {
+        bucket->RLatch();
+    }
+    dir_latch_.RUnlock();
+    return bucket;
+}
+
+/**
+ * @brief 在bucket中查找编码后的key，先用memchr找tag相同的entry，再比较整个key
+ *
+ * @return entry的下标，不存在时返回-1
+ */
+int IxHashIndexHandle::find_entry(Page *bucket, const char *key, uint64_t hash) const {
+    const uint8_t *tags = bucket_tags(bucket);
+    const uint8_t *end = tags + bucket_hdr(bucket)->num_entries;
+    uint8_t tag = hash_tag(hash);
+    for (const uint8_t *p = tags; p < end; p++) {
+        p = static_cast<const uint8_t *>(memchr(p, tag, end - p));
+        if (p == nullptr) {
+            break;
+        }
+        int pos = (int)(p - tags);
+        if (memcmp(bucket_entry(bucket, pos), key, file_hdr_.col_len) == 0) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+void IxHashIndexHandle::append_entry(Page *bucket, const char *key, const Rid &rid, uint64_t hash) const {
+    auto hdr = bucket_hdr(bucket);
+    assert(hdr->num_entries < file_hdr_.bucket_capacity);
+    bucket_tags(bucket)[hdr->num_entries] = hash_tag(hash);
+    char *entry = bucket_entry(bucket, hdr->num_entries);
+    memcpy(entry, key, file_hdr_.col_len);
+    memcpy(entry + file_hdr_.col_len, &rid, sizeof(Rid));
+    hdr->num_entries++;
+}
+
+// 用最后一个entry填补被删除的entry
+void IxHashIndexHandle::remove_entry(Page *bucket, int pos) const {
+    auto hdr = bucket_hdr(bucket);
+    int last = --hdr->num_entries;
+    if (pos != last) {
+        bucket_tags(bucket)[pos] = bucket_tags(bucket)[last];
+        memcpy(bucket_entry(bucket, pos), bucket_entry(bucket, last), entry_len_);
+    }
+}
+
+/**
+ * @brief 悲观插入：持有目录的写锁，bucket已满时分裂，直到key所在的bucket放得下为止
+ * 其他线程可能在释放目录的读锁之后仍然持有bucket的锁，因此分裂前仍要对bucket加写锁
+ */
+bool IxHashIndexHandle::insert_split(const char *key, const Rid &value, uint64_t hash) {
+    dir_latch_.WLock();
+    while (true) {
+        int index = dir_index(hash);
+        Page *bucket = FetchPage(dir_[index]);
+        bucket->WLatch();
+        auto hdr = bucket_hdr(bucket);
+        if (find_entry(bucket, key, hash) >= 0) {
+            bucket->WUnlatch();
+            ReleasePage(bucket, false);
+            dir_latch_.WUnlock();
+            return false;
+        }
+        if (hdr->num_entries < file_hdr_.bucket_capacity) {
+            append_entry(bucket, key, value, hash);
+            bucket->WUnlatch();
+            ReleasePage(bucket, true);
+            dir_latch_.WUnlock();
+            return true;
+        }
+        if (hdr->local_depth == IX_HASH_MAX_DEPTH) {
+            bucket->WUnlatch();
+            ReleasePage(bucket, false);
+            dir_latch_.WUnlock();
+            throw InternalError("Hash index directory is full");
+        }
+        split_bucket(bucket, index);
+        bucket->WUnlatch();
+        ReleasePage(bucket, true);
+    }
+}
+
+/**
+ * @brief 把bucket分裂为两个：hash值第local_depth位为1的entry移动到新的bucket，
+ * 指向原bucket且下标第local_depth位为1的目录项改为指向新的bucket；local_depth等于global_depth时先把目录加倍
+ *
+ * @param bucket 已满且加了写锁的bucket
+ * @param index 指向该bucket的任意一个目录项的下标
+ * @note 调用者持有目录的写锁
+ */
+void IxHashIndexHandle::split_bucket(Page *bucket, int index) {
+    auto hdr = bucket_hdr(bucket);
+    if (hdr->local_depth == file_hdr_.global_depth) {
+        grow_dir();
+    }
+    int bit = 1 << hdr->local_depth;
+    Page *image = CreatePage();
+    auto image_hdr = bucket_hdr(image);
+    hdr->local_depth++;
+    *image_hdr = {.local_depth = hdr->local_depth, .num_entries = 0};
+    for (int i = 0; i < hdr->num_entries;) {
+        const char *entry = bucket_entry(bucket, i);
+        uint64_t hash = ix_hash_key(entry, file_hdr_.col_len);
+        if (hash & bit) {
+            Rid rid;
+            memcpy(&rid, entry + file_hdr_.col_len, sizeof(Rid));
+            append_entry(image, entry, rid, hash);
+            remove_entry(bucket, i);
+        } else {
+            i++;
+        }
+    }
+    // 低local_depth位与原bucket相同、且第local_depth位为1的目录项，每隔2*bit出现一次
+    int first = (index & (bit - 1)) | bit;
+    int last = first;
+    for (int i = first; i < (int)dir_.size(); i += bit << 1) {
+        dir_[i] = image->GetPageId().page_no;
+        last = i;
+    }
+    write_dir(first, last + 1);
+    ReleasePage(image, true);
+}
+
+/**
+ * @brief 目录加倍：新的一半与原来的一半指向相同的bucket，需要时分配新的目录页
+ */
+void IxHashIndexHandle::grow_dir() {
+    assert(file_hdr_.global_depth < IX_HASH_MAX_DEPTH);
+    int size = (int)dir_.size();
+    dir_.resize(size * 2);
+    std::copy(dir_.begin(), dir_.begin() + size, dir_.begin() + size);
+    while (file_hdr_.num_dir_pages * IX_HASH_DIR_SLOTS < size * 2) {
+        Page *page = CreatePage();
+        file_hdr_.dir_pages[file_hdr_.num_dir_pages++] = page->GetPageId().page_no;
+        ReleasePage(page, true);
+    }
+    file_hdr_.global_depth++;
+    buffer_pool_manager_->MarkDirty(hdr_page_);
+    write_dir(size, size * 2);
+}
+
+/**
+ * @brief 把内存中目录的[begin, end)部分写入对应的目录页
+ */
+void IxHashIndexHandle::write_dir(int begin, int end) {
+    while (begin < end) {
+        int page_idx = begin / IX_HASH_DIR_SLOTS;
+        int page_end = std::min(end, (page_idx + 1) * IX_HASH_DIR_SLOTS);
+        Page *page = FetchPage(file_hdr_.dir_pages[page_idx]);
+        memcpy(page->GetData() + (begin % IX_HASH_DIR_SLOTS) * sizeof(page_id_t), dir_.data() + begin,
+               (page_end - begin) * sizeof(page_id_t));
+        ReleasePage(page, true);
+        begin = page_end;
+    }
+}
+
+Page *IxHashIndexHandle::FetchPage(page_id_t page_no) const {
+    Page *page;
+    // 缓冲池中的页面暂时全部被pin住时，等待其他线程unpin
+    while ((page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no})) == nullptr) {
+        std::this_thread::yield();
+    }
+    return page;
+}
+
+/**
+ * @brief 分配一个新的page（bucket或目录页），内容为全0
+ * @note 只在持有目录的写锁时调用
+ */
+Page *IxHashIndexHandle::CreatePage() {
+    file_hdr_.num_pages++;
+    buffer_pool_manager_->MarkDirty(hdr_page_);
+    PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+    Page *page;
+    while ((page = buffer_pool_manager_->NewPage(&new_page_id)) == nullptr) {
+        std::this_thread::yield();
+    }
+    return page;
+}
+
+void IxHashIndexHandle::ReleasePage(Page *page, bool is_dirty) const {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), is_dirty);
+}
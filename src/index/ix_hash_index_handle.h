@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include "common/rwlatch.h"
+#include "ix_defs.h"
+#include "ix_index.h"
+#include "ix_key.h"
+
+/**
+ * @brief 基于BufferPoolManager的可扩展哈希索引，key唯一，只支持整个key上的等值查询
+ * 目录（每一项是一个bucket的page_no）常驻内存，修改时同步写入目录页，因此一次点查询只访问一个bucket页
+ * 并发控制：dir_latch_保护目录，bucket使用page的读写锁。查询、删除和bucket放得下的插入持有目录的读锁找到bucket，
+ * 对bucket加锁之后就释放目录的读锁；bucket已满时改为持有目录的写锁，分裂bucket（必要时目录加倍）直到放得下为止
+ * bucket变空时不合并，目录也不缩小
+ */
+class IxHashIndexHandle : public IxIndex {
+    friend class IxManager;
+
+   private:
+    DiskManager *disk_manager_;
+    BufferPoolManager *buffer_pool_manager_;
+    int fd_;
+    Page *hdr_page_;           // file header所在的page，索引打开期间一直pin在缓冲池中
+    IxHashFileHdr &file_hdr_;  // 指向hdr_page_中的file header
+    std::vector<page_id_t> dir_;   // 目录在内存中的副本，长度为2^global_depth
+    ReaderWriterLatch dir_latch_;  // 保护dir_以及file_hdr_中的global_depth、num_pages和目录页
+    int entry_len_;                // bucket中每个entry的长度：编码后的key和rid
+
+   public:
+    IxHashIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
+
+    bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) override;
+
+    bool insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                      const char *include = nullptr) override;
+
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction) override;
+
+    /**
+     * @brief 逐列把原始key转换为编码后的key，与B+树使用相同的编码，-0.0与0.0编码相同，等值比较只需要memcmp
+     */
+    const char *normalize_key(const char *key, char *buf) const {
+        int offset = 0;
+        for (int i = 0; i < file_hdr_.col_num; i++) {
+            ix_normalize_key(key + offset, file_hdr_.col_types[i], file_hdr_.col_lens[i], buf + offset);
+            offset += file_hdr_.col_lens[i];
+        }
+        return buf;
+    }
+
+   private:
+    int dir_index(uint64_t hash) const { return (int)(hash & ((1u << file_hdr_.global_depth) - 1)); }
+
+    static uint8_t hash_tag(uint64_t hash) { return (uint8_t)(hash >> 56); }
+
+    // for bucket pages
+    IxHashBucketHdr *bucket_hdr(Page *bucket) const { return reinterpret_cast<IxHashBucketHdr *>(bucket->GetData()); }
+
+    uint8_t *bucket_tags(Page *bucket) const {
+        return reinterpret_cast<uint8_t *>(bucket->GetData() + sizeof(IxHashBucketHdr));
+    }
+
+    char *bucket_entry(Page *bucket, int i) const {
+        return bucket->GetData() + sizeof(IxHashBucketHdr) + file_hdr_.bucket_capacity + i * entry_len_;
+    }
+
+    Page *latch_bucket(uint64_t hash, bool exclusive);
+
+    int find_entry(Page *bucket, const char *key, uint64_t hash) const;
+
+    void append_entry(Page *bucket, const char *key, const Rid &rid, uint64_t hash) const;
+
+    void remove_entry(Page *bucket, int pos) const;
+
+    // for split
+    bool insert_split(const char *key, const Rid &value, uint64_t hash);
+
+    void split_bucket(Page *bucket, int index);
+
+    void grow_dir();
+
+    void write_dir(int begin, int end);
+
+    // for get/create page
+    Page *FetchPage(page_id_t page_no) const;
+
+    Page *CreatePage();
+
+    void ReleasePage(Page *page, bool is_dirty) const;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "defs.h"
+#include "transaction/transaction.h"
+
+/**
+ * @brief 一条延迟到语句结束时才应用的索引修改，由IxChangeBuffer收集，见IxIndex::ApplyChanges()
+ */
+struct IxChange {
+    bool is_insert;       // 插入还是删除(key,rid)
+    Rid rid;
+    std::string key;      // 原始key
+    std::string include;  // 插入时的INCLUDE列的值，没有INCLUDE列时为空
+};
+
+/**
+ * @brief 各种索引的公共接口：按key的点查询以及插入、删除entry
+ * 非唯一索引中一个key可以对应多个rid，GetValue()按rid的顺序返回所有rid，删除时由rid确定要删除的entry
+ * 表上的数据修改和事务回滚只通过该接口维护索引，不需要区分索引的类型；
+ * 范围扫描只有B+树索引（IxIndexHandle）支持，扫描算子按IndexMeta::type使用具体的索引类型
+ * 传入的key都是原始key（多列索引为各列原始值的拼接），由各个索引自己编码
+ */
+class IxIndex {
+   public:
+    virtual ~IxIndex() = default;
+
+    virtual bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) = 0;
+
+    virtual bool insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                              const char *include = nullptr) = 0;
+
+    // 删除(key,rid)；key相同但rid不同的entry不删除
+    virtual bool delete_entry(const char *key, const Rid &value, Transaction *transaction) = 0;
+
+    /**
+     * @brief 批量点查询，对key对应的每个rid向result追加(key在keys中的下标, rid)，返回找到的key的个数
+     * 默认逐个调用GetValue()；B+树索引对排好序的key只下降一次，见IxIndexHandle::BatchLookup()
+     */
+    virtual int BatchLookup(const std::vector<const char *> &keys, std::vector<std::pair<int, Rid>> *result,
+                            Transaction *transaction) {
+        int found = 0;
+        std::vector<Rid> rids;
+        for (int i = 0; i < (int)keys.size(); i++) {
+            rids.clear();
+            if (GetValue(keys[i], &rids, transaction)) {
+                for (auto &rid : rids) {
+                    result->emplace_back(i, rid);
+                }
+                found++;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief 应用一批索引修改，返回实际插入/删除的entry个数；插入已经存在、删除不存在的entry时跳过
+     * 默认先按顺序删除再按顺序插入，使key被修改的唯一索引中，先释放的旧key可以被其他行使用；
+     * B+树索引按key排序后从左到右一遍应用到叶子上，见IxIndexHandle::ApplyChanges()
+     */
+    virtual int ApplyChanges(std::vector<IxChange> &changes, Transaction *transaction) {
+        int applied = 0;
+        for (auto &change : changes) {
+            if (!change.is_insert && delete_entry(change.key.data(), change.rid, transaction)) {
+                applied++;
+            }
+        }
+        for (auto &change : changes) {
+            const char *include = change.include.empty() ? nullptr : change.include.data();
+            if (change.is_insert && insert_entry(change.key.data(), change.rid, transaction, include)) {
+                applied++;
+            }
+        }
+        return applied;
+    }
+};
+
+/**
+ * @brief 一条DML语句对一个索引的修改缓冲：语句执行时只收集(op, key, rid)，语句结束时调用flush()一次性应用
+ * 语句在修改记录之前已经确定了所有要修改的rid，语句内不会通过索引读到自己的修改，
+ * flush()之后事务的后续语句（以及回滚）看到的索引与逐行维护时相同
+ */
+class IxChangeBuffer {
+   private:
+    IxIndex *index_;
+    int key_len_;
+    int include_len_;
+    std::vector<IxChange> changes_;
+
+   public:
+    IxChangeBuffer(IxIndex *index, int key_len, int include_len)
+        : index_(index), key_len_(key_len), include_len_(include_len) {}
+
+    void add_insert(const char *key, const Rid &rid, const char *include) {
+        changes_.push_back(IxChange{true, rid, std::string(key, key_len_), std::string(include, include_len_)});
+    }
+
+    void add_delete(const char *key, const Rid &rid) {
+        changes_.push_back(IxChange{false, rid, std::string(key, key_len_), std::string()});
+    }
+
+    size_t size() const { return changes_.size(); }
+
+    int flush(Transaction *transaction) {
+        if (changes_.empty()) {
+            return 0;
+        }
+        int applied = index_->ApplyChanges(changes_, transaction);
+        changes_.clear();
+        return applied;
+    }
+};
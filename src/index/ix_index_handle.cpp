@@ -1,42 +1,161 @@
 #include "ix_index_handle.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "ix_scan.h"
 
 IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
-    : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
-    // init file_hdr_
-    disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
-    // disk_manager管理的fd对应的文件中，设置从原来编号+1开始分配page_no
-    disk_manager_->set_fd2pageno(fd, disk_manager_->get_fd2pageno(fd) + 1);
+    : disk_manager_(disk_manager),
+      buffer_pool_manager_(buffer_pool_manager),
+      fd_(fd),
+      hdr_page_(buffer_pool_manager->FetchPage(PageId{.fd = fd, .page_no = IX_FILE_HDR_PAGE})),
+      file_hdr_(*reinterpret_cast<IxFileHdr *>(hdr_page_->GetData())) {
+    key_search_ = IxKeySearch::get(file_hdr_.col_len);
+    root_page_no_ = file_hdr_.root_page;
+    // 文件中的page要么在树中，要么在空闲页链表中，新的page_no从num_pages开始分配
+    disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+    if (file_hdr_.bloom_num_blocks > 0) {
+        read_bloom_filter();
+    }
 }
 
 /**
  * @brief 用于查找指定键所在的叶子结点
+ * FIND和乐观的写操作：读锁逐层向下，孩子结点加锁之后才释放父结点；写操作最后只对叶子结点加写锁，
+ * 返回时不持有其他结点的锁
+ * 悲观的写操作：写锁逐层向下，当前结点安全时释放page_set中的所有祖先结点，
+ * 返回时叶子结点和仍被锁住的祖先结点都在事务的page_set中
  *
- * @param key 要查找的目标key值
+ * @param key 要查找的目标key值（编码后的key）
  * @param operation 查找到目标键值对后要进行的操作类型
- * @param transaction 事务参数，如果不需要则默认传入nullptr
+ * @param transaction 事务参数，FIND和乐观的写操作不需要，可以传入nullptr
+ * @param optimistic 写操作是否只对叶子结点加写锁
  * @return 返回目标叶子结点
- * @note need to Unpin the leaf node outside!
+ * @note FIND和乐观的写操作需要在外面解锁并unpin叶子结点，悲观的写操作由ReleasePageSet()统一释放
  */
-IxNodeHandle *IxIndexHandle::FindLeafPage(const char *key, Operation operation, Transaction *transaction) {
+IxNodeHandle *IxIndexHandle::FindLeafPage(const char *key, Operation operation, Transaction *transaction,
+                                          bool optimistic) {
     // Todo:
     // 1. 获取根节点
     // 2. 从根节点开始不断向下查找目标key
     // 3. 找到包含该key值的叶子结点停止查找，并返回叶子节点
-    page_id_t rootpageno = file_hdr_.root_page;
-    page_id_t pageno;
-    IxNodeHandle *now = FetchNode(rootpageno);
-    //只要还不是叶子节点,就在内部节点一路往下找
-    while (!now->page_hdr->is_leaf) {
-        pageno = now->InternalLookup(key);
-        // buffer_pool_manager_->UnpinPage(now->GetPageId(), false);  //是要unpin吗
-        now = FetchNode(pageno);
+    if (operation == Operation::FIND || optimistic) {
+        if (!file_hdr_.key_compress) {
+            for (int restart = 0; restart < IX_OLC_MAX_RESTARTS; restart++) {
+                IxNodeHandle *leaf = FindLeafOptimistic(key, operation, nullptr);
+                if (leaf != nullptr) {
+                    return leaf;
+                }
+            }
+        }
+        bool write_leaf = operation != Operation::FIND;
+        root_latch_.lock();
+        IxNodeHandle *node = FetchNode(file_hdr_.root_page);
+        node->page->RLatch();
+        if (write_leaf && node->IsLeafPage()) {
+            // 持有root_latch_时根结点不会被替换，可以把读锁换成写锁
+            node->page->RUnlatch();
+            node->page->WLatch();
+        }
+        root_latch_.unlock();
+        while (!node->IsLeafPage()) {
+            IxNodeHandle *child = FetchNode(node->InternalLookup(key));
+            child->page->RLatch();
+            if (write_leaf && child->IsLeafPage()) {
+                // 持有父结点的读锁时叶子结点不会被分裂或合并，可以把读锁换成写锁
+                child->page->RUnlatch();
+                child->page->WLatch();
+            }
+            node->page->RUnlatch();
+            ReleaseNode(node, false);
+            node = child;
+        }
+        return node;
+    }
+
+    root_latch_.lock();
+    transaction->AddIntoPageSet(nullptr);
+    IxNodeHandle *node = FetchNode(file_hdr_.root_page);
+    node->page->WLatch();
+    while (true) {
+        if (IsSafe(node, key, operation)) {
+            // 当前结点不会分裂/合并，也不会修改父结点中的key，祖先结点不会再被修改
+            ReleasePageSet(transaction);
+        }
+        transaction->AddIntoPageSet(node->page);
+        if (node->IsLeafPage()) {
+            return node;
+        }
+        IxNodeHandle *child = FetchNode(node->InternalLookup(key));
+        child->page->WLatch();
+        delete node;  // page仍然在page_set中，由ReleasePageSet()解锁并unpin
+        node = child;
     }
-    //现在它是叶子节点了
-    // transaction->AddIntoPageSet(buffer_pool_manager_->FetchPage(now->GetPageId()));
-    //如果是删除操作,就要加锁
-    return now;
+}
+
+/**
+ * @brief optimistic lock coupling：不加锁地从根结点向下查找key所在的叶子结点
+ * 每个结点先读出版本号再读内容，读完后检查版本号没有变化；孩子结点pin住并读出版本号之后再检查父结点，
+ * 保证孩子结点仍然是key所在的子树。版本号为奇数（正在被写）或者发生变化时放弃本次查找，由调用者重新开始
+ * 只用于定长key结点：变长key结点的内容被并发修改时，按其中的长度读key可能越界
+ *
+ * @param key 要查找的目标key值（编码后的key）
+ * @param operation FIND时对叶子结点加读锁，INSERT/DELETE时加写锁
+ * @param[out] leaf_version 不为nullptr时不对叶子结点加锁，传出叶子结点的版本号，调用者读完叶子之后自己检查
+ * @return 叶子结点，需要在外面解锁（如果加了锁）并unpin；查找失败时返回nullptr
+ */
+IxNodeHandle *IxIndexHandle::FindLeafOptimistic(const char *key, Operation operation, uint64_t *leaf_version) {
+    page_id_t root_no = root_page_no_.load(std::memory_order_acquire);
+    IxNodeHandle *node = FetchNode(root_no);
+    uint64_t version = node->page->ReadVersion();
+    // 读出版本号之后根结点没有被替换，node就是包含key的子树
+    if (Page::IsWriteLocked(version) || root_page_no_.load(std::memory_order_acquire) != root_no) {
+        ReleaseNode(node, false);
+        return nullptr;
+    }
+    while (true) {
+        bool is_leaf = node->IsLeafPage();
+        page_id_t child_no = is_leaf ? IX_NO_PAGE : node->InternalLookup(key);
+        if (!node->page->ValidateVersion(version)) {
+            ReleaseNode(node, false);
+            return nullptr;
+        }
+        if (is_leaf) {
+            break;
+        }
+        IxNodeHandle *child = FetchNode(child_no);
+        uint64_t child_version = child->page->ReadVersion();
+        bool valid = !Page::IsWriteLocked(child_version) && node->page->ValidateVersion(version);
+        ReleaseNode(node, false);
+        if (!valid) {
+            ReleaseNode(child, false);
+            return nullptr;
+        }
+        node = child;
+        version = child_version;
+    }
+
+    if (leaf_version != nullptr) {
+        *leaf_version = version;
+        return node;
+    }
+    // 加锁之后叶子结点没有被修改过，才仍然是key所在的结点；自己加写锁会使版本号加1
+    if (operation == Operation::FIND) {
+        node->page->RLatch();
+        if (node->page->ValidateVersion(version)) {
+            return node;
+        }
+        node->page->RUnlatch();
+    } else {
+        node->page->WLatch();
+        if (node->page->ValidateVersion(version + 1)) {
+            return node;
+        }
+        node->page->WUnlatch();
+    }
+    ReleaseNode(node, false);
+    return nullptr;
 }
 
 /**
@@ -48,55 +167,316 @@ IxNodeHandle *IxIndexHandle::FindLeafPage(const char *key, Operation operation,
  * @return bool 返回目标键值对是否存在
  */
 bool IxIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf);
+    if (!MayContain(key)) {
+        return false;  // Bloom filter排除的key一定不在树中，不访问任何page
+    }
     // Todo:
     // 1. 获取目标key值所在的叶子结点
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
     // 3. 把rid存入result参数中
-    // TODO 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
+    if (!file_hdr_.unique) {
+        return GetPostings(key, result, transaction);
+    }
+    if (!file_hdr_.key_compress) {
+        // 乐观读：叶子结点也不加锁，读完之后检查版本号
+        for (int restart = 0; restart < IX_OLC_MAX_RESTARTS; restart++) {
+            uint64_t version;
+            IxNodeHandle *leaf = FindLeafOptimistic(key, Operation::FIND, &version);
+            if (leaf == nullptr) {
+                continue;
+            }
+            Rid *value;
+            bool flag = leaf->LeafLookup(key, &value);
+            Rid rid = flag ? *value : Rid{};
+            bool valid = leaf->page->ValidateVersion(version);
+            ReleaseNode(leaf, false);
+            if (valid) {
+                if (flag) result->push_back(rid);
+                return flag;
+            }
+        }
+    }
     IxNodeHandle *leaf = FindLeafPage(key, Operation::FIND, transaction);
-    Rid **value = new (Rid *);
-    bool flag = leaf->LeafLookup(key, value);
-    if (flag) result->push_back(**value);
-    // delete value;
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);  //这里也是unpin吗
+    Rid *value;
+    bool flag = leaf->LeafLookup(key, &value);
+    if (flag) result->push_back(*value);
+    leaf->page->RUnlatch();
+    ReleaseNode(leaf, false);
     return flag;
 }
 
+/**
+ * @brief 非唯一索引：按rid的顺序取出key对应的所有rid，这些entry在叶子中是连续的
+ * 一次只对一个叶子加读锁。entry延续到下一个叶子时，先记下当前叶子的版本号再解锁，对下一个叶子加锁后检查
+ * 当前叶子没有被修改过（下一个叶子被删除或合并时都会修改当前叶子），否则从最后取出的(key,rid)之后重新查找
+ *
+ * @param key 编码后的key，拼接在后面的rid部分为0
+ */
+bool IxIndexHandle::GetPostings(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    int key_len = file_hdr_.col_len - static_cast<int>(sizeof(Rid));
+    size_t begin = result->size();
+    char entry_key[IX_MAX_COL_LEN];
+    IxNodeHandle *leaf = FindLeafPage(key, Operation::FIND, transaction);
+    int pos = leaf->lower_bound(key);
+    while (true) {
+        bool done = false;
+        for (; pos < leaf->GetSize(); pos++) {
+            leaf->read_key(pos, entry_key);
+            if (memcmp(entry_key, key, key_len) != 0) {
+                done = true;
+                break;
+            }
+            result->push_back(*leaf->get_rid(pos));
+        }
+        if (done || leaf->GetNextLeaf() == IX_LEAF_HEADER_PAGE) {
+            break;
+        }
+        uint64_t version = leaf->page->ReadVersion();
+        page_id_t next_no = leaf->GetNextLeaf();
+        leaf->page->RUnlatch();
+        IxNodeHandle *next = FetchNode(next_no);
+        next->page->RLatch();
+        bool valid = leaf->page->ValidateVersion(version);
+        ReleaseNode(leaf, false);
+        leaf = next;
+        pos = 0;
+        if (!valid) {
+            leaf->page->RUnlatch();
+            ReleaseNode(leaf, false);
+            memcpy(entry_key, key, key_len);
+            if (result->size() > begin) {
+                ix_normalize_rid(result->back(), entry_key + key_len);
+            } else {
+                memset(entry_key + key_len, 0, sizeof(Rid));
+            }
+            leaf = FindLeafPage(entry_key, Operation::FIND, transaction);
+            pos = leaf->lower_bound(entry_key);
+            if (result->size() > begin && pos < leaf->GetSize() && leaf->compare_key(pos, entry_key) == 0) {
+                pos++;  // 跳过已经取出的最后一个entry
+            }
+        }
+    }
+    leaf->page->RUnlatch();
+    ReleaseNode(leaf, false);
+    return result->size() > begin;
+}
+
+/**
+ * @brief 批量查找一组key，用于索引嵌套循环连接和IN列表
+ * 按key的升序依次查找，保留从根结点到当前叶子的整条路径（持有读锁并pin住）：
+ * 下一个key仍在当前叶子中时直接在叶子中查找，否则只回退到仍然包含该key的最深的祖先结点再向下查找，
+ * 相邻的key落在同一个或相邻的叶子时，每个key只需访问一个结点
+ * 非唯一索引按(key, rid=0)下降，再从叶子开始向右取出该key的所有rid，见CollectPostings()
+ *
+ * @param keys 原始key，已经按升序排列时不再排序
+ * @param result 对每个存在的key，按key的升序追加(key在keys中的下标, rid)
+ * @param transaction 事务指针
+ * @return 找到的key的个数
+ * @note 整个批量查找期间持有路径上结点的读锁，路径上的叶子不能被修改，调用者应控制每批key的数量
+ */
+int IxIndexHandle::BatchLookup(const std::vector<const char *> &keys, std::vector<std::pair<int, Rid>> *result,
+                               Transaction *transaction) {
+    if (keys.empty()) {
+        return 0;
+    }
+    int col_len = file_hdr_.col_len;
+    std::vector<char> key_buf(keys.size() * col_len);
+    for (size_t i = 0; i < keys.size(); i++) {
+        normalize_key(keys[i], key_buf.data() + i * col_len);
+    }
+    auto key_at = [&](int i) { return key_buf.data() + i * col_len; };
+    // 只查找Bloom filter没有排除的key，全部被排除时不访问任何page
+    std::vector<int> order;
+    for (int i = 0; i < (int)keys.size(); i++) {
+        if (MayContain(key_at(i))) {
+            order.push_back(i);
+        }
+    }
+    if (order.empty()) {
+        return 0;
+    }
+    auto key_less = [&](int a, int b) { return memcmp(key_at(a), key_at(b), col_len) < 0; };
+    if (!std::is_sorted(order.begin(), order.end(), key_less)) {
+        std::stable_sort(order.begin(), order.end(), key_less);
+    }
+
+    // path[0]为根结点，path.back()为当前叶子；child_idx[l]为path[l+1]在path[l]中的下标
+    std::vector<IxNodeHandle *> path;
+    std::vector<int> child_idx;
+    root_latch_.lock();
+    path.push_back(FetchNode(file_hdr_.root_page));
+    path.back()->page->RLatch();
+    root_latch_.unlock();
+    int found = 0;
+    for (int i : order) {
+        const char *key = key_at(i);
+        // 结点的key上界是最近的有右兄弟的祖先中，右兄弟在父结点中的key；key已经大于等于上一个key，只需检查上界
+        int keep = (int)path.size() - 1;
+        for (int l = keep; l > 0; l--) {
+            IxNodeHandle *parent = path[l - 1];
+            int next = child_idx[l - 1] + 1;
+            if (next == parent->GetSize()) {
+                continue;  // path[l]是最右边的孩子，上界与parent相同
+            }
+            if (parent->compare_key(next, key) > 0) {
+                break;
+            }
+            keep = l - 1;
+        }
+        while ((int)path.size() > keep + 1) {
+            path.back()->page->RUnlatch();
+            ReleaseNode(path.back(), false);
+            path.pop_back();
+            child_idx.pop_back();
+        }
+        while (!path.back()->IsLeafPage()) {
+            IxNodeHandle *node = path.back();
+            int idx = std::max(node->upper_bound(key) - 1, 0);
+            IxNodeHandle *child = FetchNode(node->ValueAt(idx));
+            child->page->RLatch();
+            child_idx.push_back(idx);
+            path.push_back(child);
+        }
+        if (!file_hdr_.unique) {
+            found += CollectPostings(path.back(), key, i, result);
+            continue;
+        }
+        Rid *rid;
+        if (path.back()->LeafLookup(key, &rid)) {
+            result->emplace_back(i, *rid);
+            found++;
+        }
+    }
+    while (!path.empty()) {
+        path.back()->page->RUnlatch();
+        ReleaseNode(path.back(), false);
+        path.pop_back();
+    }
+    return found;
+}
+
+/**
+ * @brief BatchLookup()中的非唯一索引：从当前叶子开始按rid的顺序取出key的所有rid，entry可能延续到右边的多个叶子
+ * 调用者一直持有根结点的读锁，分裂、合并等改变树结构的修改都要从根结点开始加写锁，因此期间叶子链表不会改变，
+ * 右边的叶子只需在读取时加读锁，不需要像GetPostings()那样检查版本号
+ *
+ * @param leaf 已经加读锁的叶子，其中包含(key, rid=0)的位置
+ * @param key 编码后的key，拼接在后面的rid部分为0
+ * @param key_idx key在BatchLookup()的keys中的下标
+ * @return key是否存在
+ */
+bool IxIndexHandle::CollectPostings(IxNodeHandle *leaf, const char *key, int key_idx,
+                                    std::vector<std::pair<int, Rid>> *result) {
+    int key_len = file_hdr_.col_len - static_cast<int>(sizeof(Rid));
+    size_t begin = result->size();
+    char entry_key[IX_MAX_COL_LEN];
+    IxNodeHandle *node = leaf;
+    int pos = leaf->lower_bound(key);
+    while (true) {
+        for (; pos < node->GetSize(); pos++) {
+            node->read_key(pos, entry_key);
+            if (memcmp(entry_key, key, key_len) != 0) {
+                break;
+            }
+            result->emplace_back(key_idx, *node->get_rid(pos));
+        }
+        page_id_t next_no = node->GetNextLeaf();
+        bool more = pos == node->GetSize() && next_no != IX_LEAF_HEADER_PAGE;
+        if (node != leaf) {
+            node->page->RUnlatch();
+            ReleaseNode(node, false);
+        }
+        if (!more) {
+            break;
+        }
+        node = FetchNode(next_no);
+        node->page->RLatch();
+        pos = 0;
+    }
+    return result->size() > begin;
+}
+
 /**
  * @brief 将指定键值对插入到B+树中
  *
  * @param (key, value) 要插入的键值对
  * @param transaction 事务指针
- * @return 是否插入成功
+ * @param include 与rid一起存放在叶子中的INCLUDE列的值（长度为file_hdr_.include_len），没有INCLUDE列时为空
+ * @return 是否插入成功：唯一索引中key已经存在、非唯一索引中(key,rid)已经存在时不插入
  */
-bool IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+bool IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction, const char *include) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf, &value);
+    // 先加入Bloom filter再修改树，查询在树中能找到的key不会被filter排除；插入失败时只多一个假阳性
+    bloom_add(key);
     // Todo:
     // 1. 查找key值应该插入到哪个叶子节点
     // 2. 在该叶子节点中插入键值对
     // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
-    // TODO：记得unpin page；若当前叶子节点是最右叶子节点，则需要更新file_hdr_.last_leaf；记得处理并发的上锁
-    std::scoped_lock lock{root_latch_};
+    // 乐观插入：叶子结点插入后不分裂、且第一个key不变时，只需要叶子结点的写锁
+    IxNodeHandle *leaf = FindLeafPage(key, Operation::INSERT, transaction, true);
+    Rid *exist;
+    bool safe = IsSafe(leaf, key, Operation::INSERT);
+    bool found = leaf->LeafLookup(key, &exist);
+    if (found || safe) {
+        if (!found) {
+            leaf->Insert(key, value, include);
+        }
+        leaf->page->WUnlatch();
+        ReleaseNode(leaf, !found);
+        return !found;
+    }
+    leaf->page->WUnlatch();
+    ReleaseNode(leaf, false);
+    return InsertPessimistic(key, value, include, transaction);
+}
+
+/**
+ * @brief 悲观插入：从根结点开始加写锁，叶子结点需要分裂或者第一个key改变时使用
+ *
+ * @param key 编码后的key
+ */
+bool IxIndexHandle::InsertPessimistic(const char *key, const Rid &value, const char *include,
+                                      Transaction *transaction) {
+    Transaction local_txn(INVALID_TXN_ID);
+    if (transaction == nullptr) {
+        transaction = &local_txn;
+    }
     IxNodeHandle *leaf = FindLeafPage(key, Operation::INSERT, transaction);
-    int before_insert = leaf->page_hdr->num_key;
-    int after_insert = leaf->Insert(key, value);
-    if(leaf->page_hdr->next_leaf==1)file_hdr_.last_leaf=leaf->GetPageNo();
-    if (after_insert>before_insert) {
-        //如果插入成功,但是叶子节点满了,就要分裂
-        if (leaf->page_hdr->num_key == leaf->GetMaxSize()) {
-            //分裂
-            IxNodeHandle *newleaf = Split(leaf);
-            //更新父节点
-            InsertIntoParent(leaf, newleaf->keys, newleaf, transaction);
-            if (newleaf->page_hdr->next_leaf == 1) {
-            file_hdr_.last_leaf = newleaf->GetPageNo();
-            // disk_manager_->write_page(fd_, IX_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+    Rid *exist;
+    bool inserted;
+    if (file_hdr_.key_compress) {
+        // 变长key结点的容量取决于key的长度，先判断放不放得下，放不下时连同新entry一起分裂
+        inserted = !leaf->LeafLookup(key, &exist);
+        if (inserted) {
+            if (leaf->can_insert(key)) {
+                leaf->Insert(key, value, include);
+            } else {
+                SplitInsert(leaf, leaf->lower_bound(key), key, value, include, transaction);
+            }
+        }
+    } else {
+        int before_insert = leaf->GetSize();
+        int after_insert = leaf->Insert(key, value, include);
+        inserted = after_insert > before_insert;
+        if (inserted) {
+            if (leaf->compare_key(0, key) == 0) {
+                // 插入到了叶子结点的最前面，更新祖先结点中的key
+                maintain_parent(leaf);
+            }
+            //如果插入成功,但是叶子节点满了,就要分裂
+            if (after_insert == leaf->GetMaxSize()) {
+                IxNodeHandle *newleaf = Split(leaf);
+                InsertIntoParent(leaf, newleaf->get_key(0), newleaf, transaction);
+                ReleaseNode(newleaf, true);
             }
-            buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
-            buffer_pool_manager_->UnpinPage(newleaf->GetPageId(), true);
         }
-        return true;
     }
-    return false;
+    delete leaf;
+    ReleasePageSet(transaction);
+    return inserted;
 }
 
 /**
@@ -105,6 +485,7 @@ bool IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction
  * @param node 需要拆分的结点
  * @return 拆分得到的new_node
  * @note 本函数执行完毕后，原node和new node都需要在函数外面进行unpin
+ * @note new node在node解锁之前无法被其他线程访问到，因此不需要加锁
  */
 IxNodeHandle *IxIndexHandle::Split(IxNodeHandle *node) {
     // 1. 将原结点的键值对平均分配，右半部分分裂为新的右兄弟结点
@@ -125,15 +506,32 @@ IxNodeHandle *IxIndexHandle::Split(IxNodeHandle *node) {
         new_node->set_key(i,node->get_key(mid+i));
         new_node->set_rid(i,*node->get_rid(mid+i));
     }
+    memcpy(new_node->get_include(0), node->get_include(mid), new_node->page_hdr->num_key * file_hdr_.include_len);
+    link_split_node(node, new_node);
+    return new_node;
+}
+
+/**
+ * @brief 分裂后把new_node接入树中：叶子结点接入叶子链表，内部结点更新所有孩子的父结点
+ */
+void IxIndexHandle::link_split_node(IxNodeHandle *node, IxNodeHandle *new_node) {
     if (node->page_hdr->is_leaf) {
         //如果是叶子节点
         new_node->page_hdr->next_leaf = node->page_hdr->next_leaf;
         new_node->page_hdr->prev_leaf = node->GetPageNo();
         node->page_hdr->next_leaf = new_node->GetPageNo();
         if (new_node->page_hdr->next_leaf != INVALID_PAGE_ID) {
+            // 叶子链表上总是从左向右加锁，不会与其他线程形成环路
             IxNodeHandle *next = FetchNode(new_node->page_hdr->next_leaf);
+            next->page->WLatch();
             next->page_hdr->prev_leaf = new_node->GetPageNo();
-            buffer_pool_manager_->UnpinPage(next->GetPageId(), true);  //?
+            next->page->WUnlatch();
+            ReleaseNode(next, true);
+        }
+        if (new_node->page_hdr->next_leaf == IX_LEAF_HEADER_PAGE) {
+            std::scoped_lock lock{hdr_latch_};
+            file_hdr_.last_leaf = new_node->GetPageNo();
+            mark_hdr_dirty();
         }
     } else {
         // 如果不是
@@ -143,8 +541,126 @@ IxNodeHandle *IxIndexHandle::Split(IxNodeHandle *node) {
             maintain_child(new_node, i);
         }
     }
+}
 
-    return new_node;
+/**
+ * @brief 变长key结点放不下新entry时，连同新entry一起分裂
+ * 结点的容量取决于key的长度，不能像定长结点那样先插入再分裂，因此先取出所有entry，选好划分位置后重写两个结点
+ *
+ * @param pos 新entry在node中的位置
+ */
+void IxIndexHandle::SplitInsert(IxNodeHandle *node, int pos, const char *key, const Rid &rid, const char *include,
+                                Transaction *transaction) {
+    IxEntryList entries(&file_hdr_);
+    entries.append(node, 0, pos);
+    entries.push_back(key, rid, include);
+    entries.append(node, pos, node->GetSize());
+    SplitEntries(node, entries, transaction);
+}
+
+/**
+ * @brief 把entries分到node和新的右兄弟结点中，并把分隔key插入父结点
+ * 叶子结点的分隔key取满足 左边最后一个key < sep <= 右边第一个key 的最短key（后缀截断），
+ * 内部结点的分隔key就是右边的第一个key，原样上移
+ */
+void IxIndexHandle::SplitEntries(IxNodeHandle *node, const IxEntryList &entries, Transaction *transaction) {
+    bool is_leaf = node->IsLeafPage();
+    int mid = choose_split(entries, is_leaf);
+    char sep[IX_MAX_COL_LEN];
+    if (is_leaf) {
+        ix_separator(entries.key(mid - 1), entries.key(mid), file_hdr_.col_len, sep);
+    } else {
+        memcpy(sep, entries.key(mid), file_hdr_.col_len);
+    }
+    IxNodeHandle *new_node = CreateNode();
+    new_node->page_hdr->is_leaf = is_leaf;
+    new_node->page_hdr->parent = node->page_hdr->parent;
+    new_node->page_hdr->next_free_page_no = node->page_hdr->next_free_page_no;
+    node->rebuild(entries, 0, mid);
+    new_node->rebuild(entries, mid, entries.size());
+    link_split_node(node, new_node);
+    InsertIntoParent(node, sep, new_node, transaction);
+    ReleaseNode(new_node, true);
+}
+
+/**
+ * @brief 变长key结点分裂/重分配时选择划分位置mid：[0,mid)放在左结点，[mid,n)放在右结点
+ * 两边都要放得下，叶子至少有1个entry、内部结点至少有2个孩子；在此前提下优先选两边都不需要合并的位置，
+ * 再使两边的字节数尽量接近；叶子结点在接近均分的位置中选分隔key最短的，使父结点中的分隔key尽可能短
+ */
+int IxIndexHandle::choose_split(const IxEntryList &entries, bool is_leaf) const {
+    constexpr int window = PAGE_SIZE / 16;  // 为缩短分隔key允许的两边字节数之差的增加量
+    int n = entries.size();
+    int min_size = is_leaf ? 1 : 2;
+    int half_size = (file_hdr_.btree_order + 1) / 2;
+    auto underflow = [&](int size, int bytes) { return size < half_size && bytes < IX_VAR_MIN_USED; };
+    std::vector<int> diff(n + 1, -1);
+    std::vector<bool> balanced(n + 1, false);
+    int best = -1;
+    for (int mid = min_size; mid <= n - min_size; mid++) {
+        if (mid > file_hdr_.btree_order || n - mid > file_hdr_.btree_order) {
+            continue;
+        }
+        int left = entries.encoded_size(is_leaf, 0, mid);
+        int right = entries.encoded_size(is_leaf, mid, n);
+        if (left > PAGE_SIZE || right > PAGE_SIZE) {
+            continue;
+        }
+        diff[mid] = std::abs(left - right);
+        balanced[mid] = !underflow(mid, left) && !underflow(n - mid, right);
+        if (best < 0 || (balanced[mid] && !balanced[best]) ||
+            (balanced[mid] == balanced[best] && diff[mid] < diff[best])) {
+            best = mid;
+        }
+    }
+    if (best < 0) {
+        throw InternalError("IxIndexHandle::choose_split: entries do not fit in two nodes");
+    }
+    if (!is_leaf) {
+        return best;
+    }
+    int chosen = best;
+    int chosen_len = ix_separator_len(entries.key(best - 1), entries.key(best), file_hdr_.col_len);
+    for (int mid = min_size; mid <= n - min_size; mid++) {
+        if (diff[mid] < 0 || balanced[mid] != balanced[best] || diff[mid] > diff[best] + window) {
+            continue;
+        }
+        int len = ix_separator_len(entries.key(mid - 1), entries.key(mid), file_hdr_.col_len);
+        if (len < chosen_len || (len == chosen_len && diff[mid] < diff[chosen])) {
+            chosen = mid;
+            chosen_len = len;
+        }
+    }
+    return chosen;
+}
+
+/**
+ * @brief 按顺序取出左右两个兄弟结点的所有entry
+ * 内部结点的第一个key在查找中不会被用到，不一定是有效的分隔key，右结点的第一个key取父结点中的分隔key
+ */
+void IxIndexHandle::collect_siblings(IxEntryList *entries, IxNodeHandle *left, IxNodeHandle *right,
+                                     IxNodeHandle *parent, int right_rank) const {
+    entries->append(left, 0, left->GetSize());
+    entries->append(right, 0, right->GetSize());
+    if (!left->IsLeafPage()) {
+        char sep[IX_MAX_COL_LEN];
+        parent->read_key(right_rank, sep);
+        entries->set_key(left->GetSize(), sep);
+    }
+}
+
+/**
+ * @brief 把parent中第rank个分隔key换成key，变长的分隔key可能变长，放不下时分裂parent
+ */
+void IxIndexHandle::replace_separator(IxNodeHandle *parent, int rank, const char *key, Transaction *transaction) {
+    if (parent->can_replace_key(rank, key)) {
+        parent->set_key(rank, key);
+        return;
+    }
+    IxEntryList entries(&file_hdr_);
+    entries.append(parent, 0, parent->GetSize());
+    entries.set_key(rank, key);
+    SplitEntries(parent, entries, transaction);
 }
 
 /**
@@ -177,76 +693,194 @@ void IxIndexHandle::InsertIntoParent(IxNodeHandle *old_node, const char *key, Ix
         new_root->page_hdr->parent = INVALID_PAGE_ID;
         new_root->page_hdr->next_leaf = INVALID_PAGE_ID;
         new_root->page_hdr->prev_leaf = INVALID_PAGE_ID;   
-        // new_root->Insert(old_node->get_key(0), *old_node->get_rid(0)); // FIXED：因为不是传子节点的子树，而是把子节点当子树
-        // new_root->Insert(new_node->get_key(0), *new_node->get_rid(0)); 
-        new_root->set_key(0,old_node->get_key(0));
-        new_root->set_rid(0,Rid{old_node->GetPageNo(),-1});
-        new_root->set_key(1,new_node->get_key(0));
-        new_root->set_rid(1,Rid{new_node->GetPageNo(),-1});
-        new_root->page_hdr->num_key=2;
+        if (file_hdr_.key_compress) {
+            // 变长key结点只用分隔key查找，最左边孩子的key不会被用到，存为最短的全0的key
+            char zero_key[IX_MAX_COL_LEN] = {};
+            new_root->var_reset();
+            new_root->insert_pair(0, zero_key, Rid{old_node->GetPageNo(), -1});
+            new_root->insert_pair(1, key, Rid{new_node->GetPageNo(), -1});
+        } else {
+            // new_root->Insert(old_node->get_key(0), *old_node->get_rid(0)); // FIXED：因为不是传子节点的子树，而是把子节点当子树
+            // new_root->Insert(new_node->get_key(0), *new_node->get_rid(0)); 
+            new_root->set_key(0,old_node->get_key(0));
+            new_root->set_rid(0,Rid{old_node->GetPageNo(),-1});
+            new_root->set_key(1,new_node->get_key(0));
+            new_root->set_rid(1,Rid{new_node->GetPageNo(),-1});
+            new_root->page_hdr->num_key=2;
+        }
         //将old_node和new_node的父节点设置为new_root
         maintain_child(new_root, 0);
         maintain_child(new_root, 1);
-        file_hdr_.root_page = new_root->GetPageNo();
-        // disk_manager_->write_page(fd_, IX_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
-        buffer_pool_manager_->UnpinPage(new_root->GetPageId(), true);
+        // 根结点分裂说明它对本次插入不安全，此时一定持有root_latch_
+        UpdateRootPageNo(new_root->GetPageNo());
+        ReleaseNode(new_root, true);
     } else {
         //如果old_node不是根节点,则直接在其父节点中插入key
+        //old_node需要分裂说明它不安全，其父结点的写锁仍在page_set中，这里不需要再加锁
         IxNodeHandle *parent = FetchNode(old_node->page_hdr->parent);
+        if (file_hdr_.key_compress) {
+            // 分隔key插入在指向old_node的孩子指针之后，放不下时连同它一起分裂父结点
+            int pos = parent->find_child(old_node) + 1;
+            Rid rid{new_node->GetPageNo(), -1};
+            if (parent->can_insert(key)) {
+                parent->insert_pair(pos, key, rid);
+            } else {
+                SplitInsert(parent, pos, key, rid, nullptr, transaction);
+            }
+            ReleaseNode(parent, true);
+            return;
+        }
         parent->Insert(new_node->get_key(0),Rid{new_node->GetPageNo(),-1});
-        // if (old_node->page_hdr->next_free_page_no == INVALID_PAGE_ID) {
-        //     file_hdr_.last_leaf = new_node->GetPageNo();
-        //     disk_manager_->write_page(fd_, IX_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
-        // }
         //如果父节点满了,就要分裂
         if (parent->page_hdr->num_key == new_node->GetMaxSize()) {
             IxNodeHandle *newparent = Split(parent);
             //更新根节点
             InsertIntoParent(parent, newparent->keys, newparent, transaction);
+            ReleaseNode(newparent, true);
         }
-        buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
+        ReleaseNode(parent, true);
     }
 }
 
 /**
- * @brief 用于删除B+树中含有指定key的键值对
+ * @brief 用于删除B+树中的键值对(key,value)
  *
  * @param key 要删除的key值
+ * @param value key对应的rid；唯一索引中key对应的rid不是value时不删除
  * @param transaction 事务指针
  * @return 是否删除成功
  */
-bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
+bool IxIndexHandle::delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+    char key_buf[IX_MAX_COL_LEN];
+    key = normalize_key(key, key_buf, &value);
     // Todo:
     // 1. 获取该键值对所在的叶子结点
     // 2. 在该叶子结点中删除键值对
     // 3. 如果删除成功且删除后该结点小于半满，需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
     // 4. 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
+    // 乐观删除：叶子结点删除后不会小于半满、且第一个key不变时，只需要叶子结点的写锁
+    IxNodeHandle *leaf = FindLeafPage(key, Operation::DELETE, transaction, true);
+    Rid *exist;
+    bool safe = IsSafe(leaf, key, Operation::DELETE);
+    bool found = leaf->LeafLookup(key, &exist) && *exist == value;
+    if (!found || safe) {
+        if (found) {
+            leaf->Remove(key);
+        }
+        leaf->page->WUnlatch();
+        ReleaseNode(leaf, found);
+        return found;
+    }
+    leaf->page->WUnlatch();
+    ReleaseNode(leaf, false);
+    return DeletePessimistic(key, value, transaction);
+}
 
-    std::scoped_lock lock{root_latch_};
-    //获取叶子结点
+/**
+ * @brief 悲观删除：从根结点开始加写锁，叶子结点需要合并/重分配或者第一个key改变时使用
+ *
+ * @param key 编码后的key
+ */
+bool IxIndexHandle::DeletePessimistic(const char *key, const Rid &value, Transaction *transaction) {
+    Transaction local_txn(INVALID_TXN_ID);
+    if (transaction == nullptr) {
+        transaction = &local_txn;
+    }
     IxNodeHandle *leaf = FindLeafPage(key, Operation::DELETE, transaction);
-    //删除键值对
-    int before_delete = leaf->page_hdr->num_key;
-    int after_delete = leaf->Remove(key);
-    if (before_delete>after_delete) {
-        //如果删除成功,则需要调用CoalesceOrRedistribute来进行合并或重分配操作
-        bool ifdelete=false;
-        if(leaf->page_hdr->num_key < leaf->GetMinSize())
-        {
-            ifdelete = CoalesceOrRedistribute(leaf, transaction);
-        }
-        else
-        {
-            //?这个应该写在这吗
+    Rid *exist;
+    bool found = leaf->LeafLookup(key, &exist) && *exist == value;
+    if (found) {
+        bool remove_first = leaf->compare_key(0, key) == 0;
+        leaf->Remove(key);
+        if (leaf->IsUnderflow()) {
+            // 被删除的结点加入事务的deleted_page_set中，在ReleasePageSet()中加入空闲页链表
+            CoalesceOrRedistribute(leaf, transaction);
+        } else if (remove_first) {
             maintain_parent(leaf);
         }
-        if (ifdelete) {
-            //如果需要删除叶子结点,则需要在事务的delete_page_set中添加删除结点的对应页面
-            transaction->AddIntoDeletedPageSet(leaf->page);
+    }
+    delete leaf;
+    ReleasePageSet(transaction);
+    return found;
+}
+
+/**
+ * @brief 按key的升序一遍应用一批插入/删除：保持当前叶子的写锁，
+ * 下一个entry仍落在当前叶子中、且对叶子是安全的修改时直接在叶子中完成，不再从根结点向下查找；
+ * 不安全的修改（分裂、合并、第一个key改变）释放当前叶子后走悲观的插入/删除
+ * 一条大的UPDATE/DELETE对每个索引的修改因此按叶子顺序访问，每个叶子只被查找和写回一次
+ *
+ * @param changes 原始key的修改，按(编码后的key, 删除在插入之前)稳定排序后应用
+ * @param transaction 事务指针
+ * @return 实际插入/删除的entry个数
+ * @note 整批修改期间只持有一个叶子的写锁，与逐条insert_entry/delete_entry的加锁方式相同
+ */
+int IxIndexHandle::ApplyChanges(std::vector<IxChange> &changes, Transaction *transaction) {
+    int col_len = file_hdr_.col_len;
+    std::vector<char> key_buf(changes.size() * col_len);
+    for (size_t i = 0; i < changes.size(); i++) {
+        normalize_key(changes[i].key.data(), key_buf.data() + i * col_len, &changes[i].rid);
+        if (changes[i].is_insert) {
+            bloom_add(key_buf.data() + i * col_len);
         }
     }
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
-    return before_delete>after_delete;
+    auto key_at = [&](int i) { return key_buf.data() + i * col_len; };
+    std::vector<int> order(changes.size());
+    for (int i = 0; i < (int)changes.size(); i++) {
+        order[i] = i;
+    }
+    // 唯一索引中同一个key先删除再插入，使key被其他行修改为该值时能够插入
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        int cmp = memcmp(key_at(a), key_at(b), col_len);
+        return cmp < 0 || (cmp == 0 && !changes[a].is_insert && changes[b].is_insert);
+    });
+
+    IxNodeHandle *leaf = nullptr;
+    bool dirty = false;
+    auto release_leaf = [&]() {
+        if (leaf != nullptr) {
+            leaf->page->WUnlatch();
+            ReleaseNode(leaf, dirty);
+            leaf = nullptr;
+            dirty = false;
+        }
+    };
+    int applied = 0;
+    for (int i : order) {
+        const char *key = key_at(i);
+        IxChange &change = changes[i];
+        Operation operation = change.is_insert ? Operation::INSERT : Operation::DELETE;
+        const char *include = change.include.empty() ? nullptr : change.include.data();
+        // key不小于上一个落在leaf中的key，只需检查上界：不大于leaf的最后一个key，或者leaf是最右边的叶子
+        if (leaf != nullptr && leaf->GetNextLeaf() != IX_LEAF_HEADER_PAGE &&
+            (leaf->GetSize() == 0 || leaf->compare_key(leaf->GetSize() - 1, key) < 0)) {
+            release_leaf();
+        }
+        if (leaf == nullptr) {
+            leaf = FindLeafPage(key, operation, transaction, true);
+        }
+        Rid *exist;
+        bool found = leaf->LeafLookup(key, &exist) && (change.is_insert || *exist == change.rid);
+        if (found == change.is_insert) {
+            continue;  // 插入已经存在的entry、删除不存在的entry
+        }
+        if (IsSafe(leaf, key, operation)) {
+            if (change.is_insert) {
+                leaf->Insert(key, change.rid, include);
+            } else {
+                leaf->Remove(key);
+            }
+            dirty = true;
+            applied++;
+            continue;
+        }
+        release_leaf();
+        bool done = change.is_insert ? InsertPessimistic(key, change.rid, include, transaction)
+                                     : DeletePessimistic(key, change.rid, transaction);
+        applied += done;
+    }
+    release_leaf();
+    return applied;
 }
 
 /**
@@ -254,11 +888,11 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
  *
  * @param node 执行完删除操作的结点
  * @param transaction 事务指针
- * @param root_is_latched 传出参数：根节点是否上锁，用于并发操作
  * @return 是否需要删除结点
  * @note User needs to first find the sibling of input page.
  * If sibling's size + input page's size >= 2 * page's minsize, then redistribute.
  * Otherwise, merge(Coalesce).
+ * @note node不安全，因此其父结点一定持有写锁；兄弟结点需要另外加写锁，并放入page_set中统一释放
  */
 bool IxIndexHandle::CoalesceOrRedistribute(IxNodeHandle *node, Transaction *transaction) {
     // Todo:
@@ -270,56 +904,66 @@ bool IxIndexHandle::CoalesceOrRedistribute(IxNodeHandle *node, Transaction *tran
     // 4. 如果node结点和兄弟结点的键值对数量之和，能够支撑两个B+树结点（即node.size+neighbor.size >=
     // NodeMinSize*2)，则只需要重新分配键值对（调用Redistribute函数）
     // 5. 如果不满足上述条件，则需要合并两个结点，将右边的结点合并到左边的结点（调用Coalesce函数）
-    //TODO root_is_latched将会在并发操作中使用
     if(node->IsRootPage())
     {
         //如果是根节点,则需要调用AdjustRoot()函数来进行处理
-        return AdjustRoot(node);
+        return AdjustRoot(node, transaction);
     }
-    else
+    if(!node->IsUnderflow())
     {
-        //获取node结点的父亲结点
-        IxNodeHandle *parent = FetchNode(node->GetParentPageNo());
-        //寻找node结点的兄弟结点
-        int index = parent->find_child(node);
-        IxNodeHandle *neighbor;
-        if(index>0)
-        {
-            //优先选取前驱结点
-            neighbor = FetchNode(parent->get_rid(index-1)->page_no);
-        }
-        else
-        {
-            //index==0时，选取后继结点
-            neighbor = FetchNode(parent->get_rid(index+1)->page_no);
-        }
-        //如果node结点和兄弟结点的键值对数量之和，能够支撑两个B+树结点
-        if(node->page_hdr->num_key + neighbor->page_hdr->num_key >= node->GetMinSize()*2)
-        {
-            // 则只需要重新分配键值对
-            Redistribute(neighbor,node,parent,index);
-        }
-        else
-        {
-            // 否则需要合并两个结点
-            return Coalesce(&neighbor,&node,&parent,index,transaction);
+        return false;
+    }
+    //获取node结点的父亲结点
+    IxNodeHandle *parent = FetchNode(node->GetParentPageNo());
+    //寻找node结点的兄弟结点，优先选取前驱结点，index==0时选取后继结点
+    int index = parent->find_child(node);
+    IxNodeHandle *neighbor = FetchNode(parent->ValueAt(index > 0 ? index - 1 : index + 1));
+    neighbor->page->WLatch();
+    transaction->AddIntoPageSet(neighbor->page);
+    IxNodeHandle *neighbor_handle = neighbor;  // Coalesce可能交换node和neighbor
+    bool ret = false;
+    bool redistribute;
+    if (file_hdr_.key_compress) {
+        // 变长key结点：两个结点的entry放不进一个结点时重分配，否则合并
+        IxEntryList entries(&file_hdr_);
+        if (index > 0) {
+            collect_siblings(&entries, neighbor, node, parent, index);
+        } else {
+            collect_siblings(&entries, node, neighbor, parent, 1);
         }
-        //? 这里是写maintain吗
+        redistribute = entries.size() > file_hdr_.btree_order ||
+                       entries.encoded_size(node->IsLeafPage(), 0, entries.size()) > PAGE_SIZE;
+    } else {
+        redistribute = node->GetSize() + neighbor->GetSize() >= node->GetMinSize() * 2;
+    }
+    //如果node结点和兄弟结点的键值对数量之和，能够支撑两个B+树结点
+    if(redistribute)
+    {
+        // 则只需要重新分配键值对
+        Redistribute(neighbor,node,parent,index,transaction);
         maintain_parent(node);
         maintain_parent(neighbor);
-        // buffer_pool_manager_->UnpinPage(parent->GetPageId(),true);
     }
-    return false;
+    else
+    {
+        // 否则需要合并两个结点
+        ret = Coalesce(&neighbor,&node,&parent,index,transaction);
+    }
+    delete neighbor_handle;  // page在page_set中，由ReleasePageSet()解锁并unpin
+    ReleaseNode(parent, true);
+    return ret;
 }
 
 /**
  * @brief 用于当根结点被删除了一个键值对之后的处理
  *
  * @param old_root_node 原根节点
+ * @param transaction 事务指针
  * @return bool 根结点是否需要被删除
  * @note size of root page can be less than min size and this method is only called within coalesceOrRedistribute()
+ * @note 根结点只剩一个孩子说明它对本次删除不安全，此时一定持有root_latch_
  */
-bool IxIndexHandle::AdjustRoot(IxNodeHandle *old_root_node) {
+bool IxIndexHandle::AdjustRoot(IxNodeHandle *old_root_node, Transaction *transaction) {
     // Todo:
     // 1. 如果old_root_node是内部结点，并且大小为1，则直接把它的孩子更新成新的根结点
     // 2. 如果old_root_node是叶结点，且大小为0，则直接更新root page
@@ -329,22 +973,15 @@ bool IxIndexHandle::AdjustRoot(IxNodeHandle *old_root_node) {
     if(!old_root_node->IsLeafPage() && old_root_node->GetSize() == 1)
     {
         //则直接把它的孩子更新成新的根结点
-        IxNodeHandle *child = FetchNode(old_root_node->get_rid(0)->page_no);
+        //唯一的孩子就是刚刚合并得到的结点，已经在page_set中持有写锁
+        IxNodeHandle *child = FetchNode(old_root_node->ValueAt(0));
         child->page_hdr->parent = INVALID_PAGE_ID;
-        //? 需要unpin和delete吗
-        file_hdr_.root_page = child->GetPageNo();
-        release_node_handle(*child);
-        return true;
-    }
-    //如果old_root_node是叶结点，且大小为0
-    else if(old_root_node->IsLeafPage() && old_root_node->GetSize() == 0)
-    {
-        //则直接更新root page
-        //? 需要delete吗
-        file_hdr_.root_page = INVALID_PAGE_ID;
-        release_node_handle(*FetchNode(old_root_node->GetPageNo()));
+        UpdateRootPageNo(child->GetPageNo());
+        ReleaseNode(child, true);
+        transaction->AddIntoDeletedPageSet(old_root_node->page);
         return true;
     }
+    //如果old_root_node是叶结点，且大小为0，保留这个空的根结点，之后的插入仍然从它开始
     return false;
 }
 
@@ -362,28 +999,57 @@ bool IxIndexHandle::AdjustRoot(IxNodeHandle *old_root_node) {
  * index>0，则neighbor是node前驱结点，表示：neighbor(left)  node(right)
  * 注意更新parent结点的相关kv对
  */
-void IxIndexHandle::Redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index) {
+void IxIndexHandle::Redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index,
+                                 Transaction *transaction) {
     // Todo:
     // 1. 通过index判断neighbor_node是否为node的前驱结点
     // 2. 从neighbor_node中移动一个键值对到node结点中
     // 3. 更新父节点中的相关信息，并且修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
     // 注意：neighbor_node的位置不同，需要移动的键值对不同，需要分类讨论
+    if (file_hdr_.key_compress) {
+        // 变长key结点按字节数把两个结点的entry重新均分，父结点中的分隔key可能变长，放不下时分裂父结点
+        IxNodeHandle *left = index > 0 ? neighbor_node : node;
+        IxNodeHandle *right = index > 0 ? node : neighbor_node;
+        int right_rank = index > 0 ? index : 1;
+        IxEntryList entries(&file_hdr_);
+        collect_siblings(&entries, left, right, parent, right_rank);
+        int left_size = left->GetSize();
+        int mid = choose_split(entries, left->IsLeafPage());
+        left->rebuild(entries, 0, mid);
+        right->rebuild(entries, mid, entries.size());
+        for (int i = mid; i < left_size; i++) {
+            maintain_child(right, i - mid);
+        }
+        for (int i = left_size; i < mid; i++) {
+            maintain_child(left, i);
+        }
+        char sep[IX_MAX_COL_LEN];
+        if (left->IsLeafPage()) {
+            ix_separator(entries.key(mid - 1), entries.key(mid), file_hdr_.col_len, sep);
+        } else {
+            memcpy(sep, entries.key(mid), file_hdr_.col_len);
+        }
+        replace_separator(parent, right_rank, sep, transaction);
+        return;
+    }
 
     // 通过index判断neighbor_node是否为node的前驱结点
     if(index == 0)
     {
         // 从neighbor_node中移动一个键值对到node结点中
-        node->insert_pair(node->GetSize(),neighbor_node->get_key(0),*neighbor_node->get_rid(0));
+        node->insert_pair(node->GetSize(), neighbor_node->get_key(0), *neighbor_node->get_rid(0),
+                          neighbor_node->get_include(0));
         neighbor_node->erase_pair(0);
-        // 更新父节点中的相关信息
-        parent->set_key(0,neighbor_node->get_key(0));
+        // 更新父节点中的相关信息：neighbor是parent的第1个孩子
+        parent->set_key(1,neighbor_node->get_key(0));
         // 修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
         maintain_child(node,node->GetSize()-1);
     }
     else
     {
         // 从neighbor_node中移动一个键值对到node结点中
-        node->insert_pair(0,neighbor_node->get_key(neighbor_node->GetSize()-1),*neighbor_node->get_rid(neighbor_node->GetSize()-1));
+        int last = neighbor_node->GetSize() - 1;
+        node->insert_pair(0, neighbor_node->get_key(last), *neighbor_node->get_rid(last), neighbor_node->get_include(last));
         neighbor_node->erase_pair(neighbor_node->GetSize()-1);
         // 更新父节点中的相关信息
         parent->set_key(index,node->get_key(0));
@@ -413,7 +1079,6 @@ bool IxIndexHandle::Coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
     // 2. 把node结点的键值对移动到neighbor_node中，并更新node结点孩子结点的父节点信息（调用maintain_child函数）
     // 3. 释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
     // 提示：如果是叶子结点且为最右叶子结点，需要更新file_hdr_.last_leaf
-    //!还有问题
     // 1. 用index判断neighbor_node是否为node的前驱结点，若不是则交换两个结点，让neighbor_node作为左结点，node作为右结点
     if (index == 0) {
         IxNodeHandle *temp = *neighbor_node;
@@ -425,31 +1090,241 @@ bool IxIndexHandle::Coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
     // 2. 把node结点的键值对移动到neighbor_node中，并更新node结点孩子结点的父节点信息（调用maintain_child函数）
     int neighbor_node_key_num = (*neighbor_node)->GetSize();
     int node_key_num = (*node)->GetSize();
-    for (int i = 0; i < node_key_num; i++) {
-        (*neighbor_node)->insert_pair(neighbor_node_key_num + i,(*node)->get_key(i), *(*node)->get_rid(i));
-        maintain_child(*neighbor_node,neighbor_node_key_num + i);
+    if (file_hdr_.key_compress) {
+        // 变长key结点合并后重写左结点，公共前缀和分隔key都需要重新计算
+        IxEntryList entries(&file_hdr_);
+        collect_siblings(&entries, *neighbor_node, *node, *parent, index);
+        (*neighbor_node)->rebuild(entries, 0, entries.size());
+        for (int i = neighbor_node_key_num; i < entries.size(); i++) {
+            maintain_child(*neighbor_node, i);
+        }
+    } else {
+        for (int i = 0; i < node_key_num; i++) {
+            (*neighbor_node)->insert_pair(neighbor_node_key_num + i, (*node)->get_key(i), *(*node)->get_rid(i),
+                                          (*node)->get_include(i));
+            maintain_child(*neighbor_node,neighbor_node_key_num + i);
+        }
     }
 
     // 3. 释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
     if ((*node)->IsLeafPage()) {
-        if ((*node)->GetPageNo() == file_hdr_.last_leaf) {
-            file_hdr_.last_leaf = (*neighbor_node)->GetPageNo();
+        {
+            std::scoped_lock lock{hdr_latch_};
+            if ((*node)->GetPageNo() == file_hdr_.last_leaf) {
+                file_hdr_.last_leaf = (*neighbor_node)->GetPageNo();
+                mark_hdr_dirty();
+            }
         }
         (*neighbor_node)->page_hdr->next_leaf = (*node)->page_hdr->next_leaf;
         IxNodeHandle* nextnode = FetchNode((*node)->page_hdr->next_leaf);
+        nextnode->page->WLatch();
         nextnode->page_hdr->prev_leaf = (*neighbor_node)->GetPageNo();
-
+        nextnode->page->WUnlatch();
+        ReleaseNode(nextnode, true);
     }
-    release_node_handle(**node);
-    delete *node;
+    transaction->AddIntoDeletedPageSet((*node)->page);
     (*parent)->erase_pair(index);
-    (*parent)->set_key(index-1,(*neighbor_node)->get_key(0));
-    (*parent)->set_rid(index-1, Rid{(*neighbor_node)->GetPageNo(),-1});
-    maintain_child(*parent,index-1);
+    // neighbor_node的第一个key可能被删除了，更新parent及其祖先结点
     maintain_parent(*neighbor_node);
     return CoalesceOrRedistribute(*parent, transaction);
 }
 
+namespace {
+// 批量建索引时一层结点的划分：starts[i]为第i个结点的第一个entry的序号，最后一项为entry总数
+struct IxLevelLayout {
+    std::vector<int> starts{0};
+
+    // 定长key结点：n个entry平均分给各个结点，前n%num_nodes个结点比其余结点多一个entry
+    static IxLevelLayout even(int n, int fill, int min_size) {
+        int num_nodes = (n + fill - 1) / fill;
+        // 平均分配后不能低于结点的最小容量（只有一个结点时它是根结点，不受限制）
+        while (num_nodes > 1 && n / num_nodes < min_size) {
+            num_nodes--;
+        }
+        IxLevelLayout layout;
+        for (int i = 0; i < num_nodes; i++) {
+            layout.starts.push_back(layout.starts.back() + n / num_nodes + (i < n % num_nodes ? 1 : 0));
+        }
+        return layout;
+    }
+
+    int num_nodes() const { return static_cast<int>(starts.size()) - 1; }
+
+    int count(int i) const { return starts[i + 1] - starts[i]; }
+
+    // 第j个entry所在的结点
+    int node_of(int j) const {
+        return static_cast<int>(std::upper_bound(starts.begin(), starts.end(), j) - starts.begin()) - 1;
+    }
+};
+}  // namespace
+
+/**
+ * @brief 由排好序的(key,rid)自底向上构建B+树，用于在已有数据上建立索引
+ * 先计算每一层的结点个数，从而预先确定每个结点的page_no和父结点，每个page只需顺序写入一次：
+ * 第一个叶子复用初始的根结点page，其余叶子和各层内部结点依次分配新的page
+ * 变长key结点的容量取决于key的长度，先读一遍sorter按字节数划分叶子、计算分隔key，再读一遍写入叶子
+ *
+ * @param sorter 已经调用过finish()的排序器
+ * @param fill_factor 每个结点的填充率，实际填充数不低于结点的最小容量
+ * @note 只能在空索引上调用，调用时索引对其他线程不可见
+ */
+void IxIndexHandle::bulk_load(IxSorter *sorter, double fill_factor) {
+    if (file_hdr_.root_page != IX_INIT_ROOT_PAGE || file_hdr_.num_pages != IX_INIT_NUM_PAGES) {
+        throw InternalError("IxIndexHandle::bulk_load requires an empty index");
+    }
+    int num_entries = sorter->size();
+    if (num_entries == 0) {
+        return;
+    }
+    int col_len = file_hdr_.col_len;
+    int max_keys = file_hdr_.btree_order;
+    int min_keys = (max_keys + 1) / 2;
+    int fill = std::clamp(static_cast<int>(max_keys * fill_factor), min_keys, max_keys);
+    int budget = IxNodeHandle::var_header_size() +
+                 static_cast<int>((PAGE_SIZE - IxNodeHandle::var_header_size()) * std::min(fill_factor, 1.0));
+    std::vector<char> key(col_len);
+    std::vector<char> include(file_hdr_.include_len);
+    Rid rid;
+
+    // levels[0]为叶子层，最后一层只有一个结点，即根结点
+    // 变长key结点：level_keys[level]为该层每个结点在父结点中的分隔key，最左边的结点为全0的key
+    std::vector<IxLevelLayout> levels;
+    std::vector<std::vector<char>> level_keys;
+    if (file_hdr_.key_compress) {
+        IxLevelLayout leaves;
+        std::vector<char> seps(col_len, 0);
+        IxEntryList leaf(&file_hdr_);
+        for (int j = 0; sorter->next(key.data(), &rid, include.data()); j++) {
+            leaf.push_back(key.data(), rid, include.data());
+            if (leaf.size() > 1 && (leaf.size() > max_keys || leaf.encoded_size(true, 0, leaf.size()) > budget)) {
+                // 当前叶子放不下第j个entry，从它开始下一个叶子
+                leaves.starts.push_back(j);
+                seps.resize(seps.size() + col_len);
+                ix_separator(leaf.key(leaf.size() - 2), key.data(), col_len, seps.data() + seps.size() - col_len);
+                leaf.clear();
+                leaf.push_back(key.data(), rid, include.data());
+            }
+        }
+        leaves.starts.push_back(num_entries);
+        levels.push_back(std::move(leaves));
+        level_keys.push_back(std::move(seps));
+        sorter->rewind();
+        int slot_size = IxNodeHandle::var_slot_size(&file_hdr_, false);
+        while (levels.back().num_nodes() > 1) {
+            // 内部结点的entry为下一层各结点的分隔key
+            const std::vector<char> &child_keys = level_keys.back();
+            int n = levels.back().num_nodes();
+            IxLevelLayout layout;
+            int size = IxNodeHandle::var_header_size();
+            for (int j = 0; j < n; j++) {
+                int entry_size = slot_size + ix_key_sig_len(child_keys.data() + (size_t)j * col_len, col_len);
+                if (j > layout.starts.back() && (size + entry_size > budget || j - layout.starts.back() >= max_keys)) {
+                    layout.starts.push_back(j);
+                    size = IxNodeHandle::var_header_size();
+                }
+                size += entry_size;
+            }
+            layout.starts.push_back(n);
+            int last = layout.num_nodes() - 1;
+            if (last > 0 && layout.count(last) < 2) {
+                // 内部结点至少要有2个孩子，从前一个结点移过来一个
+                layout.starts[last]--;
+            }
+            std::vector<char> seps((size_t)layout.num_nodes() * col_len);
+            for (int i = 0; i < layout.num_nodes(); i++) {
+                memcpy(seps.data() + (size_t)i * col_len, child_keys.data() + (size_t)layout.starts[i] * col_len,
+                       col_len);
+            }
+            memset(seps.data(), 0, col_len);
+            levels.push_back(std::move(layout));
+            level_keys.push_back(std::move(seps));
+        }
+    } else {
+        levels.push_back(IxLevelLayout::even(num_entries, fill, min_keys));
+        while (levels.back().num_nodes() > 1) {
+            levels.push_back(IxLevelLayout::even(levels.back().num_nodes(), fill, min_keys));
+        }
+    }
+    std::vector<page_id_t> first_page_no(levels.size());
+    page_id_t next_page_no = disk_manager_->get_fd2pageno(fd_);
+    for (size_t level = 0; level < levels.size(); level++) {
+        first_page_no[level] = next_page_no - (level == 0 ? 1 : 0);
+        next_page_no += levels[level].num_nodes() - (level == 0 ? 1 : 0);
+    }
+    auto page_of = [&](size_t level, int i) {
+        return level == 0 && i == 0 ? IX_INIT_ROOT_PAGE : first_page_no[level] + i;
+    };
+    auto parent_of = [&](size_t level, int i) {
+        return level + 1 < levels.size() ? page_of(level + 1, levels[level + 1].node_of(i)) : IX_NO_PAGE;
+    };
+
+    // 逐层构建，定长key结点中keys保存当前层每个结点的第一个key，作为上一层的entry
+    std::vector<char> keys;
+    for (size_t level = 0; level < levels.size(); level++) {
+        const IxLevelLayout &layout = levels[level];
+        bool is_leaf = level == 0;
+        std::vector<char> node_keys((size_t)layout.num_nodes() * col_len);
+        int entry = 0;
+        for (int i = 0; i < layout.num_nodes(); i++) {
+            IxNodeHandle *node = is_leaf && i == 0 ? FetchNode(IX_INIT_ROOT_PAGE) : CreateNode();
+            if (node->GetPageNo() != page_of(level, i)) {
+                throw InternalError("IxIndexHandle::bulk_load: unexpected page no");
+            }
+            node->page_hdr->next_free_page_no = IX_NO_PAGE;
+            node->page_hdr->parent = parent_of(level, i);
+            node->page_hdr->is_leaf = is_leaf;
+            if (is_leaf) {
+                node->page_hdr->prev_leaf = i == 0 ? IX_LEAF_HEADER_PAGE : page_of(level, i - 1);
+                node->page_hdr->next_leaf = i == layout.num_nodes() - 1 ? IX_LEAF_HEADER_PAGE : page_of(level, i + 1);
+            } else {
+                node->page_hdr->prev_leaf = IX_NO_PAGE;
+                node->page_hdr->next_leaf = IX_NO_PAGE;
+            }
+            int count = layout.count(i);
+            if (file_hdr_.key_compress) {
+                IxEntryList entries(&file_hdr_);
+                for (int k = 0; k < count; k++, entry++) {
+                    if (is_leaf) {
+                        sorter->next(key.data(), &rid, include.data());
+                        entries.push_back(key.data(), rid, include.data());
+                    } else {
+                        entries.push_back(level_keys[level - 1].data() + (size_t)entry * col_len,
+                                          Rid{page_of(level - 1, entry), -1}, nullptr);
+                    }
+                }
+                node->rebuild(entries, 0, count);
+                ReleaseNode(node, true);
+                continue;
+            }
+            for (int k = 0; k < count; k++, entry++) {
+                if (is_leaf) {
+                    sorter->next(node->get_key(k), node->get_rid(k), node->get_include(k));
+                } else {
+                    node->set_key(k, keys.data() + (size_t)entry * col_len);
+                    node->set_rid(k, Rid{page_of(level - 1, entry), -1});
+                }
+            }
+            node->SetSize(count);
+            memcpy(node_keys.data() + (size_t)i * col_len, node->get_key(0), col_len);
+            ReleaseNode(node, true);
+        }
+        keys = std::move(node_keys);
+    }
+
+    page_id_t last_leaf = page_of(0, levels[0].num_nodes() - 1);
+    IxNodeHandle *leaf_header = FetchNode(IX_LEAF_HEADER_PAGE);
+    leaf_header->SetPrevLeaf(last_leaf);
+    leaf_header->SetNextLeaf(IX_INIT_ROOT_PAGE);
+    ReleaseNode(leaf_header, true);
+
+    std::scoped_lock lock{root_latch_, hdr_latch_};
+    UpdateRootPageNo(page_of(levels.size() - 1, 0));
+    file_hdr_.first_leaf = IX_INIT_ROOT_PAGE;
+    file_hdr_.last_leaf = last_leaf;
+    mark_hdr_dirty();
+}
+
 /** -- 以下为辅助函数 -- */
 /**
  * @brief 获取一个指定结点
@@ -460,53 +1335,98 @@ bool IxIndexHandle::Coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
  */
 IxNodeHandle *IxIndexHandle::FetchNode(int page_no) const {
     // assert(page_no < file_hdr_.num_pages); // 不再生效，由于删除操作，page_no可以大于个数
-    Page *page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no});
-    IxNodeHandle *node = new IxNodeHandle(&file_hdr_, page);
+    Page *page;
+    // 缓冲池中的页面暂时全部被pin住时，等待其他线程unpin
+    while ((page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no})) == nullptr) {
+        std::this_thread::yield();
+    }
+    IxNodeHandle *node = new IxNodeHandle(&file_hdr_, &key_search_, page);
     return node;
 }
 
 /**
- * @brief 创建一个新结点
+ * @brief 创建一个新结点，优先复用空闲页链表中的page，链表为空时在文件末尾分配新的page
  *
  * @return IxNodeHandle*
  * @note pin the page, remember to unpin it outside!
- * 注意：对于Index的处理是，删除某个页面后，认为该被删除的页面是free_page
- * 而first_free_page实际上就是最新被删除的页面，初始为IX_NO_PAGE
- * 在最开始插入时，一直是create node，那么first_page_no一直没变，一直是IX_NO_PAGE
+ * 空闲页链表的表头为file_hdr_.first_free_page_no，每个空闲page的next_free_page_no指向下一个空闲page
  * 与Record的处理不同，Record将未插入满的记录页认为是free_page
  */
 IxNodeHandle *IxIndexHandle::CreateNode() {
-    file_hdr_.num_pages++;
-    PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
-    // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
-    Page *page = buffer_pool_manager_->NewPage(&new_page_id);
-    // 注意，和Record的free_page定义不同，此处【不能】加上：file_hdr_.first_free_page_no = page->GetPageId().page_no
-    IxNodeHandle *node = new IxNodeHandle(&file_hdr_, page);
+    Page *page = nullptr;
+    while (true) {
+        page_id_t page_no;
+        {
+            std::scoped_lock lock{hdr_latch_};
+            page_no = file_hdr_.first_free_page_no;
+            if (page_no == IX_NO_PAGE) {
+                file_hdr_.num_pages++;
+                mark_hdr_dirty();
+                break;
+            }
+        }
+        // 在hdr_latch_之外fetch表头的page（缓冲池满时需要等待），再确认它仍然是表头
+        while ((page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no})) == nullptr) {
+            std::this_thread::yield();
+        }
+        {
+            std::scoped_lock lock{hdr_latch_};
+            if (file_hdr_.first_free_page_no == page_no) {
+                file_hdr_.first_free_page_no = reinterpret_cast<IxPageHdr *>(page->GetData())->next_free_page_no;
+                mark_hdr_dirty();
+                break;
+            }
+        }
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+        page = nullptr;
+    }
+    if (page == nullptr) {
+        PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+        while ((page = buffer_pool_manager_->NewPage(&new_page_id)) == nullptr) {
+            std::this_thread::yield();
+        }
+    } else {
+        // 乐观读可能还在读取该page的旧内容，加写锁清空使其版本号改变，与NewPage()一样从全0开始
+        page->WLatch();
+        memset(page->GetData(), 0, PAGE_SIZE);
+        page->WUnlatch();
+    }
+    IxNodeHandle *node = new IxNodeHandle(&file_hdr_, &key_search_, page);
     return node;
 }
 
 /**
- * @brief 从node开始更新其父节点的第一个key，一直向上更新直到根节点
+ * @brief 从node开始更新其父节点中对应的key，父节点的第一个key改变时继续向上更新，直到根节点
  *
  * @param node
+ * @note 只有node的第一个key改变时才会修改祖先结点，这种情况下node对本次操作不安全，修改的祖先结点都持有写锁
  */
 void IxIndexHandle::maintain_parent(IxNodeHandle *node) {
+    if (file_hdr_.key_compress) {
+        // 变长key结点中父结点存放的是分隔key，只要求 左边的key < 分隔key <= 右边的key，第一个key改变时不需要更新
+        return;
+    }
     IxNodeHandle *curr = node;
     while (curr->GetParentPageNo() != IX_NO_PAGE) {
         // Load its parent
         IxNodeHandle *parent = FetchNode(curr->GetParentPageNo());
         int rank = parent->find_child(curr);
         char *parent_key = parent->get_key(rank);
-        // char *child_max_key = curr.get_key(curr.page_hdr->num_key - 1);
         char *child_first_key = curr->get_key(0);
-        if (memcmp(parent_key, child_first_key, file_hdr_.col_len) == 0) {
-            assert(buffer_pool_manager_->UnpinPage(parent->GetPageId(), true));
-            break;
+        bool changed = memcmp(parent_key, child_first_key, file_hdr_.col_len) != 0;
+        if (changed) {
+            memcpy(parent_key, child_first_key, file_hdr_.col_len);  // 修改了parent node
+        }
+        if (curr != node) {
+            ReleaseNode(curr, true);
         }
-        memcpy(parent_key, child_first_key, file_hdr_.col_len);  // 修改了parent node
         curr = parent;
-
-        assert(buffer_pool_manager_->UnpinPage(parent->GetPageId(), true));
+        if (!changed || rank != 0) {
+            break;
+        }
+    }
+    if (curr != node) {
+        ReleaseNode(curr, true);
     }
 }
 
@@ -520,22 +1440,29 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 
     IxNodeHandle *prev = FetchNode(leaf->GetPrevLeaf());
     prev->SetNextLeaf(leaf->GetNextLeaf());
-    buffer_pool_manager_->UnpinPage(prev->GetPageId(), true);
+    ReleaseNode(prev, true);
 
     IxNodeHandle *next = FetchNode(leaf->GetNextLeaf());
     next->SetPrevLeaf(leaf->GetPrevLeaf());  // 注意此处是SetPrevLeaf()
-    buffer_pool_manager_->UnpinPage(next->GetPageId(), true);
+    ReleaseNode(next, true);
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 把被删除的结点所在的page加入空闲页链表，之后CreateNode()可以复用
  *
- * @param node
+ * @param page 被删除的结点所在的page，调用者持有其写锁
  */
-void IxIndexHandle::release_node_handle(IxNodeHandle &node) { file_hdr_.num_pages--; }
+void IxIndexHandle::free_page(Page *page) {
+    auto page_hdr = reinterpret_cast<IxPageHdr *>(page->GetData());
+    std::scoped_lock lock{hdr_latch_};
+    page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
+    file_hdr_.first_free_page_no = page->GetPageId().page_no;
+    mark_hdr_dirty();
+}
 
 /**
  * @brief 将node的第child_idx个孩子结点的父节点置为node
+ * @note 只修改孩子结点的parent字段，该字段只有持有node写锁的线程才会读写，因此不对孩子结点加锁
  */
 void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
     if (!node->IsLeafPage()) {
@@ -543,10 +1470,93 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
         int child_page_no = node->ValueAt(child_idx);
         IxNodeHandle *child = FetchNode(child_page_no);
         child->SetParentPageNo(node->GetPageNo());
-        buffer_pool_manager_->UnpinPage(child->GetPageId(), true);
+        ReleaseNode(child, true);
     }
 }
 
+/**
+ * @brief 判断node对本次操作是否安全：操作之后node不会分裂/合并，第一个key也不会改变
+ * 安全时本次操作不会再修改node的祖先结点，可以释放祖先结点的写锁
+ *
+ * @param node 已经持有写锁的结点
+ * @param key 插入/删除的key
+ * @param operation 操作类型
+ */
+bool IxIndexHandle::IsSafe(IxNodeHandle *node, const char *key, Operation operation) {
+    if (file_hdr_.key_compress) {
+        // 变长key结点按字节数判断；父结点中是分隔key，第一个key改变不影响祖先结点
+        // 内部结点可能插入一个分隔key（孩子分裂），也可能替换一个变长的分隔key（孩子重分配），按最长的key预留空间
+        if (operation == Operation::FIND) {
+            return true;
+        }
+        int max_entry = IxNodeHandle::var_slot_size(&file_hdr_, false) + file_hdr_.col_len;
+        if (node->IsLeafPage()) {
+            if (operation == Operation::INSERT) {
+                return node->can_insert(key);
+            }
+            int size = node->GetSize() - 1;
+            return node->IsRootPage() ||
+                   (size >= 1 && (size >= node->GetMinSize() ||
+                                  node->used_bytes() - node->entry_bytes(key) >= IX_VAR_MIN_USED));
+        }
+        if (node->GetSize() + 1 > file_hdr_.btree_order || node->free_bytes() < max_entry) {
+            return false;
+        }
+        if (operation == Operation::INSERT || node->IsRootPage()) {
+            return operation == Operation::INSERT || node->GetSize() > 2;
+        }
+        // 孩子合并时删除一个entry，按最长的entry计算删除后是否需要合并
+        int size = node->GetSize() - 1;
+        return size >= 2 && (size >= node->GetMinSize() || node->used_bytes() - max_entry >= IX_VAR_MIN_USED);
+    }
+    if (operation == Operation::INSERT) {
+        if (node->GetSize() + 1 >= node->GetMaxSize()) {
+            return false;
+        }
+        // 根结点没有父结点中的key需要维护
+        return node->IsRootPage() ||
+               memcmp(key, node->get_key(0), file_hdr_.col_len) > 0;
+    }
+    if (operation == Operation::DELETE) {
+        if (node->IsRootPage()) {
+            // 空的根叶子结点会被保留；内部根结点只剩一个孩子时需要替换根结点
+            return node->IsLeafPage() || node->GetSize() > 2;
+        }
+        return node->GetSize() - 1 >= node->GetMinSize() &&
+               memcmp(key, node->get_key(0), file_hdr_.col_len) != 0;
+    }
+    return true;
+}
+
+/**
+ * @brief 释放事务page_set中的所有写锁（nullptr表示root_latch_）并unpin，
+ * deleted_page_set中的页面在解锁之前加入空闲页链表
+ * 此时本线程不会再等待其他锁，复用这些page的线程对其加写锁时最多等到这里解锁，不会形成死锁
+ */
+void IxIndexHandle::ReleasePageSet(Transaction *transaction) {
+    for (Page *page : *transaction->GetDeletedPageSet()) {
+        free_page(page);
+    }
+    transaction->GetDeletedPageSet()->clear();
+    for (Page *page : *transaction->GetPageSet()) {
+        if (page == nullptr) {
+            root_latch_.unlock();
+        } else {
+            page->WUnlatch();
+            buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+        }
+    }
+    transaction->GetPageSet()->clear();
+}
+
+/**
+ * @brief unpin结点所在的page，并释放IxNodeHandle（不负责解锁）
+ */
+void IxIndexHandle::ReleaseNode(IxNodeHandle *node, bool is_dirty) const {
+    buffer_pool_manager_->UnpinPage(node->GetPageId(), is_dirty);
+    delete node;
+}
+
 /**
  * @brief 这里把iid转换成了rid，即iid的slot_no作为node的rid_idx(key_idx)
  * node其实就是把slot_no作为键值对数组的下标
@@ -558,11 +1568,16 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
  */
 Rid IxIndexHandle::get_rid(const Iid &iid) const {
     IxNodeHandle *node = FetchNode(iid.page_no);
+    node->page->RLatch();
     if (iid.slot_no >= node->GetSize()) {
+        node->page->RUnlatch();
+        ReleaseNode(node, false);
         throw IndexEntryNotFoundError();
     }
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);  // unpin it!
-    return *node->get_rid(iid.slot_no);
+    Rid rid = *node->get_rid(iid.slot_no);
+    node->page->RUnlatch();
+    ReleaseNode(node, false);  // unpin it!
+    return rid;
 }
 
 /** --以下函数将用于lab3执行层-- */
@@ -575,16 +1590,27 @@ Rid IxIndexHandle::get_rid(const Iid &iid) const {
  * 可用*(int *)key转换回去
  */
 Iid IxIndexHandle::lower_bound(const char *key) {
-    // int int_key = *(int *)key;
-    // printf("my_lower_bound key=%d\n", int_key);
+    char key_buf[IX_MAX_COL_LEN];
+    return lower_bound_normalized(normalize_key(key, key_buf));
+}
 
+/**
+ * @brief 与lower_bound相同，但key已经是编码后的key
+ * 多列索引只限定了前几列时，扫描区间的端点由上层按编码后的字节补齐其余列（下界补0x00，上界补0xFF）
+ */
+Iid IxIndexHandle::lower_bound_normalized(const char *key) {
     IxNodeHandle *node = FindLeafPage(key, Operation::FIND, nullptr);
     int key_idx = node->lower_bound(key);
 
     Iid iid = {.page_no = node->GetPageNo(), .slot_no = key_idx};
+    if (key_idx == node->GetSize() && node->GetNextLeaf() != IX_LEAF_HEADER_PAGE) {
+        // key大于该叶子中的所有key，第一个>=key的位置在下一个叶子的开头
+        iid = {.page_no = node->GetNextLeaf(), .slot_no = 0};
+    }
 
-    // unpin leaf node
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
+    // unlatch and unpin leaf node
+    node->page->RUnlatch();
+    ReleaseNode(node, false);
     return iid;
 }
 
@@ -595,25 +1621,52 @@ Iid IxIndexHandle::lower_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::upper_bound(const char *key) {
-    // int int_key = *(int *)key;
-    // printf("my_upper_bound key=%d\n", int_key);
+    char key_buf[IX_MAX_COL_LEN];
+    normalize_key(key, key_buf);
+    if (!file_hdr_.unique) {
+        // 跳过key相同的所有entry
+        memset(key_buf + file_hdr_.col_len - sizeof(Rid), 0xff, sizeof(Rid));
+    }
+    return upper_bound_normalized(key_buf);
+}
 
+/**
+ * @brief 与upper_bound相同，但key已经是编码后的key
+ */
+Iid IxIndexHandle::upper_bound_normalized(const char *key) {
     IxNodeHandle *node = FindLeafPage(key, Operation::FIND, nullptr);
     int key_idx = node->upper_bound(key);
 
-    Iid iid;
-    if (key_idx == node->GetSize()) {
-        // 这种情况无法根据iid找到rid，即后续无法调用ih->get_rid(iid)
-        iid = leaf_end();
-    } else {
-        iid = {.page_no = node->GetPageNo(), .slot_no = key_idx};
+    Iid iid = {.page_no = node->GetPageNo(), .slot_no = key_idx};
+    if (key_idx == node->GetSize() && node->GetNextLeaf() != IX_LEAF_HEADER_PAGE) {
+        // 最后一个叶子的末尾即leaf_end()，否则第一个>key的位置在下一个叶子的开头
+        iid = {.page_no = node->GetNextLeaf(), .slot_no = 0};
     }
 
-    // unpin leaf node
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
+    // unlatch and unpin leaf node
+    node->page->RUnlatch();
+    ReleaseNode(node, false);
     return iid;
 }
 
+/**
+ * @brief 判断树中是否仍有编码后的key为key、rid和INCLUDE列都与给定值相同的entry
+ * 只读索引的扫描不加锁地从叶子中取出entry，对rid加锁之后用它确认entry没有被其他事务修改或删除
+ *
+ * @param key 编码后的key（非唯一索引中包含rid）
+ * @param rid 记录位置
+ * @param include INCLUDE列的值，长度为file_hdr_.include_len
+ */
+bool IxIndexHandle::has_entry(const char *key, const Rid &rid, const char *include) {
+    IxNodeHandle *node = FindLeafPage(key, Operation::FIND, nullptr);
+    int idx = node->lower_bound(key);
+    bool found = idx < node->GetSize() && node->compare_key(idx, key) == 0 && *node->get_rid(idx) == rid &&
+                 memcmp(node->get_include(idx), include, file_hdr_.include_len) == 0;
+    node->page->RUnlatch();
+    ReleaseNode(node, false);
+    return found;
+}
+
 /**
  * @brief 指向第一个叶子的第一个结点
  * 用处在于可以作为IxScan的第一个
@@ -625,6 +1678,125 @@ Iid IxIndexHandle::leaf_begin() const {
     return iid;
 }
 
+/**
+ * @brief 统计B+树的形状：沿最左边的孩子得到高度，再沿叶子链表统计entry数、不同key的个数和填充率
+ * 调用者持有表上的S锁，统计期间树不会改变
+ */
+IxTreeStats IxIndexHandle::GetTreeStats() const {
+    IxTreeStats stats = {.height = 1, .num_leaves = 0, .num_entries = 0, .num_keys = 0, .fill_factor = 0};
+    IxNodeHandle *node = FetchNode(root_page_no_.load(std::memory_order_acquire));
+    while (!node->IsLeafPage()) {
+        page_id_t child = node->ValueAt(0);
+        ReleaseNode(node, false);
+        node = FetchNode(child);
+        stats.height++;
+    }
+    ReleaseNode(node, false);
+    // 非唯一索引中相同key的entry相邻，只比较拼接的rid之前的部分
+    int cmp_len = file_hdr_.col_len - (file_hdr_.unique ? 0 : (int)sizeof(Rid));
+    char prev[IX_MAX_COL_LEN], curr[IX_MAX_COL_LEN];
+    double fill = 0;
+    for (page_id_t page_no = file_hdr_.first_leaf; page_no != IX_LEAF_HEADER_PAGE;) {
+        node = FetchNode(page_no);
+        node->page->RLatch();
+        for (int i = 0; i < node->GetSize(); i++) {
+            node->read_key(i, curr);
+            if (stats.num_entries == 0 || memcmp(prev, curr, cmp_len) != 0) {
+                stats.num_keys++;
+                memcpy(prev, curr, cmp_len);
+            }
+            stats.num_entries++;
+        }
+        fill += file_hdr_.key_compress ? (double)node->used_bytes() / PAGE_SIZE
+                                       : (double)node->GetSize() / file_hdr_.btree_order;
+        stats.num_leaves++;
+        page_no = node->GetNextLeaf();
+        node->page->RUnlatch();
+        ReleaseNode(node, false);
+    }
+    stats.fill_factor = stats.num_leaves > 0 ? fill / stats.num_leaves : 0;
+    return stats;
+}
+
+/**
+ * @brief 按树中现有的key重建Bloom filter，被删除的key造成的假阳性随之消失
+ * 位数组按expected_keys（ANALYZE统计的不同key个数）和树中实际的不同key个数中较大者确定大小；
+ * 调用者持有表上的S锁或X锁，重建期间没有插入。旧的filter可能仍在被并发的查询使用，关闭索引时才释放
+ *
+ * @param expected_keys 预计的不同key个数
+ */
+void IxIndexHandle::BuildBloomFilter(int64_t expected_keys) {
+    // 非唯一索引中相同key的entry相邻，只加入一次
+    int cmp_len = file_hdr_.col_len - (file_hdr_.unique ? 0 : (int)sizeof(Rid));
+    char prev[IX_MAX_COL_LEN], curr[IX_MAX_COL_LEN];
+    std::vector<uint64_t> hashes;
+    for (page_id_t page_no = file_hdr_.first_leaf; page_no != IX_LEAF_HEADER_PAGE;) {
+        IxNodeHandle *node = FetchNode(page_no);
+        node->page->RLatch();
+        for (int i = 0; i < node->GetSize(); i++) {
+            node->read_key(i, curr);
+            if (hashes.empty() || memcmp(prev, curr, cmp_len) != 0) {
+                hashes.push_back(bloom_hash(curr));
+                memcpy(prev, curr, cmp_len);
+            }
+        }
+        page_no = node->GetNextLeaf();
+        node->page->RUnlatch();
+        ReleaseNode(node, false);
+    }
+    auto bloom = std::make_unique<IxBloomFilter>(
+        IxBloomFilter::blocks_for(std::max(expected_keys, static_cast<int64_t>(hashes.size()))));
+    for (uint64_t hash : hashes) {
+        bloom->add(hash);
+    }
+    std::scoped_lock lock{hdr_latch_};
+    bloom_.store(bloom.get(), std::memory_order_release);
+    blooms_.push_back(std::move(bloom));
+}
+
+/**
+ * @brief 打开索引时读入上次关闭时写在树之后的Bloom filter
+ * 这些page之后会被树的新page覆盖，因此读入后立即在磁盘上的file header中作废（打开时唯一一次同步写header页），
+ * 正常关闭时再写回，非正常关闭之后重新打开的索引没有Bloom filter，不会用过期的filter排除存在的key
+ */
+void IxIndexHandle::read_bloom_filter() {
+    auto bloom = std::make_unique<IxBloomFilter>(file_hdr_.bloom_num_blocks);
+    char buf[PAGE_SIZE];
+    page_id_t page_no = file_hdr_.bloom_page;
+    for (size_t offset = 0; offset < bloom->size(); offset += PAGE_SIZE, page_no++) {
+        size_t len = std::min(bloom->size() - offset, (size_t)PAGE_SIZE);
+        disk_manager_->read_page(fd_, page_no, buf, PAGE_SIZE);
+        bloom->write(offset, buf, len);
+    }
+    bloom_.store(bloom.get(), std::memory_order_release);
+    blooms_.push_back(std::move(bloom));
+    file_hdr_.bloom_page = IX_NO_PAGE;
+    file_hdr_.bloom_num_blocks = 0;
+    buffer_pool_manager_->FlushPage(hdr_page_->GetPageId());
+}
+
+/**
+ * @brief 关闭索引时把Bloom filter写在树的所有page之后，并记录在file header中
+ * 调用者之后会刷回树的所有page和file header，写在num_pages及之后的page不会被覆盖
+ */
+void IxIndexHandle::write_bloom_filter() {
+    IxBloomFilter *bloom = bloom_.load(std::memory_order_acquire);
+    if (bloom == nullptr) {
+        return;
+    }
+    file_hdr_.bloom_page = file_hdr_.num_pages;
+    file_hdr_.bloom_num_blocks = bloom->num_blocks();
+    mark_hdr_dirty();
+    char buf[PAGE_SIZE];
+    page_id_t page_no = file_hdr_.bloom_page;
+    for (size_t offset = 0; offset < bloom->size(); offset += PAGE_SIZE, page_no++) {
+        size_t len = std::min(bloom->size() - offset, (size_t)PAGE_SIZE);
+        memset(buf, 0, PAGE_SIZE);
+        bloom->read(offset, buf, len);
+        disk_manager_->write_page(fd_, page_no, buf, PAGE_SIZE);
+    }
+}
+
 /**
  * @brief 指向最后一个叶子的最后一个结点的后一个
  * 用处在于可以作为IxScan的最后一个
@@ -632,8 +1804,15 @@ Iid IxIndexHandle::leaf_begin() const {
  * @return Iid
  */
 Iid IxIndexHandle::leaf_end() const {
-    IxNodeHandle *node = FetchNode(file_hdr_.last_leaf);
-    Iid iid = {.page_no = file_hdr_.last_leaf, .slot_no = node->GetSize()};
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);  // unpin it!
+    page_id_t last_leaf;
+    {
+        std::scoped_lock lock{hdr_latch_};
+        last_leaf = file_hdr_.last_leaf;
+    }
+    IxNodeHandle *node = FetchNode(last_leaf);
+    node->page->RLatch();
+    Iid iid = {.page_no = last_leaf, .slot_no = node->GetSize()};
+    node->page->RUnlatch();
+    ReleaseNode(node, false);  // unpin it!
     return iid;
 }
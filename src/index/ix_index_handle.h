@@ -1,15 +1,30 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ix_bloom.h"
 #include "ix_defs.h"
+#include "ix_index.h"
 #include "ix_node_handle.h"
+#include "ix_sorter.h"
 #include "transaction/transaction.h"
 
 enum class Operation { FIND = 0, INSERT, DELETE };  // 三种操作：查找、插入、删除
 
 /**
  * @brief B+树索引
+ * 并发控制采用latch crabbing：
+ * 读操作持有父结点的读锁获取孩子结点的读锁，然后释放父结点；
+ * 写操作先乐观地只对叶子结点加写锁，如果叶子结点可能分裂/合并（不安全）再从根结点开始悲观地加写锁，
+ * 一旦孩子结点对本次操作安全，就释放事务page_set中所有祖先结点的写锁
+ * 定长key结点上的查找和乐观写操作先使用optimistic lock coupling：向下查找时不加锁，
+ * 用page的版本号检查读到的结点内容，只有查找失败多次时才退回到上面的加锁方式
+ * ANALYZE之后索引带有一个Bloom filter，点查询先检查filter，不存在的key不访问任何page
  */
-class IxIndexHandle {
+class IxIndexHandle : public IxIndex {
     friend class IxScan;
     friend class IxManager;
 
@@ -17,48 +32,124 @@ class IxIndexHandle {
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
     int fd_;
-    IxFileHdr file_hdr_;  // 存了root_page，但root_page初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
-    std::mutex root_latch_;  // 用于索引并发（请自行选择并发粒度在 Tree级 或 Page级 ）
+    Page *hdr_page_;  // file header所在的第0页，索引打开期间一直pin在缓冲池中，关闭时随其他page一起刷盘
+    IxFileHdr &file_hdr_;  // 指向hdr_page_中的file header，存了root_page，但root_page初始化为2（第1页存LEAF_HEADER_PAGE）
+    IxKeySearch key_search_;  // 打开索引时根据key长度选择一次结点内查找函数
+    std::mutex root_latch_;  // 保护file_hdr_.root_page，在事务的page_set中用nullptr表示持有该锁
+    std::atomic<page_id_t> root_page_no_;  // file_hdr_.root_page的副本，乐观读不加root_latch_读取根结点
+    mutable std::mutex hdr_latch_;  // 保护file_hdr_中的num_pages、first_free_page_no和last_leaf，以及blooms_
+    std::atomic<IxBloomFilter *> bloom_{nullptr};  // 当前使用的Bloom filter，nullptr表示没有
+    // 创建过的所有Bloom filter：重建之后旧的filter可能仍在被并发的查询使用，关闭索引时才释放
+    std::vector<std::unique_ptr<IxBloomFilter>> blooms_;
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
 
     // for search
-    bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction);
+    bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction) override;
+
+    IxNodeHandle *FindLeafPage(const char *key, Operation operation, Transaction *transaction,
+                               bool optimistic = false);
+
+    bool GetPostings(const char *key, std::vector<Rid> *result, Transaction *transaction);
+
+    bool CollectPostings(IxNodeHandle *leaf, const char *key, int key_idx, std::vector<std::pair<int, Rid>> *result);
 
-    IxNodeHandle *FindLeafPage(const char *key, Operation operation, Transaction *transaction);
+    int BatchLookup(const std::vector<const char *> &keys, std::vector<std::pair<int, Rid>> *result,
+                    Transaction *transaction) override;
 
     // for insert
-    bool insert_entry(const char *key, const Rid &value, Transaction *transaction);
+    bool insert_entry(const char *key, const Rid &value, Transaction *transaction,
+                      const char *include = nullptr) override;
 
     IxNodeHandle *Split(IxNodeHandle *node);
 
     void InsertIntoParent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction);
 
     // for delete
-    bool delete_entry(const char *key, Transaction *transaction);
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction) override;
 
     bool CoalesceOrRedistribute(IxNodeHandle *node, Transaction *transaction = nullptr);
 
-    bool AdjustRoot(IxNodeHandle *old_root_node);
+    bool AdjustRoot(IxNodeHandle *old_root_node, Transaction *transaction);
 
-    void Redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index);
+    void Redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index,
+                      Transaction *transaction = nullptr);
 
     bool Coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node, IxNodeHandle **parent, int index,
                   Transaction *transaction);
 
+    // for batched DML
+    int ApplyChanges(std::vector<IxChange> &changes, Transaction *transaction) override;
+
+    // for bulk load
+    void bulk_load(IxSorter *sorter, double fill_factor = IX_BULK_LOAD_FILL_FACTOR);
+
     // 辅助函数，lab3执行层将使用
     Iid lower_bound(const char *key);
 
     Iid upper_bound(const char *key);
 
+    Iid lower_bound_normalized(const char *key);
+
+    Iid upper_bound_normalized(const char *key);
+
+    bool has_entry(const char *key, const Rid &rid, const char *include);
+
     Iid leaf_end() const;
 
     Iid leaf_begin() const;
 
+    IxTreeStats GetTreeStats() const;
+
+    // for bloom filter
+    void BuildBloomFilter(int64_t expected_keys);
+
+    bool HasBloomFilter() const { return bloom_.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief key是否可能在树中：没有Bloom filter时总是返回true
+     * @param key 编码后的key，非唯一索引拼接在后面的rid不参与计算
+     */
+    bool MayContain(const char *key) const {
+        IxBloomFilter *bloom = bloom_.load(std::memory_order_acquire);
+        return bloom == nullptr || bloom->may_contain(bloom_hash(key));
+    }
+
+    /**
+     * @brief 公有接口传入的是原始key（多列索引为各列原始值的拼接），逐列转换为结点中存放的编码后的key
+     * 各列的编码都保持memcmp序，拼接后的key按memcmp比较即按列的字典序比较，之后的比较都使用memcmp
+     * 非唯一索引在key之后拼接编码后的rid；rid为nullptr时补0，即key相同的entry中最小的位置
+     */
+    const char *normalize_key(const char *key, char *buf, const Rid *rid = nullptr) const {
+        int offset = 0;
+        for (int i = 0; i < file_hdr_.col_num; i++) {
+            ix_normalize_key(key + offset, file_hdr_.col_types[i], file_hdr_.col_lens[i], buf + offset);
+            offset += file_hdr_.col_lens[i];
+        }
+        if (!file_hdr_.unique) {
+            if (rid != nullptr) {
+                ix_normalize_rid(*rid, buf + offset);
+            } else {
+                memset(buf + offset, 0, sizeof(Rid));
+            }
+        }
+        return buf;
+    }
+
+    // 结点中编码后的key的长度，非唯一索引包括拼接在后面的rid
+    int key_len() const { return file_hdr_.col_len; }
+
    private:
     // 辅助函数
-    void UpdateRootPageNo(page_id_t root) { file_hdr_.root_page = root; }
+    void UpdateRootPageNo(page_id_t root) {
+        file_hdr_.root_page = root;
+        root_page_no_.store(root, std::memory_order_release);
+        mark_hdr_dirty();
+    }
+
+    // file header被修改之后调用，调用者持有保护被修改字段的latch
+    void mark_hdr_dirty() { buffer_pool_manager_->MarkDirty(hdr_page_); }
 
     bool IsEmpty() const { return file_hdr_.root_page == IX_NO_PAGE; }
 
@@ -72,10 +163,55 @@ class IxIndexHandle {
 
     void erase_leaf(IxNodeHandle *leaf);
 
-    void release_node_handle(IxNodeHandle &node);
+    void free_page(Page *page);
 
     void maintain_child(IxNodeHandle *node, int child_idx);
 
+    void link_split_node(IxNodeHandle *node, IxNodeHandle *new_node);
+
+    // for variable-length key nodes
+    void SplitInsert(IxNodeHandle *node, int pos, const char *key, const Rid &rid, const char *include,
+                     Transaction *transaction);
+
+    void SplitEntries(IxNodeHandle *node, const IxEntryList &entries, Transaction *transaction);
+
+    int choose_split(const IxEntryList &entries, bool is_leaf) const;
+
+    void collect_siblings(IxEntryList *entries, IxNodeHandle *left, IxNodeHandle *right, IxNodeHandle *parent,
+                          int right_rank) const;
+
+    void replace_separator(IxNodeHandle *parent, int rank, const char *key, Transaction *transaction);
+
+    // for optimistic lock coupling
+    IxNodeHandle *FindLeafOptimistic(const char *key, Operation operation, uint64_t *leaf_version);
+
+    // for latch crabbing
+    bool InsertPessimistic(const char *key, const Rid &value, const char *include, Transaction *transaction);
+
+    bool DeletePessimistic(const char *key, const Rid &value, Transaction *transaction);
+
+    bool IsSafe(IxNodeHandle *node, const char *key, Operation operation);
+
+    void ReleasePageSet(Transaction *transaction);
+
+    void ReleaseNode(IxNodeHandle *node, bool is_dirty) const;
+
+    // for bloom filter
+    uint64_t bloom_hash(const char *key) const {
+        return ix_hash_key(key, file_hdr_.col_len - (file_hdr_.unique ? 0 : static_cast<int>(sizeof(Rid))));
+    }
+
+    void bloom_add(const char *key) {
+        IxBloomFilter *bloom = bloom_.load(std::memory_order_acquire);
+        if (bloom != nullptr) {
+            bloom->add(bloom_hash(key));
+        }
+    }
+
+    void read_bloom_filter();
+
+    void write_bloom_filter();
+
     // for index test
     Rid get_rid(const Iid &iid) const;
 };
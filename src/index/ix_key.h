@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "defs.h"
+#include "errors.h"
+
+/**
+ * @brief 保序的key编码：编码后的key按字节（memcmp）比较的结果与ix_compare比较原始值的结果一致
+ * 索引的结点中只存放编码后的key，因此B+树内部的所有比较都是一次memcmp，编码后的长度与原始长度相同
+ * - INT：翻转符号位后按大端序存放
+ * - FLOAT：非负数翻转符号位，负数翻转所有位，再按大端序存放；-0.0与0.0编码相同
+ * - STRING：记录中的字符串已经是补0到定长的，直接复制
+ */
+inline void ix_normalize_key(const char *key, ColType type, int col_len, char *out) {
+    switch (type) {
+        case TYPE_INT: {
+            uint32_t bits;
+            memcpy(&bits, key, sizeof(bits));
+            bits = __builtin_bswap32(bits ^ 0x80000000u);
+            memcpy(out, &bits, sizeof(bits));
+            break;
+        }
+        case TYPE_FLOAT: {
+            float value;
+            memcpy(&value, key, sizeof(value));
+            if (value == 0.0f) {
+                value = 0.0f;
+            }
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            bits = (bits & 0x80000000u) ? ~bits : (bits ^ 0x80000000u);
+            bits = __builtin_bswap32(bits);
+            memcpy(out, &bits, sizeof(bits));
+            break;
+        }
+        case TYPE_STRING:
+            memcpy(out, key, col_len);
+            break;
+        default:
+            throw InternalError("Unexpected data type");
+    }
+}
+
+/**
+ * @brief ix_normalize_key的逆变换，把结点中的key还原为原始值（-0.0还原为0.0）
+ */
+inline void ix_denormalize_key(const char *key, ColType type, int col_len, char *out) {
+    switch (type) {
+        case TYPE_INT: {
+            uint32_t bits;
+            memcpy(&bits, key, sizeof(bits));
+            bits = __builtin_bswap32(bits) ^ 0x80000000u;
+            memcpy(out, &bits, sizeof(bits));
+            break;
+        }
+        case TYPE_FLOAT: {
+            uint32_t bits;
+            memcpy(&bits, key, sizeof(bits));
+            bits = __builtin_bswap32(bits);
+            bits = (bits & 0x80000000u) ? (bits ^ 0x80000000u) : ~bits;
+            memcpy(out, &bits, sizeof(bits));
+            break;
+        }
+        case TYPE_STRING:
+            memcpy(out, key, col_len);
+            break;
+        default:
+            throw InternalError("Unexpected data type");
+    }
+}
+
+/**
+ * @brief 非唯一索引拼接在key之后的rid：page_no和slot_no分别按INT编码，memcmp序即(page_no, slot_no)的顺序
+ */
+inline void ix_normalize_rid(const Rid &rid, char *out) {
+    ix_normalize_key((const char *)&rid.page_no, TYPE_INT, sizeof(int), out);
+    ix_normalize_key((const char *)&rid.slot_no, TYPE_INT, sizeof(int), out + sizeof(int));
+}
+
+/**
+ * @brief 变长key结点使用的辅助函数：结点中的key省略了末尾的0，比较时视为补0到定长
+ */
+// key去掉末尾的0之后的长度
+inline int ix_key_sig_len(const char *key, int len) {
+    while (len > 0 && key[len - 1] == 0) {
+        len--;
+    }
+    return len;
+}
+
+// 两个定长key的公共前缀长度，两个key相同时为len
+inline int ix_key_common_prefix(const char *a, const char *b, int len) {
+    int i = 0;
+    while (i < len && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief 后缀截断：left < right时，right的前ix_separator_len个字节（末尾补0）是满足left < sep <= right的最短key
+ */
+inline int ix_separator_len(const char *left, const char *right, int len) {
+    return ix_key_common_prefix(left, right, len) + 1;
+}
+
+// 生成left和right之间的最短分隔key，长度为len，末尾补0
+inline void ix_separator(const char *left, const char *right, int len, char *sep) {
+    int sep_len = ix_separator_len(left, right, len);
+    memcpy(sep, right, sep_len);
+    memset(sep + sep_len, 0, len - sep_len);
+}
+
+/**
+ * @brief 哈希索引使用的64位hash，对编码后的key计算（-0.0与0.0的编码相同，hash也相同）
+ * hash值保存在索引文件的结构中（目录下标、bucket的划分），因此不能使用与实现相关的std::hash
+ */
+inline uint64_t ix_hash_key(const char *key, int len) {
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ ((uint64_t)len * m);
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t k;
+        memcpy(&k, key + i, sizeof(k));
+        k *= m;
+        k ^= k >> 47;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (i < len) {
+        uint64_t tail = 0;
+        memcpy(&tail, key + i, len - i);
+        h ^= tail;
+        h *= m;
+    }
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 47;
+    return h;
+}
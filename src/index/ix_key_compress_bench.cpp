@@ -0,0 +1,141 @@
+/**
+ * @brief 字符串key的前缀压缩和分隔key后缀截断的效果测试
+ * 在CHAR(128)的索引上分别用定长key结点和变长key结点，逐条随机插入以及批量构建，
+ * 比较树高、page数、叶子和内部结点的平均/最大扇出，以及点查询吞吐量
+ *
+ * 用法：ix_key_compress_bench [索引key数量]
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#define private public
+#include "ix.h"
+#undef private
+
+static const std::string BENCH_DB_NAME = "IxKeyCompressBench_db";
+static const std::string BENCH_FILE_NAME = "bench";
+static const int BENCH_COL_LEN = 128;
+
+template <typename F>
+static double measure(F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 每一层的结点个数、entry总数和最大entry数，levels[0]为根结点所在的层
+struct TreeStats {
+    struct Level {
+        int nodes = 0;
+        long long entries = 0;
+        int max_entries = 0;
+    };
+    std::vector<Level> levels;
+};
+
+static void collect_stats(IxIndexHandle *ih, page_id_t page_no, size_t depth, TreeStats *stats) {
+    if (stats->levels.size() <= depth) {
+        stats->levels.resize(depth + 1);
+    }
+    IxNodeHandle *node = ih->FetchNode(page_no);
+    auto &level = stats->levels[depth];
+    level.nodes++;
+    level.entries += node->GetSize();
+    level.max_entries = std::max(level.max_entries, node->GetSize());
+    if (!node->IsLeafPage()) {
+        for (int i = 0; i < node->GetSize(); i++) {
+            collect_stats(ih, node->ValueAt(i), depth + 1, stats);
+        }
+    }
+    ih->ReleaseNode(node, false);
+}
+
+static void run(const char *name, bool compress, bool bulk, const std::vector<std::string> &keys) {
+    DiskManager disk_manager;
+    BufferPoolManager bpm(16384, &disk_manager);
+    IxManager ix_manager(&disk_manager, &bpm);
+    if (disk_manager.is_dir(BENCH_DB_NAME)) {
+        disk_manager.destroy_dir(BENCH_DB_NAME);
+    }
+    disk_manager.create_dir(BENCH_DB_NAME);
+    if (chdir(BENCH_DB_NAME.c_str()) < 0) {
+        throw UnixError();
+    }
+    ix_manager.create_index(BENCH_FILE_NAME, {0}, {TYPE_STRING}, {BENCH_COL_LEN}, 0, compress);
+    auto ih = ix_manager.open_index(BENCH_FILE_NAME, 0);
+    int num_keys = static_cast<int>(keys.size());
+    double build_secs = measure([&] {
+        if (bulk) {
+            IxSorter sorter(&disk_manager, BENCH_COL_LEN, 0, BENCH_FILE_NAME);
+            for (int i = 0; i < num_keys; i++) {
+                sorter.add(keys[i].data(), Rid{.page_no = i, .slot_no = 0});
+            }
+            sorter.finish();
+            ih->bulk_load(&sorter);
+        } else {
+            for (int i = 0; i < num_keys; i++) {
+                ih->insert_entry(keys[i].data(), Rid{.page_no = i, .slot_no = 0}, nullptr);
+            }
+        }
+    });
+
+    TreeStats stats;
+    collect_stats(ih.get(), ih->file_hdr_.root_page, 0, &stats);
+    const auto &leaves = stats.levels.back();
+    long long internal_nodes = 0, internal_entries = 0;
+    int internal_max = 0;
+    for (size_t i = 0; i + 1 < stats.levels.size(); i++) {
+        internal_nodes += stats.levels[i].nodes;
+        internal_entries += stats.levels[i].entries;
+        internal_max = std::max(internal_max, stats.levels[i].max_entries);
+    }
+
+    const int num_lookups = 200000;
+    std::mt19937 rng(1);
+    std::vector<int> targets(num_lookups);
+    for (auto &t : targets) {
+        t = rng() % num_keys;
+    }
+    std::vector<Rid> result;
+    double lookup_secs = measure([&] {
+        for (int t : targets) {
+            result.clear();
+            ih->GetValue(keys[t].data(), &result, nullptr);
+        }
+    });
+
+    printf("%-22s height=%zu pages=%d leaves=%d leaf_fanout(avg/max)=%.1f/%d "
+           "internal_fanout(avg/max)=%.1f/%d build=%.2fs lookup=%.3f Mops/s\n",
+           name, stats.levels.size(), ih->file_hdr_.num_pages, leaves.nodes, (double)leaves.entries / leaves.nodes,
+           leaves.max_entries, internal_nodes > 0 ? (double)internal_entries / internal_nodes : 0.0, internal_max,
+           build_secs, num_lookups / lookup_secs / 1e6);
+
+    ix_manager.close_index(ih.get());
+    if (chdir("..") < 0) {
+        throw UnixError();
+    }
+    disk_manager.destroy_dir(BENCH_DB_NAME);
+}
+
+int main(int argc, char **argv) {
+    int num_keys = argc > 1 ? atoi(argv[1]) : 200000;
+    // 形如URL/路径的key：较长的公共前缀，后缀长度不等，末尾补0
+    std::vector<std::string> keys;
+    std::mt19937 rng(0);
+    for (int i = 0; i < num_keys; i++) {
+        char buf[BENCH_COL_LEN + 1] = {};
+        int len = snprintf(buf, sizeof(buf), "https://shop.example.com/catalog/region-%02d/item-%08d/", i % 16,
+                           (int)(rng() % 100000000));
+        for (int pad = rng() % 24; pad > 0 && len < BENCH_COL_LEN; pad--) {
+            buf[len++] = 'a' + rng() % 26;
+        }
+        keys.emplace_back(buf, BENCH_COL_LEN);
+    }
+    printf("keys=%d col_len=%d\n", num_keys, BENCH_COL_LEN);
+    run("fixed   random insert", false, false, keys);
+    run("compact random insert", true, false, keys);
+    run("fixed   bulk load", false, true, keys);
+    run("compact bulk load", true, true, keys);
+    return 0;
+}
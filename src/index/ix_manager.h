@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "ix_art_index_handle.h"
 #include "ix_defs.h"
+#include "ix_hash_index_handle.h"
 #include "ix_index_handle.h"
 
 class IxManager {
@@ -15,8 +19,19 @@ class IxManager {
     IxManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
         : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager) {}
 
+    /**
+     * @brief 索引文件名由表名和索引各列在表中的序号组成，如表t上(a,c)的索引为t.0.2.idx
+     */
+    std::string get_index_name(const std::string &filename, const std::vector<int> &col_idxs) {
+        std::string ix_name = filename;
+        for (int col_idx : col_idxs) {
+            ix_name += '.' + std::to_string(col_idx);
+        }
+        return ix_name + ".idx";
+    }
+
     std::string get_index_name(const std::string &filename, int index_no) {
-        return filename + '.' + std::to_string(index_no) + ".idx";
+        return get_index_name(filename, std::vector<int>{index_no});
     }
 
     bool exists(const std::string &filename, int index_no) {
@@ -25,22 +40,50 @@ class IxManager {
     }
 
     void create_index(const std::string &filename, int index_no, ColType col_type, int col_len) {
-        std::string ix_name = get_index_name(filename, index_no);
-        assert(index_no >= 0);
-        // Create index file
-        disk_manager_->create_file(ix_name);
-        // Open index file
-        int fd = disk_manager_->open_file(ix_name);
-        // Create file header and write to file
+        create_index(filename, std::vector<int>{index_no}, {col_type}, {col_len});
+    }
+
+    /**
+     * @brief 创建多列索引，key由col_idxs中各列的值依次拼接而成
+     *
+     * @param col_idxs 索引各列在表中的序号
+     * @param col_types 索引各列的类型
+     * @param col_lens 索引各列的长度
+     * @param include_len 叶子中随rid一起存放的INCLUDE列的总长度
+     * @param compress_keys 含字符串列的较长key是否使用变长key结点（前缀压缩和分隔key后缀截断）
+     * @param unique key是否唯一；非唯一索引的结点中在key之后拼接rid，key的长度增加sizeof(Rid)
+     */
+    void create_index(const std::string &filename, const std::vector<int> &col_idxs,
+                      const std::vector<ColType> &col_types, const std::vector<int> &col_lens, int include_len = 0,
+                      bool compress_keys = true, bool unique = true) {
+        std::string ix_name = get_index_name(filename, col_idxs);
+        int col_num = static_cast<int>(col_idxs.size());
+        assert(col_num > 0 && col_types.size() == col_idxs.size() && col_lens.size() == col_idxs.size());
+        if (col_num > IX_MAX_COL_NUM) {
+            throw InternalError("Too many columns in index");
+        }
+        int col_len = unique ? 0 : static_cast<int>(sizeof(Rid));
+        for (int len : col_lens) {
+            col_len += len;
+        }
         // Theoretically we have: |page_hdr| + (|attr| + |rid|) * n <= PAGE_SIZE
         // but we reserve one slot for convenient inserting and deleting, i.e.
         // |page_hdr| + (|attr| + |rid|) * (n + 1) <= PAGE_SIZE
         if (col_len > IX_MAX_COL_LEN) {
             throw InvalidColLengthError(col_len);
         }
+        if (include_len > IX_MAX_COL_LEN) {
+            throw InvalidColLengthError(include_len);
+        }
+        // Create index file
+        disk_manager_->create_file(ix_name);
+        // Open index file
+        int fd = disk_manager_->open_file(ix_name);
         // 根据 |page_hdr| + (|attr| + |rid|) * (n + 1) <= PAGE_SIZE 求得n的最大值btree_order
         // 即 n <= btree_order，那么btree_order就是每个结点最多可插入的键值对数量（实际还多留了一个空位，但其不可插入）
-        int btree_order = static_cast<int>((PAGE_SIZE - sizeof(IxPageHdr)) / (col_len + sizeof(Rid)) - 1);
+        // 有INCLUDE列时每个entry还要加上include_len
+        int entry_len = col_len + static_cast<int>(sizeof(Rid)) + include_len;
+        int btree_order = static_cast<int>((PAGE_SIZE - sizeof(IxPageHdr)) / entry_len - 1);
         assert(btree_order > 2);
         // int key_offset = sizeof(IxPageHdr);
         // int rid_offset = key_offset + (btree_order + 1) * col_len;
@@ -50,15 +93,36 @@ class IxManager {
             .first_free_page_no = IX_NO_PAGE,
             .num_pages = IX_INIT_NUM_PAGES,
             .root_page = IX_INIT_ROOT_PAGE,
-            .col_type = col_type,
+            .col_num = col_num,
+            .col_types = {},
+            .col_lens = {},
             .col_len = col_len,
+            .include_len = include_len,
+            .unique = unique,
+            .key_compress = false,
             .btree_order = btree_order,
             // .key_offset = key_offset,
             // .rid_offset = rid_offset,
             .keys_size = (btree_order + 1) * col_len,  // 用于IxNodeHandle初始化rids首地址
             .first_leaf = IX_INIT_ROOT_PAGE,
             .last_leaf = IX_INIT_ROOT_PAGE,
+            .bloom_page = IX_NO_PAGE,
+            .bloom_num_blocks = 0,
         };
+        for (int i = 0; i < col_num; i++) {
+            fhdr.col_types[i] = col_types[i];
+            fhdr.col_lens[i] = col_lens[i];
+        }
+        // 字符串key通常有很长的公共前缀和末尾的0，使用变长key结点可以大幅提高扇出；
+        // 要求一个结点至少能放下4个最长的entry，保证分裂和重分配后两边都放得下
+        int max_entry = IxNodeHandle::var_slot_size(&fhdr, true) + col_len;
+        bool has_string = std::find(col_types.begin(), col_types.end(), TYPE_STRING) != col_types.end();
+        if (compress_keys && has_string && col_len >= IX_KEY_COMPRESS_MIN_LEN &&
+            IxNodeHandle::var_header_size() + 4 * max_entry <= PAGE_SIZE) {
+            fhdr.key_compress = true;
+            // 数量上限按最短的entry（只有slot的内部结点entry）计算，实际容量由字节数决定
+            fhdr.btree_order = (PAGE_SIZE - IxNodeHandle::var_header_size()) / IxNodeHandle::var_slot_size(&fhdr, false);
+        }
         disk_manager_->write_page(fd, IX_FILE_HDR_PAGE, (const char *)&fhdr, sizeof(fhdr));
 
         char page_buf[PAGE_SIZE];  // 在内存中初始化page_buf中的内容，然后将其写入磁盘
@@ -88,6 +152,8 @@ class IxManager {
                 .prev_leaf = IX_LEAF_HEADER_PAGE,
                 .next_leaf = IX_LEAF_HEADER_PAGE,
             };
+            auto var_hdr = reinterpret_cast<IxVarPageHdr *>(page_buf + sizeof(IxPageHdr));
+            *var_hdr = {.prefix_len = 0, .prefix_sig = 0, .heap_begin = PAGE_SIZE, .garbage = 0};
             // Must write PAGE_SIZE here in case of future fetch_node()
             disk_manager_->write_page(fd, IX_INIT_ROOT_PAGE, page_buf, PAGE_SIZE);
         }
@@ -98,22 +164,122 @@ class IxManager {
         disk_manager_->close_file(fd);
     }
 
+    /**
+     * @brief 创建可扩展哈希索引，文件名与同样列上的B+树索引相同（同一组列上只能有一个索引）
+     * 初始时global_depth为0，目录只有一项，指向唯一的bucket
+     *
+     * @param col_idxs 索引各列在表中的序号
+     * @param col_types 索引各列的类型
+     * @param col_lens 索引各列的长度
+     */
+    void create_hash_index(const std::string &filename, const std::vector<int> &col_idxs,
+                           const std::vector<ColType> &col_types, const std::vector<int> &col_lens) {
+        std::string ix_name = get_index_name(filename, col_idxs);
+        int col_num = static_cast<int>(col_idxs.size());
+        assert(col_num > 0 && col_types.size() == col_idxs.size() && col_lens.size() == col_idxs.size());
+        if (col_num > IX_MAX_COL_NUM) {
+            throw InternalError("Too many columns in index");
+        }
+        int col_len = 0;
+        for (int len : col_lens) {
+            col_len += len;
+        }
+        if (col_len > IX_MAX_COL_LEN) {
+            throw InvalidColLengthError(col_len);
+        }
+        disk_manager_->create_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name);
+        // 每个entry占用一个1字节的tag以及key和rid
+        int entry_len = col_len + static_cast<int>(sizeof(Rid));
+        IxHashFileHdr fhdr = {
+            .num_pages = IX_HASH_INIT_NUM_PAGES,
+            .col_num = col_num,
+            .col_types = {},
+            .col_lens = {},
+            .col_len = col_len,
+            .bucket_capacity = static_cast<int>((PAGE_SIZE - sizeof(IxHashBucketHdr)) / (entry_len + 1)),
+            .global_depth = 0,
+            .num_dir_pages = 1,
+            .dir_pages = {IX_HASH_INIT_DIR_PAGE},
+        };
+        for (int i = 0; i < col_num; i++) {
+            fhdr.col_types[i] = col_types[i];
+            fhdr.col_lens[i] = col_lens[i];
+        }
+        disk_manager_->write_page(fd, IX_FILE_HDR_PAGE, (const char *)&fhdr, sizeof(fhdr));
+
+        char page_buf[PAGE_SIZE] = {};
+        // 目录的第0项指向第一个bucket
+        page_id_t bucket_page = IX_HASH_INIT_BUCKET_PAGE;
+        memcpy(page_buf, &bucket_page, sizeof(bucket_page));
+        disk_manager_->write_page(fd, IX_HASH_INIT_DIR_PAGE, page_buf, PAGE_SIZE);
+        memset(page_buf, 0, PAGE_SIZE);
+        *reinterpret_cast<IxHashBucketHdr *>(page_buf) = {.local_depth = 0, .num_entries = 0};
+        disk_manager_->write_page(fd, IX_HASH_INIT_BUCKET_PAGE, page_buf, PAGE_SIZE);
+
+        disk_manager_->close_file(fd);
+    }
+
     void destroy_index(const std::string &filename, int index_no) {
-        std::string ix_name = get_index_name(filename, index_no);
+        destroy_index(filename, std::vector<int>{index_no});
+    }
+
+    void destroy_index(const std::string &filename, const std::vector<int> &col_idxs) {
+        std::string ix_name = get_index_name(filename, col_idxs);
         disk_manager_->destroy_file(ix_name);
     }
 
-    // 注意这里打开文件，创建并返回了index file handle的指针
     std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, int index_no) {
-        std::string ix_name = get_index_name(filename, index_no);
+        return open_index(filename, std::vector<int>{index_no});
+    }
+
+    // 注意这里打开文件，创建并返回了index file handle的指针
+    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<int> &col_idxs) {
+        std::string ix_name = get_index_name(filename, col_idxs);
         int fd = disk_manager_->open_file(ix_name);
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
-    void close_index(const IxIndexHandle *ih) {
-        disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, (const char *)&ih->file_hdr_, sizeof(ih->file_hdr_));
+    std::unique_ptr<IxHashIndexHandle> open_hash_index(const std::string &filename, const std::vector<int> &col_idxs) {
+        std::string ix_name = get_index_name(filename, col_idxs);
+        int fd = disk_manager_->open_file(ix_name);
+        return std::make_unique<IxHashIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+    }
+
+    /**
+     * @brief 创建一个空的ART索引；ART索引只在内存中，没有索引文件，由调用者插入表中已有的记录
+     */
+    std::unique_ptr<IxArtIndexHandle> open_art_index(const std::vector<ColType> &col_types,
+                                                     const std::vector<int> &col_lens) {
+        return std::make_unique<IxArtIndexHandle>(col_types, col_lens);
+    }
+
+    // 按索引的实际类型关闭
+    void close_index(IxIndex *ih) {
+        if (auto hash_ih = dynamic_cast<IxHashIndexHandle *>(ih)) {
+            close_index(hash_ih);
+        } else if (dynamic_cast<IxArtIndexHandle *>(ih) != nullptr) {
+            // ART索引没有文件，由持有者释放内存
+        } else {
+            close_index(static_cast<IxIndexHandle *>(ih));
+        }
+    }
+
+    void close_index(IxHashIndexHandle *ih) {
+        buffer_pool_manager_->UnpinPage(ih->hdr_page_->GetPageId(), false);
+        buffer_pool_manager_->FlushAllPages(ih->fd_);
+        buffer_pool_manager_->DiscardPages(ih->fd_, 0);
+        disk_manager_->close_file(ih->fd_);
+    }
+
+    void close_index(IxIndexHandle *ih) {
+        ih->write_bloom_filter();
+        // file header在缓冲池中常驻的第0页里，解除pin之后和其他page一起刷到磁盘
+        buffer_pool_manager_->UnpinPage(ih->hdr_page_->GetPageId(), false);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
         buffer_pool_manager_->FlushAllPages(ih->fd_);
+        // 关闭后fd可能被其他文件复用，丢弃缓冲池中该文件的页面
+        buffer_pool_manager_->DiscardPages(ih->fd_, 0);
         disk_manager_->close_file(ih->fd_);
     }
 };
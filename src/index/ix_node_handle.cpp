@@ -1,5 +1,7 @@
 #include "ix_node_handle.h"
 
+#include <algorithm>
+
 /**
  * @brief 在当前node中查找第一个>=target的key_idx
  *
@@ -7,51 +9,10 @@
  * @note 返回key index（同时也是rid index），作为slot no
  */
 int IxNodeHandle::lower_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于等于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式，如顺序遍历、二分查找等；使用ix_compare()函数进行比较
-    int num_key = this->page_hdr->num_key;
-    int key_idx = 0;
-    if(binary_search)
-    {
-        //迭代式二分
-        int first = 0,last=num_key-1,middle;
-        char *src;
-        while(first<last)
-        {
-            middle = (first+last)/2;
-            src = get_key(middle);
-            if(ix_compare(src,target,file_hdr->col_type,file_hdr->col_len)<0)
-            {
-                first=middle+1;
-                key_idx=first;
-            }
-            else
-            {
-                last=middle;
-                key_idx=last;
-            }
-        }
-        if(key_idx==num_key-1)
-        {
-            if(ix_compare(get_key(num_key-1),target,file_hdr->col_type,file_hdr->col_len)<0)
-            {
-                return num_key;
-            }
-        }
-    }
-    else
-    {
-        for(key_idx=0;key_idx<num_key;key_idx++)
-        {
-            char* src = get_key(key_idx);
-            if(ix_compare(src,target,file_hdr->col_type,file_hdr->col_len)>=0)
-            {
-                return key_idx;
-            }
-        }
+    if (file_hdr->key_compress) {
+        return var_search<false>(target);
     }
-    return key_idx;
+    return key_search->lower_bound(keys, page_hdr->num_key, target, file_hdr->col_len);
 }
 
 /**
@@ -61,51 +22,10 @@ int IxNodeHandle::lower_bound(const char *target) const {
  * @note 注意此处的范围从1开始
  */
 int IxNodeHandle::upper_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式：顺序遍历、二分查找等；使用ix_compare()函数进行比较
-    int num_key = this->page_hdr->num_key;
-    int key_idx = 0;
-    if(binary_search)
-    {
-        //迭代式二分
-        int first = 0,last=num_key-1,middle;
-        char *src;
-        while(first<last)
-        {
-            middle = (first+last)/2;
-            src = get_key(middle);
-            if(ix_compare(src,target,file_hdr->col_type,file_hdr->col_len)<=0)
-            {
-                first=middle+1;
-                key_idx=first;
-            }
-            else
-            {
-                last=middle;
-                key_idx=last;
-            }
-        }
-        if(key_idx==num_key-1)
-        {
-            if(ix_compare(get_key(num_key-1),target,file_hdr->col_type,file_hdr->col_len)<=0)
-            {
-                return num_key;
-            }
-        }
-    }
-    else
-    {
-        for(key_idx=0;key_idx<num_key;key_idx++)
-        {
-            char* src = get_key(key_idx);
-            if(ix_compare(src,target,file_hdr->col_type,file_hdr->col_len)>0)
-            {
-                return key_idx;
-            }
-        }
+    if (file_hdr->key_compress) {
+        return var_search<true>(target);
     }
-    return key_idx;
+    return key_search->upper_bound(keys, page_hdr->num_key, target, file_hdr->col_len);
 }
 
 /**
@@ -127,8 +47,7 @@ bool IxNodeHandle::LeafLookup(const char *key, Rid **value) {
     {
         return false;
     } 
-    char* src = get_key(key_idx);
-    if(ix_compare(src,key,file_hdr->col_type,file_hdr->col_len)!=0)
+    if(compare_key(key_idx,key)!=0)
     {
         return false;
     }
@@ -165,7 +84,7 @@ page_id_t IxNodeHandle::InternalLookup(const char *key) {
  *       [0,pos)     [pos,pos+n)   [pos+n,num_key+n)
  *                      key           key_slot
  */
-void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n) {
+void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n, const char *include) {
     // Todo:
     // 1. 判断pos的合法性
     // 2. 通过key获取n个连续键值对的key值，并把n个key值插入到pos位置
@@ -176,6 +95,13 @@ void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n)
     {
         return;
     }
+    if (file_hdr->key_compress) {
+        for (int i = 0; i < n; i++) {
+            var_insert(pos + i, key + i * file_hdr->col_len, rid[i],
+                       include != nullptr ? include + i * file_hdr->include_len : nullptr);
+        }
+        return;
+    }
     for(int i=num_key-1;i>=pos;i--)
     {
         memmove(get_key(i+n),get_key(i),file_hdr->col_len);
@@ -186,6 +112,16 @@ void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n)
         memmove(get_key(pos+i),key+i*file_hdr->col_len,file_hdr->col_len);
         memmove(get_rid(pos+i),rid+i,sizeof(Rid));
     }
+    // INCLUDE列只在叶子结点中有意义，内部结点的include_len同样为file_hdr->include_len但内容不使用
+    int include_len = file_hdr->include_len;
+    if (include_len > 0) {
+        memmove(get_include(pos + n), get_include(pos), (num_key - pos) * include_len);
+        if (include != nullptr) {
+            memcpy(get_include(pos), include, n * include_len);
+        } else {
+            memset(get_include(pos), 0, n * include_len);
+        }
+    }
     page_hdr->num_key += n;
 
     // // 1.
@@ -208,27 +144,30 @@ void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n)
 /**
  * @brief 用于在结点中的指定位置插入单个键值对
  */
-void IxNodeHandle::insert_pair(int pos, const char *key, const Rid &rid) { insert_pairs(pos, key, &rid, 1); };
+void IxNodeHandle::insert_pair(int pos, const char *key, const Rid &rid, const char *include) {
+    insert_pairs(pos, key, &rid, 1, include);
+};
 
 /**
  * @brief 用于在结点中插入单个键值对。
  * 函数返回插入后的键值对数量
  *
  * @param (key, value) 要插入的键值对
+ * @param include 叶子中与rid一起存放的INCLUDE列的值，为空时填0
  * @return int 键值对数量
  */
-int IxNodeHandle::Insert(const char *key, const Rid &value) {
+int IxNodeHandle::Insert(const char *key, const Rid &value, const char *include) {
     // Todo:
     // 1. 查找要插入的键值对应该插入到当前节点的哪个位置
     // 2. 如果key重复则不插入
     // 3. 如果key不重复则插入键值对
     // 4. 返回完成插入操作之后的键值对数量
     int key_idx = lower_bound(key);
-    if(key_idx<page_hdr->num_key&&ix_compare(get_key(key_idx),key,file_hdr->col_type,file_hdr->col_len)==0)
+    if(key_idx<page_hdr->num_key&&compare_key(key_idx,key)==0)
     {
         return page_hdr->num_key;
     }
-    insert_pair(key_idx,key,value);
+    insert_pair(key_idx,key,value,include);
     return page_hdr->num_key;
 }
 
@@ -248,8 +187,13 @@ void IxNodeHandle::erase_pair(int pos) {
     {
         return;
     }
+    if (file_hdr->key_compress) {
+        var_erase(pos);
+        return;
+    }
     memmove(get_key(pos),get_key(pos+1),(num_key-pos-1)*file_hdr->col_len);
     memmove(get_rid(pos),get_rid(pos+1),(num_key-pos-1)*sizeof(Rid));
+    memmove(get_include(pos),get_include(pos+1),(num_key-pos-1)*file_hdr->include_len);
     page_hdr->num_key -= 1;
 }
 
@@ -266,7 +210,7 @@ int IxNodeHandle::Remove(const char *key) {
     // 3. 返回完成删除操作后的键值对数量
 
     int key_idx = lower_bound(key);
-    if(key_idx<page_hdr->num_key&&ix_compare(get_key(key_idx),key,file_hdr->col_type,file_hdr->col_len)==0)
+    if(key_idx<page_hdr->num_key&&compare_key(key_idx,key)==0)
     {
         erase_pair(key_idx);
     }
@@ -301,4 +245,296 @@ page_id_t IxNodeHandle::RemoveAndReturnOnlyChild() {
     erase_pair(0);
     assert(GetSize() == 0);
     return child_page_no;
-}
\ No newline at end of file
+}
+/**
+ * @brief 修改第key_idx个key，rid和INCLUDE列不变
+ * 变长key结点中新旧key的长度可能不同，先删除再在原位置插入
+ */
+void IxNodeHandle::set_key(int key_idx, const char *key) {
+    if (!file_hdr->key_compress) {
+        memcpy(keys + key_idx * file_hdr->col_len, key, file_hdr->col_len);
+        return;
+    }
+    Rid rid = *get_rid(key_idx);
+    std::vector<char> include;
+    if (page_hdr->is_leaf) {
+        include.assign(get_include(key_idx), get_include(key_idx) + file_hdr->include_len);
+    }
+    var_erase(key_idx);
+    var_insert(key_idx, key, rid, include.empty() ? nullptr : include.data());
+}
+
+void IxNodeHandle::read_key(int key_idx, char *key) const {
+    if (!file_hdr->key_compress) {
+        memcpy(key, get_key(key_idx), file_hdr->col_len);
+        return;
+    }
+    // 公共前缀 + 前缀之后的部分，其余补0
+    const IxVarSlot *slot = var_slot(key_idx);
+    memcpy(key, var_prefix(), var_hdr->prefix_sig);
+    memset(key + var_hdr->prefix_sig, 0, file_hdr->col_len - var_hdr->prefix_sig);
+    memcpy(key + var_hdr->prefix_len, page->GetData() + slot->key_off, slot->key_len);
+}
+
+int IxNodeHandle::compare_key(int key_idx, const char *key) const {
+    if (!file_hdr->key_compress) {
+        return memcmp(get_key(key_idx), key, file_hdr->col_len);
+    }
+    char buf[IX_MAX_COL_LEN];
+    read_key(key_idx, buf);
+    return memcmp(buf, key, file_hdr->col_len);
+}
+
+bool IxNodeHandle::IsUnderflow() {
+    if (!file_hdr->key_compress) {
+        return GetSize() < GetMinSize();
+    }
+    int min_size = IsLeafPage() ? 1 : 2;
+    return GetSize() < min_size || (GetSize() < GetMinSize() && used_bytes() < IX_VAR_MIN_USED);
+}
+
+/** -- 以下为变长key结点的辅助函数 -- */
+void IxNodeHandle::var_reset() {
+    page_hdr->num_key = 0;
+    var_hdr->prefix_len = 0;
+    var_hdr->prefix_sig = 0;
+    var_hdr->heap_begin = PAGE_SIZE;
+    var_hdr->garbage = 0;
+}
+
+/**
+ * @brief 用entries的[begin,end)重写结点，叶子结点的公共前缀取第一个和最后一个key的公共前缀
+ */
+void IxNodeHandle::rebuild(const IxEntryList &entries, int begin, int end) {
+    if (end - begin > file_hdr->btree_order || entries.encoded_size(page_hdr->is_leaf, begin, end) > PAGE_SIZE) {
+        throw InternalError("IxNodeHandle::rebuild: entries do not fit in one node");
+    }
+    var_reset();
+    if (page_hdr->is_leaf && end > begin) {
+        int prefix_len = entries.prefix_len(begin, end);
+        int prefix_sig = ix_key_sig_len(entries.key(begin), prefix_len);
+        var_hdr->prefix_len = prefix_len;
+        var_hdr->prefix_sig = prefix_sig;
+        var_hdr->heap_begin = PAGE_SIZE - prefix_sig;
+        memcpy(page->GetData() + var_hdr->heap_begin, entries.key(begin), prefix_sig);
+    }
+    for (int i = begin; i < end; i++) {
+        var_insert(page_hdr->num_key, entries.key(i), entries.rid(i), entries.include(i));
+    }
+}
+
+int IxNodeHandle::used_bytes() const {
+    if (!file_hdr->key_compress) {
+        int entry_len = file_hdr->col_len + static_cast<int>(sizeof(Rid)) + file_hdr->include_len;
+        return static_cast<int>(sizeof(IxPageHdr)) + page_hdr->num_key * entry_len;
+    }
+    return var_header_size() + page_hdr->num_key * var_slot_size(file_hdr, page_hdr->is_leaf) +
+           (PAGE_SIZE - var_hdr->heap_begin - var_hdr->garbage);
+}
+
+int IxNodeHandle::entry_bytes(const char *key) const {
+    int key_len = std::max(0, ix_key_sig_len(key, file_hdr->col_len) - var_hdr->prefix_len);
+    return var_slot_size(file_hdr, page_hdr->is_leaf) + key_len;
+}
+
+bool IxNodeHandle::can_insert(const char *key) const {
+    if (page_hdr->num_key + 1 > file_hdr->btree_order) {
+        return false;
+    }
+    if (!file_hdr->key_compress) {
+        return true;
+    }
+    if (var_has_prefix(key)) {
+        return entry_bytes(key) <= free_bytes();
+    }
+    // key不以公共前缀开头，插入时前缀缩短为二者的公共部分并重写结点，按重写后的大小计算
+    int prefix_len = var_hdr->prefix_len;
+    int prefix_sig = var_hdr->prefix_sig;
+    const char *prefix = var_prefix();
+    int new_len = 0;
+    while (new_len < prefix_len && key[new_len] == (new_len < prefix_sig ? prefix[new_len] : 0)) {
+        new_len++;
+    }
+    int size = var_header_size() + ix_key_sig_len(prefix, std::min(new_len, prefix_sig)) +
+               (page_hdr->num_key + 1) * var_slot_size(file_hdr, page_hdr->is_leaf) +
+               std::max(0, ix_key_sig_len(key, file_hdr->col_len) - new_len);
+    for (int i = 0; i < page_hdr->num_key; i++) {
+        int key_len = var_slot(i)->key_len;
+        int sig = key_len > 0 ? prefix_len + key_len : prefix_sig;
+        size += std::max(0, sig - new_len);
+    }
+    return size <= PAGE_SIZE;
+}
+
+bool IxNodeHandle::can_replace_key(int key_idx, const char *key) const {
+    if (!file_hdr->key_compress) {
+        return true;
+    }
+    // 只有内部结点会替换key，内部结点没有公共前缀
+    if (!var_has_prefix(key)) {
+        return false;
+    }
+    return entry_bytes(key) - var_slot_size(file_hdr, page_hdr->is_leaf) - var_slot(key_idx)->key_len <= free_bytes();
+}
+
+bool IxNodeHandle::var_has_prefix(const char *key) const {
+    if (memcmp(key, var_prefix(), var_hdr->prefix_sig) != 0) {
+        return false;
+    }
+    for (int i = var_hdr->prefix_sig; i < var_hdr->prefix_len; i++) {
+        if (key[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 变长key结点中的二分查找，语义与lower_bound/upper_bound相同
+ * target的前prefix_len个字节与公共前缀不同时，结点中的key都大于或都小于target，不需要查找；
+ * 否则只比较前缀之后的部分，省略的末尾0按补0比较
+ */
+template <bool Upper>
+int IxNodeHandle::var_search(const char *target) const {
+    int num_key = page_hdr->num_key;
+    int prefix_len = var_hdr->prefix_len;
+    int cmp = memcmp(var_prefix(), target, var_hdr->prefix_sig);
+    for (int i = var_hdr->prefix_sig; cmp == 0 && i < prefix_len; i++) {
+        cmp = target[i] != 0 ? -1 : 0;
+    }
+    if (cmp != 0) {
+        return cmp < 0 ? num_key : 0;
+    }
+    const char *rest = target + prefix_len;
+    int rest_len = ix_key_sig_len(rest, file_hdr->col_len - prefix_len);
+    int first = 0, last = num_key;
+    while (first < last) {
+        int middle = (first + last) / 2;
+        const IxVarSlot *slot = var_slot(middle);
+        cmp = memcmp(page->GetData() + slot->key_off, rest, std::min<int>(slot->key_len, rest_len));
+        if (cmp == 0) {
+            cmp = slot->key_len < rest_len ? -1 : (slot->key_len > rest_len ? 1 : 0);
+        }
+        if (Upper ? cmp <= 0 : cmp < 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief 在pos处插入一个entry，key不以公共前缀开头时缩短前缀并重写整个结点
+ * @note 调用前需要由can_insert()确认结点放得下
+ */
+void IxNodeHandle::var_insert(int pos, const char *key, const Rid &rid, const char *include) {
+    if (!var_has_prefix(key)) {
+        IxEntryList entries(file_hdr);
+        entries.append(this, 0, pos);
+        entries.push_back(key, rid, include);
+        entries.append(this, pos, page_hdr->num_key);
+        rebuild(entries, 0, entries.size());
+        return;
+    }
+    int num_key = page_hdr->num_key;
+    int slot_size = var_slot_size(file_hdr, page_hdr->is_leaf);
+    int key_len = std::max(0, ix_key_sig_len(key, file_hdr->col_len) - var_hdr->prefix_len);
+    if (var_header_size() + (num_key + 1) * slot_size + key_len > var_hdr->heap_begin) {
+        var_compact();
+    }
+    assert(var_header_size() + (num_key + 1) * slot_size + key_len <= var_hdr->heap_begin);
+    var_hdr->heap_begin -= key_len;
+    memcpy(page->GetData() + var_hdr->heap_begin, key + var_hdr->prefix_len, key_len);
+    memmove(slots + (pos + 1) * slot_size, slots + pos * slot_size, (num_key - pos) * slot_size);
+    IxVarSlot *slot = var_slot(pos);
+    slot->rid = rid;
+    slot->key_off = var_hdr->heap_begin;
+    slot->key_len = key_len;
+    if (page_hdr->is_leaf && file_hdr->include_len > 0) {
+        if (include != nullptr) {
+            set_include(pos, include);
+        } else {
+            memset(get_include(pos), 0, file_hdr->include_len);
+        }
+    }
+    page_hdr->num_key++;
+}
+
+/**
+ * @brief 删除pos处的entry，key的字节位于存放区域最前面时直接回收，否则记为碎片，在空间不够时由var_compact()整理
+ */
+void IxNodeHandle::var_erase(int pos) {
+    int slot_size = var_slot_size(file_hdr, page_hdr->is_leaf);
+    const IxVarSlot *slot = var_slot(pos);
+    if (slot->key_off == var_hdr->heap_begin) {
+        var_hdr->heap_begin += slot->key_len;
+    } else {
+        var_hdr->garbage += slot->key_len;
+    }
+    memmove(slots + pos * slot_size, slots + (pos + 1) * slot_size, (page_hdr->num_key - pos - 1) * slot_size);
+    page_hdr->num_key--;
+}
+
+void IxNodeHandle::var_compact() {
+    char buf[PAGE_SIZE];
+    char *data = page->GetData();
+    int end = PAGE_SIZE - var_hdr->prefix_sig;
+    int heap_begin = end;
+    for (int i = 0; i < page_hdr->num_key; i++) {
+        IxVarSlot *slot = var_slot(i);
+        heap_begin -= slot->key_len;
+        memcpy(buf + heap_begin, data + slot->key_off, slot->key_len);
+        slot->key_off = heap_begin;
+    }
+    memcpy(data + heap_begin, buf + heap_begin, end - heap_begin);
+    var_hdr->heap_begin = heap_begin;
+    var_hdr->garbage = 0;
+}
+
+void IxEntryList::push_back(const char *key, const Rid &rid, const char *include) {
+    keys_.insert(keys_.end(), key, key + file_hdr_->col_len);
+    rids_.push_back(rid);
+    size_t pos = includes_.size();
+    includes_.resize(pos + file_hdr_->include_len);
+    if (include != nullptr) {
+        memcpy(includes_.data() + pos, include, file_hdr_->include_len);
+    }
+    sig_lens_.push_back(ix_key_sig_len(key, file_hdr_->col_len));
+}
+
+void IxEntryList::append(const IxNodeHandle *node, int begin, int end) {
+    char key[IX_MAX_COL_LEN];
+    for (int i = begin; i < end; i++) {
+        node->read_key(i, key);
+        push_back(key, *node->get_rid(i), node->page_hdr->is_leaf ? node->get_include(i) : nullptr);
+    }
+}
+
+void IxEntryList::set_key(int i, const char *key) {
+    memcpy(keys_.data() + (size_t)i * file_hdr_->col_len, key, file_hdr_->col_len);
+    sig_lens_[i] = ix_key_sig_len(key, file_hdr_->col_len);
+}
+
+void IxEntryList::clear() {
+    keys_.clear();
+    rids_.clear();
+    includes_.clear();
+    sig_lens_.clear();
+}
+
+int IxEntryList::prefix_len(int begin, int end) const {
+    return end > begin ? ix_key_common_prefix(key(begin), key(end - 1), file_hdr_->col_len) : 0;
+}
+
+int IxEntryList::encoded_size(bool is_leaf, int begin, int end) const {
+    int prefix = is_leaf ? prefix_len(begin, end) : 0;
+    int size = IxNodeHandle::var_header_size() + (end - begin) * IxNodeHandle::var_slot_size(file_hdr_, is_leaf);
+    if (prefix > 0) {
+        size += ix_key_sig_len(key(begin), prefix);
+    }
+    for (int i = begin; i < end; i++) {
+        size += std::max(0, sig_lens_[i] - prefix);
+    }
+    return size;
+}
@@ -1,10 +1,14 @@
 #pragma once
+#include <vector>
+
 #include "ix_defs.h"
+#include "ix_node_search.h"
 
-static const bool binary_search = true;  // 控制在lower_bound/uppper_bound函数中是否使用二分查找
+class IxEntryList;
 
 /**
  * @brief 用于比较两个指针指向的数组（类型支持int*、float*、char*）
+ * @note 用于比较记录中的原始值；索引结点中的key经过ix_normalize_key编码，直接用memcmp比较
  */
 inline int ix_compare(const char *a, const char *b, ColType type, int col_len) {
     switch (type) {
@@ -33,23 +37,43 @@ inline int ix_compare(const char *a, const char *b, ColType type, int col_len) {
 class IxNodeHandle {
     friend class IxIndexHandle;
     friend class IxScan;
+    friend class IxEntryList;
 
    private:
     const IxFileHdr *file_hdr;  // 用到了file_hdr的keys_size, col_len
+    const IxKeySearch *key_search;  // 所属索引按key长度选择的结点内查找函数
     Page *page;
 
     /** page->data的第一部分，指针指向首地址，后续占用长度为sizeof(IxPageHdr) */
     IxPageHdr *page_hdr;
-    /** page->data的第二部分，指针指向首地址，后续占用长度为file_hdr->keys_size，每个key的长度为file_hdr->col_len */
+    /** page->data的第二部分，指针指向首地址，后续占用长度为file_hdr->keys_size，每个key的长度为file_hdr->col_len
+     *  存放的是ix_normalize_key编码后的key，结点内的所有比较都是memcmp */
     char *keys;
     /** page->data的第三部分，指针指向首地址，每个rid的长度为sizeof(Rid) */
     Rid *rids;
+    /** page->data的第四部分，叶子结点中与rid一一对应的INCLUDE列的值，每项长度为file_hdr->include_len */
+    char *includes;
+    /** 变长key结点（file_hdr->key_compress）的页头和slot数组，此时不使用keys、rids和includes */
+    IxVarPageHdr *var_hdr;
+    char *slots;
 
    public:
-    IxNodeHandle(const IxFileHdr *file_hdr_, Page *page_) : file_hdr(file_hdr_), page(page_) {
+    IxNodeHandle(const IxFileHdr *file_hdr_, const IxKeySearch *key_search_, Page *page_)
+        : file_hdr(file_hdr_), key_search(key_search_), page(page_) {
         page_hdr = reinterpret_cast<IxPageHdr *>(page->GetData());
-        keys = page->GetData() + sizeof(IxPageHdr);
-        rids = reinterpret_cast<Rid *>(keys + file_hdr->keys_size);
+        if (file_hdr->key_compress) {
+            var_hdr = reinterpret_cast<IxVarPageHdr *>(page->GetData() + sizeof(IxPageHdr));
+            slots = reinterpret_cast<char *>(var_hdr + 1);
+            keys = nullptr;
+            rids = nullptr;
+            includes = nullptr;
+        } else {
+            keys = page->GetData() + sizeof(IxPageHdr);
+            rids = reinterpret_cast<Rid *>(keys + file_hdr->keys_size);
+            includes = reinterpret_cast<char *>(rids + file_hdr->keys_size / file_hdr->col_len);
+            var_hdr = nullptr;
+            slots = nullptr;
+        }
     }
 
     IxNodeHandle() = default;
@@ -79,7 +103,7 @@ class IxNodeHandle {
      *
      * @return the size after Insert
      */
-    int Insert(const char *key, const Rid &value);
+    int Insert(const char *key, const Rid &value, const char *include = nullptr);
 
     /**
      * @brief used in leaf node to remove (key,value) which contains the key
@@ -90,15 +114,16 @@ class IxNodeHandle {
 
     /**
      * @brief 将key的前n位插入到原来keys中的pos位置；将rid的前n位插入到原来rids中的pos位置
+     * include不为空时同样插入n个INCLUDE列的值，为空时对应位置填0
      *
      * @note [0,pos)           [pos,num_key)
      *                            key_slot
      *       [0,pos)     [pos,pos+n)   [pos+n,num_key+n)
      *                      key           key_slot
      */
-    void insert_pairs(int pos, const char *key, const Rid *rid, int n);
+    void insert_pairs(int pos, const char *key, const Rid *rid, int n, const char *include = nullptr);
 
-    void insert_pair(int pos, const char *key, const Rid &rid);
+    void insert_pair(int pos, const char *key, const Rid &rid, const char *include = nullptr);
 
     void erase_pair(int pos);
 
@@ -110,13 +135,33 @@ class IxNodeHandle {
     int find_child(IxNodeHandle *child);
 
     /** 以下为已经实现了的辅助函数 **/
-    char *get_key(int key_idx) const { return keys + key_idx * file_hdr->col_len; }
+    // 定长key结点中第key_idx个key的地址；变长key结点中的key不是完整存放的，使用read_key()
+    char *get_key(int key_idx) const {
+        assert(!file_hdr->key_compress);
+        return keys + key_idx * file_hdr->col_len;
+    }
+
+    Rid *get_rid(int rid_idx) const { return file_hdr->key_compress ? &var_slot(rid_idx)->rid : &rids[rid_idx]; }
+
+    /**
+     * @brief 修改第key_idx个key，变长key结点中新key的长度可以不同，调用前需要由can_replace_key()确认空间足够
+     */
+    void set_key(int key_idx, const char *key);
 
-    Rid *get_rid(int rid_idx) const { return &rids[rid_idx]; }
+    void set_rid(int rid_idx, const Rid &rid) { *get_rid(rid_idx) = rid; }
 
-    void set_key(int key_idx, const char *key) { memcpy(keys + key_idx * file_hdr->col_len, key, file_hdr->col_len); }
+    char *get_include(int idx) const {
+        return file_hdr->key_compress ? reinterpret_cast<char *>(var_slot(idx) + 1)
+                                      : includes + idx * file_hdr->include_len;
+    }
+
+    void set_include(int idx, const char *include) { memcpy(get_include(idx), include, file_hdr->include_len); }
 
-    void set_rid(int rid_idx, const Rid &rid) { rids[rid_idx] = rid; }
+    // 把第key_idx个完整的key（长度为col_len）复制到key中，两种结点都可以使用
+    void read_key(int key_idx, char *key) const;
+
+    // 第key_idx个key与key比较（memcmp序）
+    int compare_key(int key_idx, const char *key) const;
 
     int GetSize() { return page_hdr->num_key; }
 
@@ -126,7 +171,21 @@ class IxNodeHandle {
 
     int GetMinSize() { return GetMaxSize() / 2; }
 
-    int KeyAt(int i) { return *(int *)get_key(i); }
+    /**
+     * @brief 结点是否需要合并或重分配
+     * 定长key结点按key的数量判断；变长key结点的容量取决于key的长度，按字节数判断，
+     * 此外叶子结点至少要有1个key，内部结点至少要有2个孩子
+     */
+    bool IsUnderflow();
+
+    // 结点中存放的是编码后的key，INT类型的key需要解码后才能作为int使用
+    int KeyAt(int i) {
+        char buf[IX_MAX_COL_LEN];
+        read_key(i, buf);
+        int key;
+        ix_denormalize_key(buf, TYPE_INT, sizeof(int), (char *)&key);
+        return key;
+    }
 
     /**
      * @brief 得到第i个孩子结点的page_no
@@ -159,4 +218,95 @@ class IxNodeHandle {
      * @return the last child
      */
     page_id_t RemoveAndReturnOnlyChild();
+
+    /** 以下为变长key结点的辅助函数 **/
+    static int var_slot_size(const IxFileHdr *file_hdr, bool is_leaf) {
+        int size = static_cast<int>(sizeof(IxVarSlot)) + (is_leaf ? file_hdr->include_len : 0);
+        return (size + alignof(Rid) - 1) / alignof(Rid) * alignof(Rid);
+    }
+
+    static constexpr int var_header_size() { return sizeof(IxPageHdr) + sizeof(IxVarPageHdr); }
+
+    // 初始化为空的变长key结点，page_hdr->is_leaf需要已经设置好
+    void var_reset();
+
+    /**
+     * @brief 用entries的[begin,end)重写整个变长key结点，重新计算公共前缀
+     */
+    void rebuild(const IxEntryList &entries, int begin, int end);
+
+    // 结点已经占用的字节数（包括页头）
+    int used_bytes() const;
+
+    int free_bytes() const { return PAGE_SIZE - used_bytes(); }
+
+    /**
+     * @brief 插入key之后结点不会超过容量（变长key结点同时考虑key的数量上限btree_order和字节数）
+     */
+    bool can_insert(const char *key) const;
+
+    // 把第key_idx个key换成key之后是否放得下
+    bool can_replace_key(int key_idx, const char *key) const;
+
+    // key在本结点中占用的字节数（slot和去掉公共前缀、末尾的0之后的key）
+    int entry_bytes(const char *key) const;
+
+   private:
+    IxVarSlot *var_slot(int idx) const {
+        return reinterpret_cast<IxVarSlot *>(slots + idx * var_slot_size(file_hdr, page_hdr->is_leaf));
+    }
+
+    const char *var_prefix() const { return page->GetData() + PAGE_SIZE - var_hdr->prefix_sig; }
+
+    bool var_has_prefix(const char *key) const;
+
+    template <bool Upper>
+    int var_search(const char *target) const;
+
+    void var_insert(int pos, const char *key, const Rid &rid, const char *include);
+
+    void var_erase(int pos);
+
+    void var_compact();
+};
+
+/**
+ * @brief 一组完整的entry（key补齐到col_len），按顺序存放
+ * 变长key结点分裂、合并和重分配时先把entry都取出来，选好划分位置后再用IxNodeHandle::rebuild()写回
+ */
+class IxEntryList {
+   public:
+    explicit IxEntryList(const IxFileHdr *file_hdr) : file_hdr_(file_hdr) {}
+
+    int size() const { return static_cast<int>(rids_.size()); }
+
+    const char *key(int i) const { return keys_.data() + (size_t)i * file_hdr_->col_len; }
+
+    const Rid &rid(int i) const { return rids_[i]; }
+
+    const char *include(int i) const { return includes_.data() + (size_t)i * file_hdr_->include_len; }
+
+    int sig_len(int i) const { return sig_lens_[i]; }
+
+    void push_back(const char *key, const Rid &rid, const char *include);
+
+    // 依次取出node的第[begin,end)个entry
+    void append(const IxNodeHandle *node, int begin, int end);
+
+    void set_key(int i, const char *key);
+
+    void clear();
+
+    // 把[begin,end)写入一个变长key结点需要的字节数（包括页头）
+    int encoded_size(bool is_leaf, int begin, int end) const;
+
+    // 叶子结点中[begin,end)的公共前缀长度
+    int prefix_len(int begin, int end) const;
+
+   private:
+    const IxFileHdr *file_hdr_;
+    std::vector<char> keys_;
+    std::vector<Rid> rids_;
+    std::vector<char> includes_;
+    std::vector<int> sig_lens_;  // 每个key去掉末尾的0之后的长度
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "ix_key.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IX_SEARCH_X86
+#endif
+
+// 结点内查找时，二分缩小到不超过该数量的key后改为线性比较（约为一到两个cache line）
+constexpr int IX_SEARCH_LINEAR_KEYS = 16;
+
+/**
+ * @brief 结点内查找函数：在有序的keys[0,num_key)中查找第一个>=target（lower_bound）或>target（upper_bound）的位置
+ * keys和target都是ix_normalize_key编码后的key，按memcmp比较
+ */
+using IxSearchFn = int (*)(const char *keys, int num_key, const char *target, int col_len);
+
+// 4字节的编码key按大端序读出后，无符号整数的大小关系与memcmp一致
+inline uint32_t ix_load_key32(const char *key) {
+    uint32_t bits;
+    memcpy(&bits, key, sizeof(bits));
+    return __builtin_bswap32(bits);
+}
+
+// 统计base[0,n)中排在target之前的key个数：lower_bound为key<target，upper_bound为key<=target
+template <bool Upper>
+inline int ix_count_before_scalar(const char *base, int n, uint32_t target) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t key = ix_load_key32(base + i * sizeof(uint32_t));
+        count += Upper ? key <= target : key < target;
+    }
+    return count;
+}
+
+#ifdef IX_SEARCH_X86
+template <bool Upper>
+__attribute__((target("avx2"))) inline int ix_count_before_avx2(const char *base, int n, uint32_t target) {
+    // 每个32位lane内部反转字节序，并翻转符号位，使有符号比较等价于无符号比较
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,  //
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+    __m256i t = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(target)), sign);
+    int count = 0;
+    for (int i = 0; i < n; i += 8) {
+        int len = n - i < 8 ? n - i : 8;
+        // 只读取有效的key，mask的lane i为全1当且仅当i<len
+        __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(len), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256i keys = _mm256_maskload_epi32(reinterpret_cast<const int *>(base) + i, valid);
+        keys = _mm256_xor_si256(_mm256_shuffle_epi8(keys, bswap), sign);
+        __m256i before = Upper ? _mm256_andnot_si256(_mm256_cmpgt_epi32(keys, t), valid)
+                               : _mm256_and_si256(_mm256_cmpgt_epi32(t, keys), valid);
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(before)));
+    }
+    return count;
+}
+#endif
+
+/**
+ * @brief 4字节key的查找：无分支的二分查找把范围缩小到IX_SEARCH_LINEAR_KEYS个key以内，再由CountBefore线性比较
+ */
+template <bool Upper, int (*CountBefore)(const char *, int, uint32_t)>
+inline int ix_search_key32(const char *keys, int num_key, const char *target, int) {
+    const char *base = keys;
+    uint32_t t = ix_load_key32(target);
+    int n = num_key;
+    while (n > IX_SEARCH_LINEAR_KEYS) {
+        int half = n / 2;
+        uint32_t key = ix_load_key32(base + half * sizeof(uint32_t));
+        bool before = Upper ? key <= t : key < t;
+        base = before ? base + half * sizeof(uint32_t) : base;  // 编译为条件传送
+        n -= half;
+    }
+    return static_cast<int>((base - keys) / sizeof(uint32_t)) + CountBefore(base, n, t);
+}
+
+#ifdef IX_SEARCH_X86
+// 整个查找函数在AVX2 target下编译，使ix_search_key32和ix_count_before_avx2都能内联
+template <bool Upper>
+__attribute__((target("avx2"))) int ix_search_key32_avx2(const char *keys, int num_key, const char *target,
+                                                          int col_len) {
+    return ix_search_key32<Upper, ix_count_before_avx2<Upper>>(keys, num_key, target, col_len);
+}
+#endif
+
+// 任意长度key的查找：逐次memcmp的二分查找
+template <bool Upper>
+int ix_search_bytes(const char *keys, int num_key, const char *target, int col_len) {
+    int lo = 0, hi = num_key;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = memcmp(keys + mid * col_len, target, col_len);
+        if (Upper ? cmp <= 0 : cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief 一个索引使用的结点内查找函数，由IxIndexHandle根据key长度选择一次，此后的查找不再判断
+ * key经过编码后比较规则与类型无关：4字节的key（INT、FLOAT、CHAR(4)）使用整数比较，其余使用memcmp
+ */
+struct IxKeySearch {
+    IxSearchFn lower_bound;
+    IxSearchFn upper_bound;
+
+    /**
+     * @param col_len key的长度
+     * @param use_simd CPU支持AVX2时是否使用向量化的线性比较
+     */
+    static IxKeySearch get(int col_len, bool use_simd = true) {
+        if (col_len != sizeof(uint32_t)) {
+            return {ix_search_bytes<false>, ix_search_bytes<true>};
+        }
+#ifdef IX_SEARCH_X86
+        if (use_simd && cpu_has_avx2()) {
+            return {ix_search_key32_avx2<false>, ix_search_key32_avx2<true>};
+        }
+#endif
+        return {ix_search_key32<false, ix_count_before_scalar<false>>,
+                ix_search_key32<true, ix_count_before_scalar<true>>};
+    }
+
+    static bool cpu_has_avx2() {
+#ifdef IX_SEARCH_X86
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+};
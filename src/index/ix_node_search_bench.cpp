@@ -0,0 +1,142 @@
+/**
+ * @brief 结点内查找的性能测试
+ * 1. 在满的INT结点上比较原来在原始key上逐次ix_compare的二分查找，以及编码后的key上的memcmp二分查找、
+ *    无分支二分+标量线性查找、无分支二分+AVX2线性查找
+ * 2. 在批量构建的INT索引上比较后三种查找方式的点查询吞吐量
+ *
+ * 用法：ix_node_search_bench [索引key数量]
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#define private public
+#include "ix.h"
+#undef private
+
+static const std::string BENCH_DB_NAME = "IxNodeSearchBench_db";
+static const std::string BENCH_FILE_NAME = "bench";
+
+// 原来IxNodeHandle::lower_bound/upper_bound的实现：每次比较都通过ix_compare判断类型
+template <bool Upper>
+static int legacy_search(const char *keys, int num_key, const char *target, int col_len) {
+    int first = 0, last = num_key;
+    while (first < last) {
+        int middle = (first + last) / 2;
+        int cmp = ix_compare(keys + middle * col_len, target, TYPE_INT, col_len);
+        if (Upper ? cmp <= 0 : cmp < 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+template <typename F>
+static double measure(F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void bench_node(int order) {
+    const int num_probes = 2000000;
+    std::vector<int> keys(order);
+    for (int i = 0; i < order; i++) {
+        keys[i] = 2 * i;
+    }
+    std::vector<int> targets(1 << 16);
+    std::mt19937 rng(0);
+    for (auto &t : targets) {
+        t = rng() % (2 * order);
+    }
+    // 新的查找函数使用编码后的key
+    std::vector<int> norm_keys(order), norm_targets(targets.size());
+    for (int i = 0; i < order; i++) {
+        ix_normalize_key((const char *)&keys[i], TYPE_INT, sizeof(int), (char *)&norm_keys[i]);
+    }
+    for (size_t i = 0; i < targets.size(); i++) {
+        ix_normalize_key((const char *)&targets[i], TYPE_INT, sizeof(int), (char *)&norm_targets[i]);
+    }
+    auto run = [&](const char *name, IxSearchFn fn, bool normalized) {
+        const std::vector<int> &node = normalized ? norm_keys : keys;
+        const std::vector<int> &probes = normalized ? norm_targets : targets;
+        long long sum = 0;
+        double secs = measure([&] {
+            for (int i = 0; i < num_probes; i++) {
+                sum += fn((const char *)node.data(), order, (const char *)&probes[i & 0xFFFF], sizeof(int));
+            }
+        });
+        printf("node search %-8s keys=%d: %8.2f Mops/s (checksum %lld)\n", name, order, num_probes / secs / 1e6, sum);
+    };
+    run("legacy", legacy_search<false>, false);
+    run("memcmp", ix_search_bytes<false>, true);
+    run("scalar", IxKeySearch::get(sizeof(int), false).lower_bound, true);
+    if (IxKeySearch::cpu_has_avx2()) {
+        run("avx2", IxKeySearch::get(sizeof(int), true).lower_bound, true);
+    }
+}
+
+static void bench_tree(int num_keys) {
+    DiskManager disk_manager;
+    BufferPoolManager bpm(8192, &disk_manager);
+    IxManager ix_manager(&disk_manager, &bpm);
+    if (disk_manager.is_dir(BENCH_DB_NAME)) {
+        disk_manager.destroy_dir(BENCH_DB_NAME);
+    }
+    disk_manager.create_dir(BENCH_DB_NAME);
+    if (chdir(BENCH_DB_NAME.c_str()) < 0) {
+        throw UnixError();
+    }
+    ix_manager.create_index(BENCH_FILE_NAME, 0, TYPE_INT, sizeof(int));
+    auto ih = ix_manager.open_index(BENCH_FILE_NAME, 0);
+    {
+        IxSorter sorter(&disk_manager, sizeof(int), 0, BENCH_FILE_NAME);
+        char key_buf[sizeof(int)];
+        for (int key = 0; key < num_keys; key++) {
+            sorter.add(ih->normalize_key((const char *)&key, key_buf), Rid{.page_no = key, .slot_no = 0});
+        }
+        sorter.finish();
+        ih->bulk_load(&sorter);
+    }
+
+    const int num_lookups = 200000;
+    std::vector<int> targets(num_lookups);
+    std::mt19937 rng(0);
+    for (auto &t : targets) {
+        t = rng() % num_keys;
+    }
+    auto run = [&](const char *name, IxKeySearch key_search) {
+        ih->key_search_ = key_search;
+        std::vector<Rid> result;
+        double secs = measure([&] {
+            for (int key : targets) {
+                result.clear();
+                ih->GetValue((const char *)&key, &result, nullptr);
+            }
+        });
+        printf("point lookup %-8s keys=%d: %8.3f Mops/s\n", name, num_keys, num_lookups / secs / 1e6);
+    };
+    run("memcmp", IxKeySearch{ix_search_bytes<false>, ix_search_bytes<true>});
+    run("scalar", IxKeySearch::get(sizeof(int), false));
+    if (IxKeySearch::cpu_has_avx2()) {
+        run("avx2", IxKeySearch::get(sizeof(int), true));
+    }
+
+    ix_manager.close_index(ih.get());
+    if (chdir("..") < 0) {
+        throw UnixError();
+    }
+    disk_manager.destroy_dir(BENCH_DB_NAME);
+}
+
+int main(int argc, char **argv) {
+    int num_keys = argc > 1 ? atoi(argv[1]) : 200000;
+    printf("avx2 supported: %s\n", IxKeySearch::cpu_has_avx2() ? "yes" : "no");
+    for (int order : {64, 338}) {
+        bench_node(order);
+    }
+    bench_tree(num_keys);
+    return 0;
+}
@@ -1,22 +1,78 @@
 #include "ix_scan.h"
 
+#include <algorithm>
+
+IxScan::IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm,
+               bool read_entries)
+    : ih_(ih), iid_(lower), end_(upper), bpm_(bpm), read_entries_(read_entries) {
+    load_batch();
+}
+
 /**
- * @brief 找到leaf page的下一个slot_no
+ * @brief 移动到下一个entry，当前批次取完时取出下一个叶子中的entry
  */
 void IxScan::next() {
     assert(!is_end());
-    IxNodeHandle *node = ih_->FetchNode(iid_.page_no);
-    assert(node->IsLeafPage());
-    assert(iid_.slot_no < node->GetSize());
-    // increment slot no
-    iid_.slot_no++;
-    if (iid_.page_no != ih_->file_hdr_.last_leaf && iid_.slot_no == node->GetSize()) {
-        // go to next leaf
-        iid_.slot_no = 0;
-        iid_.page_no = node->GetNextLeaf();
+    pos_++;
+    if (pos_ < rids_.size()) {
+        iid_.slot_no = batch_begin_ + (int)pos_;
+        return;
     }
+    if (end_.page_no == iid_.page_no || next_leaf_ == IX_LEAF_HEADER_PAGE) {
+        iid_ = end_;
+        return;
+    }
+    iid_ = {.page_no = next_leaf_, .slot_no = 0};
+    load_batch();
 }
 
-Rid IxScan::rid() const {
-    return ih_->get_rid(iid_);
+Rid IxScan::entry(char *key, char *include) const {
+    assert(read_entries_);
+    int key_len = ih_->key_len(), include_len = ih_->file_hdr_.include_len;
+    memcpy(key, keys_.data() + pos_ * key_len, key_len);
+    memcpy(include, includes_.data() + pos_ * include_len, include_len);
+    return rids_[pos_];
+}
+
+/**
+ * @brief 从iid_所在的叶子中取出[iid_, 区间终点或叶子末尾)的entry作为新的批次，并预读下一个叶子
+ * 叶子中没有落在区间内的entry时（iid_在叶子末尾）继续取下一个叶子
+ */
+void IxScan::load_batch() {
+    int key_len = ih_->key_len(), include_len = ih_->file_hdr_.include_len;
+    while (!is_end()) {
+        IxNodeHandle *node = ih_->FetchNode(iid_.page_no);
+        node->page->RLatch();
+        assert(node->IsLeafPage());
+        int stop = end_.page_no == iid_.page_no ? std::min(end_.slot_no, node->GetSize()) : node->GetSize();
+        batch_begin_ = iid_.slot_no;
+        pos_ = 0;
+        rids_.clear();
+        keys_.clear();
+        includes_.clear();
+        for (int i = batch_begin_; i < stop; i++) {
+            rids_.push_back(*node->get_rid(i));
+            if (read_entries_) {
+                keys_.resize(keys_.size() + key_len);
+                node->read_key(i, keys_.data() + keys_.size() - key_len);
+                const char *include = node->get_include(i);
+                includes_.insert(includes_.end(), include, include + include_len);
+            }
+        }
+        next_leaf_ = node->GetNextLeaf();
+        node->page->RUnlatch();
+        bpm_->UnpinPage(node->GetPageId(), false);
+        delete node;
+        if (end_.page_no != iid_.page_no && next_leaf_ != IX_LEAF_HEADER_PAGE) {
+            bpm_->PrefetchPage({ih_->fd_, next_leaf_});
+        }
+        if (!rids_.empty()) {
+            return;
+        }
+        if (end_.page_no == iid_.page_no || next_leaf_ == IX_LEAF_HEADER_PAGE) {
+            iid_ = end_;
+        } else {
+            iid_ = {.page_no = next_leaf_, .slot_no = 0};
+        }
+    }
 }
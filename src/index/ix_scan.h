@@ -1,26 +1,63 @@
 #pragma once
 
 #include "ix_defs.h"
+#include "ix_hash_index_handle.h"
 #include "ix_index_handle.h"
 
 /**
  * @brief 用于直接遍历叶子结点，而不用FindLeafPage()来得到叶子结点
+ * 按批次扫描：每次对一个叶子加一次读锁，把其中落在扫描区间内的entry全部取出，之后的next()/rid()不再访问叶子；
+ * 取出一个叶子时提示缓冲池预读下一个叶子，消费当前批次的同时下一个叶子在后台读入
  */
 class IxScan : public RecScan {
     const IxIndexHandle *ih_;
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     BufferPoolManager *bpm_;
+    bool read_entries_;  // 是否同时取出key和INCLUDE列，供entry()使用
+
+    int batch_begin_ = 0;  // 当前批次第一个entry在叶子中的slot_no
+    size_t pos_ = 0;       // 当前entry在批次中的下标
+    page_id_t next_leaf_ = IX_NO_PAGE;
+    std::vector<Rid> rids_;
+    std::vector<char> keys_;      // read_entries_时每个entry编码后的key，长度为key_len()
+    std::vector<char> includes_;  // read_entries_时每个entry的INCLUDE列
 
    public:
-    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm)
-        : ih_(ih), iid_(lower), end_(upper), bpm_(bpm) {}
+    /**
+     * @param read_entries 同时取出key和INCLUDE列，只读索引的扫描使用
+     */
+    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm,
+           bool read_entries = false);
 
     void next() override;
 
     bool is_end() const override { return iid_ == end_; }
 
-    Rid rid() const override;
+    Rid rid() const override { return rids_[pos_]; }
+
+    // 读取当前entry的编码后的key和INCLUDE列，返回rid；需要在构造时指定read_entries
+    Rid entry(char *key, char *include) const;
 
     const Iid &iid() const { return iid_; }
+
+   private:
+    void load_batch();
+};
+
+/**
+ * @brief 哈希/ART索引上的等值扫描：构造时一次取出key对应的所有rid，之后依次返回
+ */
+class IxPointScan : public RecScan {
+    std::vector<Rid> rids_;
+    size_t pos_ = 0;
+
+   public:
+    IxPointScan(IxIndex *ih, const char *key) { ih->GetValue(key, &rids_, nullptr); }
+
+    void next() override { pos_++; }
+
+    bool is_end() const override { return pos_ >= rids_.size(); }
+
+    Rid rid() const override { return rids_[pos_]; }
 };
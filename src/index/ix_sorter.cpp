@@ -0,0 +1,248 @@
+#include "ix_sorter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+IxSorter::IxSorter(DiskManager *disk_manager, int col_len, int include_len, std::string tmp_prefix,
+                   size_t memory_limit)
+    : disk_manager_(disk_manager),
+      col_len_(col_len),
+      include_len_(include_len),
+      entry_size_(col_len + (int)sizeof(Rid) + include_len),
+      entries_per_page_(PAGE_SIZE / entry_size_),
+      tmp_prefix_(std::move(tmp_prefix)) {
+    max_buffered_ = std::max<size_t>(memory_limit / entry_size_, 1);
+}
+
+IxSorter::~IxSorter() {
+    for (auto &run : runs_) {
+        disk_manager_->close_file(run.fd);
+        disk_manager_->destroy_file(run.path);
+    }
+}
+
+/**
+ * @brief 添加一个(key,rid)对，key为IxIndexHandle::normalize_key编码后的key；内存中的entry达到上限时写出一个run
+ * include为随rid一起存放在叶子中的INCLUDE列的值，长度为include_len
+ */
+void IxSorter::add(const char *key, const Rid &rid, const char *include) {
+    assert(!finished_);
+    size_t pos = buffer_.size();
+    buffer_.resize(pos + entry_size_);
+    memcpy(buffer_.data() + pos, key, col_len_);
+    memcpy(buffer_.data() + pos + col_len_, &rid, sizeof(Rid));
+    if (include_len_ > 0) {
+        assert(include != nullptr);
+        memcpy(buffer_.data() + pos + col_len_ + sizeof(Rid), include, include_len_);
+    }
+    if (buffer_.size() / entry_size_ >= max_buffered_) {
+        spill();
+    }
+}
+
+/**
+ * @brief 结束输入并准备有序输出：没有写出过run时直接在内存中排序，否则把剩余数据写出后多路归并
+ */
+void IxSorter::finish() {
+    assert(!finished_);
+    finished_ = true;
+    if (runs_.empty()) {
+        const char *prev = nullptr;
+        for (auto entry : sort_buffer()) {
+            if (prev != nullptr && memcmp(prev, entry, col_len_) == 0) {
+                continue;
+            }
+            sorted_.insert(sorted_.end(), entry, entry + entry_size_);
+            prev = entry;
+        }
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        num_entries_ = (int)(sorted_.size() / entry_size_);
+        return;
+    }
+    spill();
+    merge();
+    num_entries_ = output_->num_entries;
+    open_reader(output_reader_, output_);
+}
+
+/**
+ * @brief 按(key,rid)的顺序输出下一个entry，输出的key是编码后的key，可以直接写入结点
+ *
+ * @return 没有更多entry时返回false
+ */
+bool IxSorter::next(char *key, Rid *rid, char *include) {
+    assert(finished_);
+    if (next_output_ >= num_entries_) {
+        return false;
+    }
+    const char *entry;
+    if (output_ == nullptr) {
+        entry = sorted_.data() + (size_t)next_output_ * entry_size_;
+    } else {
+        advance(output_reader_);
+        entry = output_reader_.entry;
+    }
+    memcpy(key, entry, col_len_);
+    memcpy(rid, entry + col_len_, sizeof(Rid));
+    if (include != nullptr) {
+        memcpy(include, entry + col_len_ + sizeof(Rid), include_len_);
+    }
+    next_output_++;
+    return true;
+}
+
+/**
+ * @brief 回到输出的开头，之后可以用next()再读取一遍，用于需要两遍读取的批量构建
+ */
+void IxSorter::rewind() {
+    assert(finished_);
+    next_output_ = 0;
+    if (output_ != nullptr) {
+        open_reader(output_reader_, output_);
+    }
+}
+
+/** -- 以下为辅助函数 -- */
+int IxSorter::compare(const char *a, const char *b) const {
+    int cmp = memcmp(a, b, col_len_);
+    if (cmp != 0) {
+        return cmp;
+    }
+    Rid ra, rb;
+    memcpy(&ra, a + col_len_, sizeof(Rid));
+    memcpy(&rb, b + col_len_, sizeof(Rid));
+    if (ra.page_no != rb.page_no) {
+        return ra.page_no < rb.page_no ? -1 : 1;
+    }
+    return (ra.slot_no < rb.slot_no) ? -1 : ((ra.slot_no > rb.slot_no) ? 1 : 0);
+}
+
+std::vector<const char *> IxSorter::sort_buffer() const {
+    std::vector<const char *> entries;
+    entries.reserve(buffer_.size() / entry_size_);
+    for (size_t pos = 0; pos < buffer_.size(); pos += entry_size_) {
+        entries.push_back(buffer_.data() + pos);
+    }
+    std::sort(entries.begin(), entries.end(), [&](const char *a, const char *b) { return compare(a, b) < 0; });
+    return entries;
+}
+
+/**
+ * @brief 把内存中的entry排序、去重后写成一个新的run
+ */
+void IxSorter::spill() {
+    if (buffer_.empty()) {
+        return;
+    }
+    Run &run = create_run();
+    std::vector<char> page_buf(PAGE_SIZE);
+    const char *prev = nullptr;
+    for (auto entry : sort_buffer()) {
+        if (prev != nullptr && memcmp(prev, entry, col_len_) == 0) {
+            continue;
+        }
+        write_entry(run, page_buf, entry);
+        prev = entry;
+    }
+    finish_run(run, page_buf);
+    buffer_.clear();
+}
+
+IxSorter::Run &IxSorter::create_run() {
+    std::string path = tmp_prefix_ + ".sort" + std::to_string(runs_.size());
+    // 上次建索引中途崩溃时可能遗留同名的临时文件
+    if (disk_manager_->is_file(path)) {
+        disk_manager_->destroy_file(path);
+    }
+    disk_manager_->create_file(path);
+    int fd = disk_manager_->open_file(path);
+    runs_.push_back(Run{path, fd, 0});
+    return runs_.back();
+}
+
+void IxSorter::write_entry(Run &run, std::vector<char> &page_buf, const char *entry) {
+    int slot = run.num_entries % entries_per_page_;
+    memcpy(page_buf.data() + slot * entry_size_, entry, entry_size_);
+    run.num_entries++;
+    if (slot == entries_per_page_ - 1) {
+        disk_manager_->write_page(run.fd, (run.num_entries - 1) / entries_per_page_, page_buf.data(), PAGE_SIZE);
+    }
+}
+
+/**
+ * @brief 写出run最后一个未写满的page
+ */
+void IxSorter::finish_run(Run &run, std::vector<char> &page_buf) {
+    if (run.num_entries % entries_per_page_ != 0) {
+        disk_manager_->write_page(run.fd, run.num_entries / entries_per_page_, page_buf.data(), PAGE_SIZE);
+    }
+}
+
+void IxSorter::open_reader(RunReader &reader, const Run *run) {
+    reader.run = run;
+    reader.page_buf.resize(PAGE_SIZE);
+    reader.next_entry = 0;
+    reader.entry = nullptr;
+}
+
+/**
+ * @brief 读取run中的下一个entry，需要时从磁盘读入下一个page
+ *
+ * @return run已经读完时返回false
+ */
+bool IxSorter::advance(RunReader &reader) {
+    if (reader.next_entry >= reader.run->num_entries) {
+        return false;
+    }
+    int slot = reader.next_entry % entries_per_page_;
+    if (slot == 0) {
+        disk_manager_->read_page(reader.run->fd, reader.next_entry / entries_per_page_, reader.page_buf.data(),
+                                 PAGE_SIZE);
+    }
+    reader.entry = reader.page_buf.data() + slot * entry_size_;
+    reader.next_entry++;
+    return true;
+}
+
+/**
+ * @brief 多路归并所有run，得到一个有序且key不重复的输出run
+ * 每个run只需要一个page的读缓冲，key相同时保留最先出现的（rid最小的）entry
+ */
+void IxSorter::merge() {
+    int num_runs = (int)runs_.size();
+    if (num_runs == 1) {
+        output_ = &runs_.front();
+        return;
+    }
+    std::vector<RunReader> readers(num_runs);
+    auto greater = [&](int a, int b) {
+        int cmp = compare(readers[a].entry, readers[b].entry);
+        return cmp != 0 ? cmp > 0 : a > b;
+    };
+    std::priority_queue<int, std::vector<int>, decltype(greater)> heap(greater);
+    for (int i = 0; i < num_runs; i++) {
+        open_reader(readers[i], &runs_[i]);
+        if (advance(readers[i])) {
+            heap.push(i);
+        }
+    }
+    Run &out = create_run();
+    std::vector<char> page_buf(PAGE_SIZE);
+    std::string prev_key;
+    while (!heap.empty()) {
+        int i = heap.top();
+        heap.pop();
+        const char *entry = readers[i].entry;
+        if (out.num_entries == 0 || memcmp(prev_key.data(), entry, col_len_) != 0) {
+            write_entry(out, page_buf, entry);
+            prev_key.assign(entry, col_len_);
+        }
+        if (advance(readers[i])) {
+            heap.push(i);
+        }
+    }
+    finish_run(out, page_buf);
+    output_ = &out;
+}
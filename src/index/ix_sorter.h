@@ -0,0 +1,87 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "ix_defs.h"
+
+/**
+ * @brief 批量建索引时使用的外部排序器
+ * 收集(编码后的key,rid,INCLUDE列)，按(key,rid)排序并去掉重复的key（保留rid最小的一项，与逐条insert_entry时先插入者生效一致）
+ * 内存中的数据超过memory_limit时，排序后写入一个临时的run文件，finish()时再把所有run多路归并为一个有序文件
+ */
+class IxSorter {
+   private:
+    // 磁盘上的一个有序run，按page顺序紧密存放定长的(key,rid)
+    struct Run {
+        std::string path;
+        int fd;
+        int num_entries;
+    };
+
+    // 顺序读取一个run
+    struct RunReader {
+        const Run *run;
+        std::vector<char> page_buf;
+        int next_entry = 0;  // 下一个要读取的entry在run中的序号
+        const char *entry = nullptr;  // 当前entry
+    };
+
+    DiskManager *disk_manager_;
+    int col_len_;
+    int include_len_;
+    int entry_size_;       // col_len + sizeof(Rid) + include_len
+    int entries_per_page_;
+    std::string tmp_prefix_;  // 临时run文件的文件名前缀
+    size_t max_buffered_;     // 内存中最多缓存的entry个数
+
+    std::vector<char> buffer_;  // 尚未写出的entry
+    std::deque<Run> runs_;  // 所有run，包括归并的输出（deque保证已有元素的引用不失效）
+    bool finished_ = false;
+
+    // finish()之后的输出：未溢出时为内存中的sorted_，否则为归并得到的run
+    std::vector<char> sorted_;
+    const Run *output_ = nullptr;
+    RunReader output_reader_;
+    int num_entries_ = 0;
+    int next_output_ = 0;
+
+   public:
+    IxSorter(DiskManager *disk_manager, int col_len, int include_len, std::string tmp_prefix,
+             size_t memory_limit = IX_SORT_MEMORY);
+
+    ~IxSorter();
+
+    void add(const char *key, const Rid &rid, const char *include = nullptr);
+
+    void finish();
+
+    /**
+     * @brief 去重后的entry个数，finish()之后有效
+     */
+    int size() const { return num_entries_; }
+
+    bool next(char *key, Rid *rid, char *include = nullptr);
+
+    void rewind();
+
+   private:
+    int compare(const char *a, const char *b) const;
+
+    std::vector<const char *> sort_buffer() const;
+
+    void spill();
+
+    Run &create_run();
+
+    void write_entry(Run &run, std::vector<char> &page_buf, const char *entry);
+
+    void finish_run(Run &run, std::vector<char> &page_buf);
+
+    void open_reader(RunReader &reader, const Run *run);
+
+    bool advance(RunReader &reader);
+
+    void merge();
+};
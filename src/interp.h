@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <map>
 
 #include "errors.h"
@@ -12,10 +13,13 @@
 const char *help_info = "Supported SQL syntax:\n"
                    "  command ;\n"
                    "command:\n"
-                   "  CREATE TABLE table_name (column_name type [, column_name type ...])\n"
+                   "  CREATE TABLE table_name (column_name type [, column_name type ...]) [USING {NSM | PAX}]\n"
                    "  DROP TABLE table_name\n"
-                   "  CREATE INDEX table_name (column_name)\n"
+                   "  CREATE INDEX table_name (column_name [, ...]) [USING {BTREE | HASH | ART}] [INCLUDE (column_name [, ...])]\n"
                    "  DROP INDEX table_name (column_name)\n"
+                   "  VACUUM table_name\n"
+                   "  REINDEX table_name\n"
+                   "  ANALYZE table_name\n"
                    "  INSERT INTO table_name VALUES (value [, value ...])\n"
                    "  DELETE FROM table_name [WHERE where_clause]\n"
                    "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
@@ -84,7 +88,7 @@ class Interp {
                 }
             }
             SetTransaction(txn_id, context);
-            sm_manager_->create_table(x->tab_name, col_defs, context);
+            sm_manager_->create_table(x->tab_name, col_defs, context, interp_layout(x->layout));
             if(context->txn_->GetTxnMode() == false)
                 txn_mgr_->Commit(context->txn_, context->log_mgr_);
         } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(root)) {
@@ -96,13 +100,32 @@ class Interp {
         } else if (auto x = std::dynamic_pointer_cast<ast::CreateIndex>(root)) {
             // create index;
             SetTransaction(txn_id, context);
-            sm_manager_->create_index(x->tab_name, x->col_name, context);
+            sm_manager_->create_index(x->tab_name, x->col_names, context, x->include_names,
+                                      interp_index_type(x->index_type));
             if(context->txn_->GetTxnMode() == false)
                 txn_mgr_->Commit(context->txn_, context->log_mgr_);
         } else if (auto x = std::dynamic_pointer_cast<ast::DropIndex>(root)) {
             // drop index
             SetTransaction(txn_id, context);
-            sm_manager_->drop_index(x->tab_name, x->col_name, context);
+            sm_manager_->drop_index(x->tab_name, x->col_names, context);
+            if(context->txn_->GetTxnMode() == false)
+                txn_mgr_->Commit(context->txn_, context->log_mgr_);
+        } else if (auto x = std::dynamic_pointer_cast<ast::VacuumTable>(root)) {
+            // vacuum
+            SetTransaction(txn_id, context);
+            sm_manager_->vacuum_table(x->tab_name, context);
+            if(context->txn_->GetTxnMode() == false)
+                txn_mgr_->Commit(context->txn_, context->log_mgr_);
+        } else if (auto x = std::dynamic_pointer_cast<ast::ReindexTable>(root)) {
+            // reindex
+            SetTransaction(txn_id, context);
+            sm_manager_->reindex_table(x->tab_name, context);
+            if(context->txn_->GetTxnMode() == false)
+                txn_mgr_->Commit(context->txn_, context->log_mgr_);
+        } else if (auto x = std::dynamic_pointer_cast<ast::AnalyzeTable>(root)) {
+            // analyze
+            SetTransaction(txn_id, context);
+            sm_manager_->analyze_table(x->tab_name, context);
             if(context->txn_->GetTxnMode() == false)
                 txn_mgr_->Commit(context->txn_, context->log_mgr_);
         } else if (auto x = std::dynamic_pointer_cast<ast::InsertStmt>(root)) {
@@ -177,6 +200,30 @@ class Interp {
         return m.at(sv_type);
     }
 
+    RmLayout interp_layout(const std::string &layout) {
+        std::string name = layout;
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (name.empty() || name == "NSM") {
+            return RM_LAYOUT_NSM;
+        } else if (name == "PAX") {
+            return RM_LAYOUT_PAX;
+        }
+        throw UnknownMethodError(layout);
+    }
+
+    IxIndexType interp_index_type(const std::string &index_type) {
+        std::string name = index_type;
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (name.empty() || name == "BTREE") {
+            return IX_INDEX_BTREE;
+        } else if (name == "HASH") {
+            return IX_INDEX_HASH;
+        } else if (name == "ART") {
+            return IX_INDEX_ART;
+        }
+        throw UnknownMethodError(index_type);
+    }
+
     CompOp interp_sv_comp_op(ast::SvCompOp op) {
         std::map<ast::SvCompOp, CompOp> m = {
             {ast::SV_OP_EQ, OP_EQ}, {ast::SV_OP_NE, OP_NE}, {ast::SV_OP_LT, OP_LT},
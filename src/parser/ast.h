@@ -58,9 +58,10 @@ struct ColDef : public Field {
 struct CreateTable : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Field>> fields;
+    std::string layout;  // USING子句指定的页内布局，为空表示默认布局
 
-    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_) :
-            tab_name(std::move(tab_name_)), fields(std::move(fields_)) {}
+    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_, std::string layout_ = "") :
+            tab_name(std::move(tab_name_)), fields(std::move(fields_)), layout(std::move(layout_)) {}
 };
 
 struct DropTable : public TreeNode {
@@ -77,18 +78,40 @@ struct DescTable : public TreeNode {
 
 struct CreateIndex : public TreeNode {
     std::string tab_name;
-    std::string col_name;
-
-    CreateIndex(std::string tab_name_, std::string col_name_) :
-            tab_name(std::move(tab_name_)), col_name(std::move(col_name_)) {}
+    std::vector<std::string> col_names;  // 多列索引按顺序给出各列
+    std::vector<std::string> include_names;  // INCLUDE子句中的列，存放在叶子中但不参与比较
+    std::string index_type;  // USING子句指定的索引类型，为空表示B+树
+
+    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_,
+                std::vector<std::string> include_names_ = {}, std::string index_type_ = "") :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)),
+            include_names(std::move(include_names_)), index_type(std::move(index_type_)) {}
 };
 
 struct DropIndex : public TreeNode {
     std::string tab_name;
-    std::string col_name;
+    std::vector<std::string> col_names;  // 多列索引按顺序给出各列
 
-    DropIndex(std::string tab_name_, std::string col_name_) :
-            tab_name(std::move(tab_name_)), col_name(std::move(col_name_)) {}
+    DropIndex(std::string tab_name_, std::vector<std::string> col_names_) :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
+};
+
+struct VacuumTable : public TreeNode {
+    std::string tab_name;
+
+    VacuumTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
+};
+
+struct ReindexTable : public TreeNode {
+    std::string tab_name;
+
+    ReindexTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
+};
+
+struct AnalyzeTable : public TreeNode {
+    std::string tab_name;
+
+    AnalyzeTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
 };
 
 struct Expr : public TreeNode {
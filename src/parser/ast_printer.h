@@ -83,11 +83,22 @@ private:
         } else if (auto x = std::dynamic_pointer_cast<CreateIndex>(node)) {
             std::cout << "CREATE_INDEX\n";
             print_val(x->tab_name, offset);
-            print_val(x->col_name, offset);
+            print_val_list(x->col_names, offset);
+            print_val_list(x->include_names, offset);
+            print_val(x->index_type, offset);
         } else if (auto x = std::dynamic_pointer_cast<DropIndex>(node)) {
             std::cout << "DROP_INDEX\n";
             print_val(x->tab_name, offset);
-            print_val(x->col_name, offset);
+            print_val_list(x->col_names, offset);
+        } else if (auto x = std::dynamic_pointer_cast<VacuumTable>(node)) {
+            std::cout << "VACUUM\n";
+            print_val(x->tab_name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<ReindexTable>(node)) {
+            std::cout << "REINDEX\n";
+            print_val(x->tab_name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<AnalyzeTable>(node)) {
+            std::cout << "ANALYZE\n";
+            print_val(x->tab_name, offset);
         } else if (auto x = std::dynamic_pointer_cast<ColDef>(node)) {
             std::cout << "COL_DEF\n";
             print_val(x->col_name, offset);
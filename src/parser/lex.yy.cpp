@@ -379,8 +379,8 @@ static void yynoreturn yy_fatal_error ( const char* msg  );
 	(yy_hold_char) = *yy_cp; \
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 48
-#define YY_END_OF_BUFFER 49
+#define YY_NUM_RULES 53
+#define YY_END_OF_BUFFER 54
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -388,25 +388,28 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[159] =
+static const flex_int16_t yy_accept[191] =
     {   0,
-        0,    0,    0,    0,   49,   47,    6,    7,    7,   47,
-       42,   47,   47,   47,   44,   42,   42,   43,   43,   43,
-       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
-       43,   43,   43,   43,   43,    3,    4,    6,    7,    0,
-       46,   44,    5,    1,   45,   40,   41,   39,   43,   43,
-       43,   43,   43,   18,   43,   43,   43,   43,   43,   43,
-       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
-       43,   43,   43,   43,    2,    5,   45,   43,   35,   20,
-       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
-       43,   43,   43,   31,   43,   43,   43,   43,   43,   29,
-
-       43,   43,   43,   43,   43,   43,   43,   32,   43,   43,
-       43,   19,   16,   37,   43,   26,   38,   43,   43,   23,
-       36,   43,   43,   43,   43,    8,   43,   43,   43,   43,
-       11,    9,   43,   43,   43,   33,   34,   43,   21,   17,
-       43,   43,   15,   43,   43,   27,   10,   14,   25,   22,
-       43,   30,   13,   28,   24,   43,   12,    0
+        0,    0,    0,    0,   54,   52,    6,    7,    7,   52,
+       47,   47,   47,   52,   47,   52,   47,   52,   49,   47,
+       47,   47,   47,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,    3,    4,    6,    7,    0,   51,   49,    5,    1,
+       50,   45,   46,   44,   48,   48,   48,   48,   48,   48,
+       48,   18,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,    2,    5,   50,   48,   48,   35,
+       20,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+
+       48,   48,   48,   48,   48,   31,   48,   48,   48,   48,
+       48,   48,   29,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   32,   48,   48,   48,   19,   16,   37,
+       48,   26,   38,   48,   48,   48,   23,   36,   48,   48,
+       48,   48,   48,    8,   48,   48,   48,   48,   48,   48,
+       11,   48,    9,   48,   48,   48,   33,   48,   34,   48,
+       21,   17,   48,   48,   48,   15,   48,   39,   48,   48,
+       27,   48,   10,   14,   25,   48,   22,   48,   48,   30,
+       13,   28,   41,   24,   43,   40,   42,   48,   12,    0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -419,12 +422,12 @@ static const YY_CHAR yy_ec[256] =
        14,   14,   14,   14,   14,   14,   14,    1,   15,   16,
        17,   18,    1,    1,   19,   20,   21,   22,   23,   24,
        25,   26,   27,   28,   29,   30,   31,   32,   33,   34,
-       35,   36,   37,   38,   39,   40,   41,   42,   43,   35,
-        1,    1,    1,    1,   44,    1,   45,   46,   47,   48,
+       35,   36,   37,   38,   39,   40,   41,   42,   43,   44,
+        1,    1,    1,    1,   45,    1,   19,   20,   21,   22,
 
-       49,   50,   51,   52,   53,   54,   55,   56,   57,   58,
-       59,   60,   35,   61,   62,   63,   64,   65,   66,   67,
-       68,   35,    1,    1,    1,    1,    1,    1,    1,    1,
+       23,   24,   25,   26,   27,   28,   29,   30,   31,   32,
+       33,   34,   35,   36,   37,   38,   39,   40,   41,   42,
+       43,   44,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -441,151 +444,191 @@ static const YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static const YY_CHAR yy_meta[69] =
+static const YY_CHAR yy_meta[46] =
     {   0,
-        1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    3,    1,    1,    1,    1,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1
     } ;
 
-static const flex_int16_t yy_base[163] =
+static const flex_int16_t yy_base[191] =
     {   0,
-        0,    0,  287,  286,  292,  318,  289,  318,  287,  284,
-      318,  274,   58,  279,   59,   57,  267,   50,   54,   50,
-       55,   38,   54,    0,   58,   56,   59,   66,   59,   65,
-      100,   80,   67,   87,   87,  318,  133,   98,  318,   89,
-      318,  116,    0,  318,   75,  318,  318,  318,    0,   84,
-       99,  108,  106,    0,  114,  103,  112,  107,  103,  111,
-      107,  108,  112,  134,  121,  119,  129,  123,  135,  121,
-      138,  153,  148,  158,  318,    0,   71,  109,    0,    0,
-      156,  149,  155,  168,  165,  168,  156,  154,  174,  163,
-      161,  176,  177,  169,  171,  178,  183,  178,  188,    0,
-
-      177,  192,  204,  188,  194,  195,  192,    0,  208,  200,
-      201,    0,    0,    0,  202,    0,    0,  199,  206,    0,
-        0,  206,  209,  216,  225,    0,  224,  213,  230,  231,
-        0,    0,  218,  234,  236,    0,    0,  230,    0,    0,
-      241,  233,  237,  252,  240,    0,    0,    0,    0,    0,
-      257,    0,    0,    0,    0,  253,    0,  318,  308,  311,
-       76,  314
+        1,    1,   46,    1,    1,    1,  137,    1,  218,   91,
+        1,    1,    1,  232,    1,  250,    1,  439,  436,    1,
+      166,    1,  432,  168,  194,  192,  193,  201,  204,  207,
+      237,  221,  153,  236,  238,  209,  222,  252,  217,  254,
+      249,    1,  437,    1,    1,    1,    1,    1,  136,    1,
+      437,    1,    1,    1,  423,  425,  187,  237,  256,  426,
+      257,  427,  260,  259,  260,  225,  261,  268,  264,  266,
+      255,  201,  274,  273,  280,  281,  277,  234,  278,  294,
+      293,  289,  246,  294,    1,    1,    1,  286,  297,  428,
+      430,  292,  296,  299,  301,  300,  313,  304,  303,  320,
+
+      315,  308,  318,  321,  326,  321,  431,  324,  332,  432,
+      327,  335,  433,  329,  330,  344,  434,  333,  334,  335,
+      336,  354,  435,  436,  352,  348,  349,  437,  438,  439,
+      350,  440,  441,  351,  353,  357,  442,  443,  360,  364,
+      369,  374,  378,  444,  379,  371,  379,  373,  384,  385,
+      445,  381,  446,  382,  392,  393,  447,  397,  448,  385,
+      449,  450,  395,  402,  392,  394,  409,  451,  408,  405,
+      452,  410,  453,  454,  455,  418,  456,  412,  424,  457,
+      458,  459,  460,  461,  462,  463,  464,  414,  465,  511
     } ;
 
-static const flex_int16_t yy_def[163] =
+static const flex_int16_t yy_def[191] =
     {   0,
-      158,    1,  159,  159,  158,  158,  158,  158,  158,  160,
-      158,  158,  158,  158,  158,  158,  158,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  158,  158,  158,  158,  160,
-      158,  158,  162,  158,  158,  158,  158,  158,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  158,  162,  158,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,  161,  161,  161,
-      161,  161,  161,  161,  161,  161,  161,    0,  158,  158,
-      158,  158
+      190,    1,    1,    3,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,   14,  190,  190,   14,  190,
+      190,  190,  190,  190,   24,   25,   25,   25,   25,   25,
+       25,   24,   32,   32,   32,   25,   25,   32,   32,   32,
+       32,  190,  190,    7,  190,   10,  190,   19,  190,  190,
+      190,  190,  190,  190,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   25,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   25,  190,   49,   51,   32,   32,   32,
+       32,   32,   32,   32,   32,   25,   32,   32,   32,   32,
+
+       32,   32,   32,   25,   25,   32,   32,   32,   25,   32,
+       32,   25,   32,   32,   32,   32,   32,   32,   32,   32,
+       32,   25,   32,   32,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   25,   32,   32,   32,   25,   25,
+       32,   32,   32,   32,   25,   25,   32,   32,   32,   32,
+       32,   32,   25,   32,   32,   32,   25,   32,   32,   32,
+       32,   25,   32,   32,   32,   25,   32,   32,   32,   32,
+       32,   32,   32,   32,   32,   32,   32,   32,   32,    0
     } ;
 
-static const flex_int16_t yy_nxt[387] =
+static const flex_int16_t yy_nxt[557] =
     {   0,
-        6,    7,    8,    9,   10,   11,   11,   11,   12,   11,
-       13,   11,   14,   15,   11,   16,   11,   17,   18,   19,
-       20,   21,   22,   23,   24,   25,   26,   27,   24,   28,
-       24,   24,   29,   24,   24,   30,   31,   32,   33,   34,
-       35,   24,   24,    6,   18,   19,   20,   21,   22,   23,
-       24,   25,   26,   27,   24,   28,   24,   24,   29,   24,
-       30,   31,   32,   33,   34,   35,   24,   24,   43,   50,
-       45,   42,   42,   46,   47,   55,   53,   58,   49,   60,
-       63,   51,   56,   61,   77,   57,   52,   64,   77,   62,
-       59,   65,   66,   41,   67,   50,   54,   68,   71,   38,
-
-       72,   55,   53,   58,   60,   73,   63,   51,   56,   61,
-       57,   52,   74,   64,   62,   59,   78,   65,   66,   67,
-       79,   54,   69,   68,   71,   70,   72,   45,   80,   42,
-       81,   73,   82,   83,   84,   87,   85,   88,   74,   89,
-       90,   91,   78,   86,  106,   75,   79,   95,   69,   96,
-       97,   70,   98,  101,   80,   92,   81,  102,   82,   83,
-       84,   87,   85,   88,   99,   89,   90,   91,   86,  106,
-       93,   94,  100,   95,  103,   96,   97,  104,   98,  101,
-      105,   92,  107,  102,  108,  109,  110,  111,  112,  113,
-       99,  114,  115,  116,  117,   93,   94,  100,  118,  119,
-
-      103,  120,  121,  104,  122,  123,  105,  124,  107,  108,
-      125,  109,  110,  111,  112,  113,  114,  126,  115,  116,
-      117,  127,  128,  132,  118,  119,  129,  120,  121,  130,
-      122,  123,  131,  124,  133,  141,  125,  134,  135,  136,
-      137,  138,  126,  139,  140,  142,  143,  127,  128,  132,
-      144,  129,  145,  146,  130,  147,  148,  131,  149,  151,
-      133,  141,  134,  135,  136,  137,  138,  150,  139,  140,
-      152,  142,  143,  153,  154,  144,  155,  156,  145,  146,
-      147,  157,  148,   48,  149,  151,   44,   42,   41,   39,
-       38,  158,  150,   37,   37,  152,  158,  158,  153,  158,
-
-      154,  155,  158,  156,  158,  158,  158,  157,   36,   36,
-       36,   40,   40,   40,   76,  158,   76,    5,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158
+        5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+       15,   16,   17,   18,   19,   20,   21,   22,   23,   24,
+       25,   26,   27,   28,   29,   30,   31,   32,   33,   30,
+       34,   30,   30,   35,   30,   30,   36,   37,   38,   39,
+       40,   41,   30,   30,   30,    6,   42,   42,   42,   42,
+       42,   42,   42,   43,   42,   42,   42,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       42,   46,   46,   46,   46,   47,   46,   46,   46,   46,
+
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   86,   86,   44,   86,
+       86,   86,   86,   86,   86,   86,   86,   86,   86,   86,
+       86,   86,   86,   86,   86,   86,   86,   86,   86,   86,
+       86,   86,   86,   86,   86,   86,   86,   86,   86,   86,
+       86,   86,   86,   86,   86,   86,   86,   86,   86,   86,
+       86,   55,   52,   53,   56,   73,   56,   57,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   58,
+
+       56,   56,   56,   56,   59,   56,   56,   56,   56,   56,
+       56,   56,   60,   56,   56,   66,   61,   63,   56,   88,
+       45,  103,  104,   56,   64,   56,   56,   65,   67,   56,
+       56,   76,   56,   69,   56,   56,   62,  105,  106,   70,
+       56,   77,   68,   56,   78,   48,   56,   79,   56,   56,
+       81,   56,   72,   82,   96,   89,   56,   56,   90,   71,
+       49,   97,   74,  112,   56,   56,  118,   56,   56,   56,
+       80,  113,   83,   75,   84,  119,   91,   56,   93,   56,
+       56,   92,   95,   56,  102,   56,   56,   56,   56,   94,
+       56,   56,   56,   98,   99,   56,  100,   56,  101,   56,
+
+      107,  109,   56,  108,   56,   56,  111,  110,   56,   56,
+      114,   56,   56,  115,  116,  117,  120,   56,  123,  126,
+       56,  121,  127,   56,   56,   56,  122,   56,   56,  125,
+       56,  124,   56,  128,   56,   56,   56,  129,  131,   56,
+      130,  133,   56,  135,   56,  132,   56,  134,  136,   56,
+      139,   56,   56,  137,  140,   56,  142,  143,   56,  145,
+       56,   56,  146,   56,   56,   56,   56,   56,   56,  144,
+      150,  148,  149,  151,   56,   56,   56,   56,  154,   56,
+       56,   56,   56,   56,   56,  155,  156,  157,   56,  158,
+      163,   56,  160,  164,  159,   56,  152,  161,  165,  162,
+
+       56,  166,   56,  168,   56,   56,  170,  171,  167,   56,
+       56,  169,   56,   56,  174,  175,   56,  178,  176,  173,
+      179,   56,  177,   56,  172,   56,   56,   56,   56,  180,
+      181,  182,  185,   56,   56,   56,   56,   56,  183,   56,
+      186,  184,  189,   56,  188,   56,   50,   51,   54,   85,
+       87,   56,   56,  187,   56,   56,   56,   56,   56,   56,
+       56,   56,  138,  141,   56,  147,  153,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190
     } ;
 
-static const flex_int16_t yy_chk[387] =
+static const flex_int16_t yy_chk[557] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,   13,   18,
-       15,   13,   15,   16,   16,   20,   19,   21,  161,   22,
-       25,   18,   20,   23,   77,   20,   18,   26,   45,   23,
-       21,   27,   28,   40,   29,   18,   19,   30,   32,   38,
-
-       33,   20,   19,   21,   22,   34,   25,   18,   20,   23,
-       20,   18,   35,   26,   23,   21,   50,   27,   28,   29,
-       51,   19,   31,   30,   32,   31,   33,   42,   52,   42,
-       53,   34,   55,   56,   57,   59,   58,   60,   35,   61,
-       62,   63,   50,   58,   78,   37,   51,   65,   31,   66,
-       67,   31,   68,   70,   52,   64,   53,   71,   55,   56,
-       57,   59,   58,   60,   69,   61,   62,   63,   58,   78,
-       64,   64,   69,   65,   72,   66,   67,   73,   68,   70,
-       74,   64,   81,   71,   82,   83,   84,   85,   86,   87,
-       69,   88,   89,   90,   91,   64,   64,   69,   92,   93,
-
-       72,   94,   95,   73,   96,   97,   74,   98,   81,   82,
-       99,   83,   84,   85,   86,   87,   88,  101,   89,   90,
-       91,  102,  103,  107,   92,   93,  104,   94,   95,  105,
-       96,   97,  106,   98,  109,  124,   99,  110,  111,  115,
-      118,  119,  101,  122,  123,  125,  127,  102,  103,  107,
-      128,  104,  129,  130,  105,  133,  134,  106,  135,  141,
-      109,  124,  110,  111,  115,  118,  119,  138,  122,  123,
-      142,  125,  127,  143,  144,  128,  145,  151,  129,  130,
-      133,  156,  134,   17,  135,  141,   14,   12,   10,    9,
-        7,    5,  138,    4,    3,  142,    0,    0,  143,    0,
-
-      144,  145,    0,  151,    0,    0,    0,  156,  159,  159,
-      159,  160,  160,  160,  162,    0,  162,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158
+        1,    1,    1,    1,    1,    1,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   49,   49,    7,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   24,   21,   21,   33,   33,   24,   24,   24,   24,
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+       24,   24,   24,   25,   26,   27,   25,   26,   57,   57,
+        9,   72,   72,   28,   26,   25,   29,   26,   27,   30,
+       25,   36,   72,   29,   26,   27,   25,   72,   72,   29,
+       32,   36,   28,   28,   37,   14,   29,   37,   39,   30,
+       39,   36,   32,   39,   66,   58,   66,   32,   58,   31,
+       16,   66,   34,   78,   37,   78,   83,   34,   58,   35,
+       38,   78,   40,   35,   41,   83,   59,   83,   63,   31,
+       41,   61,   65,   38,   71,   40,   71,   59,   61,   64,
+       64,   63,   67,   67,   68,   69,   69,   70,   70,   68,
+
+       73,   75,   65,   74,   74,   73,   77,   76,   77,   79,
+       79,   75,   76,   80,   81,   82,   84,   88,   92,   95,
+       82,   88,   96,   92,   81,   80,   89,   93,   89,   94,
+       94,   93,   95,   97,   99,   98,   84,   98,  100,  102,
+       99,  102,   96,  104,   97,  101,  101,  103,  105,  103,
+      108,  100,  106,  106,  109,  108,  111,  112,  111,  115,
+      114,  115,  116,  104,  118,  119,  120,  121,  105,  114,
+      120,  118,  119,  121,  109,  116,  122,  112,  125,  126,
+      127,  131,  134,  125,  135,  126,  127,  131,  136,  134,
+      141,  139,  136,  142,  135,  140,  122,  139,  143,  140,
+
+      141,  145,  146,  147,  148,  142,  149,  150,  146,  143,
+      147,  148,  152,  154,  155,  156,  160,  163,  158,  154,
+      164,  145,  160,  165,  152,  166,  149,  150,  158,  165,
+      166,  167,  172,  164,  155,  156,  170,  163,  169,  169,
+      176,  170,  188,  178,  179,  188,   18,   19,   23,   43,
+       51,  167,  172,  178,   55,  179,   56,   60,   62,   90,
+      176,   91,  107,  110,  113,  117,  123,  124,  128,  129,
+      130,  132,  133,  137,  138,  144,  151,  153,  157,  159,
+      161,  162,  168,  171,  173,  174,  175,  177,  180,  181,
+      182,  183,  184,  185,  186,  187,  189,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190,  190,  190,  190,  190,
+      190,  190,  190,  190,  190,  190
     } ;
 
 static yy_state_type yy_last_accepting_state;
@@ -627,9 +670,9 @@ char *yytext;
         } \
     }
 
-#line 631 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
+#line 674 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
 
-#line 633 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
+#line 676 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
 
 #define INITIAL 0
 #define STATE_COMMENT 1
@@ -867,7 +910,7 @@ YY_DECL
 
 #line 48 "lex.l"
     /* block comment */
-#line 871 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
+#line 914 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -894,13 +937,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 159 )
+				if ( yy_current_state >= 191 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 318 );
+		while ( yy_base[yy_current_state] != 511 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1119,57 +1162,82 @@ YY_RULE_SETUP
 #line 89 "lex.l"
 { return HELP; }
 	YY_BREAK
-/* operators */
 case 39:
 YY_RULE_SETUP
-#line 91 "lex.l"
-{ return GEQ; }
+#line 90 "lex.l"
+{ return USING; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 92 "lex.l"
-{ return LEQ; }
+#line 91 "lex.l"
+{ return INCLUDE; }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 93 "lex.l"
-{ return NEQ; }
+#line 92 "lex.l"
+{ return VACUUM; }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
+#line 93 "lex.l"
+{ return REINDEX; }
+	YY_BREAK
+case 43:
+YY_RULE_SETUP
 #line 94 "lex.l"
+{ return ANALYZE; }
+	YY_BREAK
+/* operators */
+case 44:
+YY_RULE_SETUP
+#line 96 "lex.l"
+{ return GEQ; }
+	YY_BREAK
+case 45:
+YY_RULE_SETUP
+#line 97 "lex.l"
+{ return LEQ; }
+	YY_BREAK
+case 46:
+YY_RULE_SETUP
+#line 98 "lex.l"
+{ return NEQ; }
+	YY_BREAK
+case 47:
+YY_RULE_SETUP
+#line 99 "lex.l"
 { return yytext[0]; }
 	YY_BREAK
 /* id */
-case 43:
+case 48:
 YY_RULE_SETUP
-#line 96 "lex.l"
+#line 101 "lex.l"
 {
     yylval->sv_str = yytext;
     return IDENTIFIER;
 }
 	YY_BREAK
 /* literals */
-case 44:
+case 49:
 YY_RULE_SETUP
-#line 101 "lex.l"
+#line 106 "lex.l"
 {
     yylval->sv_int = atoi(yytext);
     return VALUE_INT;
 }
 	YY_BREAK
-case 45:
+case 50:
 YY_RULE_SETUP
-#line 105 "lex.l"
+#line 110 "lex.l"
 {
     yylval->sv_float = atof(yytext);
     return VALUE_FLOAT;
 }
 	YY_BREAK
-case 46:
-/* rule 46 can match eol */
+case 51:
+/* rule 51 can match eol */
 YY_RULE_SETUP
-#line 109 "lex.l"
+#line 114 "lex.l"
 {
     yylval->sv_str = std::string(yytext + 1, strlen(yytext) - 2);
     return VALUE_STRING;
@@ -1178,21 +1246,21 @@ YY_RULE_SETUP
 /* EOF */
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(STATE_COMMENT):
-#line 114 "lex.l"
+#line 119 "lex.l"
 { return T_EOF; }
 	YY_BREAK
 /* unexpected char */
-case 47:
+case 52:
 YY_RULE_SETUP
-#line 116 "lex.l"
+#line 121 "lex.l"
 { std::cerr << "Lexer Error: unexpected character " << yytext[0] << std::endl; }
 	YY_BREAK
-case 48:
+case 53:
 YY_RULE_SETUP
-#line 117 "lex.l"
+#line 122 "lex.l"
 ECHO;
 	YY_BREAK
-#line 1196 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
+#line 1264 "/home/luo/RUCbase/rucbase/src/parser/lex.yy.cpp"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -1487,7 +1555,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 159 )
+			if ( yy_current_state >= 191 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
@@ -1515,11 +1583,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 159 )
+		if ( yy_current_state >= 191 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 158);
+	yy_is_jam = (yy_current_state == 190);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2158,6 +2226,6 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 117 "lex.l"
+#line 122 "lex.l"
 
 
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,7 +67,7 @@
 
 
 /* First part of user prologue.  */
-#line 1 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+#line 1 "/root/repo/src/parser/yacc.y"
 
 #include "ast.h"
 #include "yacc.tab.h"
@@ -81,7 +82,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 85 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 86 "/root/repo/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -104,94 +105,100 @@ using namespace ast;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
-# define YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SHOW = 258,
-    TABLES = 259,
-    CREATE = 260,
-    TABLE = 261,
-    DROP = 262,
-    DESC = 263,
-    INSERT = 264,
-    INTO = 265,
-    VALUES = 266,
-    DELETE = 267,
-    FROM = 268,
-    WHERE = 269,
-    UPDATE = 270,
-    SET = 271,
-    SELECT = 272,
-    INT = 273,
-    CHAR = 274,
-    FLOAT = 275,
-    INDEX = 276,
-    AND = 277,
-    JOIN = 278,
-    EXIT = 279,
-    HELP = 280,
-    TXN_BEGIN = 281,
-    TXN_COMMIT = 282,
-    TXN_ABORT = 283,
-    TXN_ROLLBACK = 284,
-    ORDER = 285,
-    BY = 286,
-    ASC = 287,
-    LIMIT = 288,
-    LEQ = 289,
-    NEQ = 290,
-    GEQ = 291,
-    T_EOF = 292,
-    IDENTIFIER = 293,
-    VALUE_STRING = 294,
-    VALUE_INT = 295,
-    VALUE_FLOAT = 296
-  };
-#endif
-
-/* Value type.  */
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SHOW = 3,                       /* SHOW  */
+  YYSYMBOL_TABLES = 4,                     /* TABLES  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_DROP = 7,                       /* DROP  */
+  YYSYMBOL_DESC = 8,                       /* DESC  */
+  YYSYMBOL_INSERT = 9,                     /* INSERT  */
+  YYSYMBOL_INTO = 10,                      /* INTO  */
+  YYSYMBOL_VALUES = 11,                    /* VALUES  */
+  YYSYMBOL_DELETE = 12,                    /* DELETE  */
+  YYSYMBOL_FROM = 13,                      /* FROM  */
+  YYSYMBOL_WHERE = 14,                     /* WHERE  */
+  YYSYMBOL_UPDATE = 15,                    /* UPDATE  */
+  YYSYMBOL_SET = 16,                       /* SET  */
+  YYSYMBOL_SELECT = 17,                    /* SELECT  */
+  YYSYMBOL_INT = 18,                       /* INT  */
+  YYSYMBOL_CHAR = 19,                      /* CHAR  */
+  YYSYMBOL_FLOAT = 20,                     /* FLOAT  */
+  YYSYMBOL_INDEX = 21,                     /* INDEX  */
+  YYSYMBOL_AND = 22,                       /* AND  */
+  YYSYMBOL_JOIN = 23,                      /* JOIN  */
+  YYSYMBOL_EXIT = 24,                      /* EXIT  */
+  YYSYMBOL_HELP = 25,                      /* HELP  */
+  YYSYMBOL_TXN_BEGIN = 26,                 /* TXN_BEGIN  */
+  YYSYMBOL_TXN_COMMIT = 27,                /* TXN_COMMIT  */
+  YYSYMBOL_TXN_ABORT = 28,                 /* TXN_ABORT  */
+  YYSYMBOL_TXN_ROLLBACK = 29,              /* TXN_ROLLBACK  */
+  YYSYMBOL_ORDER = 30,                     /* ORDER  */
+  YYSYMBOL_BY = 31,                        /* BY  */
+  YYSYMBOL_ASC = 32,                       /* ASC  */
+  YYSYMBOL_LIMIT = 33,                     /* LIMIT  */
+  YYSYMBOL_USING = 34,                     /* USING  */
+  YYSYMBOL_VACUUM = 35,                    /* VACUUM  */
+  YYSYMBOL_INCLUDE = 36,                   /* INCLUDE  */
+  YYSYMBOL_REINDEX = 37,                   /* REINDEX  */
+  YYSYMBOL_ANALYZE = 38,                   /* ANALYZE  */
+  YYSYMBOL_LEQ = 39,                       /* LEQ  */
+  YYSYMBOL_NEQ = 40,                       /* NEQ  */
+  YYSYMBOL_GEQ = 41,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 42,                     /* T_EOF  */
+  YYSYMBOL_IDENTIFIER = 43,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 44,              /* VALUE_STRING  */
+  YYSYMBOL_VALUE_INT = 45,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 46,               /* VALUE_FLOAT  */
+  YYSYMBOL_47_ = 47,                       /* ';'  */
+  YYSYMBOL_48_ = 48,                       /* '('  */
+  YYSYMBOL_49_ = 49,                       /* ')'  */
+  YYSYMBOL_50_ = 50,                       /* ','  */
+  YYSYMBOL_51_ = 51,                       /* '.'  */
+  YYSYMBOL_52_ = 52,                       /* '='  */
+  YYSYMBOL_53_ = 53,                       /* '<'  */
+  YYSYMBOL_54_ = 54,                       /* '>'  */
+  YYSYMBOL_55_ = 55,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 56,                  /* $accept  */
+  YYSYMBOL_start = 57,                     /* start  */
+  YYSYMBOL_stmt = 58,                      /* stmt  */
+  YYSYMBOL_txnStmt = 59,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 60,                    /* dbStmt  */
+  YYSYMBOL_ddl = 61,                       /* ddl  */
+  YYSYMBOL_ordercol = 62,                  /* ordercol  */
+  YYSYMBOL_orderbyList = 63,               /* orderbyList  */
+  YYSYMBOL_dml = 64,                       /* dml  */
+  YYSYMBOL_fieldList = 65,                 /* fieldList  */
+  YYSYMBOL_field = 66,                     /* field  */
+  YYSYMBOL_type = 67,                      /* type  */
+  YYSYMBOL_valueList = 68,                 /* valueList  */
+  YYSYMBOL_value = 69,                     /* value  */
+  YYSYMBOL_condition = 70,                 /* condition  */
+  YYSYMBOL_optWhereClause = 71,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 72,               /* whereClause  */
+  YYSYMBOL_col = 73,                       /* col  */
+  YYSYMBOL_colList = 74,                   /* colList  */
+  YYSYMBOL_op = 75,                        /* op  */
+  YYSYMBOL_expr = 76,                      /* expr  */
+  YYSYMBOL_setClauses = 77,                /* setClauses  */
+  YYSYMBOL_setClause = 78,                 /* setClause  */
+  YYSYMBOL_selector = 79,                  /* selector  */
+  YYSYMBOL_tableList = 80,                 /* tableList  */
+  YYSYMBOL_colNameList = 81,               /* colNameList  */
+  YYSYMBOL_optInclude = 82,                /* optInclude  */
+  YYSYMBOL_optUsing = 83,                  /* optUsing  */
+  YYSYMBOL_tbName = 84,                    /* tbName  */
+  YYSYMBOL_colName = 85                    /* colName  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
-
-
-
-int yyparse (void);
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-#endif /* !YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED  */
 
 
 
@@ -232,6 +239,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -291,6 +310,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -309,6 +329,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -327,17 +348,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -366,7 +393,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -431,8 +458,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -498,27 +524,29 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  39
+#define YYFINAL  45
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   113
+#define YYLAST   131
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  51
+#define YYNTOKENS  56
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  27
+#define YYNNTS  30
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  69
+#define YYNRULES  78
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  129
+#define YYNSTATES  147
 
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   296
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   301
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -528,9 +556,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      43,    44,    50,     2,    45,     2,    46,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    42,
-      48,    47,    49,     2,     2,     2,     2,     2,     2,     2,
+      48,    49,    55,     2,    50,     2,    51,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    47,
+      53,    52,    54,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -553,208 +581,224 @@ static const yytype_int8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
        0,    56,    56,    61,    66,    71,    79,    80,    81,    82,
       86,    90,    94,    98,   105,   112,   116,   120,   124,   128,
-     135,   139,   143,   149,   153,   159,   163,   167,   171,   176,
-     181,   186,   193,   197,   204,   211,   215,   219,   226,   230,
-     237,   241,   245,   252,   259,   260,   267,   271,   278,   282,
-     289,   293,   300,   304,   308,   312,   316,   320,   327,   331,
-     338,   342,   349,   356,   360,   364,   368,   372,   378,   380
+     132,   136,   140,   147,   151,   155,   161,   165,   171,   175,
+     179,   183,   188,   193,   198,   205,   209,   216,   223,   227,
+     231,   238,   242,   249,   253,   257,   264,   271,   272,   279,
+     283,   290,   294,   301,   305,   312,   316,   320,   324,   328,
+     332,   339,   343,   350,   354,   361,   368,   372,   376,   380,
+     384,   391,   395,   402,   403,   410,   411,   417,   419
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SHOW", "TABLES", "CREATE", "TABLE",
-  "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE", "FROM", "WHERE",
-  "UPDATE", "SET", "SELECT", "INT", "CHAR", "FLOAT", "INDEX", "AND",
-  "JOIN", "EXIT", "HELP", "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT",
-  "TXN_ROLLBACK", "ORDER", "BY", "ASC", "LIMIT", "LEQ", "NEQ", "GEQ",
-  "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT", "';'",
-  "'('", "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept",
-  "start", "stmt", "txnStmt", "dbStmt", "ddl", "ordercol", "orderbyList",
-  "dml", "fieldList", "field", "type", "valueList", "value", "condition",
+  "\"end of file\"", "error", "\"invalid token\"", "SHOW", "TABLES",
+  "CREATE", "TABLE", "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE",
+  "FROM", "WHERE", "UPDATE", "SET", "SELECT", "INT", "CHAR", "FLOAT",
+  "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN", "TXN_COMMIT",
+  "TXN_ABORT", "TXN_ROLLBACK", "ORDER", "BY", "ASC", "LIMIT", "USING",
+  "VACUUM", "INCLUDE", "REINDEX", "ANALYZE", "LEQ", "NEQ", "GEQ", "T_EOF",
+  "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT", "';'", "'('",
+  "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept", "start",
+  "stmt", "txnStmt", "dbStmt", "ddl", "ordercol", "orderbyList", "dml",
+  "fieldList", "field", "type", "valueList", "value", "condition",
   "optWhereClause", "whereClause", "col", "colList", "op", "expr",
-  "setClauses", "setClause", "selector", "tableList", "tbName", "colName", YY_NULLPTR
+  "setClauses", "setClause", "selector", "tableList", "colNameList",
+  "optInclude", "optUsing", "tbName", "colName", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,    59,    40,    41,    44,    46,    61,    60,    62,
-      42
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-59)
+#define YYPACT_NINF (-70)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-69)
+#define YYTABLE_NINF (-78)
 
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      36,    15,    49,    51,   -14,    28,    58,   -14,   -25,   -59,
-     -59,   -59,   -59,   -59,   -59,   -59,    27,    12,   -59,   -59,
-     -59,   -59,   -59,   -14,   -14,   -14,   -14,   -59,   -59,   -14,
-     -14,    33,    31,   -59,   -59,    38,    75,    43,   -59,   -59,
-     -59,    47,    50,   -59,    52,    80,    82,    56,    59,   -14,
-      56,    56,    56,    56,    55,    59,   -59,   -59,     1,   -59,
-      53,   -59,   -11,   -59,   -59,    14,   -59,    48,    57,    60,
-      35,   -59,    77,   -26,    56,   -59,    35,   -14,   -14,    17,
-     -59,    56,   -59,    62,   -59,   -59,   -59,   -59,   -59,   -59,
-     -59,    42,   -59,    59,   -59,   -59,   -59,   -59,   -59,   -59,
-      41,   -59,   -59,   -59,   -59,    71,    63,   -59,    66,   -59,
-      35,   -59,   -59,   -59,   -59,    56,   -59,    64,   -59,   -59,
-     -16,    -6,   -59,    67,    56,   -59,   -59,   -59,   -59
+      42,    20,     4,     9,   -30,    16,    35,   -30,   -20,   -70,
+     -70,   -70,   -70,   -70,   -70,   -30,   -30,   -30,   -70,    41,
+      11,   -70,   -70,   -70,   -70,   -70,   -30,   -30,   -30,   -30,
+     -70,   -70,   -30,   -30,    60,    27,   -70,   -70,    37,    72,
+      50,   -70,   -70,   -70,   -70,   -70,   -70,    59,    61,   -70,
+      62,    97,    98,    68,    70,   -30,    68,    68,    68,    68,
+      66,    70,   -70,   -70,     2,   -70,    63,   -70,    -6,   -70,
+     -70,   -31,   -70,    44,     6,   -70,    33,    28,   -70,    94,
+      52,    68,   -70,    28,   -30,   -30,    10,    83,    68,   -70,
+      71,   -70,   -70,    83,    68,   -70,   -70,   -70,   -70,    49,
+     -70,    70,   -70,   -70,   -70,   -70,   -70,   -70,    51,   -70,
+     -70,   -70,   -70,    87,    75,    78,   -70,   -70,    77,    88,
+     -70,   -70,    28,   -70,   -70,   -70,   -70,    68,   -70,   -70,
+      74,    79,   -70,   -70,   -70,   -22,    -5,   -70,    68,    80,
+      68,   -70,   -70,    53,   -70,   -70,   -70
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
-       3,    10,    11,    12,    13,     5,     0,     0,     9,     6,
-       7,     8,    14,     0,     0,     0,     0,    68,    17,     0,
-       0,     0,    69,    63,    50,    64,     0,     0,    49,     1,
-       2,     0,     0,    16,     0,     0,    44,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    26,    69,    44,    60,
-       0,    51,    44,    65,    48,     0,    32,     0,     0,     0,
-       0,    46,    45,     0,     0,    27,     0,     0,     0,    28,
-      15,     0,    35,     0,    37,    34,    18,    19,    42,    40,
-      41,     0,    38,     0,    56,    55,    57,    52,    53,    54,
-       0,    61,    62,    67,    66,     0,     0,    33,     0,    25,
-       0,    47,    58,    59,    43,     0,    30,     0,    39,    23,
-      29,    20,    36,     0,     0,    22,    21,    31,    24
+       3,    10,    11,    12,    13,     0,     0,     0,     5,     0,
+       0,     9,     6,     7,     8,    14,     0,     0,     0,     0,
+      77,    17,     0,     0,     0,    78,    66,    53,    67,     0,
+       0,    52,    20,    21,    22,     1,     2,     0,     0,    16,
+       0,     0,    47,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    29,    78,    47,    63,     0,    54,    47,    68,
+      51,     0,    35,     0,     0,    71,     0,     0,    49,    48,
+       0,     0,    30,     0,     0,     0,    31,    75,     0,    38,
+       0,    40,    37,    75,     0,    19,    45,    43,    44,     0,
+      41,     0,    59,    58,    60,    55,    56,    57,     0,    64,
+      65,    70,    69,     0,     0,     0,    15,    36,     0,    73,
+      72,    28,     0,    50,    61,    62,    46,     0,    33,    76,
+       0,     0,    18,    42,    26,    32,    23,    39,     0,     0,
+       0,    25,    24,     0,    34,    27,    74
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -59,   -59,   -59,   -59,   -59,   -59,   -15,   -59,   -59,   -59,
-      29,   -59,   -59,   -58,    18,   -42,   -59,    -8,   -59,   -59,
-     -59,   -59,    39,   -59,   -59,     7,   -46
+     -70,   -70,   -70,   -70,   -70,   -70,   -14,   -70,   -70,   -70,
+      40,   -70,   -70,   -69,    29,    -3,   -70,    -8,   -70,   -70,
+     -70,   -70,    48,   -70,   -70,   -57,   -70,    38,     5,   -52
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    16,    17,    18,    19,    20,   119,   120,    21,    65,
-      66,    85,    91,    92,    71,    56,    72,    73,    35,   100,
-     114,    58,    59,    36,    62,    37,    38
+       0,    19,    20,    21,    22,    23,   134,   135,    24,    71,
+      72,    92,    99,   100,    78,    62,    79,    80,    38,   108,
+     126,    64,    65,    39,    68,    74,   132,   116,    40,    41
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      34,    60,   125,    55,    64,    67,    68,    69,    94,    95,
-      96,    28,    77,    32,    31,    55,    75,   123,   102,    22,
-      79,    97,    98,    99,    27,    33,   126,    39,    60,   124,
-      41,    42,    43,    44,    78,    67,    45,    46,    29,     1,
-      61,     2,   112,     3,     4,     5,    74,   105,     6,    47,
-     106,     7,   118,     8,    40,    23,    63,    25,    80,    81,
-       9,    10,    11,    12,    13,    14,    82,    83,    84,   121,
-      24,    30,    26,    15,    88,    89,    90,   -68,   121,    32,
-      88,    89,    90,    48,   103,   104,   109,   110,    49,    50,
-      51,    54,   113,    52,    57,    53,    55,    32,    70,    93,
-      76,    86,   115,   116,    87,   108,   117,   127,   122,   128,
-     107,   111,     0,   101
+      37,    66,    76,   141,    70,    73,    75,    75,    61,    31,
+      26,   139,    34,    30,   110,    28,    61,    84,    87,    88,
+      42,    43,    44,    35,    25,    27,    32,   142,   140,    66,
+      29,    47,    48,    49,    50,    36,    73,    51,    52,   124,
+     113,    45,   120,   114,    85,     1,    67,     2,    33,     3,
+       4,     5,    81,   133,     6,    93,    94,     7,    46,     8,
+      69,    82,    89,    90,    91,    86,     9,    10,    11,    12,
+      13,    14,    96,    97,    98,   136,    53,    15,   -77,    16,
+      17,   143,    95,    94,    18,    55,    75,    54,   136,   111,
+     112,   102,   103,   104,    35,    96,    97,    98,   121,   122,
+     125,    56,   146,    94,   105,   106,   107,    57,    60,    58,
+      59,    63,    61,    35,    77,    83,   101,   115,   127,   118,
+     128,   129,   130,   137,   131,   144,   145,   138,   117,   109,
+     123,   119
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_uint8 yycheck[] =
 {
-       8,    47,     8,    14,    50,    51,    52,    53,    34,    35,
-      36,     4,    23,    38,     7,    14,    58,    33,    76,     4,
-      62,    47,    48,    49,    38,    50,    32,     0,    74,    45,
-      23,    24,    25,    26,    45,    81,    29,    30,    10,     3,
-      48,     5,   100,     7,     8,     9,    45,    30,    12,    16,
-      33,    15,   110,    17,    42,     6,    49,     6,    44,    45,
-      24,    25,    26,    27,    28,    29,    18,    19,    20,   115,
-      21,    13,    21,    37,    39,    40,    41,    46,   124,    38,
-      39,    40,    41,    45,    77,    78,    44,    45,    13,    46,
-      43,    11,   100,    43,    38,    43,    14,    38,    43,    22,
-      47,    44,    31,    40,    44,    43,    40,    40,    44,   124,
-      81,    93,    -1,    74
+       8,    53,    59,     8,    56,    57,    58,    59,    14,     4,
+       6,    33,     7,    43,    83,     6,    14,    23,    49,    50,
+      15,    16,    17,    43,     4,    21,    10,    32,    50,    81,
+      21,    26,    27,    28,    29,    55,    88,    32,    33,   108,
+      30,     0,    94,    33,    50,     3,    54,     5,    13,     7,
+       8,     9,    50,   122,    12,    49,    50,    15,    47,    17,
+      55,    64,    18,    19,    20,    68,    24,    25,    26,    27,
+      28,    29,    44,    45,    46,   127,    16,    35,    51,    37,
+      38,   138,    49,    50,    42,    13,   138,    50,   140,    84,
+      85,    39,    40,    41,    43,    44,    45,    46,    49,    50,
+     108,    51,    49,    50,    52,    53,    54,    48,    11,    48,
+      48,    43,    14,    43,    48,    52,    22,    34,    31,    48,
+      45,    43,    45,    49,    36,    45,   140,    48,    88,    81,
+     101,    93
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     3,     5,     7,     8,     9,    12,    15,    17,    24,
-      25,    26,    27,    28,    29,    37,    52,    53,    54,    55,
-      56,    59,     4,     6,    21,     6,    21,    38,    76,    10,
-      13,    76,    38,    50,    68,    69,    74,    76,    77,     0,
-      42,    76,    76,    76,    76,    76,    76,    16,    45,    13,
-      46,    43,    43,    43,    11,    14,    66,    38,    72,    73,
-      77,    68,    75,    76,    77,    60,    61,    77,    77,    77,
-      43,    65,    67,    68,    45,    66,    47,    23,    45,    66,
-      44,    45,    18,    19,    20,    62,    44,    44,    39,    40,
-      41,    63,    64,    22,    34,    35,    36,    47,    48,    49,
-      70,    73,    64,    76,    76,    30,    33,    61,    43,    44,
-      45,    65,    64,    68,    71,    31,    40,    40,    64,    57,
-      58,    77,    44,    33,    45,     8,    32,    40,    57
+      25,    26,    27,    28,    29,    35,    37,    38,    42,    57,
+      58,    59,    60,    61,    64,     4,     6,    21,     6,    21,
+      43,    84,    10,    13,    84,    43,    55,    73,    74,    79,
+      84,    85,    84,    84,    84,     0,    47,    84,    84,    84,
+      84,    84,    84,    16,    50,    13,    51,    48,    48,    48,
+      11,    14,    71,    43,    77,    78,    85,    73,    80,    84,
+      85,    65,    66,    85,    81,    85,    81,    48,    70,    72,
+      73,    50,    71,    52,    23,    50,    71,    49,    50,    18,
+      19,    20,    67,    49,    50,    49,    44,    45,    46,    68,
+      69,    22,    39,    40,    41,    52,    53,    54,    75,    78,
+      69,    84,    84,    30,    33,    34,    83,    66,    48,    83,
+      85,    49,    50,    70,    69,    73,    76,    31,    45,    43,
+      45,    36,    82,    69,    62,    63,    85,    49,    48,    33,
+      50,     8,    32,    81,    45,    62,    49
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    51,    52,    52,    52,    52,    53,    53,    53,    53,
-      54,    54,    54,    54,    55,    56,    56,    56,    56,    56,
-      57,    57,    57,    58,    58,    59,    59,    59,    59,    59,
-      59,    59,    60,    60,    61,    62,    62,    62,    63,    63,
-      64,    64,    64,    65,    66,    66,    67,    67,    68,    68,
-      69,    69,    70,    70,    70,    70,    70,    70,    71,    71,
-      72,    72,    73,    74,    74,    75,    75,    75,    76,    77
+       0,    56,    57,    57,    57,    57,    58,    58,    58,    58,
+      59,    59,    59,    59,    60,    61,    61,    61,    61,    61,
+      61,    61,    61,    62,    62,    62,    63,    63,    64,    64,
+      64,    64,    64,    64,    64,    65,    65,    66,    67,    67,
+      67,    68,    68,    69,    69,    69,    70,    71,    71,    72,
+      72,    73,    73,    74,    74,    75,    75,    75,    75,    75,
+      75,    76,    76,    77,    77,    78,    79,    79,    80,    80,
+      80,    81,    81,    82,    82,    83,    83,    84,    85
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     6,     3,     2,     6,     6,
-       1,     2,     2,     1,     3,     7,     4,     5,     5,     8,
-       7,    10,     1,     3,     2,     1,     4,     1,     1,     3,
-       1,     1,     1,     3,     0,     2,     1,     3,     3,     1,
-       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     3,     3,     1,     1,     1,     3,     3,     1,     1
+       1,     1,     1,     1,     2,     7,     3,     2,     8,     6,
+       2,     2,     2,     1,     2,     2,     1,     3,     7,     4,
+       5,     5,     8,     7,    10,     1,     3,     2,     1,     4,
+       1,     1,     3,     1,     1,     1,     3,     0,     2,     1,
+       3,     3,     1,     1,     3,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     3,     3,     1,     1,     1,     3,
+       3,     1,     3,     0,     4,     0,     2,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -776,10 +820,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -823,12 +866,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -856,24 +906,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
 
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -884,19 +942,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -906,14 +961,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -946,7 +1002,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -958,9 +1015,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -975,8 +1032,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -999,12 +1056,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1014,13 +1120,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1034,10 +1140,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1052,7 +1158,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1086,31 +1191,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1134,52 +1223,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1187,17 +1278,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1206,7 +1303,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1218,7 +1315,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1229,29 +1326,32 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1259,7 +1359,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (void)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1278,55 +1378,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1334,17 +1429,10 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1367,10 +1455,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1401,7 +1490,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1412,11 +1501,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1436,6 +1525,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1456,18 +1546,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1539,498 +1641,566 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 57 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 2: /* start: stmt ';'  */
+#line 57 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1549 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1651 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 3:
-#line 62 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 3: /* start: HELP  */
+#line 62 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1558 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1660 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 4:
-#line 67 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 4: /* start: EXIT  */
+#line 67 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1567 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1669 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 5:
-#line 72 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 5: /* start: T_EOF  */
+#line 72 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1576 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1678 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 10:
-#line 87 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 10: /* txnStmt: TXN_BEGIN  */
+#line 87 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1584 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1686 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 11:
-#line 91 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 11: /* txnStmt: TXN_COMMIT  */
+#line 91 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1592 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1694 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 12:
-#line 95 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 12: /* txnStmt: TXN_ABORT  */
+#line 95 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1600 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1702 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 13:
-#line 99 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 13: /* txnStmt: TXN_ROLLBACK  */
+#line 99 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1608 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1710 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 14:
-#line 106 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 14: /* dbStmt: SHOW TABLES  */
+#line 106 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1616 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1718 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 15:
-#line 113 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 15: /* ddl: CREATE TABLE tbName '(' fieldList ')' optUsing  */
+#line 113 "/root/repo/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), (yyvsp[0].sv_str));
     }
-#line 1624 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1726 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 16:
-#line 117 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 16: /* ddl: DROP TABLE tbName  */
+#line 117 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1632 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1734 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 17:
-#line 121 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 17: /* ddl: DESC tbName  */
+#line 121 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1640 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1742 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 18: /* ddl: CREATE INDEX tbName '(' colNameList ')' optUsing optInclude  */
+#line 125 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-5].sv_str), (yyvsp[-3].sv_strs), (yyvsp[0].sv_strs), (yyvsp[-1].sv_str));
+    }
+#line 1750 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 19: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 129 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+    }
+#line 1758 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 20: /* ddl: VACUUM tbName  */
+#line 133 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<VacuumTable>((yyvsp[0].sv_str));
+    }
+#line 1766 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 18:
-#line 125 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 21: /* ddl: REINDEX tbName  */
+#line 137 "/root/repo/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_str));
+        (yyval.sv_node) = std::make_shared<ReindexTable>((yyvsp[0].sv_str));
     }
-#line 1648 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1774 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 19:
-#line 129 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 22: /* ddl: ANALYZE tbName  */
+#line 141 "/root/repo/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_str));
+        (yyval.sv_node) = std::make_shared<AnalyzeTable>((yyvsp[0].sv_str));
     }
-#line 1656 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1782 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 20:
-#line 136 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 23: /* ordercol: colName  */
+#line 148 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order_col) = std::make_shared<OrderCol>((yyvsp[0].sv_str), true);
     }
-#line 1664 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1790 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 21:
-#line 140 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 24: /* ordercol: colName ASC  */
+#line 152 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order_col) = std::make_shared<OrderCol>((yyvsp[-1].sv_str), true);
     }
-#line 1672 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1798 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 22:
-#line 144 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 25: /* ordercol: colName DESC  */
+#line 156 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order_col) = std::make_shared<OrderCol>((yyvsp[-1].sv_str), false);
     }
-#line 1680 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1806 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 23:
-#line 150 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 26: /* orderbyList: ordercol  */
+#line 162 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order_cols) = std::vector<std::shared_ptr<OrderCol>>{(yyvsp[0].sv_order_col)};
     }
-#line 1688 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1814 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 24:
-#line 154 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 27: /* orderbyList: orderbyList ',' ordercol  */
+#line 166 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order_cols).push_back((yyvsp[0].sv_order_col));
     }
-#line 1696 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1822 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 25:
-#line 160 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 28: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 172 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1704 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1830 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 26:
-#line 164 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 29: /* dml: DELETE FROM tbName optWhereClause  */
+#line 176 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1712 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1838 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 27:
-#line 168 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 30: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 180 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1720 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1846 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 28:
-#line 172 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 31: /* dml: SELECT selector FROM tableList optWhereClause  */
+#line 184 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-3].sv_cols), (yyvsp[-1].sv_strs), (yyvsp[0].sv_conds));
     }
-#line 1728 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1854 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 29:
-#line 177 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 32: /* dml: SELECT selector FROM tableList optWhereClause ORDER BY orderbyList  */
+#line 189 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-6].sv_cols), (yyvsp[-4].sv_strs), (yyvsp[-3].sv_conds), (yyvsp[0].sv_order_cols));
     }
-#line 1736 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1862 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 30:
-#line 182 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 33: /* dml: SELECT selector FROM tableList optWhereClause LIMIT VALUE_INT  */
+#line 194 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), std::vector<std::shared_ptr<OrderCol>>{}, (yyvsp[0].sv_int));
     }
-#line 1744 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1870 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 31:
-#line 187 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 34: /* dml: SELECT selector FROM tableList optWhereClause ORDER BY orderbyList LIMIT VALUE_INT  */
+#line 199 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-8].sv_cols), (yyvsp[-6].sv_strs), (yyvsp[-5].sv_conds), (yyvsp[-2].sv_order_cols), (yyvsp[0].sv_int));
     }
-#line 1752 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1878 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 32:
-#line 194 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 35: /* fieldList: field  */
+#line 206 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1760 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1886 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 33:
-#line 198 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 36: /* fieldList: fieldList ',' field  */
+#line 210 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1768 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1894 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 34:
-#line 205 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 37: /* field: colName type  */
+#line 217 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1776 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1902 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 35:
-#line 212 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 38: /* type: INT  */
+#line 224 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1784 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1910 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 36:
-#line 216 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 39: /* type: CHAR '(' VALUE_INT ')'  */
+#line 228 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1792 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1918 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 37:
-#line 220 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 40: /* type: FLOAT  */
+#line 232 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1800 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1926 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 38:
-#line 227 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 41: /* valueList: value  */
+#line 239 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1808 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1934 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 39:
-#line 231 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 42: /* valueList: valueList ',' value  */
+#line 243 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1816 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1942 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 40:
-#line 238 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 43: /* value: VALUE_INT  */
+#line 250 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1824 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1950 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 41:
-#line 242 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 44: /* value: VALUE_FLOAT  */
+#line 254 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1832 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1958 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 42:
-#line 246 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 45: /* value: VALUE_STRING  */
+#line 258 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1840 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1966 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 43:
-#line 253 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 46: /* condition: col op expr  */
+#line 265 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1848 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1974 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 44:
-#line 259 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 47: /* optWhereClause: %empty  */
+#line 271 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1854 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1980 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 45:
-#line 261 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 48: /* optWhereClause: WHERE whereClause  */
+#line 273 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1862 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1988 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 46:
-#line 268 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 49: /* whereClause: condition  */
+#line 280 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1870 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 1996 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 47:
-#line 272 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 50: /* whereClause: whereClause AND condition  */
+#line 284 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1878 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2004 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 48:
-#line 279 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 51: /* col: tbName '.' colName  */
+#line 291 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1886 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2012 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 49:
-#line 283 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 52: /* col: colName  */
+#line 295 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1894 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2020 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 50:
-#line 290 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 53: /* colList: col  */
+#line 302 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1902 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2028 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 51:
-#line 294 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 54: /* colList: colList ',' col  */
+#line 306 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 1910 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2036 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 52:
-#line 301 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 55: /* op: '='  */
+#line 313 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 1918 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2044 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 53:
-#line 305 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 56: /* op: '<'  */
+#line 317 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 1926 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2052 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 54:
-#line 309 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 57: /* op: '>'  */
+#line 321 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 1934 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2060 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 55:
-#line 313 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 58: /* op: NEQ  */
+#line 325 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 1942 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2068 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 56:
-#line 317 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 59: /* op: LEQ  */
+#line 329 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 1950 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2076 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 57:
-#line 321 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 60: /* op: GEQ  */
+#line 333 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 1958 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2084 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 58:
-#line 328 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 61: /* expr: value  */
+#line 340 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 1966 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2092 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 59:
-#line 332 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 62: /* expr: col  */
+#line 344 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 1974 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2100 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 60:
-#line 339 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 63: /* setClauses: setClause  */
+#line 351 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 1982 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2108 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 61:
-#line 343 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 64: /* setClauses: setClauses ',' setClause  */
+#line 355 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 1990 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2116 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 62:
-#line 350 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 65: /* setClause: colName '=' value  */
+#line 362 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 1998 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2124 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 63:
-#line 357 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 66: /* selector: '*'  */
+#line 369 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2006 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2132 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 65:
-#line 365 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 68: /* tableList: tbName  */
+#line 377 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2014 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2140 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 66:
-#line 369 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 69: /* tableList: tableList ',' tbName  */
+#line 381 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2022 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2148 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 67:
-#line 373 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+  case 70: /* tableList: tableList JOIN tbName  */
+#line 385 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2030 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+#line 2156 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
+  case 71: /* colNameList: colName  */
+#line 392 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
+    }
+#line 2164 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
 
-#line 2034 "/home/luo/RUCbase/rucbase/src/parser/yacc.tab.cpp"
+  case 72: /* colNameList: colNameList ',' colName  */
+#line 396 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs).push_back((yyvsp[0].sv_str));
+    }
+#line 2172 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 73: /* optInclude: %empty  */
+#line 402 "/root/repo/src/parser/yacc.y"
+                      { (yyval.sv_strs) = {}; }
+#line 2178 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 74: /* optInclude: INCLUDE '(' colNameList ')'  */
+#line 404 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs) = (yyvsp[-1].sv_strs);
+    }
+#line 2186 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 75: /* optUsing: %empty  */
+#line 410 "/root/repo/src/parser/yacc.y"
+                      { (yyval.sv_str) = ""; }
+#line 2192 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 76: /* optUsing: USING IDENTIFIER  */
+#line 412 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_str) = (yyvsp[0].sv_str);
+    }
+#line 2200 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+
+#line 2204 "/root/repo/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2045,11 +2215,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2074,50 +2243,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2150,6 +2314,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2166,13 +2331,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2186,7 +2352,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2197,13 +2363,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2214,7 +2378,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2222,24 +2386,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2255,18 +2417,17 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 381 "/home/luo/RUCbase/rucbase/src/parser/yacc.y"
+
+#line 420 "/root/repo/src/parser/yacc.y"
 
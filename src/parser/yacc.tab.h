@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -31,11 +31,12 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-#ifndef YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
-# define YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
+#ifndef YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED
+# define YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
@@ -44,51 +45,61 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    SHOW = 258,
-    TABLES = 259,
-    CREATE = 260,
-    TABLE = 261,
-    DROP = 262,
-    DESC = 263,
-    INSERT = 264,
-    INTO = 265,
-    VALUES = 266,
-    DELETE = 267,
-    FROM = 268,
-    WHERE = 269,
-    UPDATE = 270,
-    SET = 271,
-    SELECT = 272,
-    INT = 273,
-    CHAR = 274,
-    FLOAT = 275,
-    INDEX = 276,
-    AND = 277,
-    JOIN = 278,
-    EXIT = 279,
-    HELP = 280,
-    TXN_BEGIN = 281,
-    TXN_COMMIT = 282,
-    TXN_ABORT = 283,
-    TXN_ROLLBACK = 284,
-    ORDER = 285,
-    BY = 286,
-    ASC = 287,
-    LIMIT = 288,
-    LEQ = 289,
-    NEQ = 290,
-    GEQ = 291,
-    T_EOF = 292,
-    IDENTIFIER = 293,
-    VALUE_STRING = 294,
-    VALUE_INT = 295,
-    VALUE_FLOAT = 296
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    SHOW = 258,                    /* SHOW  */
+    TABLES = 259,                  /* TABLES  */
+    CREATE = 260,                  /* CREATE  */
+    TABLE = 261,                   /* TABLE  */
+    DROP = 262,                    /* DROP  */
+    DESC = 263,                    /* DESC  */
+    INSERT = 264,                  /* INSERT  */
+    INTO = 265,                    /* INTO  */
+    VALUES = 266,                  /* VALUES  */
+    DELETE = 267,                  /* DELETE  */
+    FROM = 268,                    /* FROM  */
+    WHERE = 269,                   /* WHERE  */
+    UPDATE = 270,                  /* UPDATE  */
+    SET = 271,                     /* SET  */
+    SELECT = 272,                  /* SELECT  */
+    INT = 273,                     /* INT  */
+    CHAR = 274,                    /* CHAR  */
+    FLOAT = 275,                   /* FLOAT  */
+    INDEX = 276,                   /* INDEX  */
+    AND = 277,                     /* AND  */
+    JOIN = 278,                    /* JOIN  */
+    EXIT = 279,                    /* EXIT  */
+    HELP = 280,                    /* HELP  */
+    TXN_BEGIN = 281,               /* TXN_BEGIN  */
+    TXN_COMMIT = 282,              /* TXN_COMMIT  */
+    TXN_ABORT = 283,               /* TXN_ABORT  */
+    TXN_ROLLBACK = 284,            /* TXN_ROLLBACK  */
+    ORDER = 285,                   /* ORDER  */
+    BY = 286,                      /* BY  */
+    ASC = 287,                     /* ASC  */
+    LIMIT = 288,                   /* LIMIT  */
+    USING = 289,                   /* USING  */
+    VACUUM = 290,                  /* VACUUM  */
+    INCLUDE = 291,                 /* INCLUDE  */
+    REINDEX = 292,                 /* REINDEX  */
+    ANALYZE = 293,                 /* ANALYZE  */
+    LEQ = 294,                     /* LEQ  */
+    NEQ = 295,                     /* NEQ  */
+    GEQ = 296,                     /* GEQ  */
+    T_EOF = 297,                   /* T_EOF  */
+    IDENTIFIER = 298,              /* IDENTIFIER  */
+    VALUE_STRING = 299,            /* VALUE_STRING  */
+    VALUE_INT = 300,               /* VALUE_INT  */
+    VALUE_FLOAT = 301              /* VALUE_FLOAT  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
@@ -109,6 +120,8 @@ struct YYLTYPE
 
 
 
+
 int yyparse (void);
 
-#endif /* !YY_YY_HOME_LUO_RUCBASE_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED  */
+
+#endif /* !YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED  */
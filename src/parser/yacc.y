@@ -23,7 +23,7 @@ using namespace ast;
 // keywords
 %token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM
 WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK
-ORDER BY ASC LIMIT
+ORDER BY ASC LIMIT USING VACUUM INCLUDE REINDEX ANALYZE
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
 
@@ -41,8 +41,8 @@ ORDER BY ASC LIMIT
 %type <sv_expr> expr
 %type <sv_val> value
 %type <sv_vals> valueList
-%type <sv_str> tbName colName
-%type <sv_strs> tableList
+%type <sv_str> tbName colName optUsing
+%type <sv_strs> tableList colNameList optInclude
 %type <sv_col> col
 %type <sv_cols> colList selector
 %type <sv_set_clause> setClause
@@ -109,9 +109,9 @@ dbStmt:
     ;
 
 ddl:
-        CREATE TABLE tbName '(' fieldList ')'
+        CREATE TABLE tbName '(' fieldList ')' optUsing
     {
-        $$ = std::make_shared<CreateTable>($3, $5);
+        $$ = std::make_shared<CreateTable>($3, $5, $7);
     }
     |   DROP TABLE tbName
     {
@@ -121,14 +121,26 @@ ddl:
     {
         $$ = std::make_shared<DescTable>($2);
     }
-    |   CREATE INDEX tbName '(' colName ')'
+    |   CREATE INDEX tbName '(' colNameList ')' optUsing optInclude
     {
-        $$ = std::make_shared<CreateIndex>($3, $5);
+        $$ = std::make_shared<CreateIndex>($3, $5, $8, $7);
     }
-    |   DROP INDEX tbName '(' colName ')'
+    |   DROP INDEX tbName '(' colNameList ')'
     {
         $$ = std::make_shared<DropIndex>($3, $5);
     }
+    |   VACUUM tbName
+    {
+        $$ = std::make_shared<VacuumTable>($2);
+    }
+    |   REINDEX tbName
+    {
+        $$ = std::make_shared<ReindexTable>($2);
+    }
+    |   ANALYZE tbName
+    {
+        $$ = std::make_shared<AnalyzeTable>($2);
+    }
     ;
 
 ordercol:
@@ -375,6 +387,33 @@ tableList:
     }
     ;
 
+colNameList:
+        colName
+    {
+        $$ = std::vector<std::string>{$1};
+    }
+    |   colNameList ',' colName
+    {
+        $$.push_back($3);
+    }
+    ;
+
+optInclude:
+        /* epsilon */ { $$ = {}; }
+    |   INCLUDE '(' colNameList ')'
+    {
+        $$ = $3;
+    }
+    ;
+
+optUsing:
+        /* epsilon */ { $$ = ""; }
+    |   USING IDENTIFIER
+    {
+        $$ = $2;
+    }
+    ;
+
 tbName: IDENTIFIER;
 
 colName: IDENTIFIER;
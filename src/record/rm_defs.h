@@ -8,6 +8,18 @@ constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+// 超过该长度的字符串字段不再内联存放在记录中，而是存放到溢出文件（<table>.ovf）的页链中
+constexpr int RM_OVERFLOW_THRESHOLD = RM_MAX_RECORD_SIZE;
+constexpr int RM_OVERFLOW_HDR_PAGE = 0;
+constexpr int RM_MAX_COLS = 64;  // PAX布局下一张表最多的列数
+constexpr int RM_VACUUM_BATCH_SIZE = 1024;  // VACUUM每个批次最多移动的记录数，每个批次结束时截断尾部的空page
+constexpr int RM_LOOKAHEAD_PAGES = 32;  // 回表扫描默认同时预读的记录页个数，见RmLookaheadScan
+
+// 页内记录布局（在CREATE TABLE时指定，保存在file header中）
+enum RmLayout {
+    RM_LAYOUT_NSM = 0,  // 按行存放，每个slot存放一条完整的记录
+    RM_LAYOUT_PAX = 1   // 按列存放，页内每一列的值连续存放在各自的minipage中
+};
 
 // record file header（RmManager::create_file函数初始化，并写入磁盘文件中的第0页）
 struct RmFileHdr {
@@ -17,6 +29,9 @@ struct RmFileHdr {
     int num_records_per_page;  // 每个page最多能存储的元组个数
     int first_free_page_no;    // 文件中当前第一个可用的page no（初始化为-1）
     int bitmap_size;           // bitmap大小
+    int layout;                // 页内记录布局RmLayout（旧文件中为0，即RM_LAYOUT_NSM）
+    int num_cols;              // PAX布局下记录的列数
+    int col_lens[RM_MAX_COLS];  // PAX布局下每一列的长度，所有列长之和等于record_size
 };
 
 // record page header（RmFileHandle::create_page函数进行初始化）
@@ -25,6 +40,24 @@ struct RmPageHdr {
     int num_records;        // 当前page中当前分配的record个数（初始化为0）
 };
 
+// 记录中溢出字段所存放的指针，指向溢出文件中的页链
+struct RmOverflowPtr {
+    int first_page_no;  // 页链的第一个page no（值为空串时为RM_NO_PAGE）
+    int len;            // 字段值的实际长度
+};
+
+// overflow file header（RmManager::create_overflow_file函数初始化，并写入溢出文件中的第0页）
+struct RmOverflowFileHdr {
+    int num_pages;           // 文件中当前分配的page个数（初始化为1）
+    int first_free_page_no;  // 已释放的page组成的空闲链表表头（初始化为-1）
+};
+
+// overflow page header，每个溢出页存放一段字段值，并指向页链中的下一页
+struct RmOverflowPageHdr {
+    int next_page_no;  // 页链中的下一个page no（最后一页为-1）
+    int data_len;      // 当前page中存放的数据长度
+};
+
 // 类似于Tuple
 struct RmRecord {
     char *data;  // data初始化分配size个字节的空间
@@ -13,13 +13,78 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *cont
     // 加锁
     context->lock_mgr_->LockSharedOnRecord(context->txn_, rid, fd_);
     RmPageHandle pagehandle = fetch_page_handle(rid.page_no);
-    std::unique_ptr<RmRecord> recordptr{new RmRecord(file_hdr_.record_size, pagehandle.get_slot(rid.slot_no))};
+    std::unique_ptr<RmRecord> recordptr{new RmRecord(file_hdr_.record_size)};
+    read_slot(pagehandle, rid.slot_no, recordptr->data);
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), false);
     // 放入锁集
     LockDataId lock_data_id =  LockDataId{fd_,rid,LockDataType::RECORD};
     context->txn_->GetLockSet()->insert(lock_data_id);
     return recordptr;
 }
 
+/**
+ * @brief 只读取记录中的部分列，返回的记录仍为行格式，未读取的列填0
+ * PAX布局下只会访问col_idxs对应的minipage；NSM布局下整条记录本来就是连续的，直接读取整条记录
+ *
+ * @param rid 指定记录所在的位置
+ * @param col_idxs 需要读取的列号
+ * @return std::unique_ptr<RmRecord>
+ */
+std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, const std::vector<int> &col_idxs,
+                                                   Context *context) const {
+    if (!is_pax()) {
+        return get_record(rid, context);
+    }
+    context->lock_mgr_->LockSharedOnRecord(context->txn_, rid, fd_);
+    RmPageHandle pagehandle = fetch_page_handle(rid.page_no);
+    std::unique_ptr<RmRecord> recordptr{new RmRecord(file_hdr_.record_size)};
+    memset(recordptr->data, 0, file_hdr_.record_size);
+    for (int col_idx : col_idxs) {
+        memcpy(recordptr->data + col_offsets_[col_idx], get_field(pagehandle, rid.slot_no, col_idx),
+               file_hdr_.col_lens[col_idx]);
+    }
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), false);
+    LockDataId lock_data_id = LockDataId{fd_, rid, LockDataType::RECORD};
+    context->txn_->GetLockSet()->insert(lock_data_id);
+    return recordptr;
+}
+
+/**
+ * @brief 不加锁地读取记录中的部分列（col_idxs为空时读取整条记录），未读取的列填0
+ * 供并行扫描的worker线程使用：事务的锁集不是线程安全的，worker只负责筛选记录，
+ * 满足条件的记录由执行器在返回给上层时再通过get_record()加锁读取并重新判断谓词
+ * 不持有记录锁，因此复制期间持有page的读latch，避免读到其他事务写了一半的记录
+ * 写操作先加记录锁再修改page，回滚也在释放锁之前完成，所以在同一个latch内检查到记录没有被其他事务加锁时，
+ * 读到的一定是已提交的内容；否则记录可能是未提交的修改，需要由调用者加锁后重新读取
+ *
+ * @param rid 指定记录所在的位置
+ * @param col_idxs 需要读取的列号
+ * @param context 不为nullptr时检查记录是否被其他事务加锁
+ * @param locked_by_others 输出记录是否被其他事务加锁
+ * @return std::unique_ptr<RmRecord>
+ */
+std::unique_ptr<RmRecord> RmFileHandle::read_record(const Rid &rid, const std::vector<int> &col_idxs, Context *context,
+                                                    bool *locked_by_others) const {
+    RmPageHandle pagehandle = fetch_page_handle(rid.page_no);
+    std::unique_ptr<RmRecord> recordptr{new RmRecord(file_hdr_.record_size)};
+    pagehandle.page->RLatch();
+    if (!is_pax() || col_idxs.empty()) {
+        read_slot(pagehandle, rid.slot_no, recordptr->data);
+    } else {
+        memset(recordptr->data, 0, file_hdr_.record_size);
+        for (int col_idx : col_idxs) {
+            memcpy(recordptr->data + col_offsets_[col_idx], get_field(pagehandle, rid.slot_no, col_idx),
+                   file_hdr_.col_lens[col_idx]);
+        }
+    }
+    if (context != nullptr) {
+        *locked_by_others = context->lock_mgr_->IsRecordLockedByOthers(context->txn_, rid, fd_);
+    }
+    pagehandle.page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), false);
+    return recordptr;
+}
+
 /**
  * @brief 在该记录文件（RmFileHandle）中插入一条记录
  *
@@ -38,15 +103,20 @@ Rid RmFileHandle::insert_record(char *buf, Context *context) {
     int i = Bitmap::first_bit(0,pagehandle.bitmap,file_hdr_.num_records_per_page);
     // 加锁
     context->lock_mgr_->LockExclusiveOnRecord(context->txn_, Rid{pagehandle.page->GetPageId().page_no,i},fd_);
-    char *slot = pagehandle.get_slot(i);
-    memcpy(slot, buf, file_hdr_.record_size);
+    // 写page时持有写latch，与并行扫描中不加锁的read_record()互斥
+    pagehandle.page->WLatch();
+    write_slot(pagehandle, i, buf);
     Bitmap::set(pagehandle.bitmap,i);
     pagehandle.page_hdr->num_records++;
+    zone_map_.on_insert(pagehandle.page->GetPageId().page_no, buf);
+    pagehandle.page->WUnlatch();
     if (pagehandle.page_hdr->num_records >= file_hdr_.num_records_per_page) //一般来说只会==时候触发
     {
         file_hdr_.first_free_page_no = pagehandle.page_hdr->next_free_page_no;
+        mark_hdr_dirty();
         pagehandle.page_hdr->next_free_page_no=-1;//重置，这行写不写无所谓
     }
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), true);
     // 放入锁集
     LockDataId lock_data_id =  LockDataId{fd_,Rid{pagehandle.page->GetPageId().page_no,i},LockDataType::RECORD};
     context->txn_->GetLockSet()->insert(lock_data_id);
@@ -66,17 +136,19 @@ void RmFileHandle::delete_record(const Rid &rid, Context *context) {
     // 加锁
     context->lock_mgr_->LockExclusiveOnRecord(context->txn_, rid, fd_);
     RmPageHandle pagehandle = fetch_page_handle(rid.page_no);
+    pagehandle.page->WLatch();
     Bitmap::reset(pagehandle.bitmap,rid.slot_no); 
     pagehandle.page_hdr->num_records--;
+    zone_map_.on_delete(rid.page_no);
+    pagehandle.page->WUnlatch();
     if(pagehandle.page_hdr->num_records==file_hdr_.num_records_per_page-1)//说明刚刚是满的
     {
         release_page_handle(pagehandle);
     }
-    
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), true);
     // 放入锁集
     LockDataId lock_data_id =  LockDataId{fd_,rid,LockDataType::RECORD};
     context->txn_->GetLockSet()->insert(lock_data_id);
-    // buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), true);
 }
 
 /**
@@ -92,13 +164,102 @@ void RmFileHandle::update_record(const Rid &rid, char *buf, Context *context) {
     // 加锁
     context->lock_mgr_->LockExclusiveOnRecord(context->txn_, rid, fd_);
     RmPageHandle pagehandle = fetch_page_handle(rid.page_no);
-    char *slot = pagehandle.get_slot(rid.slot_no);
-    memcpy(slot, buf, file_hdr_.record_size);
+    pagehandle.page->WLatch();
+    write_slot(pagehandle, rid.slot_no, buf);
+    zone_map_.on_update(rid.page_no, buf);
+    pagehandle.page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), true);
     // 放入锁集
     LockDataId lock_data_id =  LockDataId{fd_,rid,LockDataType::RECORD};
     context->txn_->GetLockSet()->insert(lock_data_id);
 }
 
+/**
+ * @brief 压缩记录文件：把尾部page中的记录移动到前面page的空闲slot中，然后截断尾部的空page
+ * 调用者需要保证期间没有其他事务访问该文件（持有表上的X锁），并且没有未提交的写操作（回滚会按原rid写回）
+ * 移动只改变记录的物理位置，由on_move负责更新索引中的rid
+ *
+ * @param max_moves 本批次最多移动的记录数
+ * @param on_move 每移动一条记录后调用
+ * @return int 本批次实际移动的记录数，小于max_moves说明压缩已经完成
+ */
+int RmFileHandle::vacuum(int max_moves, const MoveCallback &on_move) {
+    int moved = 0;
+    int dst_page = RM_FIRST_RECORD_PAGE;
+    int src_page = file_hdr_.num_pages - 1;
+    std::unique_ptr<char[]> buf(new char[file_hdr_.record_size]);
+    while (moved < max_moves) {
+        // src为最后一个有记录的page，dst为src之前第一个未满的page
+        while (src_page >= RM_FIRST_RECORD_PAGE && get_num_records(src_page) == 0) {
+            src_page--;
+        }
+        while (dst_page < src_page && get_num_records(dst_page) == file_hdr_.num_records_per_page) {
+            dst_page++;
+        }
+        if (dst_page >= src_page) {
+            break;
+        }
+        RmPageHandle src = fetch_page_handle(src_page);
+        RmPageHandle dst = fetch_page_handle(dst_page);
+        int src_slot = Bitmap::first_bit(1, src.bitmap, file_hdr_.num_records_per_page);
+        int dst_slot = Bitmap::first_bit(0, dst.bitmap, file_hdr_.num_records_per_page);
+        // dst_page < src_page，按page号顺序加latch
+        dst.page->WLatch();
+        src.page->WLatch();
+        read_slot(src, src_slot, buf.get());
+        write_slot(dst, dst_slot, buf.get());
+        Bitmap::set(dst.bitmap, dst_slot);
+        dst.page_hdr->num_records++;
+        Bitmap::reset(src.bitmap, src_slot);
+        src.page_hdr->num_records--;
+        zone_map_.on_insert(dst_page, buf.get());
+        zone_map_.on_delete(src_page);
+        src.page->WUnlatch();
+        dst.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(src.page->GetPageId(), true);
+        buffer_pool_manager_->UnpinPage(dst.page->GetPageId(), true);
+        on_move(Rid{src_page, src_slot}, Rid{dst_page, dst_slot}, buf.get());
+        moved++;
+    }
+    truncate_empty_pages();
+    return moved;
+}
+
+/**
+ * @brief 根据zone map判断指定page中是否可能存在满足谓词的记录
+ * 如果该page的zone尚未构建或者已经loose，先读取page中的全部记录重新计算min/max
+ * 写操作在page的写latch内维护zone，重新计算期间持有读latch，避免并发插入的记录被旧的min/max覆盖
+ *
+ * @param page_no 要判断的page
+ * @param preds 扫描谓词
+ * @return false表示该page可以直接跳过
+ */
+bool RmFileHandle::page_may_match(int page_no, const std::vector<RmScanPred> &preds) const {
+    if (preds.empty() || !zone_map_.enabled()) {
+        return true;
+    }
+    if (zone_map_.needs_build(page_no)) {
+        RmPageHandle pagehandle = fetch_page_handle(page_no);
+        pagehandle.page->RLatch();
+        // 加latch之前其他扫描可能已经完成了构建
+        if (zone_map_.needs_build(page_no)) {
+            std::vector<std::unique_ptr<char[]>> bufs;
+            std::vector<const char *> recs;
+            for (int i = Bitmap::first_bit(1, pagehandle.bitmap, file_hdr_.num_records_per_page);
+                 i < file_hdr_.num_records_per_page;
+                 i = Bitmap::next_bit(1, pagehandle.bitmap, file_hdr_.num_records_per_page, i)) {
+                bufs.emplace_back(new char[file_hdr_.record_size]);
+                read_slot(pagehandle, i, bufs.back().get());
+                recs.push_back(bufs.back().get());
+            }
+            zone_map_.rebuild(page_no, recs);
+        }
+        pagehandle.page->RUnlatch();
+        buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), false);
+    }
+    return zone_map_.may_match(page_no, preds);
+}
+
 /** -- 以下为辅助函数 -- */
 /**
  * @brief 获取指定页面编号的page handle
@@ -130,15 +291,15 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
     // 1.使用缓冲池来创建一个新page
     // 2.更新page handle中的相关信息
     // 3.更新file_hdr_
-    PageId *newpageid = new PageId;
-    newpageid->fd = fd_;
-    // newpageid->page_no=file_hdr_.num_pages;
-    // 应该下面会自动allocate a page
-    Page *newpage = buffer_pool_manager_->NewPage(newpageid);
+    PageId newpageid = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+    // NewPage中会调用AllocatePage分配page_no
+    Page *newpage = buffer_pool_manager_->NewPage(&newpageid);
     RmPageHandle newPageHandle = RmPageHandle(&file_hdr_, newpage);
     newPageHandle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
-    file_hdr_.first_free_page_no = newpageid->page_no;
+    file_hdr_.first_free_page_no = newpageid.page_no;
     file_hdr_.num_pages++;
+    mark_hdr_dirty();
+    zone_map_.init_page(newpageid.page_no);
     return newPageHandle;
 }
 
@@ -175,22 +336,94 @@ void RmFileHandle::release_page_handle(RmPageHandle &page_handle) {
     // 2. file_hdr_.first_free_page_no
     page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
     file_hdr_.first_free_page_no = page_handle.page->GetPageId().page_no;
+    mark_hdr_dirty();
+}
+
+/**
+ * @brief 返回指定page中的记录数
+ */
+int RmFileHandle::get_num_records(int page_no) const {
+    RmPageHandle pagehandle = fetch_page_handle(page_no);
+    int num_records = pagehandle.page_hdr->num_records;
+    buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), false);
+    return num_records;
+}
+
+/**
+ * @brief 截断文件尾部没有记录的page，并按page_no从小到大重建空闲page链表
+ * 重建后插入会优先使用前面的page，文件不会再次无谓地变长
+ * @note only used in vacuum()
+ */
+void RmFileHandle::truncate_empty_pages() {
+    int num_pages = file_hdr_.num_pages;
+    while (num_pages > RM_FIRST_RECORD_PAGE && get_num_records(num_pages - 1) == 0) {
+        num_pages--;
+    }
+    if (num_pages < file_hdr_.num_pages) {
+        buffer_pool_manager_->DiscardPages(fd_, num_pages);
+        disk_manager_->truncate_file(fd_, num_pages);
+        file_hdr_.num_pages = num_pages;
+        zone_map_.truncate(num_pages);
+    }
+    file_hdr_.first_free_page_no = RM_NO_PAGE;
+    for (int page_no = num_pages - 1; page_no >= RM_FIRST_RECORD_PAGE; page_no--) {
+        RmPageHandle pagehandle = fetch_page_handle(page_no);
+        if (pagehandle.page_hdr->num_records < file_hdr_.num_records_per_page) {
+            pagehandle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
+            file_hdr_.first_free_page_no = page_no;
+        } else {
+            pagehandle.page_hdr->next_free_page_no = RM_NO_PAGE;
+        }
+        buffer_pool_manager_->UnpinPage(pagehandle.page->GetPageId(), true);
+    }
+    mark_hdr_dirty();
 }
 
 // used for recovery (lab4)
 void RmFileHandle::insert_record(const Rid &rid, char *buf) {
     if (rid.page_no < file_hdr_.num_pages) {
-        create_new_page_handle();
+        RmPageHandle new_page_handle = create_new_page_handle();
+        buffer_pool_manager_->UnpinPage(new_page_handle.page->GetPageId(), true);
     }
     RmPageHandle pageHandle = fetch_page_handle(rid.page_no);
+    pageHandle.page->WLatch();
     Bitmap::set(pageHandle.bitmap, rid.slot_no);
     pageHandle.page_hdr->num_records++;
     if (pageHandle.page_hdr->num_records == file_hdr_.num_records_per_page) {
         file_hdr_.first_free_page_no = pageHandle.page_hdr->next_free_page_no;
+        mark_hdr_dirty();
     }
 
-    char *slot = pageHandle.get_slot(rid.slot_no);
-    memcpy(slot, buf, file_hdr_.record_size);
+    write_slot(pageHandle, rid.slot_no, buf);
+    zone_map_.on_insert(rid.page_no, buf);
+    pageHandle.page->WUnlatch();
 
     buffer_pool_manager_->UnpinPage(pageHandle.page->GetPageId(), true);
-}
\ No newline at end of file
+}
+/**
+ * @brief 将slot_no处的记录以行格式复制到buf中
+ * PAX布局下需要从各列的minipage中收集该记录的各个字段
+ */
+void RmFileHandle::read_slot(const RmPageHandle &page_handle, int slot_no, char *buf) const {
+    if (!is_pax()) {
+        memcpy(buf, page_handle.get_slot(slot_no), file_hdr_.record_size);
+        return;
+    }
+    for (int i = 0; i < file_hdr_.num_cols; i++) {
+        memcpy(buf + col_offsets_[i], get_field(page_handle, slot_no, i), file_hdr_.col_lens[i]);
+    }
+}
+
+/**
+ * @brief 将行格式的记录buf写入slot_no处
+ * PAX布局下需要把各个字段分散写入各列的minipage中
+ */
+void RmFileHandle::write_slot(const RmPageHandle &page_handle, int slot_no, const char *buf) {
+    if (!is_pax()) {
+        memcpy(page_handle.get_slot(slot_no), buf, file_hdr_.record_size);
+        return;
+    }
+    for (int i = 0; i < file_hdr_.num_cols; i++) {
+        memcpy(get_field(page_handle, slot_no, i), buf + col_offsets_[i], file_hdr_.col_lens[i]);
+    }
+}
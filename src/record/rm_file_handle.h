@@ -2,11 +2,14 @@
 
 #include <assert.h>
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "bitmap.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_zone_map.h"
 
 class RmManager;
 
@@ -43,17 +46,29 @@ class RmFileHandle {      // TableHeap
      * page_no范围为[0,file_hdr.num_pages)，page_no从0开始增加，其中第0页存file_hdr，从第1页开始存page_handle
      * 在page_handle中有page_hdr.free_page_no存第一个可用(未满)的page_no
      * */
-    RmFileHdr file_hdr_;
+    Page *hdr_page_;       // file header所在的第0页，文件打开期间一直pin在缓冲池中，关闭时随其他page一起刷盘
+    RmFileHdr &file_hdr_;  // 指向hdr_page_中的file header，修改之后调用mark_hdr_dirty()
+    std::vector<int> col_offsets_;  // PAX布局下每一列在行格式记录中的偏移量，也用于定位该列的minipage
+    mutable RmZoneMap zone_map_;    // 每个page各列的min/max，扫描时惰性构建/收紧
 
    public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
-        : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
-        // 注意：这里从磁盘中读出文件描述符为fd的文件的file_hdr，读到内存中
-        // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
-        // init file_hdr_
-        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+        : disk_manager_(disk_manager),
+          buffer_pool_manager_(buffer_pool_manager),
+          fd_(fd),
+          hdr_page_(buffer_pool_manager->FetchPage(PageId{.fd = fd, .page_no = RM_FILE_HDR_PAGE})),
+          file_hdr_(*reinterpret_cast<RmFileHdr *>(hdr_page_->GetData())) {
+        // 注意：file_hdr_直接使用缓冲池中第0页的内容，修改file header不需要立即写盘，
+        // 由RmManager::close_file()通过FlushAllPages()和数据page一起写回
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+        if (is_pax()) {
+            int offset = 0;
+            for (int i = 0; i < file_hdr_.num_cols; i++) {
+                col_offsets_.push_back(offset);
+                offset += file_hdr_.col_lens[i];
+            }
+        }
     }
 
     DISALLOW_COPY(RmFileHandle);
@@ -63,13 +78,33 @@ class RmFileHandle {      // TableHeap
     RmFileHdr get_file_hdr() { return file_hdr_; }
     int GetFd() { return fd_; }
 
+    bool is_pax() const { return file_hdr_.layout == RM_LAYOUT_PAX; }
+
+    // file header被修改之后调用，header页一直被pin住，不经过UnpinPage
+    void mark_hdr_dirty() { buffer_pool_manager_->MarkDirty(hdr_page_); }
+
+    // 设置zone map统计的列（由SmManager在打开/创建表时调用）
+    void set_zone_cols(std::vector<RmZoneCol> cols) { zone_map_.set_cols(std::move(cols)); }
+
+    bool page_may_match(int page_no, const std::vector<RmScanPred> &preds) const;
+
+    // 提示缓冲池即将读取该page，不在缓冲池中时由操作系统在后台读入
+    void prefetch_page(int page_no) const { buffer_pool_manager_->PrefetchPage(PageId{fd_, page_no}); }
+
     bool is_record(const Rid &rid) const {
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool is_set = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        return is_set;
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
 
+    std::unique_ptr<RmRecord> get_record(const Rid &rid, const std::vector<int> &col_idxs, Context *context) const;
+
+    std::unique_ptr<RmRecord> read_record(const Rid &rid, const std::vector<int> &col_idxs, Context *context = nullptr,
+                                          bool *locked_by_others = nullptr) const;
+
     Rid insert_record(char *buf, Context *context);
 
     void insert_record(const Rid &rid, char *buf);
@@ -78,6 +113,11 @@ class RmFileHandle {      // TableHeap
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
+    // 记录被VACUUM移动后的回调，参数为(旧rid, 新rid, 记录数据)
+    using MoveCallback = std::function<void(const Rid &, const Rid &, const char *)>;
+
+    int vacuum(int max_moves, const MoveCallback &on_move);
+
     RmPageHandle create_new_page_handle();
 
     RmPageHandle fetch_page_handle(int page_no) const;
@@ -86,4 +126,18 @@ class RmFileHandle {      // TableHeap
     RmPageHandle create_page_handle();
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    int get_num_records(int page_no) const;
+
+    void truncate_empty_pages();
+
+    // PAX布局下，返回位于slot_no的记录的第col_idx列在其minipage中的地址
+    char *get_field(const RmPageHandle &page_handle, int slot_no, int col_idx) const {
+        return page_handle.slots + col_offsets_[col_idx] * file_hdr_.num_records_per_page +
+               slot_no * file_hdr_.col_lens[col_idx];
+    }
+
+    void read_slot(const RmPageHandle &page_handle, int slot_no, char *buf) const;
+
+    void write_slot(const RmPageHandle &page_handle, int slot_no, const char *buf);
 };
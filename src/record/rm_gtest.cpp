@@ -16,10 +16,13 @@
 #include "rm.h"
 #undef private  // for use private variables in "rm.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 
 #include "gtest/gtest.h"
@@ -235,4 +238,571 @@ TEST(RecordManagerTest, MultipleFilesTest) {
         std::string filename = filenames[i];
         rm_manager->destroy_file(filename);
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief 测试溢出页链的写入、读取、释放与复用
+ */
+TEST(RecordManagerTest, OverflowTest) {
+    srand((unsigned)time(nullptr));
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "ovf_table";
+    if (disk_manager->is_file(rm_manager->get_overflow_name(filename))) {
+        rm_manager->destroy_overflow_file(filename);
+    }
+    rm_manager->create_overflow_file(filename);
+    auto overflow_handle = rm_manager->open_overflow_file(filename);
+    assert(overflow_handle->file_hdr_.num_pages == 1);
+    assert(overflow_handle->file_hdr_.first_free_page_no == RM_NO_PAGE);
+
+    // 值的长度覆盖空串、单页和跨多页的情况
+    std::vector<int> lens = {0, 1, RmOverflowHandle::DATA_PER_PAGE, RmOverflowHandle::DATA_PER_PAGE + 1,
+                             3 * RmOverflowHandle::DATA_PER_PAGE + 17};
+    std::vector<std::pair<RmOverflowPtr, std::string>> mock;
+    for (int len : lens) {
+        std::string value(len, '\0');
+        rand_buf(len, value.data());
+        mock.emplace_back(overflow_handle->insert_value(value.data(), len), value);
+    }
+
+    auto check_values = [&]() {
+        for (auto &entry : mock) {
+            int buf_len = entry.second.size() + 8;
+            std::vector<char> buf(buf_len, 'x');
+            overflow_handle->get_value(entry.first, buf.data(), buf_len);
+            assert(memcmp(buf.data(), entry.second.data(), entry.second.size()) == 0);
+            // 缓冲区剩余部分填0
+            for (int i = entry.second.size(); i < buf_len; i++) {
+                assert(buf[i] == 0);
+            }
+        }
+    };
+    check_values();
+
+    // reopen file
+    rm_manager->close_overflow_file(overflow_handle.get());
+    overflow_handle = rm_manager->open_overflow_file(filename);
+    check_values();
+
+    // 释放最长的页链后，相同长度的新值应当复用释放的页，而不是分配新页
+    int num_pages = overflow_handle->file_hdr_.num_pages;
+    overflow_handle->delete_value(mock.back().first);
+    assert(overflow_handle->file_hdr_.first_free_page_no != RM_NO_PAGE);
+    mock.pop_back();
+    std::string value(lens.back(), '\0');
+    rand_buf(value.size(), value.data());
+    mock.emplace_back(overflow_handle->insert_value(value.data(), value.size()), value);
+    assert(overflow_handle->file_hdr_.num_pages == num_pages);
+    assert(overflow_handle->file_hdr_.first_free_page_no == RM_NO_PAGE);
+    check_values();
+
+    rm_manager->close_overflow_file(overflow_handle.get());
+    rm_manager->destroy_overflow_file(filename);
+}
+
+/**
+ * @brief 测试PAX布局：记录按列存放在minipage中，读写接口仍为行格式
+ */
+TEST(RecordManagerTest, PaxLayoutTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::string filename = "pax_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+
+    // 随机生成若干列
+    std::vector<int> col_lens;
+    int record_size = 0;
+    while (col_lens.size() < 20 && record_size < 200) {
+        int len = 1 + rand() % 16;
+        col_lens.push_back(len);
+        record_size += len;
+    }
+    rm_manager->create_file(filename, record_size, RM_LAYOUT_PAX, col_lens);
+    auto file_handle = rm_manager->open_file(filename);
+    assert(file_handle->is_pax());
+    assert(file_handle->file_hdr_.num_cols == (int)col_lens.size());
+
+    char write_buf[PAGE_SIZE];
+    for (int round = 0; round < 1000; round++) {
+        double insert_prob = 1. - mock.size() / 500.;
+        double dice = rand() * 1. / RAND_MAX;
+        if (mock.empty() || dice < insert_prob) {
+            rand_buf(record_size, write_buf);
+            Rid rid = file_handle->insert_record(write_buf, context);
+            mock[rid] = std::string((char *)write_buf, record_size);
+        } else {
+            auto it = mock.begin();
+            std::advance(it, rand() % mock.size());
+            auto rid = it->first;
+            if (rand() % 2 == 0) {
+                rand_buf(record_size, write_buf);
+                file_handle->update_record(rid, write_buf, context);
+                mock[rid] = std::string((char *)write_buf, record_size);
+            } else {
+                file_handle->delete_record(rid, context);
+                mock.erase(rid);
+            }
+        }
+        if (round % 100 == 0) {
+            rm_manager->close_file(file_handle.get());
+            file_handle = rm_manager->open_file(filename);
+        }
+    }
+    // check_equal使用的context没有lock manager，这里直接用本测试的context逐条检查
+    size_t num_records = 0;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        assert(mock.count(scan.rid()) > 0);
+        auto rec = file_handle->get_record(scan.rid(), context);
+        assert(memcmp(rec->data, mock.at(scan.rid()).c_str(), record_size) == 0);
+        num_records++;
+    }
+    assert(num_records == mock.size());
+
+    // 只读取部分列时，读取的列与整条记录一致，其余列为0
+    std::vector<int> col_idxs = {0, (int)col_lens.size() - 1};
+    for (auto &entry : mock) {
+        auto rec = file_handle->get_record(entry.first, col_idxs, context);
+        int col_offset = 0;
+        for (size_t i = 0; i < col_lens.size(); i++) {
+            bool selected = std::find(col_idxs.begin(), col_idxs.end(), (int)i) != col_idxs.end();
+            std::string expected = selected ? entry.second.substr(col_offset, col_lens[i]) : std::string(col_lens[i], 0);
+            assert(memcmp(rec->data + col_offset, expected.data(), col_lens[i]) == 0);
+            col_offset += col_lens[i];
+        }
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 测试zone map：带谓词的RmScan跳过不可能满足谓词的page，且结果与全表扫描过滤一致
+ */
+TEST(RecordManagerTest, ZoneMapTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "zone_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录格式：ts(int) + payload(char(60))
+    int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    file_handle->set_zone_cols({{.type = TYPE_INT, .offset = 0, .len = 4, .enabled = true},
+                                {.type = TYPE_STRING, .offset = 4, .len = 60, .enabled = true}});
+
+    // 按时间顺序追加
+    constexpr int NUM_RECORDS = 5000;
+    std::vector<Rid> rids;
+    char write_buf[PAGE_SIZE];
+    for (int ts = 0; ts < NUM_RECORDS; ts++) {
+        rand_buf(record_size, write_buf);
+        *(int *)write_buf = ts;
+        rids.push_back(file_handle->insert_record(write_buf, context));
+    }
+    // 随机删除一部分记录，zone变为loose
+    std::vector<bool> deleted(NUM_RECORDS, false);
+    for (int i = 0; i < NUM_RECORDS / 10; i++) {
+        int ts = rand() % NUM_RECORDS;
+        if (!deleted[ts]) {
+            file_handle->delete_record(rids[ts], context);
+            deleted[ts] = true;
+        }
+    }
+
+    auto match = [](RmCompOp op, int ts, int value) {
+        return (op == RM_OP_EQ && ts == value) || (op == RM_OP_LT && ts < value) || (op == RM_OP_LE && ts <= value) ||
+               (op == RM_OP_GT && ts > value) || (op == RM_OP_GE && ts >= value);
+    };
+    // RmScan只按page跳过，page内的记录仍需由上层过滤
+    auto scan_with = [&](RmCompOp op, int value) {
+        std::string raw((char *)&value, sizeof(int));
+        std::vector<int> found;
+        for (RmScan scan(file_handle.get(), {{.col_idx = 0, .op = op, .value = raw}}); !scan.is_end(); scan.next()) {
+            auto rec = file_handle->get_record(scan.rid(), context);
+            int ts = *(int *)rec->data;
+            if (match(op, ts, value)) {
+                found.push_back(ts);
+            }
+        }
+        return found;
+    };
+    auto expect_with = [&](RmCompOp op, int value) {
+        std::vector<int> expected;
+        for (int ts = 0; ts < NUM_RECORDS; ts++) {
+            if (!deleted[ts] && match(op, ts, value)) {
+                expected.push_back(ts);
+            }
+        }
+        return expected;
+    };
+
+    for (int i = 0; i < 20; i++) {
+        RmCompOp op = static_cast<RmCompOp>(rand() % 5);
+        int value = rand() % NUM_RECORDS;
+        auto found = scan_with(op, value);
+        std::sort(found.begin(), found.end());
+        assert(found == expect_with(op, value));
+    }
+
+    // ts > NUM_RECORDS - 10 只可能落在最后一个page中，其余page都应被跳过
+    int last_page = rids.back().page_no;
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < last_page; page_no++) {
+        int value = NUM_RECORDS - 10;
+        std::vector<RmScanPred> preds = {{.col_idx = 0, .op = RM_OP_GT, .value = std::string((char *)&value, 4)}};
+        assert(!file_handle->page_may_match(page_no, preds));
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 并发插入和带谓词的扫描：扫描重新构建zone时，其他线程插入的记录不能被漏掉
+ */
+TEST(RecordManagerTest, ZoneMapConcurrentTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "zone_concurrent_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 8;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    file_handle->set_zone_cols({{.type = TYPE_INT, .offset = 0, .len = 4, .enabled = true}});
+
+    // 原有记录的ts都小于BIG，并发插入的记录ts >= BIG
+    constexpr int NUM_RECORDS = 200;
+    constexpr int NUM_INSERTS = 200;
+    constexpr int BIG = 1000000;
+    std::vector<Rid> rids;
+    char write_buf[PAGE_SIZE];
+    for (int ts = 0; ts < NUM_RECORDS; ts++) {
+        rand_buf(record_size, write_buf);
+        *(int *)write_buf = ts;
+        rids.push_back(file_handle->insert_record(write_buf, context));
+    }
+    std::string raw((char *)&BIG, sizeof(int));
+    std::vector<RmScanPred> preds = {{.col_idx = 0, .op = RM_OP_GE, .value = raw}};
+    auto count_big = [&]() {
+        int cnt = 0;
+        for (RmScan scan(file_handle.get(), preds); !scan.is_end(); scan.next()) {
+            auto rec = file_handle->read_record(scan.rid(), {});
+            cnt += *(int *)rec->data >= BIG;
+        }
+        return cnt;
+    };
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> scanners;
+    for (int i = 0; i < 2; i++) {
+        scanners.emplace_back([&]() {
+            while (!done) {
+                count_big();
+            }
+        });
+    }
+    for (int i = 0; i < NUM_INSERTS; i++) {
+        // 更新使zone变为loose，扫描线程随即开始重新构建，同时插入一条满足谓词的记录
+        int ts = rand() % NUM_RECORDS;
+        *(int *)write_buf = ts;
+        file_handle->update_record(rids[ts], write_buf, context);
+        std::this_thread::sleep_for(std::chrono::microseconds(rand() % 100));
+        *(int *)write_buf = BIG + i;
+        Rid rid = file_handle->insert_record(write_buf, context);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        // 之后没有再修改该page，zone必须包含刚插入的记录
+        ASSERT_TRUE(file_handle->page_may_match(rid.page_no, preds));
+    }
+    done = true;
+    for (auto &scanner : scanners) {
+        scanner.join();
+    }
+    ASSERT_EQ(count_big(), NUM_INSERTS);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, VacuumTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "vacuum_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    constexpr int NUM_RECORDS = 5000;
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, record_size);
+        rids.push_back(rid);
+    }
+    // 删除大部分记录，使文件变得稀疏
+    for (auto &rid : rids) {
+        if (rand() % 10 != 0) {
+            file_handle->delete_record(rid, context);
+            mock.erase(rid);
+        }
+    }
+    int old_num_pages = file_handle->file_hdr_.num_pages;
+
+    // 分批压缩，按回调维护rid -> 记录的映射
+    int batch_size = 100;
+    int moved;
+    do {
+        moved = file_handle->vacuum(batch_size, [&](const Rid &old_rid, const Rid &new_rid, const char *buf) {
+            assert(mock.count(old_rid) > 0 && mock.count(new_rid) == 0);
+            assert(memcmp(mock[old_rid].c_str(), buf, record_size) == 0);
+            mock[new_rid] = mock[old_rid];
+            mock.erase(old_rid);
+        });
+    } while (moved == batch_size);
+
+    // 压缩后只保留容纳全部记录所需的最少page
+    int per_page = file_handle->file_hdr_.num_records_per_page;
+    int min_pages = RM_FIRST_RECORD_PAGE + ((int)mock.size() + per_page - 1) / per_page;
+    assert(file_handle->file_hdr_.num_pages == min_pages);
+    assert(file_handle->file_hdr_.num_pages < old_num_pages);
+    assert(disk_manager->GetFileSize(filename) <= min_pages * PAGE_SIZE);
+
+    // 剩余记录通过get_record和RmScan都能正确读出
+    size_t num_records = 0;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        assert(mock.count(scan.rid()) > 0);
+        auto rec = file_handle->get_record(scan.rid(), context);
+        assert(memcmp(rec->data, mock.at(scan.rid()).c_str(), record_size) == 0);
+        num_records++;
+    }
+    assert(num_records == mock.size());
+
+    // 空闲page链表被重建，填满剩余的空闲slot不会让文件继续变长
+    int num_free = (min_pages - RM_FIRST_RECORD_PAGE) * per_page - (int)mock.size();
+    for (int i = 0; i < num_free; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        assert(rid.page_no < min_pages);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+
+    // 重新打开文件后数据保持一致
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    assert(file_handle->file_hdr_.num_pages == min_pages);
+    for (auto &entry : mock) {
+        auto rec = file_handle->get_record(entry.first, context);
+        assert(memcmp(rec->data, entry.second.c_str(), record_size) == 0);
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, ScanRangeTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "range_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 200;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 2000; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+
+    // 按固定大小切分page范围分别扫描，结果的并集应与整个文件的扫描结果相同且没有重复
+    int num_pages = file_handle->file_hdr_.num_pages;
+    int range_pages = 3;
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> found;
+    for (int first = RM_FIRST_RECORD_PAGE; first < num_pages; first += range_pages) {
+        for (RmScan scan(file_handle.get(), {}, first, first + range_pages); !scan.is_end(); scan.next()) {
+            Rid rid = scan.rid();
+            assert(rid.page_no >= first && rid.page_no < first + range_pages);
+            assert(found.count(rid) == 0);
+            auto rec = file_handle->read_record(rid, {});
+            found[rid] = std::string(rec->data, record_size);
+        }
+    }
+    assert(found == mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 预读队列按下层扫描的顺序输出rid：下层扫描按随机顺序（模拟索引顺序）产生文件中所有记录的rid
+ */
+TEST(RecordManagerTest, LookaheadScanTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "lookahead_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 200;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 2000; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, record_size);
+        rids.push_back(rid);
+    }
+    std::random_shuffle(rids.begin(), rids.end());
+    // 同一个page连续出现的rid
+    rids.insert(rids.begin() + 100, rids.begin(), rids.begin() + 10);
+
+    class VectorScan : public RecScan {
+        std::vector<Rid> rids_;
+        size_t pos_ = 0;
+
+       public:
+        explicit VectorScan(std::vector<Rid> rids) : rids_(std::move(rids)) {}
+        void next() override { pos_++; }
+        bool is_end() const override { return pos_ >= rids_.size(); }
+        Rid rid() const override { return rids_[pos_]; }
+    };
+    for (int depth : {0, 1, 8, 100000}) {
+        std::vector<Rid> output;
+        for (RmLookaheadScan scan(std::make_unique<VectorScan>(rids), file_handle.get(), depth); !scan.is_end();
+             scan.next()) {
+            Rid rid = scan.rid();
+            auto rec = file_handle->read_record(rid, {});
+            assert(std::string(rec->data, record_size) == mock[rid]);
+            output.push_back(rid);
+        }
+        assert(output == rids);
+    }
+    RmLookaheadScan empty(std::make_unique<VectorScan>(std::vector<Rid>{}), file_handle.get());
+    assert(empty.is_end());
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief file header常驻缓冲池：分配新page只修改缓冲池中的header页并标记为脏页，不同步写磁盘，
+ * 刷盘之后磁盘上的header与内存中一致，关闭并重新打开后读到相同的header
+ */
+TEST(RecordManagerTest, HeaderPageTest) {
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    Context *context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    std::string filename = "header_page_table";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 500;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    assert(!file_handle->hdr_page_->IsDirty());
+
+    char write_buf[PAGE_SIZE];
+    rand_buf(record_size, write_buf);
+    for (int i = 0; i < 100; i++) {
+        file_handle->insert_record(write_buf, context);
+    }
+    RmFileHdr file_hdr = file_handle->get_file_hdr();
+    assert(file_hdr.num_pages > 2);
+    assert(file_handle->hdr_page_->IsDirty());
+    RmFileHdr disk_hdr;
+    disk_manager->read_page(file_handle->GetFd(), RM_FILE_HDR_PAGE, (char *)&disk_hdr, sizeof(disk_hdr));
+    assert(disk_hdr.num_pages == 1);
+
+    buffer_pool_manager->FlushAllPages(file_handle->GetFd());
+    assert(!file_handle->hdr_page_->IsDirty());
+    disk_manager->read_page(file_handle->GetFd(), RM_FILE_HDR_PAGE, (char *)&disk_hdr, sizeof(disk_hdr));
+    assert(memcmp(&disk_hdr, &file_hdr, sizeof(file_hdr)) == 0);
+
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    assert(memcmp(&file_handle->file_hdr_, &file_hdr, sizeof(file_hdr)) == 0);
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
@@ -2,9 +2,12 @@
 
 #include <assert.h>
 
+#include <numeric>
+
 #include "bitmap.h"
 #include "rm_defs.h"
 #include "rm_file_handle.h"
+#include "rm_overflow_handle.h"
 
 //只用于创建/打开/关闭/删除文件，打开文件的时候会返回record file handle
 //它可以管理多个record文件（管理多个record file handle）
@@ -17,10 +20,20 @@ class RmManager {
     RmManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
         : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager) {}
 
-    void create_file(const std::string &filename, int record_size) {
+    /**
+     * @param layout 页内记录布局
+     * @param col_lens PAX布局下每一列的长度（NSM布局下不需要）
+     */
+    void create_file(const std::string &filename, int record_size, RmLayout layout = RM_LAYOUT_NSM,
+                     const std::vector<int> &col_lens = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
+        if (layout == RM_LAYOUT_PAX &&
+            (col_lens.empty() || col_lens.size() > RM_MAX_COLS ||
+             std::accumulate(col_lens.begin(), col_lens.end(), 0) != record_size)) {
+            throw InvalidRecordSizeError(record_size);
+        }
         disk_manager_->create_file(filename);
         int fd = disk_manager_->open_file(filename);
 
@@ -29,10 +42,17 @@ class RmManager {
         file_hdr.record_size = record_size;
         file_hdr.num_pages = 1;
         file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+        // We have: OFFSET_PAGE_HDR + sizeof(RmPageHdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+        // PAX布局只是把n条记录的各列重新排列，minipage总长度同样为n * record_size
         file_hdr.num_records_per_page =
-            (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
+            (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)Page::OFFSET_PAGE_HDR - (int)sizeof(RmPageHdr)) + 1) /
+            (1 + record_size * BITMAP_WIDTH);
         file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        file_hdr.layout = layout;
+        if (layout == RM_LAYOUT_PAX) {
+            file_hdr.num_cols = col_lens.size();
+            std::copy(col_lens.begin(), col_lens.end(), file_hdr.col_lens);
+        }
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
@@ -49,10 +69,43 @@ class RmManager {
     }
 
     void close_file(const RmFileHandle *file_handle) {
-        disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *)&file_handle->file_hdr_,
-                                  sizeof(file_handle->file_hdr_));
+        // file header在缓冲池中常驻的第0页里，解除pin之后和其他page一起刷到磁盘
+        buffer_pool_manager_->UnpinPage(file_handle->hdr_page_->GetPageId(), false);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
         buffer_pool_manager_->FlushAllPages(file_handle->fd_);
+        // 关闭后fd可能被其他文件复用，丢弃缓冲池中该文件的页面
+        buffer_pool_manager_->DiscardPages(file_handle->fd_, 0);
         disk_manager_->close_file(file_handle->fd_);
     }
+
+    // 溢出文件与表文件同目录，名为<table>.ovf，只有含溢出字段的表才会创建
+    std::string get_overflow_name(const std::string &filename) { return filename + ".ovf"; }
+
+    void create_overflow_file(const std::string &filename) {
+        std::string ovf_name = get_overflow_name(filename);
+        disk_manager_->create_file(ovf_name);
+        int fd = disk_manager_->open_file(ovf_name);
+
+        RmOverflowFileHdr file_hdr{};
+        file_hdr.num_pages = 1;
+        file_hdr.first_free_page_no = RM_NO_PAGE;
+        disk_manager_->write_page(fd, RM_OVERFLOW_HDR_PAGE, (char *)&file_hdr, sizeof(file_hdr));
+        disk_manager_->close_file(fd);
+    }
+
+    void destroy_overflow_file(const std::string &filename) {
+        disk_manager_->destroy_file(get_overflow_name(filename));
+    }
+
+    std::unique_ptr<RmOverflowHandle> open_overflow_file(const std::string &filename) {
+        int fd = disk_manager_->open_file(get_overflow_name(filename));
+        return std::make_unique<RmOverflowHandle>(disk_manager_, buffer_pool_manager_, fd);
+    }
+
+    void close_overflow_file(const RmOverflowHandle *overflow_handle) {
+        buffer_pool_manager_->UnpinPage(overflow_handle->hdr_page_->GetPageId(), false);
+        buffer_pool_manager_->FlushAllPages(overflow_handle->fd_);
+        buffer_pool_manager_->DiscardPages(overflow_handle->fd_, 0);
+        disk_manager_->close_file(overflow_handle->fd_);
+    }
 };
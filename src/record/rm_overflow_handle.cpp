@@ -0,0 +1,100 @@
+#include "rm_overflow_handle.h"
+
+#include <algorithm>
+
+/**
+ * @brief 将长度为len的字段值写入一条新的页链
+ *
+ * @param buf 字段值的地址
+ * @param len 字段值的长度
+ * @return RmOverflowPtr 指向页链的指针，由上层存放在记录中
+ */
+RmOverflowPtr RmOverflowHandle::insert_value(const char *buf, int len) {
+    RmOverflowPtr ptr{RM_NO_PAGE, len};
+    if (len <= 0) {
+        ptr.len = 0;
+        return ptr;
+    }
+    std::scoped_lock lock{latch_};
+    // 从后往前写，这样每一页写完时已经知道下一页的page no，不需要再回头修改
+    int num_chunks = (len + DATA_PER_PAGE - 1) / DATA_PER_PAGE;
+    int next_page_no = RM_NO_PAGE;
+    for (int i = num_chunks - 1; i >= 0; i--) {
+        int chunk_off = i * DATA_PER_PAGE;
+        int chunk_len = std::min(DATA_PER_PAGE, len - chunk_off);
+        Page *page = create_page();
+        auto page_hdr = reinterpret_cast<RmOverflowPageHdr *>(page->GetData() + Page::OFFSET_PAGE_HDR);
+        page_hdr->next_page_no = next_page_no;
+        page_hdr->data_len = chunk_len;
+        memcpy(page->GetData() + Page::OFFSET_PAGE_HDR + sizeof(RmOverflowPageHdr), buf + chunk_off, chunk_len);
+        next_page_no = page->GetPageId().page_no;
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    }
+    ptr.first_page_no = next_page_no;
+    return ptr;
+}
+
+/**
+ * @brief 读取ptr指向的页链，将字段值复制到buf中，buf中剩余的部分填0
+ *
+ * @param ptr 记录中存放的溢出指针
+ * @param buf 输出缓冲区
+ * @param buf_len 输出缓冲区的长度（一般为字段长度）
+ */
+void RmOverflowHandle::get_value(const RmOverflowPtr &ptr, char *buf, int buf_len) {
+    memset(buf, 0, buf_len);
+    int copied = 0;
+    int page_no = ptr.first_page_no;
+    while (page_no != RM_NO_PAGE && copied < buf_len) {
+        Page *page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no});
+        auto page_hdr = reinterpret_cast<RmOverflowPageHdr *>(page->GetData() + Page::OFFSET_PAGE_HDR);
+        int chunk_len = std::min(page_hdr->data_len, buf_len - copied);
+        memcpy(buf + copied, page->GetData() + Page::OFFSET_PAGE_HDR + sizeof(RmOverflowPageHdr), chunk_len);
+        copied += chunk_len;
+        page_no = page_hdr->next_page_no;
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    }
+}
+
+/**
+ * @brief 释放ptr指向的整条页链，释放的page放入空闲链表中供之后的insert_value复用
+ *
+ * @param ptr 记录中存放的溢出指针
+ */
+void RmOverflowHandle::delete_value(const RmOverflowPtr &ptr) {
+    std::scoped_lock lock{latch_};
+    int page_no = ptr.first_page_no;
+    while (page_no != RM_NO_PAGE) {
+        Page *page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no});
+        auto page_hdr = reinterpret_cast<RmOverflowPageHdr *>(page->GetData() + Page::OFFSET_PAGE_HDR);
+        int next_page_no = page_hdr->next_page_no;
+        page_hdr->next_page_no = file_hdr_.first_free_page_no;
+        page_hdr->data_len = 0;
+        file_hdr_.first_free_page_no = page_no;
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+        page_no = next_page_no;
+    }
+    buffer_pool_manager_->MarkDirty(hdr_page_);
+}
+
+/** -- 以下为辅助函数 -- */
+/**
+ * @brief 优先从空闲链表中取出一个page，没有空闲page时使用缓冲池创建新page
+ *
+ * @return Page* 已pin住的page，调用者需要负责unpin
+ * @note 调用者需要持有latch_
+ */
+Page *RmOverflowHandle::create_page() {
+    if (file_hdr_.first_free_page_no != RM_NO_PAGE) {
+        Page *page = buffer_pool_manager_->FetchPage(PageId{fd_, file_hdr_.first_free_page_no});
+        auto page_hdr = reinterpret_cast<RmOverflowPageHdr *>(page->GetData() + Page::OFFSET_PAGE_HDR);
+        file_hdr_.first_free_page_no = page_hdr->next_page_no;
+        buffer_pool_manager_->MarkDirty(hdr_page_);
+        return page;
+    }
+    PageId page_id{fd_, INVALID_PAGE_ID};
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    file_hdr_.num_pages++;
+    buffer_pool_manager_->MarkDirty(hdr_page_);
+    return page;
+}
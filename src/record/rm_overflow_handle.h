@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+
+#include "rm_defs.h"
+
+class RmManager;
+
+// 每个RmOverflowHandle对应一张表的溢出文件，文件中的page组成若干条页链，每条页链存放一个大字段的值
+// 记录本身只保存RmOverflowPtr，只有在需要字段值时（投影或条件判断）才会读取页链
+class RmOverflowHandle {
+    friend class RmManager;
+
+   private:
+    DiskManager *disk_manager_;
+    BufferPoolManager *buffer_pool_manager_;
+    int fd_;
+    Page *hdr_page_;                // file header所在的page，文件打开期间一直pin在缓冲池中
+    RmOverflowFileHdr &file_hdr_;  // 指向hdr_page_中的file header
+    std::mutex latch_;              // 保护file_hdr_中的空闲链表
+
+   public:
+    // 每个溢出页中可以存放的数据长度
+    static constexpr int DATA_PER_PAGE = PAGE_SIZE - Page::OFFSET_PAGE_HDR - (int)sizeof(RmOverflowPageHdr);
+
+    RmOverflowHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
+        : disk_manager_(disk_manager),
+          buffer_pool_manager_(buffer_pool_manager),
+          fd_(fd),
+          hdr_page_(buffer_pool_manager->FetchPage(PageId{.fd = fd, .page_no = RM_OVERFLOW_HDR_PAGE})),
+          file_hdr_(*reinterpret_cast<RmOverflowFileHdr *>(hdr_page_->GetData())) {
+        disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+    }
+
+    DISALLOW_COPY(RmOverflowHandle);
+
+    int GetFd() { return fd_; }
+
+    RmOverflowPtr insert_value(const char *buf, int len);
+
+    void get_value(const RmOverflowPtr &ptr, char *buf, int buf_len);
+
+    void delete_value(const RmOverflowPtr &ptr);
+
+   private:
+    Page *create_page();
+};
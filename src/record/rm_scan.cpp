@@ -1,29 +1,24 @@
 #include "rm_scan.h"
 
+#include <algorithm>
+
 #include "rm_file_handle.h"
 
 /**
  * @brief 初始化file_handle和rid
  *
  * @param file_handle
+ * @param preds 扫描谓词，zone map表明不可能满足谓词的page会被跳过
+ * @param first_page_no 扫描的第一个page
+ * @param end_page_no 扫描到该page之前为止，并行扫描时每个worker只扫描文件的一段page
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle, std::vector<RmScanPred> preds, int first_page_no, int end_page_no)
+    : file_handle_(file_handle), preds_(std::move(preds)), end_page_no_(end_page_no) {
     // Todo:
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
     //这是查有record的位置，而不是查空闲的表，不要弄错了!
-    int maxpage = file_handle_->file_hdr_.num_pages;
-    int pageno = 1;
-    if(maxpage > 1){  
-        for(pageno = 1; pageno <  maxpage; pageno++){
-            if(file_handle_->fetch_page_handle(pageno).page_hdr->num_records > 0){ 
-                int i = Bitmap::first_bit(1, file_handle_->fetch_page_handle(pageno).bitmap, file_handle_->file_hdr_.num_records_per_page);
-                rid_.page_no = pageno; 
-                rid_.slot_no = i;
-                return;
-            }
-        }
-    }
-    rid_=Rid{-1,-1};
+    rid_ = Rid{first_page_no, -1};
+    next();
 }
 
 /**
@@ -32,16 +27,24 @@ RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
 void RmScan::next() {
     // Todo:
     // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
+    if (is_end()) {
+        return;
+    }
     int maxpage = file_handle_->file_hdr_.num_pages;
+    if (end_page_no_ != RM_NO_PAGE) {
+        maxpage = std::min(maxpage, end_page_no_);
+    }
     int pageno = rid_.page_no;
     int slotno = rid_.slot_no;
-    for(;pageno < maxpage; pageno++){
-        int i = Bitmap::next_bit(1, file_handle_->fetch_page_handle(pageno).bitmap, file_handle_->file_hdr_.num_records_per_page, slotno);
-        if(i == file_handle_->file_hdr_.num_records_per_page){   
-            slotno = -1;
-            continue;  
+    for (; pageno < maxpage; pageno++, slotno = -1) {
+        // 刚进入一个page时，先根据zone map判断能否跳过整个page
+        if (slotno == -1 && !file_handle_->page_may_match(pageno, preds_)) {
+            continue;
         }
-        else{   
+        RmPageHandle page_handle = file_handle_->fetch_page_handle(pageno);
+        int i = Bitmap::next_bit(1, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page, slotno);
+        file_handle_->buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        if (i < file_handle_->file_hdr_.num_records_per_page) {
             rid_.page_no = pageno;
             rid_.slot_no = i;
             return;
@@ -65,4 +68,36 @@ bool RmScan::is_end() const {
 Rid RmScan::rid() const {
     // Todo: 修改返回值
     return rid_;
-}
\ No newline at end of file
+}
+
+RmLookaheadScan::RmLookaheadScan(std::unique_ptr<RecScan> scan, const RmFileHandle *file_handle, int depth)
+    : scan_(std::move(scan)), file_handle_(file_handle), depth_(std::max(depth, 1)) {
+    fill();
+}
+
+void RmLookaheadScan::next() {
+    assert(!is_end());
+    Rid rid = queue_.front();
+    queue_.pop_front();
+    if (queue_.empty() || queue_.front().page_no != rid.page_no) {
+        queued_pages_--;
+    }
+    fill();
+}
+
+/**
+ * @brief 从下层扫描中取出rid，直到队列中有depth_个不同的记录页或者下层扫描结束
+ */
+void RmLookaheadScan::fill() {
+    while (queued_pages_ < depth_ && !scan_->is_end()) {
+        Rid rid = scan_->rid();
+        if (queue_.empty() || queue_.back().page_no != rid.page_no) {
+            queued_pages_++;
+            if (depth_ > 1) {
+                file_handle_->prefetch_page(rid.page_no);
+            }
+        }
+        queue_.push_back(rid);
+        scan_->next();
+    }
+}
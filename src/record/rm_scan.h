@@ -1,14 +1,22 @@
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "rm_defs.h"
+#include "rm_zone_map.h"
 
 class RmFileHandle;
 
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
     Rid rid_;
+    std::vector<RmScanPred> preds_;  // 用于根据zone map跳过page的谓词，为空时扫描所有page
+    int end_page_no_;                // 扫描范围为[起始page, end_page_no_)，RM_NO_PAGE表示扫描到文件末尾
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, std::vector<RmScanPred> preds = {},
+           int first_page_no = RM_FIRST_RECORD_PAGE, int end_page_no = RM_NO_PAGE);
 
     void next() override;
 
@@ -16,3 +24,31 @@ public:
 
     Rid rid() const override;
 };
+
+/**
+ * @brief 回表扫描的预读队列：包装一个产生rid的扫描（如索引扫描），提前取出rid，
+ * 使队列中始终有depth个不同的记录页，每个页进入队列时提示缓冲池预读，由操作系统在后台并行读入；
+ * rid仍按下层扫描的顺序输出，读取当前记录时，后面depth-1个记录页的读取已经在进行中
+ */
+class RmLookaheadScan : public RecScan {
+    std::unique_ptr<RecScan> scan_;
+    const RmFileHandle *file_handle_;
+    int depth_;
+    std::deque<Rid> queue_;  // 已经从scan_中取出、还没有输出的rid，队首为当前rid
+    int queued_pages_ = 0;   // 队列中连续的相同page算作一个，即队列中正在预读的page个数
+public:
+    /**
+     * @param scan 产生rid的扫描，由RmLookaheadScan持有
+     * @param depth 同时预读的记录页个数，不大于1时不预读
+     */
+    RmLookaheadScan(std::unique_ptr<RecScan> scan, const RmFileHandle *file_handle, int depth = RM_LOOKAHEAD_PAGES);
+
+    void next() override;
+
+    bool is_end() const override { return queue_.empty(); }
+
+    Rid rid() const override { return queue_.front(); }
+
+private:
+    void fill();
+};
@@ -0,0 +1,184 @@
+#include "rm_zone_map.h"
+
+/**
+ * @brief 设置参与统计的列，已有的统计信息全部失效
+ */
+void RmZoneMap::set_cols(std::vector<RmZoneCol> cols) {
+    std::scoped_lock lock{latch_};
+    cols_ = std::move(cols);
+    zones_.clear();
+}
+
+/**
+ * @brief 新分配的page中没有记录，其zone直接处于已构建状态
+ */
+void RmZoneMap::init_page(int page_no) {
+    if (!enabled()) {
+        return;
+    }
+    std::scoped_lock lock{latch_};
+    Zone &zone = get_zone(page_no);
+    zone = Zone();
+    zone.built = true;
+}
+
+/**
+ * @brief 插入后扩大范围；尚未构建的zone也一并扩大，使其始终包含插入过的记录
+ */
+void RmZoneMap::on_insert(int page_no, const char *rec) {
+    if (!enabled()) {
+        return;
+    }
+    std::scoped_lock lock{latch_};
+    widen(get_zone(page_no), rec);
+}
+
+/**
+ * @brief 更新后旧值可能已经不存在，扩大范围的同时标记为loose
+ */
+void RmZoneMap::on_update(int page_no, const char *rec) {
+    if (!enabled()) {
+        return;
+    }
+    std::scoped_lock lock{latch_};
+    Zone &zone = get_zone(page_no);
+    if (zone.built) {
+        widen(zone, rec);
+        zone.loose = true;
+    }
+}
+
+/**
+ * @brief 删除时不收缩范围，只标记为loose
+ */
+void RmZoneMap::on_delete(int page_no) {
+    if (!enabled()) {
+        return;
+    }
+    std::scoped_lock lock{latch_};
+    get_zone(page_no).loose = true;
+}
+
+/**
+ * @brief 文件被截断后丢弃page_no >= num_pages的zone
+ */
+void RmZoneMap::truncate(int num_pages) {
+    std::scoped_lock lock{latch_};
+    if ((int)zones_.size() > num_pages) {
+        zones_.resize(num_pages);
+    }
+}
+
+/**
+ * @brief page的zone是否需要（重新）构建：未构建，或删除/更新后变得loose
+ */
+bool RmZoneMap::needs_build(int page_no) const {
+    std::scoped_lock lock{latch_};
+    if (page_no >= (int)zones_.size()) {
+        return true;
+    }
+    return !zones_[page_no].built || zones_[page_no].loose;
+}
+
+/**
+ * @brief 根据page中现有的全部记录重新计算min/max
+ */
+void RmZoneMap::rebuild(int page_no, const std::vector<const char *> &recs) {
+    std::scoped_lock lock{latch_};
+    Zone &zone = get_zone(page_no);
+    zone = Zone();
+    for (auto rec : recs) {
+        widen(zone, rec);
+    }
+    zone.built = true;
+}
+
+/**
+ * @brief 判断page中是否可能存在满足所有谓词的记录
+ *
+ * @return false表示该page可以跳过
+ */
+bool RmZoneMap::may_match(int page_no, const std::vector<RmScanPred> &preds) const {
+    std::scoped_lock lock{latch_};
+    if (page_no >= (int)zones_.size() || !zones_[page_no].built) {
+        return true;
+    }
+    const Zone &zone = zones_[page_no];
+    if (zone.empty) {
+        return false;
+    }
+    for (auto &pred : preds) {
+        auto &col = cols_[pred.col_idx];
+        if (!col.enabled) {
+            continue;
+        }
+        const char *value = pred.value.data();
+        int cmp_min = compare(zone.mins[pred.col_idx].data(), value, col);
+        int cmp_max = compare(zone.maxs[pred.col_idx].data(), value, col);
+        bool match = true;
+        if (pred.op == RM_OP_EQ) {
+            match = cmp_min <= 0 && cmp_max >= 0;
+        } else if (pred.op == RM_OP_LT) {
+            match = cmp_min < 0;
+        } else if (pred.op == RM_OP_LE) {
+            match = cmp_min <= 0;
+        } else if (pred.op == RM_OP_GT) {
+            match = cmp_max > 0;
+        } else if (pred.op == RM_OP_GE) {
+            match = cmp_max >= 0;
+        }
+        if (!match) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** -- 以下为辅助函数 -- */
+RmZoneMap::Zone &RmZoneMap::get_zone(int page_no) {
+    if (page_no >= (int)zones_.size()) {
+        zones_.resize(page_no + 1);
+    }
+    return zones_[page_no];
+}
+
+void RmZoneMap::widen(Zone &zone, const char *rec) {
+    if (zone.empty) {
+        zone.mins.resize(cols_.size());
+        zone.maxs.resize(cols_.size());
+    }
+    for (size_t i = 0; i < cols_.size(); i++) {
+        auto &col = cols_[i];
+        if (!col.enabled) {
+            continue;
+        }
+        const char *value = rec + col.offset;
+        if (zone.empty || compare(value, zone.mins[i].data(), col) < 0) {
+            zone.mins[i].assign(value, col.len);
+        }
+        if (zone.empty || compare(value, zone.maxs[i].data(), col) > 0) {
+            zone.maxs[i].assign(value, col.len);
+        }
+    }
+    zone.empty = false;
+}
+
+// 与ix_compare的比较规则保持一致
+int RmZoneMap::compare(const char *a, const char *b, const RmZoneCol &col) const {
+    switch (col.type) {
+        case TYPE_INT: {
+            int ia = *(int *)a;
+            int ib = *(int *)b;
+            return (ia < ib) ? -1 : ((ia > ib) ? 1 : 0);
+        }
+        case TYPE_FLOAT: {
+            float fa = *(float *)a;
+            float fb = *(float *)b;
+            return (fa < fb) ? -1 : ((fa > fb) ? 1 : 0);
+        }
+        case TYPE_STRING:
+            return memcmp(a, b, col.len);
+        default:
+            throw InternalError("Unexpected data type");
+    }
+}
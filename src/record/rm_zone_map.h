@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rm_defs.h"
+
+// zone map中参与统计的列（由SmManager根据表的元数据设置）
+struct RmZoneCol {
+    ColType type;
+    int offset;    // 字段在记录中的偏移量
+    int len;       // 字段长度
+    bool enabled;  // 是否为该列维护min/max（溢出字段的值不在记录中，不统计）
+};
+
+enum RmCompOp { RM_OP_EQ, RM_OP_LT, RM_OP_LE, RM_OP_GT, RM_OP_GE };
+
+// 扫描谓词 col op value，RmScan根据它跳过min/max不可能满足谓词的page
+struct RmScanPred {
+    int col_idx;        // 列在RmZoneCol数组中的下标
+    RmCompOp op;
+    std::string value;  // 与字段等长的原始值
+};
+
+/**
+ * @brief 记录文件的zone map：为每个page的每一列维护min/max
+ * 插入和更新时扩大范围；删除时不收缩，只把page标记为loose，等到扫描访问该page时再重新计算（惰性收紧）
+ * zone map只保存在内存中，打开文件后各page处于未构建状态，同样在第一次扫描时构建
+ */
+class RmZoneMap {
+   private:
+    struct Zone {
+        bool built = false;  // min/max是否有效
+        bool loose = false;  // 删除/更新后范围可能偏大
+        bool empty = true;   // page中没有记录
+        std::vector<std::string> mins;
+        std::vector<std::string> maxs;
+    };
+
+    std::vector<RmZoneCol> cols_;
+    std::vector<Zone> zones_;  // page no -> zone
+    mutable std::mutex latch_;
+
+   public:
+    void set_cols(std::vector<RmZoneCol> cols);
+
+    bool enabled() const { return !cols_.empty(); }
+
+    void init_page(int page_no);
+
+    void on_insert(int page_no, const char *rec);
+
+    void on_update(int page_no, const char *rec);
+
+    void on_delete(int page_no);
+
+    void truncate(int num_pages);
+
+    bool needs_build(int page_no) const;
+
+    void rebuild(int page_no, const std::vector<const char *> &recs);
+
+    bool may_match(int page_no, const std::vector<RmScanPred> &preds) const;
+
+   private:
+    Zone &get_zone(int page_no);
+
+    void widen(Zone &zone, const char *rec);
+
+    int compare(const char *a, const char *b, const RmZoneCol &col) const;
+};
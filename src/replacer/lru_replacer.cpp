@@ -19,6 +19,7 @@ bool LRUReplacer::Victim(frame_id_t *frame_id) {
     //  选择合适的frame指定为淘汰页面,赋值给*frame_id
     if(LRUlist_.empty())return false;
     *frame_id = LRUlist_.back();
+    LRUhash_.erase(*frame_id);
     LRUlist_.pop_back();
     return true;
 }
@@ -31,16 +32,12 @@ void LRUReplacer::Pin(frame_id_t frame_id) {
     std::scoped_lock lock{latch_};
     // Todo:
     // 固定指定id的frame
-    // 在数据结构中移除该frame
-    for(auto it=LRUlist_.begin();it!=LRUlist_.end();it++)
-    {
-        if(*it==frame_id)
-        {
-            LRUlist_.erase(it);
-            return ;
-        }
+    // 在数据结构中移除该frame，通过LRUhash_直接定位，不遍历链表
+    auto it = LRUhash_.find(frame_id);
+    if (it != LRUhash_.end()) {
+        LRUlist_.erase(it->second);
+        LRUhash_.erase(it);
     }
-
 }
 
 /**
@@ -52,14 +49,11 @@ void LRUReplacer::Unpin(frame_id_t frame_id) {
     //  支持并发锁
     //  选择一个frame取消固定
     std::scoped_lock lock{latch_};
-    for(auto it=LRUlist_.begin();it!=LRUlist_.end();it++)
-    {
-        if(*it==frame_id)
-        {
-            return ;
-        }
+    if (LRUhash_.count(frame_id) > 0) {
+        return;
     }
     LRUlist_.push_front(frame_id);
+    LRUhash_[frame_id] = LRUlist_.begin();
 }
 
 /** @return replacer中能够victim的数量 */
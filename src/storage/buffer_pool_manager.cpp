@@ -10,7 +10,13 @@ bool BufferPoolManager::FindVictimPage(frame_id_t *frame_id) {
     //  1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
     //  1.1 未满获得frame
     //  1.2 已满使用lru_replacer中的方法选择淘汰页面
-    return true;
+    if (!free_list_.empty()) {
+        *frame_id = free_list_.front();
+        free_list_.pop_front();
+        return true;
+    }
+    // replacer中只有pin_count为0的frame，Victim失败说明所有页面都被pin住了
+    return replacer_->Victim(frame_id);
 }
 
 /**
@@ -25,6 +31,16 @@ void BufferPoolManager::UpdatePage(Page *page, PageId new_page_id, frame_id_t ne
     //  1 如果是脏页，写回磁盘，并且把dirty置为false
     //  2 更新page table
     //  3 重置page的data，更新page id
+    if (page->is_dirty_) {
+        disk_manager_->write_page(page->GetPageId().fd, page->GetPageId().page_no, page->GetData(), PAGE_SIZE);
+        page->is_dirty_ = false;
+    }
+    if (page->GetPageId().page_no != INVALID_PAGE_ID) {
+        page_table_.erase(page->GetPageId());
+    }
+    page_table_[new_page_id] = new_frame_id;
+    page->ResetMemory();
+    page->id_ = new_page_id;
 }
 
 /**
@@ -46,56 +62,39 @@ Page *BufferPoolManager::FetchPage(PageId page_id) {
     //  4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
     assert(page_id.page_no!=INVALID_PAGE_ID);
     std::scoped_lock lock{latch_};
+    // if p exists
+    auto it = page_table_.find(page_id);
+    if (it != page_table_.end()) {
+        // 每次Fetch都要增加pin_count，否则另一个线程unpin之后页面可能在仍被使用时被淘汰
+        replacer_->Pin(it->second);
+        pages_[it->second].pin_count_++;
+        return &pages_[it->second];
+    }
     // Page(R) for exchange
-    frame_id_t *frame_id = new frame_id_t;
-
-    bool flag = true;  // flag表示现有的都被pin住了
-    for (int i = 0; i < int(pool_size_ - free_list_.size()); i++) {
-        if (pages_[i].pin_count_ <= 0) {
-            flag = false;
-            break;
-        }
-        if(pages_[i].id_==page_id)
-        {
-            flag=false;
-            break;
-        }
+    frame_id_t frame_id;
+    if (!FindVictimPage(&frame_id)) {
+        return nullptr;  // 所有页面都被pin住了
     }
-    if (flag && free_list_.empty()) return nullptr;  //如果全部pin住了那缓冲池现在就等于是用不了了
+    Page *page = &pages_[frame_id];
+    UpdatePage(page, page_id, frame_id);
+    disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    replacer_->Pin(frame_id);
+    page->pin_count_ = 1;
+    return page;
+}
 
-    // if p exists
-    if (page_table_.find(page_id) != page_table_.end()) {
-        replacer_->Pin(page_table_[page_id]);
-        return pages_ + page_table_[page_id];
-    } else {
-        // if p doesn't exists & should from replacer
-        if (free_list_.empty()) {
-            replacer_->Victim(frame_id);
-        } else {
-            // if p doesn't exists & free_list has extra space
-            *frame_id = free_list_.front();
-            free_list_.pop_front();
+/**
+ * @brief 提示即将读取该页面：已经在缓冲池中时什么也不做，否则由disk_manager提示操作系统在后台读入
+ * 不分配frame也不pin，不会挤占其他页面
+ */
+void BufferPoolManager::PrefetchPage(PageId page_id) {
+    {
+        std::scoped_lock lock{latch_};
+        if (page_table_.count(page_id) > 0) {
+            return;
         }
     }
-
-    // if page(R) is dirty
-    if (pages_[*frame_id].is_dirty_) {
-        disk_manager_->write_page(pages_[*frame_id].GetPageId().fd, pages_[*frame_id].GetPageId().page_no,
-                                  pages_[*frame_id].GetData(), PAGE_SIZE);
-        pages_[*frame_id].is_dirty_ = false;
-    }
-
-    page_table_.erase(pages_[*frame_id].id_);
-    page_table_.insert({page_id, *frame_id});
-
-    pages_[*frame_id].is_dirty_ = false;
-    pages_[*frame_id].id_ = page_id;
-    pages_[*frame_id].pin_count_++;
-    disk_manager_->read_page(page_id.fd, page_id.page_no, pages_[*frame_id].data_, PAGE_SIZE);
-
-    auto retp = (pages_ + (*frame_id));
-    delete frame_id;
-    return retp;
+    disk_manager_->prefetch_page(page_id.fd, page_id.page_no);
 }
 
 /**
@@ -112,25 +111,31 @@ bool BufferPoolManager::UnpinPage(PageId page_id, bool is_dirty) {
     //  1.2 P在页表中存在 如何解除一次固定(pin_count)
     //  2. 页面是否需要置脏
     std::scoped_lock lock{latch_};
-    frame_id_t *frame_id = new frame_id_t;
-    // if p exists
-    if (page_table_.find(page_id) != page_table_.end()) {
-        *frame_id = page_table_[page_id];
-        if (pages_[*frame_id].pin_count_ > 0) {
-            pages_[*frame_id].pin_count_--;
-        }
-        if (pages_[*frame_id].pin_count_ == 0) {
-            
-            // disk_manager_->write_page(pages_[*frame_id].GetPageId().fd, pages_[*frame_id].GetPageId().page_no, pages_[*frame_id].GetData(), PAGE_SIZE);
-            replacer_->Unpin(*frame_id);
-            
-        }
-        if (is_dirty == true) {
-                pages_[*frame_id].is_dirty_ = true;
-            }
-        return true;
-    } else
+    auto it = page_table_.find(page_id);
+    if (it == page_table_.end()) {
         return false;
+    }
+    Page *page = &pages_[it->second];
+    if (page->pin_count_ <= 0) {
+        return false;
+    }
+    if (is_dirty) {
+        page->is_dirty_ = true;
+    }
+    if (--page->pin_count_ == 0) {
+        replacer_->Unpin(it->second);
+    }
+    return true;
+}
+
+/**
+ * @brief 把一个一直被pin住的page标记为脏页，这种page不经过UnpinPage，例如文件打开期间常驻缓冲池的file header
+ *
+ * @param page 被pin住的page
+ */
+void BufferPoolManager::MarkDirty(Page *page) {
+    std::scoped_lock lock{latch_};
+    page->is_dirty_ = true;
 }
 
 /**
@@ -171,42 +176,16 @@ Page *BufferPoolManager::NewPage(PageId *page_id) {
     //  4.   Update P's metadata, zero out memory and add P to the page table. pin_count set to 1.
     //  5.   Set the page ID output parameter. Return a pointer to P.
     std::scoped_lock lock{latch_};
-    bool flag = true;  // flag表示现有的都被pin住了
-    bool from_free = true;
-    for (int i = 0; i < int(pool_size_ - free_list_.size()); i++) {
-        if (pages_[i].pin_count_ <= 0) {
-            flag = false;
-            break;
-        }
+    frame_id_t frame_id;
+    if (!FindVictimPage(&frame_id)) {
+        return nullptr;
     }
-    if (flag && free_list_.empty()) return nullptr;
-
-    frame_id_t *frame_id = new frame_id_t;
-    if (free_list_.empty()) {
-        //?不一定对，这里Victim直接pop了
-        replacer_->Victim(frame_id);
-        if (pages_[*frame_id].is_dirty_) {
-        disk_manager_->write_page(pages_[*frame_id].GetPageId().fd, pages_[*frame_id].GetPageId().page_no,
-                                  pages_[*frame_id].GetData(), PAGE_SIZE);
-        pages_[*frame_id].is_dirty_ = false;
-        }
-        from_free = false;
-    } else {
-        //只有有释放的时候才能push_back。
-        *frame_id = free_list_.front();
-        free_list_.pop_front();
-    }
-
     page_id->page_no = disk_manager_->AllocatePage(page_id->fd);
-    if (!from_free) page_table_.erase(pages_[*frame_id].id_);
-    page_table_.insert({*page_id, *frame_id});
-    pages_[*frame_id].ResetMemory();
-    pages_[*frame_id].id_ = *page_id;
-    replacer_->Pin(*frame_id);
-    pages_[*frame_id].pin_count_ = 1;
-    auto retp = (pages_ + (*frame_id));
-    delete frame_id;
-    return retp;
+    Page *page = &pages_[frame_id];
+    UpdatePage(page, *page_id, frame_id);
+    replacer_->Pin(frame_id);
+    page->pin_count_ = 1;
+    return page;
 }
 
 /**
@@ -224,21 +203,23 @@ bool BufferPoolManager::DeletePage(PageId page_id) {
     //  3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free
     //  list.
     std::scoped_lock lock{latch_};
-    frame_id_t *frame_id = new frame_id_t;
     // if p exists
-    if (page_table_.find(page_id) != page_table_.end()) {
-        *frame_id = page_table_[page_id];
-        if (pages_[*frame_id].pin_count_ > 0) {
+    auto it = page_table_.find(page_id);
+    if (it != page_table_.end()) {
+        frame_id_t frame_id = it->second;
+        if (pages_[frame_id].pin_count_ > 0) {
             return false;
         }
-        page_table_.erase(page_id);
-        pages_[*frame_id].ResetMemory();
-        pages_[*frame_id].pin_count_ = 0;
-        pages_[*frame_id].is_dirty_ = false;
-        free_list_.push_front(*frame_id);
+        page_table_.erase(it);
+        // 从replacer中移除，避免该frame同时出现在free_list_和replacer中
+        replacer_->Pin(frame_id);
+        pages_[frame_id].ResetMemory();
+        pages_[frame_id].pin_count_ = 0;
+        pages_[frame_id].is_dirty_ = false;
+        pages_[frame_id].id_.page_no = INVALID_PAGE_ID;
+        free_list_.push_front(frame_id);
         disk_manager_->DeallocatePage(page_id.page_no);
     }
-    delete frame_id;
     return true;
 }
 
@@ -257,4 +238,29 @@ void BufferPoolManager::FlushAllPages(int fd) {
             page->is_dirty_ = false;
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 丢弃指定文件中page_no >= first_page_no的所有页面，不写回磁盘（文件随后会被截断）
+ *
+ * @param fd 指定的diskfile open句柄
+ * @param first_page_no 第一个要丢弃的page_no
+ */
+void BufferPoolManager::DiscardPages(int fd, page_id_t first_page_no) {
+    std::scoped_lock lock{latch_};
+    for (size_t i = 0; i < pool_size_; i++) {
+        Page *page = &pages_[i];
+        PageId page_id = page->GetPageId();
+        if (page_id.fd != fd || page_id.page_no == INVALID_PAGE_ID || page_id.page_no < first_page_no) {
+            continue;
+        }
+        page_table_.erase(page_id);
+        // 从replacer中移除，避免该frame同时出现在free_list_和replacer中
+        replacer_->Pin(i);
+        page->ResetMemory();
+        page->pin_count_ = 0;
+        page->is_dirty_ = false;
+        page->id_.page_no = INVALID_PAGE_ID;
+        free_list_.push_back(i);
+    }
+}
@@ -108,6 +108,13 @@ class BufferPoolManager {
      */
     Page *FetchPage(PageId page_id);
 
+    /**
+     * Hints that the page will be fetched soon. If it is not in the buffer pool, the disk manager asks the OS to read
+     * it in the background, so a later FetchPage() does not wait for the disk. Nothing is pinned.
+     * @param page_id id of page to be prefetched
+     */
+    void PrefetchPage(PageId page_id);
+
     /**
      * Unpin the target page from the buffer pool.
      * @param page_id id of page to be unpinned
@@ -116,6 +123,13 @@ class BufferPoolManager {
      */
     bool UnpinPage(PageId page_id, bool is_dirty);
 
+    /**
+     * Marks a page that stays pinned as dirty, e.g. a file header kept in the buffer pool while the file is open.
+     * The page is written back by FlushPage()/FlushAllPages() like any other dirty page.
+     * @param page the pinned page
+     */
+    void MarkDirty(Page *page);
+
     /**
      * Flushes the target page to disk.
      * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
@@ -142,6 +156,12 @@ class BufferPoolManager {
      */
     void FlushAllPages(int fd);
 
+    /**
+     * Drops all pages of the file whose page_no >= first_page_no from the buffer pool without writing them back.
+     * Used before the file is truncated, so the caller must make sure nobody is still using these pages.
+     */
+    void DiscardPages(int fd, page_id_t first_page_no);
+
    private:
     bool FindVictimPage(frame_id_t *frame_id);
 
@@ -201,6 +201,67 @@ TEST_F(BufferPoolManagerTest, LargeScaleTest) {
     disk_manager_->close_file(fd);
 }
 
+/**
+ * @brief 测试pin_count的计数以及DeletePage后frame的复用
+ * @note 生成测试文件pin_count_test
+ */
+TEST_F(BufferPoolManagerTest, PinCountTest) {
+    const std::string filename = "pin_count_test";
+
+    const size_t buffer_pool_size = 2;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+
+    // Scenario: A page fetched twice stays pinned until it has been unpinned twice.
+    auto *page0 = bpm->NewPage(&tmp_page_id);
+    ASSERT_NE(nullptr, page0);
+    PageId page0_id = tmp_page_id;
+    strcpy(page0->GetData(), "page0");
+    EXPECT_EQ(page0, bpm->FetchPage(page0_id));
+    EXPECT_EQ(true, bpm->UnpinPage(page0_id, true));
+    auto *page1 = bpm->NewPage(&tmp_page_id);
+    ASSERT_NE(nullptr, page1);
+    PageId page1_id = tmp_page_id;
+    EXPECT_EQ(nullptr, bpm->NewPage(&tmp_page_id));
+    EXPECT_EQ(true, bpm->UnpinPage(page0_id, true));
+    EXPECT_EQ(false, bpm->UnpinPage(page0_id, true));
+
+    // Scenario: Once unpinned, page 0 can be evicted and read back from disk.
+    auto *page2 = bpm->NewPage(&tmp_page_id);
+    ASSERT_NE(nullptr, page2);
+    PageId page2_id = tmp_page_id;
+    EXPECT_EQ(nullptr, bpm->FetchPage(page0_id));
+    EXPECT_EQ(true, bpm->UnpinPage(page2_id, false));
+    page0 = bpm->FetchPage(page0_id);
+    ASSERT_NE(nullptr, page0);
+    EXPECT_EQ(0, strcmp(page0->GetData(), "page0"));
+    EXPECT_EQ(true, bpm->UnpinPage(page0_id, false));
+
+    // Scenario: A pinned page cannot be deleted.
+    EXPECT_EQ(false, bpm->DeletePage(page1_id));
+    EXPECT_EQ(true, bpm->UnpinPage(page1_id, false));
+    EXPECT_EQ(true, bpm->DeletePage(page1_id));
+
+    // Scenario: A deleted frame goes back to the free list only, so two new pages get two different frames.
+    auto *page3 = bpm->NewPage(&tmp_page_id);
+    ASSERT_NE(nullptr, page3);
+    PageId page3_id = tmp_page_id;
+    strcpy(page3->GetData(), "page3");
+    auto *page4 = bpm->NewPage(&tmp_page_id);
+    ASSERT_NE(nullptr, page4);
+    EXPECT_NE(page3, page4);
+    EXPECT_EQ(page3, bpm->FetchPage(page3_id));
+    EXPECT_EQ(0, strcmp(page3->GetData(), "page3"));
+    EXPECT_EQ(nullptr, bpm->NewPage(&tmp_page_id));
+
+    bpm->FlushAllPages(fd);
+
+    disk_manager_->close_file(fd);
+}
+
 /**
  * @brief 多文件测试
  * @note 生成若干测试文件multiple_files_test_*
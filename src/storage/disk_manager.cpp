@@ -34,6 +34,10 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
     read(fd,offset,num_bytes);
 }
 
+void DiskManager::prefetch_page(int fd, page_id_t page_no) {
+    posix_fadvise(fd, (off_t)page_no * PAGE_SIZE, PAGE_SIZE, POSIX_FADV_WILLNEED);
+}
+
 /**
  * @brief Allocate new page (operations like create index/table)
  * For now just keep an increasing counter
@@ -165,6 +169,19 @@ void DiskManager::close_file(int fd) {
     }
 }
 
+/**
+ * @brief 将文件截断为num_pages个page，之后从num_pages开始分配page_no
+ *
+ * @param fd 文件开启后的文件描述符
+ * @param num_pages 保留的page个数
+ */
+void DiskManager::truncate_file(int fd, int num_pages) {
+    if (ftruncate(fd, (off_t)num_pages * PAGE_SIZE) != 0) {
+        throw UnixError();
+    }
+    set_fd2pageno(fd, num_pages);
+}
+
 int DiskManager::GetFileSize(const std::string &file_name) {
     struct stat stat_buf;
     int rc = stat(file_name.c_str(), &stat_buf);
@@ -51,6 +51,12 @@ class DiskManager {
      */
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    /**
+     * @brief 提示操作系统即将读取指定的页面，由内核在后台读入page cache，之后的read_page不再等待磁盘
+     * 只是提示，不读取数据也不报告错误
+     */
+    void prefetch_page(int fd, page_id_t page_no);
+
     /**
      * @brief Allocate a page on disk.
      * @return the page_no of the allocated page
@@ -81,6 +87,8 @@ class DiskManager {
 
     void close_file(int fd);
 
+    void truncate_file(int fd, int num_pages);
+
     int GetFileSize(const std::string &file_name);
 
     std::string GetFileName(int fd);
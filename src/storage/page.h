@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/config.h"
 #include "common/rwlatch.h"
 
@@ -64,11 +66,18 @@ class Page {
 
     bool IsDirty() const { return is_dirty_; }
 
-    /** Acquire the page write latch. */
-    inline void WLatch() { rwlatch_.WLock(); }
+    /** Acquire the page write latch. 加写锁之后版本号为奇数 */
+    inline void WLatch() {
+        rwlatch_.WLock();
+        version_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
 
-    /** Release the page write latch. */
-    inline void WUnlatch() { rwlatch_.WUnlock(); }
+    /** Release the page write latch. 释放写锁之前版本号加1变为偶数 */
+    inline void WUnlatch() {
+        version_.fetch_add(1, std::memory_order_release);
+        rwlatch_.WUnlock();
+    }
 
     /** Acquire the page read latch. */
     inline void RLatch() { rwlatch_.RLock(); }
@@ -76,6 +85,20 @@ class Page {
     /** Release the page read latch. */
     inline void RUnlatch() { rwlatch_.RUnlock(); }
 
+    /**
+     * @brief 乐观读（不加锁）开始时读取版本号，页面持有写锁时版本号为奇数
+     * 读完页面内容后用ValidateVersion()检查版本号没有变化，变化说明读到的内容可能不一致
+     * @note 乐观读期间页面需要被pin住，版本号只在内存中，不写入磁盘
+     */
+    inline uint64_t ReadVersion() const { return version_.load(std::memory_order_acquire); }
+
+    inline bool ValidateVersion(uint64_t version) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version_.load(std::memory_order_relaxed) == version;
+    }
+
+    static bool IsWriteLocked(uint64_t version) { return version & 1; }
+
     static constexpr size_t OFFSET_PAGE_START = 0;
     static constexpr size_t OFFSET_LSN = 0;
     static constexpr size_t OFFSET_PAGE_HDR = 4;
@@ -103,4 +126,7 @@ class Page {
 
     /** Page latch. */
     ReaderWriterLatch rwlatch_;
+
+    /** 每次加写锁和释放写锁时加1，用于乐观读 */
+    std::atomic<uint64_t> version_{0};
 };
\ No newline at end of file
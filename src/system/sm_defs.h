@@ -4,3 +4,8 @@
 #include <string>
 
 static const std::string DB_META_NAME = "db.meta";
+
+// ANALYZE最多抽样的记录数，表中的记录更多时使用蓄水池抽样
+constexpr int SM_STATS_SAMPLE_ROWS = 30000;
+// 等深直方图的桶数
+constexpr int SM_STATS_HIST_BUCKETS = 32;
@@ -58,24 +58,45 @@ TEST(SystemManagerTest, SimpleTest) {
     // Create table 2
     sm_manager->create_table(tab2, col_defs, context);
     // Create index for table 1
-    sm_manager->create_index(tab1, "a", context);
-    sm_manager->create_index(tab1, "c", context);
+    sm_manager->create_index(tab1, {"a"}, context);
+    sm_manager->create_index(tab1, {"c"}, context);
     // Cannot re-create index
     try {
-        sm_manager->create_index(tab1, "a", context);
+        sm_manager->create_index(tab1, {"a"}, context);
         assert(0);
     } catch (IndexExistsError &) {
     }
     // Create index for table 2
-    sm_manager->create_index(tab2, "b", context);
+    sm_manager->create_index(tab2, {"b"}, context);
     // Drop index of table 1
-    sm_manager->drop_index(tab1, "a", context);
+    sm_manager->drop_index(tab1, {"a"}, context);
     // Cannot drop index that does not exist
     try {
-        sm_manager->drop_index(tab1, "b", context);
+        sm_manager->drop_index(tab1, {"b"}, context);
         assert(0);
     } catch (IndexNotFoundError &) {
     }
+    // Create multi-column index, column order matters
+    sm_manager->create_index(tab2, {"a", "b"}, context);
+    try {
+        sm_manager->create_index(tab2, {"a", "b"}, context);
+        assert(0);
+    } catch (IndexExistsError &) {
+    }
+    try {
+        sm_manager->drop_index(tab2, {"b", "a"}, context);
+        assert(0);
+    } catch (IndexNotFoundError &) {
+    }
+    // Indexes are persisted in the catalog
+    sm_manager->close_db();
+    sm_manager->open_db(db);
+    auto &indexes = sm_manager->db_.get_table(tab2).indexes;
+    ASSERT_EQ(indexes.size(), 2);
+    EXPECT_EQ(indexes[1].col_names(), std::vector<std::string>({"a", "b"}));
+    EXPECT_EQ(indexes[1].col_tot_len, 8);
+    sm_manager->drop_index(tab2, {"a", "b"}, context);
+    EXPECT_TRUE(sm_manager->db_.get_table(tab2).get_col("a")->index == false);
     // Drop index
     sm_manager->drop_table(tab1, context);
     // Cannot drop table that does not exist
@@ -87,4 +108,79 @@ TEST(SystemManagerTest, SimpleTest) {
     // Clean up
     sm_manager->close_db();
     sm_manager->drop_db(db);
-}
\ No newline at end of file
+}
+// 测试ANALYZE收集的统计信息及其持久化
+TEST(SystemManagerTest, AnalyzeTest) {
+    std::string db = "analyze_db";
+    std::string tab = "tab";
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto sm_manager =
+        std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    auto txn = std::make_unique<Transaction>(0);
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+    Context *insert_context = new Context(lock_manager.get(), nullptr, txn.get(), result, &offset);
+
+    if (sm_manager->is_dir(db)) {
+        sm_manager->drop_db(db);
+    }
+    sm_manager->create_db(db);
+    sm_manager->open_db(db);
+    std::vector<ColDef> col_defs = {{.name = "a", .type = TYPE_INT, .len = 4},
+                                    {.name = "b", .type = TYPE_FLOAT, .len = 4},
+                                    {.name = "c", .type = TYPE_STRING, .len = 16}};
+    sm_manager->create_table(tab, col_defs, context);
+    // a有100个不同的值，b和c各不相同
+    const int num_rows = 5000;
+    auto fh = sm_manager->fhs_.at(tab).get();
+    char buf[24];
+    for (int i = 0; i < num_rows; i++) {
+        int a = i % 100;
+        float b = i * 0.5f;
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, &a, sizeof(a));
+        memcpy(buf + 4, &b, sizeof(b));
+        snprintf(buf + 8, 16, "key%05d", i);
+        fh->insert_record(buf, insert_context);
+    }
+    sm_manager->create_index(tab, {"a"}, context);
+    sm_manager->analyze_table(tab, context);
+
+    auto check = [&]() {
+        auto &meta = sm_manager->db_.get_table(tab);
+        ASSERT_TRUE(meta.stats.analyzed);
+        EXPECT_EQ(meta.stats.num_rows, num_rows);
+        ASSERT_EQ(meta.stats.cols.size(), 3);
+        auto &a_stats = meta.stats.cols[0];
+        EXPECT_EQ(a_stats.ndv, 100);
+        EXPECT_EQ(meta.stats.cols[1].ndv, num_rows);
+        EXPECT_EQ(meta.stats.cols[2].ndv, num_rows);
+        ASSERT_EQ(a_stats.bounds.size(), SM_STATS_HIST_BUCKETS + 1);
+        EXPECT_TRUE(std::is_sorted(a_stats.bounds.begin(), a_stats.bounds.end()));
+        int mid = 50, one = 7, missing = 100;
+        int zero = 0;
+        EXPECT_EQ(a_stats.min_val, sm_stats_value((const char *)&zero, TYPE_INT, 4));
+        EXPECT_NEAR(a_stats.fraction_below(sm_stats_value((const char *)&mid, TYPE_INT, 4)), 0.5, 0.05);
+        EXPECT_NEAR(a_stats.fraction_equal(sm_stats_value((const char *)&one, TYPE_INT, 4)), 0.01, 0.001);
+        EXPECT_EQ(a_stats.fraction_equal(sm_stats_value((const char *)&missing, TYPE_INT, 4)), 0);
+        auto &index_stats = meta.indexes[0].stats;
+        EXPECT_GE(index_stats.height, 2);
+        EXPECT_GT(index_stats.num_leaves, 1);
+        EXPECT_EQ(index_stats.num_entries, num_rows);
+        EXPECT_EQ(index_stats.num_keys, 100);
+        EXPECT_GT(index_stats.fill_factor, 0.5);
+        EXPECT_LE(index_stats.fill_factor, 1);
+    };
+    check();
+    // 统计信息随元数据持久化
+    sm_manager->close_db();
+    sm_manager->open_db(db);
+    check();
+    sm_manager->close_db();
+    sm_manager->drop_db(db);
+}
@@ -4,6 +4,7 @@
 #include <unistd.h>
 
 #include <fstream>
+#include <random>
 
 #include "index/ix.h"
 #include "record/rm.h"
@@ -71,14 +72,15 @@ void SmManager::open_db(const std::string &db_name) {
         auto &tab = entry.second;
         // fhs_[tab.name] = rm_manager_->open_file(tab.name);
         fhs_.emplace(tab.name, rm_manager_->open_file(tab.name));
-        for (size_t i = 0; i < tab.cols.size(); i++) {
-            auto &col = tab.cols[i];
-            if (col.index) {
-                auto index_name = ix_manager_->get_index_name(tab.name, i);
-                assert(ihs_.count(index_name) == 0);
-                // ihs_[index_name] = ix_manager_->open_index(tab.name, i);
-                ihs_.emplace(index_name, ix_manager_->open_index(tab.name, i));
-            }
+        fhs_.at(tab.name)->set_zone_cols(get_zone_cols(tab));
+        if (disk_manager_->is_file(rm_manager_->get_overflow_name(tab.name))) {
+            ofhs_.emplace(tab.name, rm_manager_->open_overflow_file(tab.name));
+        }
+        for (auto &index : tab.indexes) {
+            auto index_name = ix_manager_->get_index_name(tab.name, index.col_idxs);
+            assert(ihs_.count(index_name) == 0);
+            // ihs_[index_name] = ix_manager_->open_index(tab.name, index.col_idxs);
+            ihs_.emplace(index_name, open_index(tab.name, index));
         }
     }
 }
@@ -98,6 +100,11 @@ void SmManager::close_db() {
         rm_manager_->close_file(entry.second.get());
     }
     fhs_.clear();
+    // Close all overflow files
+    for (auto &entry : ofhs_) {
+        rm_manager_->close_overflow_file(entry.second.get());
+    }
+    ofhs_.clear();
     // Close all index files
     for (auto &entry : ihs_) {
         ix_manager_->close_index(entry.second.get());
@@ -140,12 +147,14 @@ void SmManager::desc_table(const std::string &tab_name, Context *context) {
     printer.print_separator(context);
 }
 
-void SmManager::create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context) {
+void SmManager::create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context,
+                             RmLayout layout) {
     if (db_.is_table(tab_name)) {
         throw TableExistsError(tab_name);
     }
     // Create table meta
     int curr_offset = 0;
+    bool has_overflow = false;
     TabMeta tab;
     tab.name = tab_name;
     for (auto &col_def : col_defs) {
@@ -155,15 +164,26 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
                        .len = col_def.len,
                        .offset = curr_offset,
                        .index = false};
-        curr_offset += col_def.len;
+        // 溢出字段在记录中只占一个RmOverflowPtr的长度
+        curr_offset += col.stored_len();
+        has_overflow |= col.is_overflow();
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    std::vector<int> col_lens;
+    for (auto &col : tab.cols) {
+        col_lens.push_back(col.stored_len());
+    }
+    rm_manager_->create_file(tab_name, record_size, layout, col_lens);
     db_.tabs_[tab_name] = tab;
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
+    fhs_.at(tab_name)->set_zone_cols(get_zone_cols(tab));
+    if (has_overflow) {
+        rm_manager_->create_overflow_file(tab_name);
+        ofhs_.emplace(tab_name, rm_manager_->open_overflow_file(tab_name));
+    }
 }
 
 void SmManager::drop_table(const std::string &tab_name, Context *context) {
@@ -176,60 +196,440 @@ void SmManager::drop_table(const std::string &tab_name, Context *context) {
     // Close & destroy record file
     rm_manager_->close_file(fhs_[tab_name].get());
     rm_manager_->destroy_file(tab_name);
+    // Close & destroy overflow file
+    if (ofhs_.count(tab_name)) {
+        rm_manager_->close_overflow_file(ofhs_.at(tab_name).get());
+        rm_manager_->destroy_overflow_file(tab_name);
+        ofhs_.erase(tab_name);
+    }
     // Close & destroy index file
-    for (size_t i = 0; i < tab.cols.size(); i++) {
-        auto &col = tab.cols[i];
-        if (col.index) {
-            auto index_name = ix_manager_->get_index_name(tab_name, i);
-            ix_manager_->close_index(ihs_[index_name].get());
-            ix_manager_->destroy_index(tab_name, i);
-            ihs_.erase(index_name);
-        }
+    for (auto &index : tab.indexes) {
+        destroy_index(tab_name, index);
     }
     // Remove table meta
     db_.tabs_.erase(tab_name);
     fhs_.erase(tab_name);
 }
 
-void SmManager::create_index(const std::string &tab_name, const std::string &col_name, Context *context) {
+/**
+ * @brief 在表上按col_names的顺序创建（多列）索引，key由各列的值依次拼接而成
+ *
+ * @param tab_name 表名
+ * @param col_names 索引包含的列名
+ * @param context
+ * @param include_names INCLUDE列的列名，这些列的值存放在叶子中，使只用到索引列的查询不必访问记录
+ * @param type 索引类型，哈希和ART索引只用于整个key上的等值查询，不支持INCLUDE列
+ */
+void SmManager::create_index(const std::string &tab_name, const std::vector<std::string> &col_names,
+                             Context *context, const std::vector<std::string> &include_names, IxIndexType type) {
     TabMeta &tab = db_.get_table(tab_name);
-    auto col = tab.get_col(col_name);
-    if (col->index) {
-        throw IndexExistsError(tab_name, col_name);
+    if (tab.is_index(col_names)) {
+        throw IndexExistsError(tab_name, index_cols_str(col_names));
     }
-    // Create index file
-    int col_idx = col - tab.cols.begin();
-    ix_manager_->create_index(tab_name, col_idx, col->type, col->len);  // 这里调用了
-    // Open index file
-    auto ih = ix_manager_->open_index(tab_name, col_idx);
-    // Get record file handle
+    if (!ix_index_ordered(type) && !include_names.empty()) {
+        throw InternalError("INCLUDE columns are only supported by B+ tree indexes");
+    }
+    auto get_col_idx = [&](const std::string &col_name) {
+        auto col = tab.get_col(col_name);
+        if (col == tab.cols.end()) {
+            throw ColumnNotFoundError(col_name);
+        }
+        // 溢出字段的值不在记录中，不能作为索引键或INCLUDE列
+        if (col->is_overflow()) {
+            throw InvalidColLengthError(col->len);
+        }
+        return static_cast<int>(col - tab.cols.begin());
+    };
+    std::vector<int> col_idxs, include_idxs;
+    for (auto &col_name : col_names) {
+        col_idxs.push_back(get_col_idx(col_name));
+    }
+    for (auto &col_name : include_names) {
+        include_idxs.push_back(get_col_idx(col_name));
+    }
+    IndexMeta index = tab.make_index_meta(col_idxs, include_idxs, type);
     auto file_handle = fhs_.at(tab_name).get();
-    // Index all records into index
-    for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
-        auto rec = file_handle->get_record(rm_scan.rid(), context);  // rid是record的存储位置，作为value插入到索引里
-        const char *key = rec->data + col->offset;
-        // record data里以各个属性的offset进行分隔，属性的长度为col len，record里面每个属性的数据作为key插入索引里
-        ih->insert_entry(key, rm_scan.rid(), context->txn_);
+    // 建索引期间持有表上的S锁，读取记录时不再逐条加锁
+    if (context != nullptr && context->lock_mgr_ != nullptr) {
+        context->lock_mgr_->LockSharedOnTable(context->txn_, file_handle->GetFd());
+        context->txn_->GetLockSet()->insert(LockDataId{file_handle->GetFd(), LockDataType::TABLE});
     }
+    auto index_name = ix_manager_->get_index_name(tab_name, col_idxs);
+    auto ih = build_index(tab_name, index);
     // Store index handle
-    auto index_name = ix_manager_->get_index_name(tab_name, col_idx);
     assert(ihs_.count(index_name) == 0);
     // ihs_[index_name] = std::move(ih);
     ihs_.emplace(index_name, std::move(ih));
-    // Mark column index as created
-    col->index = true;
+    // Mark index as created
+    tab.indexes.push_back(std::move(index));
+    update_index_flags(tab);
+}
+
+void SmManager::drop_index(const std::string &tab_name, const std::vector<std::string> &col_names,
+                           Context *context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    auto index = tab.get_index_meta(col_names);
+    if (index == tab.indexes.end()) {
+        throw IndexNotFoundError(tab_name, index_cols_str(col_names));
+    }
+    destroy_index(tab_name, *index);
+    tab.indexes.erase(index);
+    update_index_flags(tab);
+}
+
+/**
+ * @brief 收集表的统计信息，保存在TabMeta中，随元数据一起持久化
+ * 用蓄水池抽样从表中取出至多SM_STATS_SAMPLE_ROWS条记录，由样本计算每一列的不同值个数、最小/最大值和等深直方图；
+ * 每个B+树索引遍历一遍叶子，统计树高、叶子数、不同key的个数和填充率，并按不同key的个数重建索引的Bloom filter，
+ * 之后不存在的key上的点查询不访问索引的page。统计期间持有表上的S锁
+ *
+ * @param tab_name 表名
+ * @param context
+ */
+void SmManager::analyze_table(const std::string &tab_name, Context *context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    auto file_handle = fhs_.at(tab_name).get();
+    if (context != nullptr && context->lock_mgr_ != nullptr) {
+        context->lock_mgr_->LockSharedOnTable(context->txn_, file_handle->GetFd());
+        context->txn_->GetLockSet()->insert(LockDataId{file_handle->GetFd(), LockDataType::TABLE});
+    }
+    // 溢出字段的值不在记录中，不统计
+    std::vector<int> read_cols;
+    for (int i = 0; i < (int)tab.cols.size(); i++) {
+        if (!tab.cols[i].is_overflow()) {
+            read_cols.push_back(i);
+        }
+    }
+    std::vector<std::vector<uint64_t>> samples(tab.cols.size());
+    std::mt19937_64 rng(0);
+    int64_t num_rows = 0;
+    for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next(), num_rows++) {
+        int64_t slot = num_rows;
+        if (num_rows >= SM_STATS_SAMPLE_ROWS) {
+            slot = std::uniform_int_distribution<int64_t>(0, num_rows)(rng);
+            if (slot >= SM_STATS_SAMPLE_ROWS) {
+                continue;
+            }
+        }
+        auto rec = file_handle->read_record(rm_scan.rid(), read_cols);
+        for (int col_idx : read_cols) {
+            auto &col = tab.cols[col_idx];
+            uint64_t value = sm_stats_value(rec->data + col.offset, col.type, col.len);
+            if (slot == (int64_t)samples[col_idx].size()) {
+                samples[col_idx].push_back(value);
+            } else {
+                samples[col_idx][slot] = value;
+            }
+        }
+    }
+    TabStats stats = {.analyzed = true,
+                      .num_rows = num_rows,
+                      .num_pages = file_handle->get_file_hdr().num_pages,
+                      .cols = std::vector<ColStats>(tab.cols.size())};
+    for (size_t i = 0; i < tab.cols.size(); i++) {
+        auto &sample = samples[i];
+        auto &col_stats = stats.cols[i];
+        col_stats = {.ndv = 0, .null_frac = 0, .min_val = 0, .max_val = 0, .bounds = {}};
+        if (sample.empty()) {
+            continue;
+        }
+        std::sort(sample.begin(), sample.end());
+        int64_t n = sample.size(), d = 0, f1 = 0;
+        for (int64_t j = 0, k; j < n; j = k) {
+            for (k = j + 1; k < n && sample[k] == sample[j]; k++) {
+            }
+            d++;
+            f1 += k - j == 1;
+        }
+        // 样本是整张表时d是准确的，否则用Duj1估计量：n*d / (n - f1 + f1*n/N)
+        double ndv = n == num_rows ? d : n * d / (n - f1 + (double)f1 * n / num_rows);
+        col_stats.ndv = std::clamp((int64_t)ndv, d, num_rows);
+        col_stats.min_val = sample.front();
+        col_stats.max_val = sample.back();
+        int buckets = (int)std::min<int64_t>(SM_STATS_HIST_BUCKETS, n);
+        for (int b = 0; b <= buckets; b++) {
+            col_stats.bounds.push_back(sample[(n - 1) * b / buckets]);
+        }
+    }
+    tab.stats = std::move(stats);
+    for (auto &index : tab.indexes) {
+        if (index.type == IX_INDEX_BTREE) {
+            auto ih = ihs_.at(ix_manager_->get_index_name(tab_name, index.col_idxs)).get();
+            auto bih = static_cast<IxIndexHandle *>(ih);
+            index.stats = bih->GetTreeStats();
+            bih->BuildBloomFilter(index.stats.num_keys);
+        }
+    }
+
+    // 输出统计结果
+    RecordPrinter col_printer(4);
+    col_printer.print_separator(context);
+    col_printer.print_record({"Field", "NDV", "Min", "Max"}, context);
+    col_printer.print_separator(context);
+    for (size_t i = 0; i < tab.cols.size(); i++) {
+        auto &col_stats = tab.stats.cols[i];
+        bool known = !col_stats.bounds.empty();
+        col_printer.print_record({tab.cols[i].name, std::to_string(col_stats.ndv),
+                                  known ? stats_value_str(tab.cols[i], col_stats.min_val) : "",
+                                  known ? stats_value_str(tab.cols[i], col_stats.max_val) : ""},
+                                 context);
+    }
+    col_printer.print_separator(context);
+    RecordPrinter index_printer(5);
+    index_printer.print_separator(context);
+    index_printer.print_record({"Index", "Height", "Leaves", "Keys", "Fill"}, context);
+    index_printer.print_separator(context);
+    for (auto &index : tab.indexes) {
+        if (index.type == IX_INDEX_BTREE) {
+            char fill[16];
+            snprintf(fill, sizeof(fill), "%.2f", index.stats.fill_factor);
+            index_printer.print_record({index_cols_str(index.col_names()), std::to_string(index.stats.height),
+                                        std::to_string(index.stats.num_leaves), std::to_string(index.stats.num_keys),
+                                        fill},
+                                       context);
+        }
+    }
+    index_printer.print_separator(context);
+}
+
+/**
+ * @brief 把统计信息中的值还原为可读的形式，字符串列只保留了前8个字节
+ */
+std::string SmManager::stats_value_str(const ColMeta &col, uint64_t value) {
+    char key[sizeof(uint64_t)];
+    for (int i = sizeof(key) - 1; i >= 0; i--, value >>= 8) {
+        key[i] = static_cast<char>(value & 0xff);
+    }
+    if (col.type == TYPE_STRING) {
+        return std::string(key, strnlen(key, sizeof(key)));
+    }
+    char raw[sizeof(uint64_t)];
+    ix_denormalize_key(key, col.type, col.len, raw);
+    return col.type == TYPE_INT ? std::to_string(*reinterpret_cast<int *>(raw))
+                                : std::to_string(*reinterpret_cast<float *>(raw));
+}
+
+/**
+ * @brief 重建表上的所有索引：按表中现有的记录重新构建索引文件
+ * 删除较多之后，B+树的空闲页链表中可能积累了大量page，重建后的文件只包含存放现有entry所需的page；
+ * Bloom filter不支持删除，也在这里按现有的key重建
+ * 重建期间持有表上的X锁（直到事务结束），其他事务不会在旧的索引上扫描；数据库不需要下线
+ *
+ * @param tab_name 表名
+ * @param context
+ */
+void SmManager::reindex_table(const std::string &tab_name, Context *context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    auto file_handle = fhs_.at(tab_name).get();
+    if (context != nullptr && context->lock_mgr_ != nullptr) {
+        context->lock_mgr_->LockExclusiveOnTable(context->txn_, file_handle->GetFd());
+        context->txn_->GetLockSet()->insert(LockDataId{file_handle->GetFd(), LockDataType::TABLE});
+    }
+    for (auto &index : tab.indexes) {
+        destroy_index(tab_name, index);
+        auto ih = build_index(tab_name, index);
+        // ANALYZE过的B+树索引重建Bloom filter，去掉被删除的key留下的假阳性
+        if (index.type == IX_INDEX_BTREE && index.stats.height > 0) {
+            static_cast<IxIndexHandle *>(ih.get())->BuildBloomFilter(index.stats.num_keys);
+        }
+        ihs_.emplace(ix_manager_->get_index_name(tab_name, index.col_idxs), std::move(ih));
+    }
+}
+
+/**
+ * @brief 创建索引文件，并插入表中所有记录的entry，调用者需要保证建索引期间表中的记录不变
+ *
+ * @param tab_name 表名
+ * @param index 索引的元数据
+ * @return 打开的索引
+ */
+std::unique_ptr<IxIndex> SmManager::build_index(const std::string &tab_name, const IndexMeta &index) {
+    if (index.type == IX_INDEX_ART) {
+        return open_index(tab_name, index);
+    }
+    std::vector<ColType> col_types;
+    std::vector<int> col_lens;
+    for (auto &col : index.cols) {
+        col_types.push_back(col.type);
+        col_lens.push_back(col.len);
+    }
+    // Create index file
+    if (index.type == IX_INDEX_HASH) {
+        ix_manager_->create_hash_index(tab_name, index.col_idxs, col_types, col_lens);
+    } else {
+        // B+树索引不要求key唯一，相同key的entry按rid排序
+        ix_manager_->create_index(tab_name, index.col_idxs, col_types, col_lens, index.include_len, true, false);
+    }
+    // Open index file
+    auto ih = open_index(tab_name, index);
+    // Get record file handle
+    auto file_handle = fhs_.at(tab_name).get();
+    std::vector<int> read_cols = index.col_idxs;
+    read_cols.insert(read_cols.end(), index.include_idxs.begin(), index.include_idxs.end());
+    std::vector<char> key(index.col_tot_len), include(index.include_len);
+    if (index.type == IX_INDEX_HASH) {
+        // 哈希索引没有顺序，逐条插入，bucket满时分裂；key唯一，表中有重复的key时不能建立
+        for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
+            auto rec = file_handle->read_record(rm_scan.rid(), read_cols);
+            index.get_key(rec->data, key.data());
+            if (!ih->insert_entry(key.data(), rm_scan.rid(), nullptr)) {
+                ix_manager_->close_index(ih.get());
+                ix_manager_->destroy_index(tab_name, index.col_idxs);
+                throw DuplicateKeyError(tab_name, index_cols_str(index.col_names()));
+            }
+        }
+    } else {
+        // 排序所有(key,rid)后自底向上批量构建B+树，而不是逐条insert_entry
+        auto bih = static_cast<IxIndexHandle *>(ih.get());
+        std::vector<char> norm_key(bih->key_len());
+        IxSorter sorter(disk_manager_, bih->key_len(), index.include_len,
+                        ix_manager_->get_index_name(tab_name, index.col_idxs));
+        for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
+            auto rec = file_handle->read_record(rm_scan.rid(), read_cols);  // rid是record的存储位置，作为value插入到索引里
+            index.get_key(rec->data, key.data());
+            index.get_include(rec->data, include.data());
+            Rid rid = rm_scan.rid();
+            sorter.add(bih->normalize_key(key.data(), norm_key.data(), &rid), rid, include.data());
+        }
+        sorter.finish();
+        bih->bulk_load(&sorter);
+    }
+    return ih;
 }
 
-void SmManager::drop_index(const std::string &tab_name, const std::string &col_name, Context *context) {
-    TabMeta &tab = db_.tabs_[tab_name];
-    auto col = tab.get_col(col_name);
-    if (!col->index) {
-        throw IndexNotFoundError(tab_name, col_name);
+/**
+ * @brief 按索引的类型打开索引文件；ART索引只在内存中，每次打开时按表中现有的记录重新构建
+ */
+std::unique_ptr<IxIndex> SmManager::open_index(const std::string &tab_name, const IndexMeta &index) {
+    if (index.type == IX_INDEX_HASH) {
+        return ix_manager_->open_hash_index(tab_name, index.col_idxs);
     }
-    int col_idx = col - tab.cols.begin();
-    auto index_name = ix_manager_->get_index_name(tab_name, col_idx);
+    if (index.type == IX_INDEX_ART) {
+        std::vector<ColType> col_types;
+        std::vector<int> col_lens;
+        for (auto &col : index.cols) {
+            col_types.push_back(col.type);
+            col_lens.push_back(col.len);
+        }
+        auto ih = ix_manager_->open_art_index(col_types, col_lens);
+        auto file_handle = fhs_.at(tab_name).get();
+        std::vector<char> key(index.col_tot_len);
+        for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
+            auto rec = file_handle->read_record(rm_scan.rid(), index.col_idxs);
+            index.get_key(rec->data, key.data());
+            ih->insert_entry(key.data(), rm_scan.rid(), nullptr);
+        }
+        return ih;
+    }
+    return ix_manager_->open_index(tab_name, index.col_idxs);
+}
+
+/**
+ * @brief 关闭并删除表上的一个索引，ART索引没有索引文件，只释放内存
+ */
+void SmManager::destroy_index(const std::string &tab_name, const IndexMeta &index) {
+    auto index_name = ix_manager_->get_index_name(tab_name, index.col_idxs);
     ix_manager_->close_index(ihs_.at(index_name).get());
-    ix_manager_->destroy_index(tab_name, col_idx);
+    if (index.type != IX_INDEX_ART) {
+        ix_manager_->destroy_index(tab_name, index.col_idxs);
+    }
     ihs_.erase(index_name);
-    col->index = false;
+}
+
+/**
+ * @brief 重新计算每一列是否属于某个索引（desc table中显示）
+ */
+void SmManager::update_index_flags(TabMeta &tab) {
+    for (auto &col : tab.cols) {
+        col.index = false;
+    }
+    for (auto &index : tab.indexes) {
+        for (int col_idx : index.col_idxs) {
+            tab.cols[col_idx].index = true;
+        }
+    }
+}
+
+std::string SmManager::index_cols_str(const std::vector<std::string> &col_names) {
+    std::string str;
+    for (auto &col_name : col_names) {
+        str += (str.empty() ? "" : ",") + col_name;
+    }
+    return str;
+}
+
+/**
+ * @brief 压缩表的记录文件：把尾部稀疏page中的记录移动到前面page的空闲slot中并截断文件
+ * 压缩前对表加X锁（保证没有其他事务持有未提交的rid），按两阶段锁的规则由事务结束时释放
+ * 记录移动只改变物理位置，不写入事务的write set；每移动一条记录都要更新该表所有索引中的rid
+ * 移动和索引修改都不写日志，事务回滚时不会撤销，压缩过程中崩溃可能使索引与记录文件不一致，需要REINDEX
+ * 当前事务的write set中若有该表的记录，回滚时会按原rid写回（包括被删除记录空出的slot），因此拒绝压缩
+ *
+ * @param tab_name 表名
+ * @param context
+ */
+void SmManager::vacuum_table(const std::string &tab_name, Context *context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    for (auto write_record : *context->txn_->GetWriteSet()) {
+        if (write_record->GetTableName() == tab_name) {
+            throw InternalError("VACUUM cannot run on a table modified by the current transaction");
+        }
+    }
+    RmFileHandle *fh = fhs_.at(tab_name).get();
+    std::vector<std::pair<const IndexMeta *, IxIndex *>> indexes;
+    for (auto &index : tab.indexes) {
+        indexes.emplace_back(&index, ihs_.at(ix_manager_->get_index_name(tab_name, index.col_idxs)).get());
+    }
+    auto on_move = [&](const Rid &old_rid, const Rid &new_rid, const char *buf) {
+        char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
+        for (auto &[index, ih] : indexes) {
+            index->get_key(buf, key);
+            index->get_include(buf, include);
+            ih->delete_entry(key, old_rid, context->txn_);
+            ih->insert_entry(key, new_rid, context->txn_, include);
+        }
+    };
+    context->lock_mgr_->LockExclusiveOnTable(context->txn_, fh->GetFd());
+    context->txn_->GetLockSet()->insert(LockDataId{fh->GetFd(), LockDataType::TABLE});
+    int moved;
+    do {
+        moved = fh->vacuum(RM_VACUUM_BATCH_SIZE, on_move);
+    } while (moved == RM_VACUUM_BATCH_SIZE);
+}
+
+/**
+ * @brief 释放记录中溢出字段所引用的页链
+ * 删除和更新操作不会立即释放旧值的页链（事务可能回滚），而是在事务提交/回滚时调用该函数
+ *
+ * @param tab_name 表名
+ * @param record 要释放页链的记录
+ * @param keep 若不为空，则record中与keep引用相同页链的字段不会被释放
+ */
+void SmManager::release_overflow(const std::string &tab_name, const RmRecord &record, const RmRecord *keep) {
+    auto ofh = ofhs_.find(tab_name);
+    if (ofh == ofhs_.end() || !db_.is_table(tab_name)) {
+        return;
+    }
+    for (auto &col : db_.get_table(tab_name).cols) {
+        if (!col.is_overflow()) {
+            continue;
+        }
+        auto ptr = reinterpret_cast<const RmOverflowPtr *>(record.data + col.offset);
+        if (keep != nullptr &&
+            reinterpret_cast<const RmOverflowPtr *>(keep->data + col.offset)->first_page_no == ptr->first_page_no) {
+            continue;
+        }
+        ofh->second->delete_value(*ptr);
+    }
+}
+
+/**
+ * @brief 生成表的zone map列描述，数值列和定长字符列维护min/max，溢出字段不维护
+ */
+std::vector<RmZoneCol> SmManager::get_zone_cols(const TabMeta &tab) {
+    std::vector<RmZoneCol> zone_cols;
+    for (auto &col : tab.cols) {
+        zone_cols.push_back({.type = col.type, .offset = col.offset, .len = col.len, .enabled = !col.is_overflow()});
+    }
+    return zone_cols;
 }
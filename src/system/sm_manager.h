@@ -4,6 +4,7 @@
 // #include "record/rm.h"
 #include "common/context.h"
 #include "record/rm_file_handle.h"
+#include "record/rm_overflow_handle.h"
 #include "sm_defs.h"
 #include "sm_meta.h"
 
@@ -22,7 +23,8 @@ class SmManager {
    public:
     DbMeta db_;  // create_db时将会将DbMeta写入文件，open_db时将会从文件中读出DbMeta
     std::unordered_map<std::string, std::unique_ptr<RmFileHandle>> fhs_;   // file name -> record file handle
-    std::unordered_map<std::string, std::unique_ptr<IxIndexHandle>> ihs_;  // file name -> index file handle
+    std::unordered_map<std::string, std::unique_ptr<IxIndex>> ihs_;  // file name -> index file handle（B+树、哈希或ART索引）
+    std::unordered_map<std::string, std::unique_ptr<RmOverflowHandle>> ofhs_;  // table name -> overflow file handle
    private:
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
@@ -33,6 +35,18 @@ class SmManager {
     // std::map<std::string, std::unique_ptr<RmFileHandle>> *fhs_;
     // std::map<std::string, std::unique_ptr<IxIndexHandle>> *ihs_;
 
+    std::unique_ptr<IxIndex> open_index(const std::string &tab_name, const IndexMeta &index);
+
+    std::unique_ptr<IxIndex> build_index(const std::string &tab_name, const IndexMeta &index);
+
+    void destroy_index(const std::string &tab_name, const IndexMeta &index);
+
+    std::vector<RmZoneCol> get_zone_cols(const TabMeta &tab);
+
+    void update_index_flags(TabMeta &tab);
+
+    static std::string stats_value_str(const ColMeta &col, uint64_t value);
+
    public:
     SmManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, RmManager *rm_manager,
               IxManager *ix_manager)
@@ -76,18 +90,40 @@ class SmManager {
 
     void desc_table(const std::string &tab_name, Context *context);
 
-    void create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context);
+    void create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context,
+                      RmLayout layout = RM_LAYOUT_NSM);
 
     void drop_table(const std::string &tab_name, Context *context);
 
     void apply_drop_table(const std::string &tab_name, Context *context);
 
     // Index management
-    void create_index(const std::string &tab_name, const std::string &col_name, Context *context);
+    void create_index(const std::string &tab_name, const std::vector<std::string> &col_names, Context *context,
+                      const std::vector<std::string> &include_names = {}, IxIndexType type = IX_INDEX_BTREE);
+
+    void drop_index(const std::string &tab_name, const std::vector<std::string> &col_names, Context *context);
+
+    void apply_drop_index(const std::string &tab_name, const std::vector<std::string> &col_names, Context *context);
 
-    void drop_index(const std::string &tab_name, const std::string &col_name, Context *context);
+    // Compaction
+    void vacuum_table(const std::string &tab_name, Context *context);
+
+    void reindex_table(const std::string &tab_name, Context *context);
+
+    // Statistics
+    void analyze_table(const std::string &tab_name, Context *context);
+
+    // Overflow management
+    /**
+     * @brief release the overflow chains referenced by a record
+     *
+     * @param tab_name the name of the table
+     * @param record the record whose overflow columns should be released
+     * @param keep if not null, chains that are still referenced by this record are kept
+     */
+    void release_overflow(const std::string &tab_name, const RmRecord &record, const RmRecord *keep = nullptr);
 
-    void apply_drop_index(const std::string &tab_name, const std::string &col_name, Context *context);
+    static std::string index_cols_str(const std::vector<std::string> &col_names);
 
     // Transaction rollback management
     /**
@@ -136,15 +172,17 @@ class SmManager {
      * @brief rollback the create index operation
      *
      * @param tab_name the name of the table
-     * @param col_name the name of the column on which index is created
+     * @param col_names the names of the columns on which index is created
      */
-    void rollback_create_index(const std::string &tab_name, const std::string &col_name, Context *context);
+    void rollback_create_index(const std::string &tab_name, const std::vector<std::string> &col_names,
+                               Context *context);
 
     /**
      * @brief rollback the drop index operation
      *
      * @param tab_name the name of the table
-     * @param col_name the name of the column on which index is created
+     * @param col_names the names of the columns on which index is created
      */
-    void rollback_drop_index(const std::string &tab_name, const std::string &col_name, Context *context);
+    void rollback_drop_index(const std::string &tab_name, const std::vector<std::string> &col_names,
+                             Context *context);
 };
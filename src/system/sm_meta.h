@@ -1,12 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "errors.h"
+#include "index/ix_defs.h"
+#include "index/ix_key.h"
+#include "record/rm_defs.h"
 #include "sm_defs.h"
 
 struct ColMeta {
@@ -15,7 +19,13 @@ struct ColMeta {
     ColType type;          // 字段类型
     int len;               // 字段长度
     int offset;            // 字段位于记录中的偏移量
-    bool index;            // 该字段上是否建立索引
+    bool index;            // 该字段是否属于某个索引
+
+    // 超长的字符串字段存放在溢出页中，记录里只保存一个RmOverflowPtr
+    bool is_overflow() const { return type == TYPE_STRING && len > RM_OVERFLOW_THRESHOLD; }
+
+    // 字段在记录中实际占用的长度
+    int stored_len() const { return is_overflow() ? (int)sizeof(RmOverflowPtr) : len; }
 
     friend std::ostream &operator<<(std::ostream &os, const ColMeta &col) {
         // ColMeta中有各个基本类型的变量，然后调用重载的这些变量的操作符<<（具体实现逻辑在defs.h）
@@ -28,9 +38,137 @@ struct ColMeta {
     }
 };
 
+/**
+ * @brief 统计信息中列的值：保序编码（ix_normalize_key）的前8个字节按大端序解释为整数，大小关系与原始值一致
+ * INT和FLOAT列的编码只有4个字节，转换是精确的；字符串列只区分前8个字节，用于估计选择率已经足够
+ */
+inline uint64_t sm_stats_value(const char *val, ColType type, int len) {
+    unsigned char key[sizeof(uint64_t)] = {};
+    if (type == TYPE_STRING) {
+        memcpy(key, val, std::min(len, (int)sizeof(key)));
+    } else {
+        ix_normalize_key(val, type, len, (char *)key);
+    }
+    uint64_t value = 0;
+    for (unsigned char byte : key) {
+        value = value << 8 | byte;
+    }
+    return value;
+}
+
+/* ANALYZE收集的列统计信息，其中的值都是sm_stats_value()的结果 */
+struct ColStats {
+    int64_t ndv;                   // 不同值的个数（由样本估计）
+    double null_frac;              // NULL值所占的比例，目前所有列都不能为NULL，总是0
+    uint64_t min_val;              // 最小值
+    uint64_t max_val;              // 最大值
+    std::vector<uint64_t> bounds;  // 等深直方图的边界，相邻两个边界之间的记录数相同，第一项和最后一项为min和max
+
+    // 值小于val的记录所占的比例，桶内按均匀分布插值
+    double fraction_below(uint64_t val) const {
+        if (bounds.size() < 2 || val <= bounds.front()) {
+            return 0;
+        }
+        if (val > bounds.back()) {
+            return 1;
+        }
+        // bounds[b] < val <= bounds[b + 1]
+        int b = static_cast<int>(std::lower_bound(bounds.begin(), bounds.end(), val) - bounds.begin()) - 1;
+        double width = static_cast<double>(bounds[b + 1] - bounds[b]);
+        return (b + static_cast<double>(val - bounds[b]) / width) / (bounds.size() - 1);
+    }
+
+    // 值等于val的记录所占的比例：val占据多个桶（高频值）时按桶数计算，否则假设各个值均匀分布
+    double fraction_equal(uint64_t val) const {
+        if (ndv == 0 || val < min_val || val > max_val) {
+            return 0;
+        }
+        auto range = std::equal_range(bounds.begin(), bounds.end(), val);
+        int buckets = static_cast<int>(range.second - range.first) - 1;
+        return std::max(1.0 / ndv, static_cast<double>(buckets) / (bounds.size() - 1));
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const ColStats &stats) {
+        os << stats.ndv << ' ' << stats.null_frac << ' ' << stats.min_val << ' ' << stats.max_val << ' '
+           << stats.bounds.size();
+        for (uint64_t bound : stats.bounds) {
+            os << ' ' << bound;
+        }
+        return os;
+    }
+
+    friend std::istream &operator>>(std::istream &is, ColStats &stats) {
+        size_t n;
+        is >> stats.ndv >> stats.null_frac >> stats.min_val >> stats.max_val >> n;
+        stats.bounds.resize(n);
+        for (auto &bound : stats.bounds) {
+            is >> bound;
+        }
+        return is;
+    }
+};
+
+/* ANALYZE收集的表统计信息，没有执行过ANALYZE时analyzed为false，优化器使用基于规则的选择 */
+struct TabStats {
+    bool analyzed = false;
+    int64_t num_rows = 0;        // 记录数
+    int num_pages = 0;           // 记录文件的page数
+    std::vector<ColStats> cols;  // 与TabMeta::cols一一对应
+};
+
+/* 索引元数据，索引的key由cols中各列的值依次拼接而成
+ * include_cols是覆盖索引的INCLUDE列，不参与比较，只在叶子中随rid一起存放 */
+struct IndexMeta {
+    std::string tab_name;               // 索引所属表名称
+    IxIndexType type;                   // B+树、哈希或ART索引
+    int col_tot_len;                    // key的总长度
+    int col_num;                        // 索引包含的列数
+    std::vector<int> col_idxs;          // 各列在表中的序号，决定了索引文件名
+    std::vector<ColMeta> cols;          // 各列的元数据
+    int include_len;                    // INCLUDE列的总长度
+    std::vector<int> include_idxs;      // INCLUDE列在表中的序号
+    std::vector<ColMeta> include_cols;  // INCLUDE列的元数据
+    IxTreeStats stats = {};             // ANALYZE统计的B+树形状，height为0表示没有统计过
+
+    std::vector<std::string> col_names() const {
+        std::vector<std::string> names;
+        for (auto &col : cols) {
+            names.push_back(col.name);
+        }
+        return names;
+    }
+
+    // 从记录中取出各列的值拼接为索引的原始key，key的长度为col_tot_len
+    void get_key(const char *record, char *key) const {
+        int offset = 0;
+        for (auto &col : cols) {
+            memcpy(key + offset, record + col.offset, col.len);
+            offset += col.len;
+        }
+    }
+
+    // 从记录中取出INCLUDE列的值拼接起来，长度为include_len
+    void get_include(const char *record, char *include) const {
+        int offset = 0;
+        for (auto &col : include_cols) {
+            memcpy(include + offset, record + col.offset, col.len);
+            offset += col.len;
+        }
+    }
+
+    // 该列的值是否能直接从索引中得到（key列或INCLUDE列）
+    bool covers(const std::string &col_name) const {
+        auto has_col = [&](const ColMeta &col) { return col.name == col_name; };
+        return std::any_of(cols.begin(), cols.end(), has_col) ||
+               std::any_of(include_cols.begin(), include_cols.end(), has_col);
+    }
+};
+
 struct TabMeta {
     std::string name;
     std::vector<ColMeta> cols;
+    std::vector<IndexMeta> indexes;  // 表上建立的所有索引
+    TabStats stats;                  // ANALYZE收集的统计信息
 
     /**
      * @brief 根据列名在本表元数据结构体中查找是否有该名字的列
@@ -63,11 +201,77 @@ struct TabMeta {
         return it;
     }
 
+    /**
+     * @brief 判断表上是否有按col_names顺序的索引
+     *
+     * @param col_names 索引包含的列名，顺序有意义
+     */
+    bool is_index(const std::vector<std::string> &col_names) const {
+        return std::any_of(indexes.begin(), indexes.end(),
+                           [&](const IndexMeta &index) { return index.col_names() == col_names; });
+    }
+
+    /**
+     * @brief 根据索引包含的列名获得索引元数据IndexMeta
+     *
+     * @param col_names 索引包含的列名，顺序有意义
+     * @return std::vector<IndexMeta>::iterator，不存在时为indexes.end()
+     */
+    std::vector<IndexMeta>::iterator get_index_meta(const std::vector<std::string> &col_names) {
+        return std::find_if(indexes.begin(), indexes.end(),
+                            [&](const IndexMeta &index) { return index.col_names() == col_names; });
+    }
+
+    /**
+     * @brief 根据索引类型、key列和INCLUDE列在表中的序号生成索引元数据
+     */
+    IndexMeta make_index_meta(const std::vector<int> &col_idxs, const std::vector<int> &include_idxs = {},
+                              IxIndexType type = IX_INDEX_BTREE) const {
+        IndexMeta index = {.tab_name = name,
+                           .type = type,
+                           .col_tot_len = 0,
+                           .col_num = (int)col_idxs.size(),
+                           .col_idxs = col_idxs,
+                           .cols = {},
+                           .include_len = 0,
+                           .include_idxs = include_idxs};
+        for (int col_idx : col_idxs) {
+            index.cols.push_back(cols[col_idx]);
+            index.col_tot_len += cols[col_idx].len;
+        }
+        for (int col_idx : include_idxs) {
+            index.include_cols.push_back(cols[col_idx]);
+            index.include_len += cols[col_idx].len;
+        }
+        return index;
+    }
+
+    // 索引只保存各列的序号，列的元数据在读取时从cols中恢复
     friend std::ostream &operator<<(std::ostream &os, const TabMeta &tab) {
         os << tab.name << '\n' << tab.cols.size() << '\n';
         for (auto &col : tab.cols) {
             os << col << '\n';  // col是ColMeta类型，然后调用重载的ColMeta的操作符<<
         }
+        os << tab.indexes.size() << '\n';
+        for (auto &index : tab.indexes) {
+            os << index.col_num;
+            for (int col_idx : index.col_idxs) {
+                os << ' ' << col_idx;
+            }
+            os << ' ' << index.include_idxs.size();
+            for (int col_idx : index.include_idxs) {
+                os << ' ' << col_idx;
+            }
+            os << ' ' << index.type << ' ' << index.stats.height << ' ' << index.stats.num_leaves << ' '
+               << index.stats.num_entries << ' ' << index.stats.num_keys << ' ' << index.stats.fill_factor << '\n';
+        }
+        os << tab.stats.analyzed << '\n';
+        if (tab.stats.analyzed) {
+            os << tab.stats.num_rows << ' ' << tab.stats.num_pages << '\n';
+            for (auto &col_stats : tab.stats.cols) {
+                os << col_stats << '\n';
+            }
+        }
         return os;
     }
 
@@ -79,6 +283,33 @@ struct TabMeta {
             is >> col;
             tab.cols.push_back(col);
         }
+        is >> n;
+        for (size_t i = 0; i < n; i++) {
+            size_t col_num, include_num;
+            is >> col_num;
+            std::vector<int> col_idxs(col_num);
+            for (auto &col_idx : col_idxs) {
+                is >> col_idx;
+            }
+            is >> include_num;
+            std::vector<int> include_idxs(include_num);
+            for (auto &col_idx : include_idxs) {
+                is >> col_idx;
+            }
+            IxIndexType type;
+            is >> type;
+            tab.indexes.push_back(tab.make_index_meta(col_idxs, include_idxs, type));
+            auto &stats = tab.indexes.back().stats;
+            is >> stats.height >> stats.num_leaves >> stats.num_entries >> stats.num_keys >> stats.fill_factor;
+        }
+        is >> tab.stats.analyzed;
+        if (tab.stats.analyzed) {
+            is >> tab.stats.num_rows >> tab.stats.num_pages;
+            tab.stats.cols.resize(tab.cols.size());
+            for (auto &col_stats : tab.stats.cols) {
+                is >> col_stats;
+            }
+        }
         return is;
     }
 };
@@ -486,6 +486,28 @@ bool LockManager::LockIXOnTable(Transaction *txn, int tab_fd) {
  * @param lock_data_id 要释放的锁ID
  * @return 返回解锁是否成功
  */
+/**
+ * 不阻塞地检查是否有其他事务持有记录上的锁
+ * S锁升级为X锁时组模式不变，所以只要记录上有锁并且队列中有其他事务的请求就返回true
+ * @param txn 当前事务对象指针
+ * @param rid 要检查的记录ID
+ * @param tab_fd 记录所在的表的fd
+ * @return 返回记录是否可能正在被其他事务修改
+ */
+bool LockManager::IsRecordLockedByOthers(Transaction *txn, const Rid &rid, int tab_fd) {
+    std::unique_lock<std::mutex> lock(latch_);
+    auto lock_data = lock_table_.find(LockDataId(tab_fd, rid, LockDataType::RECORD));
+    if (lock_data == lock_table_.end() || lock_data->second.group_lock_mode_ == GroupLockMode::NON_LOCK) {
+        return false;
+    }
+    for (auto &request : lock_data->second.request_queue_) {
+        if (request.txn_id_ != txn->GetTransactionId()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool LockManager::Unlock(Transaction *txn, LockDataId lock_data_id) {
     //更新锁表
     std::unique_lock<std::mutex> lock(latch_);
@@ -67,6 +67,8 @@ public:
 
     bool Unlock(Transaction *txn, LockDataId lock_data_id);
 
+    bool IsRecordLockedByOthers(Transaction *txn, const Rid &rid, int tab_fd);
+
 private:
     std::mutex latch_;  // 互斥锁，用于锁表的互斥访问
     std::unordered_map<LockDataId, LockRequestQueue> lock_table_;   // 全局锁表
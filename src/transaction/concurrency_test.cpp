@@ -1,6 +1,8 @@
 #include "concurrency/lock_manager.h"
 #include "transaction_manager.h"
 #include "execution/execution_manager.h"
+#include "execution/executor_index_only_scan.h"
+#include "execution/executor_parallel_seq_scan.h"
 #include "interp.h"
 #include "gtest/gtest.h"
 
@@ -265,4 +267,127 @@ TEST_F(ConcurrencyTest, UnrepeatableReadTest) {
 
     t0.join();
     t1.join();
-}
\ No newline at end of file
+}
+
+TEST_F(ConcurrencyTest, ParallelSeqScanRecheckTest) {
+    /**
+     * pre: create table t1 (id int, num int); insert (1,1) ... (10,1);
+     * t1: begin; parallel scan t1 where num = 1, worker已经筛选完所有记录，输出第一条记录
+     * t2: update t1 set num = 2 where id = 2; delete from t1 where id = 3;
+     * t1: 继续扫描，id为2和3的记录已经不满足条件，不能输出
+     */
+    char *res = new char[BUFFER_LENGTH];
+    int offset;
+    txn_id_t txn_id = INVALID_TXN_ID;
+    exec_sql("create table t1 (id int, num int);", res, &offset, &txn_id);
+    for (int i = 1; i <= 10; i++) {
+        exec_sql("insert into t1 values (" + std::to_string(i) + ", 1);", res, &offset, &txn_id);
+    }
+
+    Transaction *txn = txn_manager_->Begin(nullptr, log_manager_.get());
+    Context context(lock_manager_.get(), log_manager_.get(), txn);
+    Condition cond{.lhs_col = {"t1", "num"}, .op = OP_EQ, .is_rhs_val = true};
+    cond.rhs_val.set_int(1);
+    cond.rhs_val.init_raw(sizeof(int));
+    // 只有一个worker和一个morsel，beginTuple()返回时worker已经筛选完整张表
+    ParallelSeqScanExecutor scan(sm_manager_.get(), "t1", {cond}, &context, 1);
+    scan.beginTuple();
+
+    exec_sql("update t1 set num = 2 where id = 2;", res, &offset, &txn_id);
+    exec_sql("delete from t1 where id = 3;", res, &offset, &txn_id);
+
+    std::vector<int> ids;
+    for (; !scan.is_end(); scan.nextTuple()) {
+        auto rec = scan.Next();
+        EXPECT_EQ(*(int *)(rec->data + sizeof(int)), 1);
+        ids.push_back(*(int *)rec->data);
+    }
+    txn_manager_->Commit(txn, log_manager_.get());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, std::vector<int>({1, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST_F(ConcurrencyTest, ParallelSeqScanUncommittedTest) {
+    /**
+     * pre: create table t1 (id int, num int); insert (1,1) ... (10,1);
+     * t2: begin; 对id为2的记录加X锁并把num改为2（未提交）
+     * t1: begin; parallel scan t1 where num = 1，worker读到id为2的记录不满足条件
+     * t2: abort;
+     * t1: 与串行扫描一样，等待t2释放锁后读到回滚后的记录，所有记录都应该输出
+     */
+    char *res = new char[BUFFER_LENGTH];
+    int offset;
+    txn_id_t txn_id = INVALID_TXN_ID;
+    exec_sql("create table t1 (id int, num int);", res, &offset, &txn_id);
+    for (int i = 1; i <= 10; i++) {
+        exec_sql("insert into t1 values (" + std::to_string(i) + ", 1);", res, &offset, &txn_id);
+    }
+
+    auto fh = sm_manager_->fhs_.at("t1").get();
+    Rid rid{RM_FIRST_RECORD_PAGE, 1};
+    Transaction *writer = txn_manager_->Begin(nullptr, log_manager_.get());
+    Context writer_context(lock_manager_.get(), log_manager_.get(), writer);
+    auto old_rec = fh->read_record(rid, {});
+    ASSERT_EQ(*(int *)old_rec->data, 2);
+    RmRecord new_rec(*old_rec);
+    *(int *)(new_rec.data + sizeof(int)) = 2;
+    fh->update_record(rid, new_rec.data, &writer_context);
+    writer->GetWriteSet()->push_back(new WriteRecord(WType::UPDATE_TUPLE, "t1", rid, *old_rec));
+    std::thread aborter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        txn_manager_->Abort(writer, log_manager_.get());
+    });
+
+    Transaction *txn = txn_manager_->Begin(nullptr, log_manager_.get());
+    Context context(lock_manager_.get(), log_manager_.get(), txn);
+    Condition cond{.lhs_col = {"t1", "num"}, .op = OP_EQ, .is_rhs_val = true};
+    cond.rhs_val.set_int(1);
+    cond.rhs_val.init_raw(sizeof(int));
+    ParallelSeqScanExecutor scan(sm_manager_.get(), "t1", {cond}, &context, 1);
+    std::vector<int> ids;
+    for (scan.beginTuple(); !scan.is_end(); scan.nextTuple()) {
+        auto rec = scan.Next();
+        EXPECT_EQ(*(int *)(rec->data + sizeof(int)), 1);
+        ids.push_back(*(int *)rec->data);
+    }
+    aborter.join();
+    txn_manager_->Commit(txn, log_manager_.get());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST_F(ConcurrencyTest, IndexOnlyScanRecheckTest) {
+    /**
+     * pre: create table t1 (id int, num int); create index t1 (num) include (id); insert (1,10) ... (10,100);
+     * t1: begin; index only scan t1，叶子中的entry已经全部取出，输出第一条记录
+     * t2: update t1 set num = 25 where id = 2; delete from t1 where id = 3;
+     * t1: 继续扫描，id为2和3的entry已经不在索引中，不能输出
+     */
+    char *res = new char[BUFFER_LENGTH];
+    int offset;
+    txn_id_t txn_id = INVALID_TXN_ID;
+    exec_sql("create table t1 (id int, num int);", res, &offset, &txn_id);
+    exec_sql("create index t1 (num) include (id);", res, &offset, &txn_id);
+    for (int i = 1; i <= 10; i++) {
+        exec_sql("insert into t1 values (" + std::to_string(i) + ", " + std::to_string(i * 10) + ");", res, &offset,
+                 &txn_id);
+    }
+
+    Transaction *txn = txn_manager_->Begin(nullptr, log_manager_.get());
+    Context context(lock_manager_.get(), log_manager_.get(), txn);
+    IndexOnlyScanExecutor scan(sm_manager_.get(), "t1", {}, {"num"}, &context);
+    scan.beginTuple();
+
+    exec_sql("update t1 set num = 25 where id = 2;", res, &offset, &txn_id);
+    exec_sql("delete from t1 where id = 3;", res, &offset, &txn_id);
+
+    std::vector<int> ids;
+    for (; !scan.is_end(); scan.nextTuple()) {
+        auto rec = scan.Next();
+        int id = *(int *)rec->data;
+        EXPECT_EQ(*(int *)(rec->data + sizeof(int)), id * 10);
+        ids.push_back(id);
+    }
+    txn_manager_->Commit(txn, log_manager_.get());
+    EXPECT_EQ(ids, std::vector<int>({1, 4, 5, 6, 7, 8, 9, 10}));
+}
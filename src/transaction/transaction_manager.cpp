@@ -1,5 +1,8 @@
 #include "transaction_manager.h"
 
+#include <map>
+#include <tuple>
+
 #include "record/rm_file_handle.h"
 
 std::unordered_map<txn_id_t, Transaction *> TransactionManager::txn_map = {};
@@ -50,6 +53,33 @@ void TransactionManager::Commit(Transaction *txn, LogManager *log_manager) {
             //?提交
         }
     }
+    // 1.1 删除/更新前的旧值不会再被回滚，释放它们引用的溢出页链
+    // 从后向前处理，更新后的值是同一条记录的下一个写记录中的旧值（其中被删除的链由DELETE_TUPLE释放），
+    // 没有下一个写记录时才读取当前记录；记录已经被本事务加X锁，读取时不再加锁
+    std::map<std::tuple<std::string, int, int>, const RmRecord *> next_value;
+    std::vector<std::unique_ptr<RmRecord>> current_values;
+    for (auto it = txn->GetWriteSet()->rbegin(); it != txn->GetWriteSet()->rend(); it++) {
+        WriteRecord *wr = *it;
+        auto key = std::make_tuple(wr->GetTableName(), wr->GetRid().page_no, wr->GetRid().slot_no);
+        if (wr->GetWriteType() == WType::INSERT_TUPLE) {
+            next_value.erase(key);  // 插入之前的写记录属于slot中被删除的另一条记录
+            continue;
+        }
+        if (wr->GetWriteType() == WType::DELETE_TUPLE) {
+            sm_manager_->release_overflow(wr->GetTableName(), wr->GetRecord());
+        } else if (wr->GetWriteType() == WType::UPDATE_TUPLE && sm_manager_->ofhs_.count(wr->GetTableName())) {
+            auto next = next_value.find(key);
+            const RmRecord *new_value;
+            if (next != next_value.end()) {
+                new_value = next->second;
+            } else {
+                current_values.push_back(sm_manager_->fhs_.at(wr->GetTableName())->read_record(wr->GetRid(), {}));
+                new_value = current_values.back().get();
+            }
+            sm_manager_->release_overflow(wr->GetTableName(), wr->GetRecord(), new_value);
+        }
+        next_value[key] = &wr->GetRecord();
+    }
     // 2. 释放所有锁
     for (auto it = txn->GetLockSet()->begin(); it != txn->GetLockSet()->end(); it++) {
         lock_manager_->Unlock(txn, *it);
@@ -92,16 +122,18 @@ void TransactionManager::Abort(Transaction *txn, LogManager *log_manager) {
                 auto fh_ = sm_manager_->fhs_.at(tab_name).get();
                 Context *context_ = new Context(lock_manager_, log_manager, txn);
                 auto rec = fh_->get_record(rid, context_);
+                // 插入的新值被回滚，释放其溢出页链
+                sm_manager_->release_overflow(tab_name, *rec);
                 // delete index
-                for (int i = 0; i < tab_.cols.size(); i++) {
-                    if (tab_.cols[i].index) {
-                        auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, i))
-                                       .get();  // index file handle
-                        ifh->delete_entry(rec->data + tab_.cols[i].offset, context_->txn_);
-                    }
-                    // delete record
-                    fh_->delete_record(rid, context_);
+                char key[IX_MAX_COL_LEN];
+                for (auto &index : tab_.indexes) {
+                    auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name, index.col_idxs);
+                    auto ifh = sm_manager_->ihs_.at(index_name).get();  // index file handle
+                    index.get_key(rec->data, key);
+                    ifh->delete_entry(key, rid, context_->txn_);
                 }
+                // delete record
+                fh_->delete_record(rid, context_);
             } else if ((*it)->GetWriteType() == WType::UPDATE_TUPLE) {
                 // 更新
                 Rid rid = (*it)->GetRid();
@@ -110,23 +142,28 @@ void TransactionManager::Abort(Transaction *txn, LogManager *log_manager) {
                 auto tab_ = sm_manager_->db_.get_table(tab_name);
                 auto fh_ = sm_manager_->fhs_.at(tab_name).get();
                 Context *context_ = new Context(lock_manager_, log_manager, txn);
-                // delete index
-                for (int i = 0; i < tab_.cols.size(); i++) {
-                    if (tab_.cols[i].index) {
-                        auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, i))
-                                       .get();  // index file handle
-                        ifh->delete_entry(rec.data + tab_.cols[i].offset, context_->txn_);
-                    }
-                    // update record
-                    fh_->update_record(rid, rec.data, context_);
-                    // insert index
-                    for (int i = 0; i < tab_.cols.size(); i++) {
-                        if (tab_.cols[i].index) {
-                            auto ifh = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, i))
-                                           .get();  // index file handle
-                            ifh->insert_entry(rec.data + tab_.cols[i].offset, rid, context_->txn_);
-                        }
-                    }
+                auto new_rec = fh_->get_record(rid, context_);
+                // 更新写入的新值被回滚，释放其溢出页链（与旧值相同的页链保留）
+                if (sm_manager_->ofhs_.count(tab_name)) {
+                    sm_manager_->release_overflow(tab_name, *new_rec, &rec);
+                }
+                // delete index of the new value
+                char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
+                for (auto &index : tab_.indexes) {
+                    auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name, index.col_idxs);
+                    auto ifh = sm_manager_->ihs_.at(index_name).get();  // index file handle
+                    index.get_key(new_rec->data, key);
+                    ifh->delete_entry(key, rid, context_->txn_);
+                }
+                // update record
+                fh_->update_record(rid, rec.data, context_);
+                // insert index of the old value
+                for (auto &index : tab_.indexes) {
+                    auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name, index.col_idxs);
+                    auto ifh = sm_manager_->ihs_.at(index_name).get();  // index file handle
+                    index.get_key(rec.data, key);
+                    index.get_include(rec.data, include);
+                    ifh->insert_entry(key, rid, context_->txn_, include);
                 }
             } else if ((*it)->GetWriteType() == WType::DELETE_TUPLE) {
                 // 插入
@@ -137,13 +174,13 @@ void TransactionManager::Abort(Transaction *txn, LogManager *log_manager) {
                 auto fh_ = sm_manager_->fhs_.at(tab_name).get();
                 Context *context_ = new Context(lock_manager_, log_manager, txn);
                 // insert index
-                for (size_t i = 0; i < tab_.cols.size(); i++) {
-                    auto &col = tab_.cols[i];
-                    if (col.index) {
-                        auto ih =
-                            sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, i)).get();
-                        ih->insert_entry(rec.data + col.offset, rid, context_->txn_);
-                    }
+                char key[IX_MAX_COL_LEN], include[IX_MAX_COL_LEN];
+                for (auto &index : tab_.indexes) {
+                    auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name, index.col_idxs);
+                    auto ih = sm_manager_->ihs_.at(index_name).get();  // index file handle
+                    index.get_key(rec.data, key);
+                    index.get_include(rec.data, include);
+                    ih->insert_entry(key, rid, context_->txn_, include);
                 }
                 // insert record
                 fh_->insert_record(rid, rec.data);
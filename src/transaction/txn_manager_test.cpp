@@ -122,3 +122,95 @@ TEST_F(TransactionTest, AbortTest) {
     EXPECT_EQ(txn->GetState(), TransactionState::ABORTED);
 }
 
+
+// test vacuum inside a transaction that modified the table
+TEST_F(TransactionTest, VacuumAbortTest) {
+    exec_sql("create table t1 (num int, str char(256));");
+    for (int i = 1; i <= 40; i++) {
+        exec_sql("insert into t1 values(" + std::to_string(i) + ", 'abc');");
+    }
+    exec_sql("begin;");
+    exec_sql("delete from t1 where num <= 20;");
+    // 回滚会把删除的记录写回原slot，vacuum不能把后面的记录移动进去
+    EXPECT_THROW(exec_sql("vacuum t1;"), InternalError);
+    exec_sql("abort;");
+    exec_sql("vacuum t1;");
+    exec_sql("select num from t1 where num <= 20;");
+    EXPECT_NE(strstr(result, "Total record(s): 20\n"), nullptr);
+    exec_sql("select num from t1 where num > 20;");
+    EXPECT_NE(strstr(result, "Total record(s): 20\n"), nullptr);
+}
+
+// test duplicate keys in a hash index
+TEST_F(TransactionTest, HashIndexDuplicateTest) {
+    exec_sql("create table t1 (id int, num int);");
+    exec_sql("insert into t1 values(1, 1);");
+    exec_sql("insert into t1 values(2, 1);");
+    // 哈希索引的key唯一，列上已有重复的值时不能建立
+    EXPECT_THROW(exec_sql("create index t1 (num) using hash;"), DuplicateKeyError);
+    exec_sql("create index t1 (num);");  // 失败时已经删除了哈希索引的文件
+    exec_sql("create index t1 (id) using hash;");
+    EXPECT_THROW(exec_sql("insert into t1 values(2, 2);"), DuplicateKeyError);
+    EXPECT_THROW(exec_sql("update t1 set id = 1 where id = 2;"), DuplicateKeyError);
+    EXPECT_THROW(exec_sql("update t1 set id = 3 where num = 1;"), DuplicateKeyError);
+    exec_sql("update t1 set id = 3 where id = 2;");
+    exec_sql("insert into t1 values(2, 2);");
+    exec_sql("select * from t1 where id = 2;");
+    const char *str = "+------------------+------------------+\n"
+        "|               id |              num |\n"
+        "+------------------+------------------+\n"
+        "|                2 |                2 |\n"
+        "+------------------+------------------+\n"
+        "Total record(s): 1\n";
+    EXPECT_STREQ(result, str);
+    exec_sql("select * from t1 where id = 3;");
+    EXPECT_NE(strstr(result, "Total record(s): 1\n"), nullptr);
+    exec_sql("select * from t1 where id = 1;");
+    EXPECT_NE(strstr(result, "Total record(s): 1\n"), nullptr);
+    // 哈希索引不能用于范围条件，应退化为全表扫描
+    exec_sql("select * from t1 where id > 1;");
+    EXPECT_NE(strstr(result, "Total record(s): 2\n"), nullptr);
+}
+
+// test releasing overflow pages of updated and deleted records at commit
+TEST_F(TransactionTest, OverflowCommitTest) {
+    exec_sql("create table t1 (id int, str char(1000));");
+    exec_sql("insert into t1 values(1, 'a');");
+    exec_sql("insert into t1 values(2, 'b');");
+    exec_sql("begin;");
+    // 同一条记录先更新再删除、连续更新两次，每条被替换的页链都在提交时释放且只释放一次
+    exec_sql("update t1 set str = 'c' where id = 1;");
+    exec_sql("delete from t1 where id = 1;");
+    exec_sql("update t1 set str = 'd' where id = 2;");
+    exec_sql("update t1 set str = 'e' where id = 2;");
+    exec_sql("commit;");
+    exec_sql("select * from t1;");
+    EXPECT_NE(strstr(result, "Total record(s): 1\n"), nullptr);
+    exec_sql("select id from t1 where str = 'e';");
+    EXPECT_NE(strstr(result, "Total record(s): 1\n"), nullptr);
+    // 释放的4个page被新插入的值复用，溢出文件不增长
+    int fd = sm_manager_->ofhs_.at("t1")->GetFd();
+    page_id_t num_pages = disk_manager_->get_fd2pageno(fd);
+    for (int i = 3; i <= 6; i++) {
+        exec_sql("insert into t1 values(" + std::to_string(i) + ", 'f');");
+    }
+    EXPECT_EQ(disk_manager_->get_fd2pageno(fd), num_pages);
+    exec_sql("insert into t1 values(7, 'g');");
+    EXPECT_EQ(disk_manager_->get_fd2pageno(fd), num_pages + 1);
+}
+
+// test that vacuum keeps the table lock until the transaction ends
+TEST_F(TransactionTest, VacuumLockTest) {
+    exec_sql("create table t1 (num int, str char(256));");
+    for (int i = 1; i <= 40; i++) {
+        exec_sql("insert into t1 values(" + std::to_string(i) + ", 'abc');");
+    }
+    exec_sql("delete from t1 where num <= 20;");
+    exec_sql("begin;");
+    exec_sql("vacuum t1;");
+    LockDataId lock_data_id{sm_manager_->fhs_.at("t1")->GetFd(), LockDataType::TABLE};
+    EXPECT_EQ(txn_manager_->GetTransaction(txn_id)->GetLockSet()->count(lock_data_id), 1u);
+    exec_sql("commit;");
+    exec_sql("select num from t1 where num > 20;");
+    EXPECT_NE(strstr(result, "Total record(s): 20\n"), nullptr);
+}